@@ -3,7 +3,9 @@
 
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Container/ArrayPtr.h>
+#include <Urho3D/Container/Sort.h>
 #include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/Thread.h>
 #include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/IO/PackageFile.h>
@@ -15,11 +17,17 @@
 #include <LZ4/lz4.h>
 #include <LZ4/lz4hc.h>
 
+#include <atomic>
+
 #include <Urho3D/DebugNew.h>
 
 using namespace Urho3D;
 
 static const unsigned COMPRESSED_BLOCK_SIZE = 32768;
+// Amount of file data to load at a time for compressing with multiple threads
+static const unsigned COMPRESS_BATCH_SIZE = 64 * 1024 * 1024;
+// Compressed entries which do not shrink below this ratio of the original size are stored uncompressed
+static const float MIN_COMPRESSION_RATIO = 0.9f;
 
 struct FileEntry
 {
@@ -27,6 +35,19 @@ struct FileEntry
     unsigned offset_{};
     unsigned size_{};
     hash32 checksum_{};
+    // Following are only used for version 2 packages
+    StringHash nameHash_;
+    unsigned packedSize_{};
+    PackageCodec codec_{};
+    SharedArrayPtr<u8> data_;
+    SharedArrayPtr<u8> packedData_;
+};
+
+// Compresses the entries of the current batch until none remain
+class CompressThread : public RefCounted, public Thread
+{
+public:
+    void ThreadFunction() override;
 };
 
 SharedPtr<Context> context_(new Context());
@@ -35,8 +56,12 @@ String basePath_;
 Vector<FileEntry> entries_;
 hash32 checksum_ = 0;
 bool compress_ = false;
+bool fastCompress_ = false;
+bool version2_ = false;
 bool quiet_ = false;
 unsigned blockSize_ = COMPRESSED_BLOCK_SIZE;
+std::atomic<i32> nextEntry_;
+i32 batchEnd_ = 0;
 
 String ignoreExtensions_[] = {
     ".bak",
@@ -50,7 +75,10 @@ void Pack(const Vector<String>& arguments);
 void Unpack(const Vector<String>& arguments);
 void ProcessFile(const String& fileName, const String& rootDir);
 void WritePackageFile(const String& fileName, const String& rootDir);
+void WritePackageFileV2(const String& fileName, const String& rootDir);
 void WriteHeader(File& dest);
+void WriteHeaderV2(File& dest);
+void CompressEntry(FileEntry& entry);
 
 int main(int argc, char** argv)
 {
@@ -72,8 +100,11 @@ static const String USAGE_STR =
     "   Options:\n"
     "     q - enable quiet mode\n"
     "     c - enable LZ4 compression\n"
+    "     2 - write a version 2 package, where each file is compressed only if that saves space\n"
+    "     f - use fast LZ4 compression instead of high compression (version 2 package only)\n"
     "   Base path is an optional prefix that will be added to the file entries.\n"
     "   Example: PackageTool -pqc CoreData CoreData.pak\n"
+    "   Example: PackageTool -pqc2 Data Data.pak\n"
     "2) Unpacking: PackageTool -u<options> <input package name> <output directory name>\n"
     "   Options:\n"
     "     q - enable quiet mode\n"
@@ -98,10 +129,17 @@ void Pack(const Vector<String>& arguments)
             quiet_ = true;
         else if (mode[i] == 'c')
             compress_ = true;
+        else if (mode[i] == 'f')
+            fastCompress_ = true;
+        else if (mode[i] == '2')
+            version2_ = true;
         else
             ErrorExit("Unrecognized option");
     }
 
+    if (fastCompress_ && !version2_)
+        ErrorExit("Fast compression is applicable for version 2 package only");
+
     const String& dirName = arguments[1];
     const String& packageName = arguments[2];
     
@@ -134,7 +172,10 @@ void Pack(const Vector<String>& arguments)
     for (unsigned i = 0; i < fileNames.Size(); ++i)
         ProcessFile(fileNames[i], dirName);
 
-    WritePackageFile(packageName, dirName);
+    if (version2_)
+        WritePackageFileV2(packageName, dirName);
+    else
+        WritePackageFile(packageName, dirName);
 }
 
 void Unpack(const Vector<String>& arguments)
@@ -220,6 +261,7 @@ void PrintInfo(const Vector<String>& arguments)
         PrintLine("Package size: " + String(packageFile->GetTotalSize()));
         PrintLine("Checksum: " + String(packageFile->GetChecksum()));
         PrintLine("Compressed: " + String(packageFile->IsCompressed() ? "yes" : "no"));
+        PrintLine("Version: " + String(packageFile->GetVersion()));
         break;
     case 'L':
         if (!packageFile->IsCompressed())
@@ -235,9 +277,7 @@ void PrintInfo(const Vector<String>& arguments)
                 String fileEntry(current->first_);
                 if (outputCompressionRatio)
                 {
-                    unsigned compressedSize =
-                        (i == entries.End() ? packageFile->GetTotalSize() - sizeof(unsigned) : i->second_.offset_) -
-                        current->second_.offset_;
+                    unsigned compressedSize = current->second_.packedSize_;
                     fileEntry.AppendWithFormat("\tin: %u\tout: %u\tratio: %f", current->second_.size_, compressedSize,
                         compressedSize ? 1.f * current->second_.size_ / compressedSize : 0.f);
                 }
@@ -409,3 +449,199 @@ void WriteHeader(File& dest)
     dest.WriteU32(entries_.Size());
     dest.WriteU32(checksum_);
 }
+
+static bool CompareEntryHashes(const FileEntry& lhs, const FileEntry& rhs)
+{
+    return lhs.nameHash_ < rhs.nameHash_;
+}
+
+void CompressThread::ThreadFunction()
+{
+    for (;;)
+    {
+        i32 index = nextEntry_++;
+        if (index >= batchEnd_)
+            break;
+        CompressEntry(entries_[index]);
+    }
+}
+
+void CompressEntry(FileEntry& entry)
+{
+    unsigned dataSize = entry.size_;
+    const u8* data = entry.data_.Get();
+
+    entry.checksum_ = 0;
+    for (unsigned i = 0; i < dataSize; ++i)
+        entry.checksum_ = SDBMHash(entry.checksum_, data[i]);
+
+    entry.codec_ = PACKAGE_CODEC_NONE;
+    entry.packedSize_ = dataSize;
+    if (!compress_)
+        return;
+
+    // Worst case size: every block is incompressible and has a 4 byte header
+    unsigned numBlocks = (dataSize + blockSize_ - 1) / blockSize_;
+    unsigned maxPackedSize = numBlocks * (LZ4_compressBound(blockSize_) + 4);
+    SharedArrayPtr<u8> packedData(new u8[maxPackedSize]);
+
+    unsigned pos = 0;
+    unsigned packedPos = 0;
+
+    while (pos < dataSize)
+    {
+        unsigned unpackedSize = blockSize_;
+        if (pos + unpackedSize > dataSize)
+            unpackedSize = dataSize - pos;
+
+        char* blockData = (char*)packedData.Get() + packedPos + 4;
+        int bound = LZ4_compressBound(unpackedSize);
+        auto packedSize = (unsigned)(fastCompress_ ?
+            LZ4_compress_default((const char*)&data[pos], blockData, unpackedSize, bound) :
+            LZ4_compress_HC((const char*)&data[pos], blockData, unpackedSize, bound, 0));
+        if (!packedSize)
+            ErrorExit("LZ4 compression failed for file " + entry.name_ + " at offset " + String(pos));
+
+        u8* blockHeader = packedData.Get() + packedPos;
+        blockHeader[0] = (u8)(unpackedSize & 0xff);
+        blockHeader[1] = (u8)(unpackedSize >> 8);
+        blockHeader[2] = (u8)(packedSize & 0xff);
+        blockHeader[3] = (u8)(packedSize >> 8);
+
+        packedPos += packedSize + 4;
+        pos += unpackedSize;
+    }
+
+    // Keep the file uncompressed if compression does not save enough to be worth decompressing
+    if (packedPos < dataSize * MIN_COMPRESSION_RATIO)
+    {
+        entry.codec_ = fastCompress_ ? PACKAGE_CODEC_LZ4 : PACKAGE_CODEC_LZ4HC;
+        entry.packedSize_ = packedPos;
+        entry.packedData_ = packedData;
+    }
+}
+
+void WritePackageFileV2(const String& fileName, const String& rootDir)
+{
+    if (!quiet_)
+        PrintLine("Writing package");
+
+    File dest(context_);
+    if (!dest.Open(fileName, FILE_WRITE))
+        ErrorExit("Could not open output file " + fileName);
+
+    // The directory is sorted by name hash so that it can be binary searched when loading
+    for (i32 i = 0; i < entries_.Size(); ++i)
+        entries_[i].nameHash_ = basePath_ + entries_[i].name_;
+    Sort(entries_.Begin(), entries_.End(), CompareEntryHashes);
+
+    // Write ID, number of files & placeholder for checksum
+    WriteHeaderV2(dest);
+
+    unsigned numThreads = Max(GetNumLogicalCPUs(), 1u);
+    unsigned totalDataSize = 0;
+    i32 batchStart = 0;
+
+    while (batchStart < entries_.Size())
+    {
+        // Load a batch of files, then compress them using all threads
+        unsigned batchSize = 0;
+        batchEnd_ = batchStart;
+        while (batchEnd_ < entries_.Size() && (batchEnd_ == batchStart || batchSize + entries_[batchEnd_].size_ <= COMPRESS_BATCH_SIZE))
+        {
+            FileEntry& entry = entries_[batchEnd_];
+            String fileFullPath = rootDir + "/" + entry.name_;
+
+            File srcFile(context_, fileFullPath);
+            if (!srcFile.IsOpen())
+                ErrorExit("Could not open file " + fileFullPath);
+
+            entry.data_ = new u8[entry.size_];
+            if (srcFile.Read(&entry.data_[0], entry.size_) != entry.size_)
+                ErrorExit("Could not read file " + fileFullPath);
+
+            batchSize += entry.size_;
+            ++batchEnd_;
+        }
+
+        nextEntry_ = batchStart;
+        Vector<SharedPtr<CompressThread>> threads;
+        for (unsigned i = 1; i < numThreads && i < (unsigned)(batchEnd_ - batchStart); ++i)
+        {
+            SharedPtr<CompressThread> thread(new CompressThread());
+            thread->Run();
+            threads.Push(thread);
+        }
+        // Main thread also participates, then waits for the rest
+        CompressThread().ThreadFunction();
+        for (i32 i = 0; i < threads.Size(); ++i)
+            threads[i]->Stop();
+
+        // Write file data and correct offsets
+        for (i32 i = batchStart; i < batchEnd_; ++i)
+        {
+            FileEntry& entry = entries_[i];
+            entry.offset_ = dest.GetSize();
+            totalDataSize += entry.size_;
+            // Package checksum is calculated from the file checksums, as the files are checksummed in parallel
+            checksum_ = SDBMHash(checksum_, (u8)(entry.checksum_ & 0xff));
+            checksum_ = SDBMHash(checksum_, (u8)((entry.checksum_ >> 8) & 0xff));
+            checksum_ = SDBMHash(checksum_, (u8)((entry.checksum_ >> 16) & 0xff));
+            checksum_ = SDBMHash(checksum_, (u8)(entry.checksum_ >> 24));
+
+            if (entry.codec_ == PACKAGE_CODEC_NONE)
+                dest.Write(&entry.data_[0], entry.size_);
+            else
+                dest.Write(&entry.packedData_[0], entry.packedSize_);
+
+            if (!quiet_)
+            {
+                String fileEntry(entry.name_);
+                fileEntry.AppendWithFormat("\tin: %u\tout: %u\tratio: %f", entry.size_, entry.packedSize_,
+                    1.f * entry.size_ / entry.packedSize_);
+                PrintLine(fileEntry);
+            }
+
+            entry.data_.Reset();
+            entry.packedData_.Reset();
+        }
+
+        batchStart = batchEnd_;
+    }
+
+    // Write package size to the end of file to allow finding it linked to an executable file
+    unsigned currentSize = dest.GetSize();
+    dest.WriteU32(currentSize + sizeof(unsigned));
+
+    // Write header again with correct offsets & checksums
+    dest.Seek(0);
+    WriteHeaderV2(dest);
+
+    if (!quiet_)
+    {
+        PrintLine("Number of files: " + String(entries_.Size()));
+        PrintLine("File data size: " + String(totalDataSize));
+        PrintLine("Package size: " + String(dest.GetSize()));
+        PrintLine("Checksum: " + String(checksum_));
+        PrintLine("Compressed: " + String(compress_ ? "yes" : "no"));
+    }
+}
+
+void WriteHeaderV2(File& dest)
+{
+    dest.WriteFileID("UPK2");
+    dest.WriteU32(entries_.Size());
+    dest.WriteU32(checksum_);
+
+    for (i32 i = 0; i < entries_.Size(); ++i)
+    {
+        // Offsets, sizes & checksums are placeholders on the first write
+        dest.WriteStringHash(entries_[i].nameHash_);
+        dest.WriteString(basePath_ + entries_[i].name_);
+        dest.WriteU32(entries_[i].offset_);
+        dest.WriteU32(entries_[i].size_);
+        dest.WriteU32(entries_[i].packedSize_);
+        dest.WriteU32(entries_[i].checksum_);
+        dest.WriteU8((u8)entries_[i].codec_);
+    }
+}
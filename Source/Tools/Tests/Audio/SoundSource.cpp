@@ -0,0 +1,158 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Audio/Audio.h>
+#include <Urho3D/Audio/Sound.h>
+#include <Urho3D/Audio/SoundSource.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+static constexpr i32 MIX_RATE = 44100;
+
+// Create a 16-bit sound from sample values
+static SharedPtr<Sound> CreateSound(Context* context, const Vector<short>& samples, i32 frequency, bool stereo)
+{
+    SharedPtr<Sound> sound(new Sound(context));
+    sound->SetData(samples.Buffer(), samples.Size() * (u32)sizeof(short));
+    sound->SetFormat(frequency, true, stereo);
+    return sound;
+}
+
+// Return a buffer that already holds other sound
+static Vector<i32> CreateMixBuffer(u32 frames, bool stereo)
+{
+    const u32 size = stereo ? frames * 2 : frames;
+    Vector<i32> dest(size);
+    for (u32 i = 0; i < size; ++i)
+        dest[i] = (i32)(i * 7919 % 20001) - 10000;
+    return dest;
+}
+
+// Mix a sound into a buffer that already holds other sound
+static Vector<i32> MixSound(SoundSource* source, Sound* sound, u32 frames, bool stereo)
+{
+    Vector<i32> dest = CreateMixBuffer(frames, stereo);
+    source->SetFrequency(0.0f);
+    source->Play(sound);
+    source->Mix(dest.Buffer(), frames, MIX_RATE, stereo, false);
+    return dest;
+}
+
+void Test_Audio_SoundSource()
+{
+    SharedPtr<Context> context(new Context());
+    context->RegisterSubsystem(new Audio(context));
+
+    SharedPtr<Scene> scene(new Scene(context));
+    auto* source = scene->CreateChild()->CreateComponent<SoundSource>();
+
+    {
+        // Without resampling 16-bit sounds are mixed with the vectorized kernels. Sounds at twice the rate skip every other
+        // frame with the scalar routines, so mixing them must give the same result as the vectorized kernels mixing the
+        // frames that are left. The frame count is not a multiple of the vector width, so the scalar tail is mixed too
+        constexpr u32 frames = 1003;
+        const float gains[] = {1.0f, 0.73f, 0.002f, 5.5f};
+
+        for (i32 channels = 1; channels <= 2; ++channels)
+        {
+            Vector<short> samples;
+            Vector<short> everyOther;
+            for (u32 i = 0; i < frames * 2; ++i)
+            {
+                for (i32 j = 0; j < channels; ++j)
+                {
+                    // Include the extremes, whose products overflow 16 bits in both directions
+                    auto sample = (short)(i % 97 == 0 ? (j ? 32767 : -32768) : (i32)(i * 40503 + j * 9973) % 65536 - 32768);
+                    samples.Push(sample);
+                    if (i % 2 == 0)
+                        everyOther.Push(sample);
+                }
+            }
+
+            SharedPtr<Sound> doubleRate = CreateSound(context, samples, MIX_RATE * 2, channels == 2);
+            SharedPtr<Sound> unitRate = CreateSound(context, everyOther, MIX_RATE, channels == 2);
+
+            for (float gain : gains)
+            {
+                source->SetGain(gain);
+                source->SetPanning(channels == 1 ? -0.4f : 0.0f);
+
+                // Stereo sounds are mixed to a mono output only by the scalar routines
+                for (i32 stereo = channels - 1; stereo <= 1; ++stereo)
+                {
+                    Vector<i32> scalar = MixSound(source, doubleRate, frames, stereo);
+                    assert(!source->IsPlaying());
+                    Vector<i32> vectorized = MixSound(source, unitRate, frames, stereo);
+                    assert(!source->IsPlaying());
+                    assert(scalar == vectorized);
+                    assert(vectorized != CreateMixBuffer(frames, stereo));
+                }
+            }
+        }
+    }
+
+    {
+        // Voices beyond the limits are taken from the lowest priority sources, however loud they are
+        auto* audio = context->GetSubsystem<Audio>();
+        Vector<short> samples(1000, 1000);
+        SharedPtr<Sound> sound = CreateSound(context, samples, MIX_RATE, false);
+        sound->SetLooped(true);
+
+        const i32 priorities[] = {0, 5, 0, 10, 5};
+        const float gains[] = {1.0f, 0.1f, 0.5f, 0.2f, 0.3f};
+        SoundSource* sources[5];
+        for (i32 i = 0; i < 5; ++i)
+        {
+            sources[i] = scene->CreateChild()->CreateComponent<SoundSource>();
+            sources[i]->SetPriority(priorities[i]);
+            sources[i]->SetGain(gains[i]);
+            sources[i]->Play(sound);
+        }
+        source->Stop();
+
+        // Resuming updates the voices also without an audio device
+        audio->SetMaxVoices(3);
+        audio->ResumeAll();
+        assert(audio->GetNumVirtualVoices() == 2);
+        assert(!sources[3]->IsVirtual());
+        assert(!sources[1]->IsVirtual() && !sources[4]->IsVirtual());
+        assert(sources[0]->IsVirtual() && sources[2]->IsVirtual());
+
+        // Among equal priorities the louder source keeps its voice
+        audio->SetMaxVoices(2);
+        audio->ResumeAll();
+        assert(!sources[3]->IsVirtual() && !sources[4]->IsVirtual());
+        assert(sources[1]->IsVirtual());
+
+        // Raising the priority of a virtual source steals the voice of the quietest lowest priority one
+        sources[2]->SetPriority(20);
+        audio->ResumeAll();
+        assert(!sources[2]->IsVirtual() && !sources[3]->IsVirtual());
+        assert(sources[4]->IsVirtual());
+
+        // Sound type limits are applied in priority order too
+        sources[0]->SetSoundType(SOUND_MUSIC);
+        sources[3]->SetSoundType(SOUND_MUSIC);
+        audio->SetMaxVoices(0);
+        audio->SetSoundTypeVoiceLimit(SOUND_MUSIC, 1);
+        audio->ResumeAll();
+        assert(!sources[3]->IsVirtual() && sources[0]->IsVirtual());
+        assert(!sources[1]->IsVirtual() && !sources[2]->IsVirtual() && !sources[4]->IsVirtual());
+        assert(audio->GetNumVirtualVoices() == 1);
+
+        // A stopped source gives its voice back
+        audio->SetSoundTypeVoiceLimit(SOUND_MUSIC, 0);
+        audio->SetMaxVoices(1);
+        sources[2]->Stop();
+        audio->ResumeAll();
+        assert(!sources[2]->IsVirtual());
+        assert(!sources[3]->IsVirtual());
+        assert(audio->GetNumVirtualVoices() == 3);
+    }
+}
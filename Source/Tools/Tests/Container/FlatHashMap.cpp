@@ -0,0 +1,132 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Container/FlatHashMap.h>
+#include <Urho3D/Container/FlatHashSet.h>
+#include <Urho3D/Container/HashMap.h>
+#include <Urho3D/Math/StringHash.h>
+
+#include <chrono>
+#include <iostream>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+// Number of keys in the benchmark
+static constexpr i32 NUM_KEYS = 50000;
+
+// Return microseconds since the previous call
+static long long ElapsedUSec(std::chrono::steady_clock::time_point& start)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    long long usec = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+    start = now;
+    return usec;
+}
+
+template <class Map> static void BenchmarkMap(const char* name, const Vector<StringHash>& keys)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Map map;
+    for (i32 i = 0; i < keys.Size(); ++i)
+        map[keys[i]] = i;
+    long long insertUSec = ElapsedUSec(start);
+
+    i64 sum = 0;
+    for (i32 pass = 0; pass < 10; ++pass)
+    {
+        for (const StringHash& key : keys)
+            sum += map.Find(key)->second_;
+    }
+    long long findUSec = ElapsedUSec(start);
+
+    assert(sum == (i64)keys.Size() * (keys.Size() - 1) / 2 * 10);
+
+    std::cout << name << ": " << keys.Size() * 1000LL / Max(insertUSec, 1LL) << " inserts/ms, "
+        << keys.Size() * 10000LL / Max(findUSec, 1LL) << " lookups/ms" << std::endl;
+}
+
+void Test_Container_FlatHashMap()
+{
+    {
+        FlatHashMap<i32, String> map;
+        assert(map.Empty());
+        assert(map.Begin() == map.End());
+        assert(!map.Contains(1));
+
+        map[1] = "one";
+        map.Insert(MakePair(2, String("two")));
+        bool exists;
+        map.Insert(MakePair(2, String("TWO")), exists);
+        assert(exists);
+        assert(map.Size() == 2);
+        assert(map[2] == "TWO");
+
+        assert(map.Erase(1));
+        assert(!map.Erase(1));
+        assert(map.Size() == 1);
+        assert(map.Find(2)->second_ == "TWO");
+    }
+
+    {
+        // Compare against HashMap with random inserts and erases, including erased slots being reused
+        FlatHashMap<i32, i32> flat;
+        HashMap<i32, i32> chained;
+        FlatHashSet<i32> set;
+        u32 random = 1;
+        for (i32 i = 0; i < 100000; ++i)
+        {
+            random = random * 1103515245u + 12345u;
+            i32 key = (i32)((random >> 16u) % 3000u);
+            if (random & 0x80000000u)
+            {
+                assert(flat.Erase(key) == chained.Erase(key));
+                set.Erase(key);
+            }
+            else
+            {
+                flat[key] = i;
+                chained[key] = i;
+                set.Insert(key);
+            }
+        }
+
+        assert(flat.Size() == chained.Size());
+        assert(set.Size() == chained.Size());
+        for (HashMap<i32, i32>::ConstIterator i = chained.Begin(); i != chained.End(); ++i)
+        {
+            assert(flat.Find(i->first_) != flat.End());
+            assert(flat.Find(i->first_)->second_ == i->second_);
+            assert(set.Contains(i->first_));
+        }
+
+        i32 count = 0;
+        for (FlatHashMap<i32, i32>::Iterator i = flat.Begin(); i != flat.End();)
+        {
+            if (i->first_ % 2)
+                i = flat.Erase(i);
+            else
+            {
+                ++count;
+                ++i;
+            }
+        }
+        assert(count == flat.Size());
+
+        FlatHashMap<i32, i32> copy(flat);
+        assert(copy == flat);
+    }
+
+    {
+        Vector<StringHash> keys;
+        keys.Reserve(NUM_KEYS);
+        for (i32 i = 0; i < NUM_KEYS; ++i)
+            keys.Push(StringHash("Key" + String(i)));
+
+        BenchmarkMap<HashMap<StringHash, i32>>("HashMap", keys);
+        BenchmarkMap<FlatHashMap<StringHash, i32>>("FlatHashMap", keys);
+    }
+}
@@ -0,0 +1,254 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Container/Allocator.h>
+#include <Urho3D/Container/FrameArena.h>
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/Component.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneEvents.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+// Number of heap allocations made through the global operator new
+static std::atomic<i32> numAllocations{0};
+
+void* operator new(size_t size)
+{
+    ++numAllocations;
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+// Number of frames in the benchmark
+static constexpr i32 NUM_FRAMES = 100;
+// Number of nodes in the benchmark scene
+static constexpr i32 NUM_NODES = 1000;
+// Number of short-lived nodes created and removed per frame, like effects
+static constexpr i32 NUM_SPAWNED = 20;
+
+URHO3D_EVENT(E_FRAMEBENCHMARK, FrameBenchmark)
+{
+    URHO3D_PARAM(P_NODES, Nodes);                  // FrameVector<Node*> pointer
+}
+
+namespace
+{
+
+// Component that moves its node on the scene update, and adds it to a list on the benchmark event
+class FrameComponent : public Component
+{
+    URHO3D_OBJECT(FrameComponent, Component);
+
+public:
+    explicit FrameComponent(Context* context) :
+        Component(context)
+    {
+    }
+
+protected:
+    void OnSceneSet(Scene* scene) override
+    {
+        if (scene)
+        {
+            SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(FrameComponent, HandleSceneUpdate));
+            SubscribeToEvent(E_FRAMEBENCHMARK, URHO3D_HANDLER(FrameComponent, HandleFrameBenchmark));
+        }
+        else
+            UnsubscribeFromAllEvents();
+    }
+
+private:
+    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+    {
+        node_->Translate(Vector3::FORWARD * eventData[SceneUpdate::P_TIMESTEP].GetFloat());
+    }
+
+    void HandleFrameBenchmark(StringHash eventType, VariantMap& eventData)
+    {
+        static_cast<FrameVector<Node*>*>(eventData[FrameBenchmark::P_NODES].GetVoidPtr())->Push(node_);
+    }
+};
+
+// Update the scene, send an event to all its components and create and remove short-lived nodes. Return number of allocations
+i32 UpdateFrame(Scene* scene, Node** spawned, bool spawn)
+{
+    i32 before = numAllocations;
+
+    scene->Update(1.f / 60.f);
+
+    {
+        FrameVector<Node*> nodes;
+        VariantMap& eventData = scene->GetEventDataMap();
+        eventData[FrameBenchmark::P_NODES] = &nodes;
+        scene->SendEvent(E_FRAMEBENCHMARK, eventData);
+        assert(nodes.Size() >= NUM_NODES);
+    }
+
+    if (spawn)
+    {
+        for (i32 i = 0; i < NUM_SPAWNED; ++i)
+        {
+            if (spawned[i])
+                spawned[i]->Remove();
+            spawned[i] = scene->CreateChild(String::EMPTY, LOCAL);
+            spawned[i]->CreateComponent<FrameComponent>(LOCAL);
+        }
+    }
+
+    FrameArena::EndFrame();
+    return numAllocations - before;
+}
+
+// Print and return average number of allocations per frame after the first frames
+i32 BenchmarkFrames(Scene* scene, bool spawn, const char* name)
+{
+    Node* spawned[NUM_SPAWNED]{};
+
+    // Let the pool, the arena and the scene containers grow to their peak size
+    for (i32 i = 0; i < 5; ++i)
+        UpdateFrame(scene, spawned, spawn);
+
+    i32 total = 0;
+    for (i32 i = 0; i < NUM_FRAMES; ++i)
+        total += UpdateFrame(scene, spawned, spawn);
+
+    for (Node* node : spawned)
+    {
+        if (node)
+            node->Remove();
+    }
+
+    std::cout << name << ": " << total / NUM_FRAMES << " allocations/frame" << std::endl;
+    return total / NUM_FRAMES;
+}
+
+}
+
+void Test_Container_FrameArena()
+{
+    {
+        FrameArena arena;
+        void* a = arena.Allocate(3, 1);
+        void* b = arena.Allocate(8, 16);
+        assert(((size_t)b & 15u) == 0);
+        assert(b != a);
+
+        // Only the most recent allocation is given back
+        arena.Release(a, 3);
+        arena.Release(b, 8);
+        assert(arena.Allocate(8, 16) == b);
+
+        // A big allocation adds a block, and after rewinding the blocks are merged into one that fits both
+        arena.Allocate(1024 * 1024);
+        i32 capacity = arena.GetCapacity();
+        arena.Reset();
+        assert(arena.GetUsed() == 0);
+        assert(arena.GetCapacity() == capacity);
+        arena.Allocate(1024 * 1024);
+        assert(arena.GetCapacity() == capacity);
+    }
+
+    {
+        FrameVector<i32> vector;
+        for (i32 i = 0; i < 100; ++i)
+            vector.Push(i);
+        assert(vector.Size() == 100);
+        assert(vector[99] == 99);
+        assert(vector.Contains(50));
+        vector.Resize(10);
+        assert(vector.Back() == 9);
+        vector.Pop();
+        assert(vector.Size() == 9);
+    }
+
+    {
+        // Allocate and free from several threads at once, checking that no memory is handed out twice
+        std::thread threads[4];
+        for (i32 t = 0; t < 4; ++t)
+        {
+            threads[t] = std::thread([t]()
+            {
+                for (i32 pass = 0; pass < 100; ++pass)
+                {
+                    i32* values[100];
+                    for (i32 i = 0; i < 100; ++i)
+                    {
+                        values[i] = static_cast<i32*>(PoolAllocate(sizeof(i32) * (1 + i % 40)));
+                        *values[i] = t * 1000 + i;
+                    }
+                    for (i32 i = 0; i < 100; ++i)
+                    {
+                        assert(*values[i] == t * 1000 + i);
+                        PoolFree(values[i], sizeof(i32) * (1 + i % 40));
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    {
+        // Freed pool memory is reused without heap allocations, and is returned to the system by trimming
+        PoolTrim();
+        void* objects[2000];
+        for (void*& object : objects)
+            object = PoolAllocate(96);
+        for (void* object : objects)
+            PoolFree(object, 96);
+
+        i32 before = numAllocations;
+        for (void*& object : objects)
+            object = PoolAllocate(96);
+        assert(numAllocations == before);
+
+        // A chunk with an object left is kept
+        for (i32 i = 1; i < 2000; ++i)
+            PoolFree(objects[i], 96);
+        assert(PoolTrim() > 0);
+        assert(PoolTrim() == 0);
+        PoolFree(objects[0], 96);
+        assert(PoolTrim() > 0);
+    }
+
+    {
+        // Measure real frames: the scene update and an event reaching every component, without and with nodes
+        // created and removed during the frame
+        SharedPtr<Context> context(new Context());
+        RegisterSceneLibrary(context);
+        context->RegisterFactory<FrameComponent>();
+
+        SharedPtr<Scene> scene(new Scene(context));
+        for (i32 i = 0; i < NUM_NODES; ++i)
+            scene->CreateChild()->CreateComponent<FrameComponent>();
+
+        // Once the containers have grown, the update and the event do not allocate
+        assert(BenchmarkFrames(scene, false, "Scene update and event") == 0);
+        BenchmarkFrames(scene, true, "Scene update and event, nodes created and removed");
+    }
+}
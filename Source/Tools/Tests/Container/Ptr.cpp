@@ -0,0 +1,77 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Container/Ptr.h>
+
+#include <thread>
+#include <utility>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+class Base : public RefCounted
+{
+};
+
+class Derived : public Base
+{
+};
+
+}
+
+void Test_Container_Ptr()
+{
+    {
+        SharedPtr<Derived> derived(new Derived());
+        WeakPtr<Derived> weak(derived);
+
+        // Moving to a base class pointer does not change the reference count
+        SharedPtr<Base> base(std::move(derived));
+        assert(derived.Null());
+        assert(base.Refs() == 1);
+
+        SharedPtr<Base> assigned;
+        assigned = std::move(base);
+        assert(base.Null());
+        assert(assigned.Refs() == 1);
+
+        SharedPtr<Derived> locked = weak.Lock();
+        assert(locked.Refs() == 2);
+        locked.Reset();
+        assigned.Reset();
+        assert(weak.Expired());
+        assert(weak.Lock().Null());
+    }
+
+#ifdef URHO3D_THREAD_SAFE_REFCOUNT
+    {
+        // Copy and release shared and weak pointers to the same object in several threads at once
+        SharedPtr<Base> object(new Derived());
+        WeakPtr<Base> weak(object);
+        std::thread threads[4];
+        for (std::thread& thread : threads)
+        {
+            thread = std::thread([&object, &weak]()
+            {
+                for (i32 i = 0; i < 100000; ++i)
+                {
+                    SharedPtr<Base> copy(object);
+                    WeakPtr<Base> weakCopy(weak);
+                    assert(weakCopy.Lock() == copy);
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+
+        assert(object.Refs() == 1);
+        assert(weak.WeakRefs() == 1);
+    }
+#endif
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Container/Sort.h>
+#include <Urho3D/Container/Vector.h>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+struct Element
+{
+    u64 key_;
+    i32 index_;
+};
+
+// Radix sort the elements and check that the result is the one of a comparison sort which breaks ties by the original order
+void CheckRadixSort(Vector<Element>& elements)
+{
+    for (i32 i = 0; i < elements.Size(); ++i)
+        elements[i].index_ = i;
+
+    Vector<Element> expected = elements;
+    Sort(expected.Begin(), expected.End(), [](const Element& lhs, const Element& rhs)
+    {
+        return lhs.key_ != rhs.key_ ? lhs.key_ < rhs.key_ : lhs.index_ < rhs.index_;
+    });
+
+    Vector<Element> temp(elements.Size());
+    RadixSort(elements.Begin(), elements.End(), temp.Begin());
+
+    assert(elements.Size() == expected.Size());
+    for (i32 i = 0; i < elements.Size(); ++i)
+    {
+        assert(elements[i].key_ == expected[i].key_);
+        assert(elements[i].index_ == expected[i].index_);
+    }
+}
+
+}
+
+void Test_Container_RadixSort()
+{
+    {
+        // Nothing to sort
+        Vector<Element> elements;
+        CheckRadixSort(elements);
+        assert(elements.Empty());
+
+        elements.Push(Element{0xffffffffffffffffull, 0});
+        CheckRadixSort(elements);
+        assert(elements.Size() == 1 && elements[0].key_ == 0xffffffffffffffffull);
+    }
+
+    {
+        // Equal keys in all passes leave the order as it is
+        Vector<Element> elements(100);
+        for (Element& element : elements)
+            element.key_ = 0x0123456789abcdefull;
+        CheckRadixSort(elements);
+    }
+
+    {
+        // Keys which differ in one byte only take one pass, which leaves the result in the temporary array
+        for (i32 byte = 0; byte < 8; ++byte)
+        {
+            Vector<Element> elements(300);
+            for (i32 i = 0; i < elements.Size(); ++i)
+                elements[i].key_ = 0x5555555555555555ull ^ ((u64)(i * 37 % 256) << (byte * 8));
+            CheckRadixSort(elements);
+        }
+    }
+
+    {
+        // The high byte decides the order over all the lower ones, and keys with the top bit set come last
+        Vector<Element> elements(512);
+        for (i32 i = 0; i < elements.Size(); ++i)
+            elements[i].key_ = ((u64)(i * 91 % 256) << 56) | (u64)(elements.Size() - i);
+        CheckRadixSort(elements);
+        assert(elements.Front().key_ >> 56 == 0x00);
+        assert(elements.Back().key_ >> 56 == 0xff);
+    }
+
+    {
+        // Random keys with many ties, spread over all bytes or packed like the draw order and distance keys of batches
+        u64 seed = 0x2545f4914f6cdd1dull;
+        for (i32 run = 0; run < 4; ++run)
+        {
+            Vector<Element> elements(2000 + run);
+            for (Element& element : elements)
+            {
+                seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+                u64 value = seed >> 16;
+                element.key_ = run % 2 ? (value % 50) * 0x0101010101010101ull : (value % 8) << 32 | (value >> 20) % 30;
+            }
+            CheckRadixSort(elements);
+        }
+    }
+}
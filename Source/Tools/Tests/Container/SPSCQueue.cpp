@@ -0,0 +1,86 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Container/SPSCQueue.h>
+
+#include <thread>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+void Test_Container_SPSCQueue()
+{
+    {
+        SPSCQueue<i32, 4> queue;
+        i32 value = -1;
+        assert(queue.Empty());
+        assert(!queue.Pop(value));
+        assert(value == -1);
+
+        // A full queue refuses the value and keeps the ones it has
+        for (i32 i = 0; i < 4; ++i)
+            assert(queue.Push(i));
+        assert(!queue.Push(4));
+        assert(!queue.Empty());
+        for (i32 i = 0; i < 4; ++i)
+        {
+            assert(queue.Pop(value));
+            assert(value == i);
+        }
+        assert(queue.Empty());
+        assert(!queue.Pop(value));
+
+        // Positions wrap around the buffer many times over
+        i32 next = 0;
+        for (i32 i = 0; i < 1000; ++i)
+        {
+            assert(queue.Push(i * 2));
+            assert(queue.Push(i * 2 + 1));
+            // Take one value on even steps and three on odd steps, so the queue holds up to three values
+            for (i32 j = 0; j < (i % 2 ? 3 : 1); ++j)
+            {
+                assert(queue.Pop(value));
+                assert(value == next);
+                ++next;
+            }
+        }
+        while (queue.Pop(value))
+        {
+            assert(value == next);
+            ++next;
+        }
+        assert(next == 2000);
+    }
+
+    {
+        // Values arrive in order when the producer and the consumer run on different threads
+        constexpr i32 numValues = 100000;
+        SPSCQueue<i32, 64> queue;
+        std::thread producer([&queue]()
+        {
+            for (i32 i = 0; i < numValues; ++i)
+            {
+                while (!queue.Push(i))
+                    std::this_thread::yield();
+            }
+        });
+
+        i32 next = 0;
+        while (next < numValues)
+        {
+            i32 value;
+            if (queue.Pop(value))
+            {
+                assert(value == next);
+                ++next;
+            }
+            else
+                std::this_thread::yield();
+        }
+        producer.join();
+        assert(queue.Empty());
+    }
+}
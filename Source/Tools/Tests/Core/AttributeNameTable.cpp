@@ -0,0 +1,152 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Core/AttributeNameTable.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Resource/XMLFile.h>
+#include <Urho3D/Scene/Serializable.h>
+
+#include <thread>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+// Hashes of literals are compile time constants
+static_assert("Int Value"_hash.Value() == StringHash::Calculate("Int Value"));
+static_assert(StringHash() + "Int Value"_hash == "Int Value"_hash);
+
+namespace
+{
+
+class TestSerializable : public Serializable
+{
+    URHO3D_OBJECT(TestSerializable, Serializable);
+
+public:
+    explicit TestSerializable(Context* context) :
+        Serializable(context)
+    {
+    }
+
+    static void RegisterObject(Context* context)
+    {
+        URHO3D_ATTRIBUTE("Int Value", intValue_, 0, AM_DEFAULT);
+        URHO3D_ATTRIBUTE("Float Value", floatValue_, 0.f, AM_DEFAULT);
+        URHO3D_ATTRIBUTE("Edit Only", editOnly_, 0, AM_EDIT);
+    }
+
+    i32 intValue_{};
+    float floatValue_{};
+    i32 editOnly_{};
+};
+
+}
+
+void Test_Core_AttributeNameTable()
+{
+    {
+        Vector<AttributeInfo> attributes;
+        for (i32 i = 0; i < 300; ++i)
+            attributes.Push(AttributeInfo(VAR_INT, ("Attribute " + String(i)).CString(), nullptr, nullptr, 0, AM_DEFAULT));
+
+        AttributeNameTable table;
+        assert(table.Build(attributes));
+        for (i32 i = 0; i < attributes.Size(); ++i)
+            assert(table.Find(StringHash(attributes[i].name_)) == i);
+        assert(table.Find("Missing") == NINDEX);
+
+        // Same names can not be told apart, so no table is built
+        attributes.Push(attributes.Front());
+        assert(!table.Build(attributes));
+        assert(table.GetNumSlots() == 0);
+        assert(table.Find("Attribute 0") == NINDEX);
+    }
+
+    {
+        SharedPtr<Context> context(new Context());
+        TestSerializable::RegisterObject(context);
+        assert(context->GetAttributeNameTable(TestSerializable::GetTypeStatic()));
+        assert(context->GetAttribute<TestSerializable>("Float Value")->type_ == VAR_FLOAT);
+        assert(!context->GetAttribute<TestSerializable>("Missing"));
+
+        SharedPtr<TestSerializable> object(new TestSerializable(context));
+        assert(object->SetAttribute("Float Value", 2.f));
+        assert(object->floatValue_ == 2.f);
+        assert(!object->SetAttribute("Float Value", 2));
+        assert(object->GetAttributeDefault("Int Value") == Variant(0));
+
+        // Attributes are found in any order, but edit-only attributes are not loaded
+        XMLFile file(context);
+        XMLElement root = file.CreateRoot("component");
+        XMLElement attr = root.CreateChild("attribute");
+        attr.SetAttribute("name", "Edit Only");
+        attr.SetAttribute("value", "3");
+        attr = root.CreateChild("attribute");
+        attr.SetAttribute("name", "Float Value");
+        attr.SetAttribute("value", "4");
+        attr = root.CreateChild("attribute");
+        attr.SetAttribute("name", "Int Value");
+        attr.SetAttribute("value", "5");
+        assert(object->LoadXML(root));
+        assert(object->GetAttribute("Int Value") == Variant(5));
+        assert(object->floatValue_ == 4.f);
+        assert(object->editOnly_ == 0);
+
+        // A repeated name leaves out the table, and the first attribute with the name is found by searching linearly
+        AttributeInfo repeated = *context->GetAttribute<TestSerializable>("Int Value");
+        context->RegisterAttribute<TestSerializable>(repeated);
+        assert(!context->GetAttributeNameTable(TestSerializable::GetTypeStatic()));
+        assert(object->SetAttribute("Int Value", 6));
+        assert(object->intValue_ == 6);
+        assert(object->LoadXML(root));
+        assert(object->intValue_ == 5);
+        assert(object->floatValue_ == 4.f);
+
+        context->RemoveAllAttributes<TestSerializable>();
+        assert(!context->GetAttributeNameTable(TestSerializable::GetTypeStatic()));
+
+        // Registering attributes only marks the table, which is built when first needed and again after more changes
+        for (i32 i = 0; i < 300; ++i)
+            context->RegisterAttribute<TestSerializable>(AttributeInfo(VAR_INT, ("Attribute " + String(i)).CString(), nullptr, nullptr, 0, AM_DEFAULT));
+        const AttributeNameTable* table = context->GetAttributeNameTable(TestSerializable::GetTypeStatic());
+        assert(table && table->Find("Attribute 299") == 299);
+        assert(context->GetAttributeNameTable(TestSerializable::GetTypeStatic()) == table);
+        context->RemoveAttribute<TestSerializable>("Attribute 0");
+        assert(context->GetAttributeNameTable(TestSerializable::GetTypeStatic())->Find("Attribute 299") == 298);
+    }
+
+    {
+        // A table stays in place while tables of other types are built, which threads may do at the same time
+        SharedPtr<Context> context(new Context());
+        constexpr i32 numTypes = 200;
+        for (i32 i = 0; i < numTypes; ++i)
+        {
+            for (i32 j = 0; j < 10; ++j)
+            {
+                context->RegisterAttribute(StringHash("Type " + String(i)), AttributeInfo(VAR_INT,
+                    ("Attribute " + String(j)).CString(), nullptr, nullptr, 0, AM_DEFAULT));
+            }
+        }
+
+        const AttributeNameTable* table = context->GetAttributeNameTable("Type 0");
+        assert(table && table->Find("Attribute 9") == 9);
+
+        std::thread threads[4];
+        for (i32 i = 0; i < 4; ++i)
+        {
+            threads[i] = std::thread([&context, i]()
+            {
+                for (i32 j = i; j < numTypes; j += 2)
+                    assert(context->GetAttributeNameTable(StringHash("Type " + String(j)))->Find("Attribute 5") == 5);
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+
+        assert(context->GetAttributeNameTable("Type 0") == table);
+        assert(table->Find("Attribute 9") == 9);
+    }
+}
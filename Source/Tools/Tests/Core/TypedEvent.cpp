@@ -0,0 +1,142 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/TypedEvent.h>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+URHO3D_EVENT(E_TESTBRIDGED, TestBridged)
+{
+    URHO3D_PARAM(P_VALUE, Value);                  // int
+}
+
+struct TestEvent
+{
+    URHO3D_TYPED_EVENT(TestEvent)
+
+    i32 value_;
+};
+
+struct TestBridgedEvent
+{
+    URHO3D_TYPED_EVENT_BRIDGE(TestBridgedEvent, E_TESTBRIDGED)
+
+    void ToEventData(VariantMap& eventData) const
+    {
+        ++numConversions_;
+        eventData[TestBridged::P_VALUE] = value_;
+    }
+
+    i32 value_;
+    static inline i32 numConversions_ = 0;
+};
+
+// The channel of a typed event is found by the hash of the struct name, which every module computes the same
+static_assert(TestEvent::GetTypedEventType() == "TestEvent"_hash);
+
+class TestReceiver : public Object
+{
+    URHO3D_OBJECT(TestReceiver, Object);
+
+public:
+    TestReceiver(Context* context, const String& name, Vector<String>& log) :
+        Object(context),
+        name_(name),
+        log_(log)
+    {
+    }
+
+    void SubscribeToBridgedVariant() { SubscribeToEvent(E_TESTBRIDGED, URHO3D_HANDLER(TestReceiver, HandleBridgedVariant)); }
+
+    void HandleTest(TestEvent& event) { log_.Push(name_ + String(event.value_)); }
+    void HandleBridged(TestBridgedEvent& event) { log_.Push(name_ + String(event.value_)); }
+
+    void HandleBridgedVariant(StringHash eventType, VariantMap& eventData)
+    {
+        log_.Push(name_ + String(eventData[TestBridged::P_VALUE].GetI32()));
+    }
+
+private:
+    String name_;
+    Vector<String>& log_;
+};
+
+}
+
+void Test_Core_TypedEvent()
+{
+    SharedPtr<Context> context(new Context());
+    Vector<String> log;
+
+    SharedPtr<TestReceiver> sender(new TestReceiver(context, "sender", log));
+    SharedPtr<TestReceiver> otherSender(new TestReceiver(context, "other", log));
+    SharedPtr<TestReceiver> a(new TestReceiver(context, "a", log));
+    SharedPtr<TestReceiver> b(new TestReceiver(context, "b", log));
+    SharedPtr<TestReceiver> c(new TestReceiver(context, "c", log));
+
+    {
+        // Handlers are called in subscription order, and only for the sender they subscribed to
+        b->SubscribeToTypedEvent<&TestReceiver::HandleTest>();
+        a->SubscribeToTypedEvent<&TestReceiver::HandleTest>();
+        c->SubscribeToTypedEvent<&TestReceiver::HandleTest>(otherSender);
+        assert(a->HasSubscribedToTypedEvent<TestEvent>());
+        assert(!c->HasSubscribedToTypedEvent<TestEvent>());
+        assert(c->HasSubscribedToTypedEvent<TestEvent>(otherSender));
+
+        TestEvent event{1};
+        sender->SendTypedEvent(event);
+        assert(log.Size() == 2 && log[0] == "b1" && log[1] == "a1");
+
+        log.Clear();
+        event.value_ = 2;
+        otherSender->SendTypedEvent(event);
+        assert(log.Size() == 3 && log[0] == "b2" && log[1] == "a2" && log[2] == "c2");
+
+        // Unsubscribed and blocked receivers are skipped
+        log.Clear();
+        b->UnsubscribeFromTypedEvent<TestEvent>();
+        a->SetBlockEvents(true);
+        sender->SendTypedEvent(event);
+        assert(log.Empty());
+        a->SetBlockEvents(false);
+
+        // A destroyed sender removes the subscriptions to it
+        Object* otherSenderPtr = otherSender.Get();
+        otherSender.Reset();
+        assert(!c->HasSubscribedToTypedEvent<TestEvent>(otherSenderPtr));
+    }
+
+    {
+        // Without VariantMap subscribers the bridged event is not converted
+        log.Clear();
+        a->SubscribeToTypedEvent<&TestReceiver::HandleBridged>();
+        TestBridgedEvent event{3};
+        sender->SendTypedEvent(event);
+        assert(log.Size() == 1 && log[0] == "a3");
+        assert(TestBridgedEvent::numConversions_ == 0);
+
+        // Typed subscribers receive the event before VariantMap subscribers, also when subscribed later
+        log.Clear();
+        b->SubscribeToBridgedVariant();
+        c->SubscribeToTypedEvent<&TestReceiver::HandleBridged>();
+        event.value_ = 4;
+        sender->SendTypedEvent(event);
+        assert(log.Size() == 3 && log[0] == "a4" && log[1] == "c4" && log[2] == "b4");
+        assert(TestBridgedEvent::numConversions_ == 1);
+
+        // A destroyed receiver is removed from the typed channels
+        log.Clear();
+        a.Reset();
+        event.value_ = 5;
+        sender->SendTypedEvent(event);
+        assert(log.Size() == 2 && log[0] == "c5" && log[1] == "b5");
+    }
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Core/Variant.h>
+#include <Urho3D/Math/Matrix4.h>
+
+#include <utility>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+void Test_Core_Variant()
+{
+    {
+        // The matrices are allocated outside the variant to keep it small, and moving takes over the allocation
+        Matrix4 matrix(1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f, 13.f, 14.f, 15.f, 16.f);
+        Variant source(matrix);
+        const Matrix4* allocated = &source.GetMatrix4();
+        Variant variant(std::move(source));
+        assert(source.IsEmpty());
+        assert(variant.GetType() == VAR_MATRIX4);
+        assert(&variant.GetMatrix4() == allocated);
+        assert(variant.GetMatrix4() == matrix);
+
+        Variant copy(variant);
+        assert(copy == variant);
+        assert(&copy.GetMatrix4() != allocated);
+
+        variant = Matrix3x4(Vector3::ONE, Quaternion::IDENTITY, 2.f);
+        assert(variant.GetType() == VAR_MATRIX3X4);
+        assert(variant.GetMatrix3x4().Scale() == Vector3(2.f, 2.f, 2.f));
+        assert(copy.GetMatrix4() == matrix);
+    }
+
+    {
+        // Moving leaves the source empty
+        VariantVector vector{Variant(1), Variant("two"), Variant(Matrix3::IDENTITY)};
+        Variant variant(vector);
+        Variant moved(std::move(variant));
+        assert(variant.IsEmpty());
+        assert(moved.GetVariantVector() == vector);
+
+        Variant assigned;
+        assigned = std::move(moved);
+        assert(moved.IsEmpty());
+        assert(assigned.GetVariantVector().Size() == 3);
+        assert(assigned.GetVariantVector()[1].GetString() == "two");
+
+        // Custom values stored in the variant are copied instead
+        Variant custom(MakeCustomValue(String("custom")));
+        Variant movedCustom(std::move(custom));
+        assert(*movedCustom.GetCustomPtr<String>() == "custom");
+    }
+}
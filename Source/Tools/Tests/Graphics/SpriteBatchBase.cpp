@@ -0,0 +1,56 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Graphics/SpriteBatchBase.h>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+void Test_Graphics_SpriteBatchBase()
+{
+    {
+        // Full portions fill the ring exactly, and the next one starts over from the beginning
+        constexpr i32 portionSize = SpriteBatchBase::T_RING_SIZE / SpriteBatchBase::PORTIONS_IN_RING;
+        i32 ringOffset = 0;
+        bool discard;
+        for (i32 pass = 0; pass < 3; ++pass)
+        {
+            for (i32 i = 0; i < SpriteBatchBase::PORTIONS_IN_RING; ++i)
+            {
+                i32 offset = SpriteBatchBase::PlaceInRing(ringOffset, portionSize, SpriteBatchBase::T_RING_SIZE, discard);
+                assert(offset == i * portionSize);
+                assert(discard == (pass > 0 && i == 0));
+                assert(ringOffset == offset + portionSize);
+            }
+        }
+        assert(ringOffset == SpriteBatchBase::T_RING_SIZE);
+    }
+
+    {
+        // Portions of any size are written one after another and never past the end. Quads stay aligned, so the first
+        // index of a portion can be found from its vertex offset
+        constexpr i32 verticesPerQuad = 4;
+        constexpr i32 maxQuads = SpriteBatchBase::Q_RING_SIZE / SpriteBatchBase::PORTIONS_IN_RING / verticesPerQuad;
+        i32 ringOffset = 0;
+        i32 previousEnd = 0;
+        i32 numDiscards = 0;
+        for (i32 i = 0; i < 1000; ++i)
+        {
+            const i32 numVertices = (1 + i * 7919 % maxQuads) * verticesPerQuad;
+            bool discard;
+            i32 offset = SpriteBatchBase::PlaceInRing(ringOffset, numVertices, SpriteBatchBase::Q_RING_SIZE, discard);
+
+            assert(discard == (previousEnd + numVertices > SpriteBatchBase::Q_RING_SIZE));
+            assert(offset == (discard ? 0 : previousEnd));
+            assert(offset % verticesPerQuad == 0);
+            assert(offset + numVertices <= SpriteBatchBase::Q_RING_SIZE);
+
+            previousEnd = ringOffset;
+            numDiscards += discard;
+        }
+        assert(numDiscards > 0);
+    }
+}
@@ -0,0 +1,192 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#ifdef URHO3D_IK
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IK/IK.h>
+#include <Urho3D/IK/IKEffector.h>
+#include <Urho3D/IK/IKScheduler.h>
+#include <Urho3D/IK/IKSolver.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SmoothedTransform.h>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+static const Vector3 ARM_TARGET(1.5f, 1.5f, 0.f);
+
+// Create a straight arm of three unit segments with a solver at the base and an effector at the tip, and return the tip
+static Node* CreateArm(Scene* scene, const Vector3& position, bool simdFabrik)
+{
+    Node* node = scene->CreateChild("Arm");
+    node->SetPosition(position);
+    auto* solver = node->CreateComponent<IKSolver>();
+    solver->SetFeature(IKSolver::SIMD_FABRIK, simdFabrik);
+
+    for (i32 i = 0; i < 3; ++i)
+    {
+        node = node->CreateChild("Joint");
+        node->SetPosition(Vector3::UP);
+    }
+
+    auto* effector = node->CreateComponent<IKEffector>();
+    effector->SetTargetPosition(position + ARM_TARGET);
+    return node;
+}
+
+// Straighten an arm again and return whether its tip was at the target
+static bool ResetArm(Node* tip)
+{
+    const bool reached = (tip->GetWorldPosition() - tip->GetParent()->GetParent()->GetParent()->GetWorldPosition() - ARM_TARGET).Length() < 0.01f;
+    Node* node = tip;
+    for (; !node->HasComponent<IKSolver>(); node = node->GetParent())
+        node->SetTransform(Vector3::UP, Quaternion::IDENTITY);
+    node->SetRotation(Quaternion::IDENTITY);
+    return reached;
+}
+
+void Test_IK_IKSolver()
+{
+    SharedPtr<Context> context(new Context());
+    RegisterSceneLibrary(context);
+    RegisterIKLibrary(context);
+
+    {
+        // The built-in FABRIK kernel reaches the same solution as the IK library
+        Vector3 solved[2];
+        for (i32 i = 0; i < 2; ++i)
+        {
+            SharedPtr<Scene> scene(new Scene(context));
+            Node* tip = CreateArm(scene, Vector3::ZERO, i == 1);
+            auto* solver = tip->GetParent()->GetParent()->GetParent()->GetComponent<IKSolver>();
+            solver->SetFeature(IKSolver::AUTO_SOLVE, false);
+            scene->Update(0.f);
+            assert(!scene->GetComponent<IKScheduler>());
+
+            solver->Solve();
+            solved[i] = tip->GetWorldPosition();
+            assert((solved[i] - ARM_TARGET).Length() < 0.01f);
+
+            // The segments keep their lengths
+            for (Node* node = tip; node != solver->GetNode(); node = node->GetParent())
+                assert(Abs(node->GetPosition().Length() - 1.f) < 0.001f);
+        }
+        assert((solved[0] - solved[1]).Length() < 0.01f);
+    }
+
+    {
+        SharedPtr<Scene> scene(new Scene(context));
+        Node* tips[2] = {CreateArm(scene, Vector3::ZERO, true), CreateArm(scene, Vector3(10.f, 0.f, 0.f), true)};
+        // The scheduler is created on the first update
+        assert(!scene->GetComponent<IKScheduler>());
+        scene->Update(0.f);
+        auto* scheduler = scene->GetComponent<IKScheduler>();
+        assert(scheduler);
+        assert(scheduler->GetNumSolvers() == 2);
+
+        scheduler->Solve();
+        assert(scheduler->GetNumSolved() == 2);
+        assert(ResetArm(tips[0]) && ResetArm(tips[1]));
+
+        // Over the budget, the solver that was left out is solved next
+        scheduler->SetMaxSolvesPerFrame(1);
+        scheduler->Solve();
+        assert(scheduler->GetNumSolved() == 1);
+        const i32 first = ResetArm(tips[0]) ? 0 : 1;
+        assert(!ResetArm(tips[1 - first]));
+        scheduler->Solve();
+        assert(ResetArm(tips[1 - first]) && !ResetArm(tips[first]));
+
+        // Solvers too far from the LOD reference are not solved
+        scheduler->SetMaxSolvesPerFrame(0);
+        scheduler->SetMaxSolveDistance(5.f);
+        scheduler->SetLodReference(scene->CreateChild("Camera"));
+        scheduler->Solve();
+        assert(scheduler->GetNumSolved() == 1);
+        assert(ResetArm(tips[0]) && !ResetArm(tips[1]));
+
+        // Solvers leave the scheduler when auto solve is disabled or they are removed
+        tips[1]->GetParent()->GetParent()->GetParent()->GetComponent<IKSolver>()->SetFeature(IKSolver::AUTO_SOLVE, false);
+        assert(scheduler->GetNumSolvers() == 1);
+        tips[0]->GetParent()->GetParent()->GetParent()->RemoveComponent<IKSolver>();
+        assert(scheduler->GetNumSolvers() == 0);
+    }
+
+    {
+        // The scheduler created for the solvers is not saved, and the solvers register to a new one on the next update
+        // if it is removed
+        SharedPtr<Scene> scene(new Scene(context));
+        CreateArm(scene, Vector3::ZERO, true);
+        auto* local = scene->CreateComponent<SmoothedTransform>(LOCAL);
+        scene->Update(0.1f);
+        auto* scheduler = scene->GetComponent<IKScheduler>();
+        assert(scheduler->IsTemporary());
+
+        // Loading does not create the scheduler, so that it does not take the ID of a local component in the file
+        VectorBuffer buffer;
+        assert(scene->Save(buffer));
+        buffer.Seek(0);
+        SharedPtr<Scene> loaded(new Scene(context));
+        assert(loaded->Load(buffer));
+        assert(!loaded->GetComponent<IKScheduler>());
+        assert(loaded->GetComponent<SmoothedTransform>()->GetID() == local->GetID());
+        loaded->Update(0.1f);
+        assert(loaded->GetComponent<IKScheduler>()->GetNumSolvers() == 1);
+        assert(loaded->GetComponent<SmoothedTransform>()->GetID() == local->GetID());
+
+        scene->RemoveComponent(scheduler);
+        assert(!scene->GetComponent<IKScheduler>());
+        scene->Update(0.1f);
+        scheduler = scene->GetComponent<IKScheduler>();
+        assert(scheduler && scheduler->GetNumSolvers() == 1);
+    }
+
+    {
+        // Solvers solved in parallel on worker threads reach the same poses as solved one by one
+        SharedPtr<Context> threadedContext(new Context());
+        RegisterSceneLibrary(threadedContext);
+        RegisterIKLibrary(threadedContext);
+        threadedContext->RegisterSubsystem(new WorkQueue(threadedContext));
+        threadedContext->GetSubsystem<WorkQueue>()->CreateThreads(3);
+
+        SharedPtr<Scene> scene(new Scene(threadedContext));
+        Vector<Node*> tips;
+        for (i32 i = 0; i < 16; ++i)
+            tips.Push(CreateArm(scene, Vector3(10.f * i, 0.f, 0.f), i % 2 == 0));
+        scene->Update(0.f);
+        auto* scheduler = scene->GetComponent<IKScheduler>();
+        assert(scheduler->GetNumSolvers() == tips.Size());
+
+        Vector<Vector3> serialPositions;
+        scheduler->SetParallelSolve(false);
+        scheduler->Solve();
+        for (Node* tip : tips)
+        {
+            serialPositions.Push(tip->GetWorldPosition());
+            assert(ResetArm(tip));
+        }
+
+        scheduler->SetParallelSolve(true);
+        scheduler->Solve();
+        assert(scheduler->GetNumSolved() == tips.Size());
+        for (i32 i = 0; i < tips.Size(); ++i)
+        {
+            assert((tips[i]->GetWorldPosition() - serialPositions[i]).Length() < 0.0001f);
+            assert(ResetArm(tips[i]));
+        }
+    }
+}
+
+#else
+
+void Test_IK_IKSolver()
+{
+}
+
+#endif
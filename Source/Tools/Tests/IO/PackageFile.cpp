@@ -0,0 +1,158 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/Compression.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/PackageFile.h>
+#include <Urho3D/IO/VectorBuffer.h>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+// Uncompressed size of the blocks, as written by PackageTool
+constexpr i32 BLOCK_SIZE = 32768;
+// Size of the last, short block
+constexpr i32 TAIL_SIZE = 1000;
+// Number of full blocks, enough to decompress them in parallel
+constexpr i32 NUM_FULL_BLOCKS = 8;
+constexpr i32 DATA_SIZE = NUM_FULL_BLOCKS * BLOCK_SIZE + TAIL_SIZE;
+
+u8 GetDataByte(i32 index)
+{
+    return (u8)(index * 7 + index / 1000);
+}
+
+// Compress the data in blocks. If corruptBlock is not negative, the header of that block claims one byte less than
+// the block decompresses to
+void WriteBlocks(Serializer& dest, i32 corruptBlock)
+{
+    Vector<u8> block(BLOCK_SIZE);
+    Vector<u8> packed((i32)EstimateCompressBound(BLOCK_SIZE));
+
+    for (i32 i = 0, offset = 0; offset < DATA_SIZE; ++i)
+    {
+        i32 unpackedSize = Min(BLOCK_SIZE, DATA_SIZE - offset);
+        for (i32 j = 0; j < unpackedSize; ++j)
+            block[j] = GetDataByte(offset + j);
+        i32 packedSize = (i32)CompressData(packed.Buffer(), block.Buffer(), unpackedSize);
+
+        dest.WriteU16((u16)(i == corruptBlock ? unpackedSize - 1 : unpackedSize));
+        dest.WriteU16((u16)packedSize);
+        dest.Write(packed.Buffer(), packedSize);
+        offset += unpackedSize;
+    }
+}
+
+// Write a version 2 package with an intact and a corrupt LZ4 compressed entry
+void WritePackage(Context* context, const String& fileName)
+{
+    const char* names[] = {"Data.bin", "Corrupt.bin"};
+    VectorBuffer blocks[2];
+    WriteBlocks(blocks[0], -1);
+    WriteBlocks(blocks[1], 3);
+
+    VectorBuffer package;
+    package.WriteFileID("UPK2");
+    package.WriteU32(2);
+    package.WriteU32(0);
+
+    i32 offsetPositions[2];
+    for (i32 i = 0; i < 2; ++i)
+    {
+        package.WriteStringHash(StringHash(names[i]));
+        package.WriteString(names[i]);
+        offsetPositions[i] = (i32)package.GetPosition();
+        package.WriteU32(0);
+        package.WriteU32(i ? DATA_SIZE - 1 : DATA_SIZE);
+        package.WriteU32((u32)blocks[i].GetSize());
+        package.WriteU32(0);
+        package.WriteU8(PACKAGE_CODEC_LZ4);
+    }
+
+    for (i32 i = 0; i < 2; ++i)
+    {
+        i32 offset = (i32)package.GetSize();
+        package.Seek(offsetPositions[i]);
+        package.WriteU32(offset);
+        package.Seek(offset);
+        package.Write(blocks[i].GetData(), blocks[i].GetSize());
+    }
+
+    File file(context, fileName, FILE_WRITE);
+    assert(file.Write(package.GetData(), (i32)package.GetSize()) == (i32)package.GetSize());
+}
+
+bool CheckData(const Vector<u8>& data, i32 offset, i32 size)
+{
+    for (i32 i = 0; i < size; ++i)
+    {
+        if (data[i] != GetDataByte(offset + i))
+            return false;
+    }
+    return true;
+}
+
+}
+
+void Test_IO_PackageFile()
+{
+    SharedPtr<Context> context(new Context());
+    context->RegisterSubsystem(new FileSystem(context));
+    context->RegisterSubsystem(new WorkQueue(context));
+    context->GetSubsystem<WorkQueue>()->CreateThreads(3);
+
+    const String fileName = context->GetSubsystem<FileSystem>()->GetTemporaryDir() + "Urho3DTestPackage.pak";
+    WritePackage(context, fileName);
+
+    for (i32 memoryMapped = 0; memoryMapped < 2; ++memoryMapped)
+    {
+        SharedPtr<PackageFile> package(new PackageFile(context, fileName, 0, memoryMapped != 0));
+        assert(package->GetNumFiles() == 2);
+        assert(package->IsMemoryMapped() == (memoryMapped != 0));
+
+        {
+            SharedPtr<File> file(new File(context, package, "Data.bin"));
+            assert(file->IsOpen() && file->IsPackaged());
+            Vector<u8> data(DATA_SIZE);
+
+            // The full blocks are decompressed in parallel and the short last block to the read buffer
+            const i32 firstSize = NUM_FULL_BLOCKS * BLOCK_SIZE + TAIL_SIZE / 2;
+            assert(file->Read(data.Buffer(), firstSize) == firstSize);
+            assert(CheckData(data, 0, firstSize));
+            assert(file->Read(data.Buffer(), DATA_SIZE) == DATA_SIZE - firstSize);
+            assert(CheckData(data, firstSize, DATA_SIZE - firstSize));
+            assert(file->IsEof());
+
+            // After starting over, a full block is decompressed to the read buffer the short block was read to
+            assert(file->Seek(0) == 0);
+            assert(file->Read(data.Buffer(), 100) == 100);
+            assert(CheckData(data, 0, 100));
+            assert(file->Read(data.Buffer(), DATA_SIZE) == DATA_SIZE - 100);
+            assert(CheckData(data, 100, DATA_SIZE - 100));
+        }
+
+        {
+            // A block that does not decompress to its size fails the read, both in parallel and one block at a time
+            SharedPtr<File> file(new File(context, package, "Corrupt.bin"));
+            Vector<u8> data(DATA_SIZE);
+            assert(file->Read(data.Buffer(), DATA_SIZE - 1) == 0);
+
+            file->Seek(0);
+            i32 totalSize = 0;
+            for (i32 readSize; (readSize = file->Read(data.Buffer(), 1024)) != 0;)
+                totalSize += readSize;
+            assert(totalSize == 3 * BLOCK_SIZE);
+        }
+    }
+
+    context->GetSubsystem<FileSystem>()->Delete(fileName);
+}
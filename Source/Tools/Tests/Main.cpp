@@ -5,14 +5,50 @@
 #include <iostream>
 #include <clocale>
 
+void Test_Audio_SoundSource();
+void Test_Container_FlatHashMap();
+void Test_Container_FrameArena();
+void Test_Container_Ptr();
+void Test_Container_RadixSort();
+void Test_Container_SPSCQueue();
 void Test_Container_Str();
+void Test_Core_AttributeNameTable();
+void Test_Core_TypedEvent();
+void Test_Core_Variant();
+void Test_Graphics_SpriteBatchBase();
+void Test_IK_IKSolver();
+void Test_IO_PackageFile();
 void Test_Math_BigInt();
+void Test_Scene_CompiledPrefab();
+void Test_Scene_LogicUpdateRegistry();
+void Test_Scene_SceneStreamer();
+void Test_Scene_Serializable();
+void Test_Urho2D_Renderer2D();
+void Test_Urho2D_TileMapLayer2D();
 void test_third_party_sdl();
 
 void Run()
 {
+    Test_Audio_SoundSource();
+    Test_Container_FlatHashMap();
+    Test_Container_FrameArena();
+    Test_Container_Ptr();
+    Test_Container_RadixSort();
+    Test_Container_SPSCQueue();
     Test_Container_Str();
+    Test_Core_AttributeNameTable();
+    Test_Core_TypedEvent();
+    Test_Core_Variant();
+    Test_Graphics_SpriteBatchBase();
+    Test_IK_IKSolver();
+    Test_IO_PackageFile();
     Test_Math_BigInt();
+    Test_Scene_CompiledPrefab();
+    Test_Scene_LogicUpdateRegistry();
+    Test_Scene_SceneStreamer();
+    Test_Scene_Serializable();
+    Test_Urho2D_Renderer2D();
+    Test_Urho2D_TileMapLayer2D();
     test_third_party_sdl();
 }
 
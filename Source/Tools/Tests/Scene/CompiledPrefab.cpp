@@ -0,0 +1,160 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Graphics/AnimatedModel.h>
+#include <Urho3D/Graphics/Graphics.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/XMLFile.h>
+#include <Urho3D/Scene/CompiledPrefab.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SmoothedTransform.h>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+// Component whose constructed value differs from the attribute default, so default values must be applied when loading
+class TestPrefabComponent : public Component
+{
+    URHO3D_OBJECT(TestPrefabComponent, Component);
+
+public:
+    explicit TestPrefabComponent(Context* context) :
+        Component(context)
+    {
+    }
+
+    static void RegisterObject(Context* context)
+    {
+        context->RegisterFactory<TestPrefabComponent>();
+        URHO3D_ATTRIBUTE("Value", value_, 0, AM_DEFAULT);
+    }
+
+    bool SaveDefaultAttributes() const override { return true; }
+
+    i32 value_{5};
+};
+
+// Compare the file attributes other than IDs, which are rewritten when instantiating
+void CompareAttributes(Serializable* lhs, Serializable* rhs)
+{
+    const Vector<AttributeInfo>* attributes = lhs->GetAttributes();
+    assert(attributes == rhs->GetAttributes());
+    if (!attributes)
+        return;
+
+    for (i32 i = 0; i < attributes->Size(); ++i)
+    {
+        const AttributeModeFlags mode = attributes->At(i).mode_;
+        if ((mode & AM_FILE) && !(mode & (AM_NODEID | AM_COMPONENTID | AM_NODEIDVECTOR)))
+            assert(lhs->GetAttribute(i) == rhs->GetAttribute(i));
+    }
+}
+
+void CompareNodes(Node* lhs, Node* rhs)
+{
+    CompareAttributes(lhs, rhs);
+    assert(lhs->IsReplicated() == rhs->IsReplicated());
+
+    const Vector<SharedPtr<Component>>& lhsComponents = lhs->GetComponents();
+    const Vector<SharedPtr<Component>>& rhsComponents = rhs->GetComponents();
+    assert(lhsComponents.Size() == rhsComponents.Size());
+    for (i32 i = 0; i < lhsComponents.Size(); ++i)
+    {
+        assert(lhsComponents[i]->GetType() == rhsComponents[i]->GetType());
+        assert(lhsComponents[i]->IsReplicated() == rhsComponents[i]->IsReplicated());
+        CompareAttributes(lhsComponents[i], rhsComponents[i]);
+    }
+
+    const Vector<SharedPtr<Node>>& lhsChildren = lhs->GetChildren();
+    const Vector<SharedPtr<Node>>& rhsChildren = rhs->GetChildren();
+    assert(lhsChildren.Size() == rhsChildren.Size());
+    for (i32 i = 0; i < lhsChildren.Size(); ++i)
+        CompareNodes(lhsChildren[i], rhsChildren[i]);
+}
+
+}
+
+void Test_Scene_CompiledPrefab()
+{
+    SharedPtr<Context> context(new Context());
+    context->RegisterSubsystem(new ResourceCache(context));
+    RegisterSceneLibrary(context);
+    RegisterGraphicsLibrary(context);
+    TestPrefabComponent::RegisterObject(context);
+
+    SharedPtr<Scene> scene(new Scene(context));
+
+    // A local root with replicated and local children
+    Node* source = scene->CreateChild("Prefab", LOCAL);
+    source->AddTag("Spawned");
+    source->SetVar("Health", 100);
+    auto* component = source->CreateComponent<TestPrefabComponent>(LOCAL);
+    component->value_ = 0;
+    Node* child = source->CreateChild("Replicated", REPLICATED);
+    child->SetPosition(Vector3(1.f, 2.f, 3.f));
+    child->SetEnabled(false);
+    child->CreateComponent<SmoothedTransform>(REPLICATED);
+    child->CreateChild("Local", LOCAL)->CreateComponent<TestPrefabComponent>(LOCAL)->value_ = 7;
+
+    SharedPtr<XMLFile> xml(new XMLFile(context));
+    XMLElement root = xml->CreateRoot("node");
+    assert(source->SaveXML(root));
+
+    SharedPtr<CompiledPrefab> prefab(new CompiledPrefab(context));
+    assert(prefab->Compile(source));
+    assert(prefab->GetNumNodes() == 3);
+    assert(prefab->GetNumComponents() == 3);
+
+    // Registering attributes later does not invalidate the compiled prefab
+    context->RegisterAttribute<TestPrefabComponent>(AttributeInfo(VAR_INT, "Extra", nullptr, nullptr, 0, AM_DEFAULT));
+    context->RemoveAttribute<TestPrefabComponent>("Extra");
+
+    for (CreateMode mode : {REPLICATED, LOCAL})
+    {
+        const Vector3 position(10.f, 0.f, 0.f);
+        Node* fromXML = scene->InstantiateXML(root, position, Quaternion::IDENTITY, mode);
+        Node* fromPrefab = prefab->Instantiate(scene, position, Quaternion::IDENTITY, mode);
+        assert(fromXML && fromPrefab);
+        assert(fromPrefab->IsReplicated() == (mode == REPLICATED));
+        CompareNodes(fromXML, fromPrefab);
+
+        // The default value is applied over the constructed one
+        assert(fromPrefab->GetComponent<TestPrefabComponent>()->value_ == 0);
+    }
+
+    {
+        // An animated model is loaded like from a file, so that it uses the bone nodes of the prefab instead of creating
+        // its own
+        Skeleton skeleton;
+        Bone bone;
+        bone.name_ = "Bone";
+        bone.nameHash_ = bone.name_;
+        skeleton.GetModifiableBones().Push(bone);
+        skeleton.SetRootBoneIndex(0);
+
+        SharedPtr<Model> model(new Model(context));
+        model->SetName("Models/Skeleton.mdl");
+        model->SetSkeleton(skeleton);
+        context->GetSubsystem<ResourceCache>()->AddManualResource(model);
+
+        Node* character = scene->CreateChild("Character", LOCAL);
+        character->CreateComponent<AnimatedModel>(LOCAL)->SetModel(model);
+        assert(character->GetNumChildren() == 1);
+
+        SharedPtr<CompiledPrefab> characterPrefab(new CompiledPrefab(context));
+        assert(characterPrefab->Compile(character));
+        Node* instance = characterPrefab->Instantiate(scene, Vector3::ZERO, Quaternion::IDENTITY, LOCAL);
+        assert(instance->GetNumChildren() == 1);
+        Node* boneNode = instance->GetChild("Bone");
+        assert(boneNode);
+        assert(instance->GetComponent<AnimatedModel>()->GetSkeleton().GetBone("Bone")->node_ == boneNode);
+    }
+}
@@ -0,0 +1,155 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/LogicComponent.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+Vector<String> updateLog;
+
+class TestLogic : public LogicComponent
+{
+    URHO3D_OBJECT(TestLogic, LogicComponent);
+
+public:
+    explicit TestLogic(Context* context) :
+        LogicComponent(context)
+    {
+        SetUpdateEventMask(LogicComponentEvents::Update | LogicComponentEvents::PostUpdate);
+    }
+
+    void DelayedStart() override { updateLog.Push(name_ + " start"); }
+
+    void Update(float timeStep) override
+    {
+        updateLog.Push(name_ + " update");
+
+        if (createOnUpdate_)
+        {
+            createOnUpdate_ = false;
+            GetNode()->CreateComponent<TestLogic>()->name_ = name_ + "+";
+        }
+        // Last, as the component may remove itself
+        if (removeOnUpdate_)
+            removeOnUpdate_->Remove();
+    }
+
+    void PostUpdate(float timeStep) override { updateLog.Push(name_ + " post"); }
+
+    String name_;
+    WeakPtr<Component> removeOnUpdate_;
+    bool createOnUpdate_{};
+};
+
+class OtherTestLogic : public TestLogic
+{
+    URHO3D_OBJECT(OtherTestLogic, TestLogic);
+
+public:
+    using TestLogic::TestLogic;
+};
+
+template <class T> T* CreateTestLogic(Node* node, const String& name)
+{
+    auto* component = node->CreateComponent<T>();
+    component->name_ = name;
+    return component;
+}
+
+bool UpdateLogEquals(std::initializer_list<const char*> expected)
+{
+    if (updateLog.Size() != (i32)expected.size())
+        return false;
+
+    i32 i = 0;
+    for (const char* entry : expected)
+    {
+        if (updateLog[i++] != entry)
+            return false;
+    }
+
+    return true;
+}
+
+}
+
+void Test_Scene_LogicUpdateRegistry()
+{
+    SharedPtr<Context> context(new Context());
+    RegisterSceneLibrary(context);
+    context->RegisterFactory<TestLogic>();
+    context->RegisterFactory<OtherTestLogic>();
+
+    SharedPtr<Scene> scene(new Scene(context));
+    Node* node = scene->CreateChild();
+
+    {
+        // DelayedStart() runs once before the first update. Types update in the order they were first added, and all
+        // updates run before the post-updates
+        TestLogic* a = CreateTestLogic<TestLogic>(node, "a");
+        CreateTestLogic<OtherTestLogic>(node, "b");
+        CreateTestLogic<TestLogic>(node, "c");
+
+        scene->Update(0.1f);
+        assert(UpdateLogEquals({"a start", "a update", "c start", "c update", "b start", "b update", "a post", "c post", "b post"}));
+
+        updateLog.Clear();
+        scene->Update(0.1f);
+        assert(UpdateLogEquals({"a update", "c update", "b update", "a post", "c post", "b post"}));
+
+        // Components that block events are skipped, and get their DelayedStart() only once they are updated
+        updateLog.Clear();
+        a->SetBlockEvents(true);
+        TestLogic* d = CreateTestLogic<TestLogic>(node, "d");
+        d->SetBlockEvents(true);
+        scene->Update(0.1f);
+        assert(UpdateLogEquals({"c update", "b update", "c post", "b post"}));
+        assert(!d->IsDelayedStartCalled());
+
+        updateLog.Clear();
+        a->SetBlockEvents(false);
+        d->SetBlockEvents(false);
+        scene->Update(0.1f);
+        assert(UpdateLogEquals({"a update", "c update", "d start", "d update", "b update", "a post", "c post", "d post", "b post"}));
+
+        node->RemoveAllComponents();
+        updateLog.Clear();
+    }
+
+    {
+        // A component removed during the update is not updated afterwards, and a component created during the update is
+        // updated the next time
+        TestLogic* a = CreateTestLogic<TestLogic>(node, "a");
+        TestLogic* b = CreateTestLogic<TestLogic>(node, "b");
+        TestLogic* c = CreateTestLogic<TestLogic>(node, "c");
+        scene->Update(0.1f);
+
+        updateLog.Clear();
+        a->removeOnUpdate_ = c;
+        b->createOnUpdate_ = true;
+        scene->Update(0.1f);
+        assert(UpdateLogEquals({"a update", "b update", "a post", "b post", "b+ post"}));
+        assert(node->GetNumComponents() == 3);
+
+        // The removed component left a hole, which is compacted after the update without changing the order
+        updateLog.Clear();
+        scene->Update(0.1f);
+        assert(UpdateLogEquals({"a update", "b update", "b+ start", "b+ update", "a post", "b post", "b+ post"}));
+
+        // A component may remove itself
+        updateLog.Clear();
+        b->removeOnUpdate_ = b;
+        scene->Update(0.1f);
+        assert(UpdateLogEquals({"a update", "b update", "b+ update", "a post", "b+ post"}));
+        assert(node->GetNumComponents() == 2);
+    }
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneCell.h>
+#include <Urho3D/Scene/SceneStreamer.h>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+// Write a cell file whose root node is named after the cell
+void WriteCell(Context* context, const String& resourceDir, i32 x)
+{
+    SharedPtr<Scene> scene(new Scene(context));
+    Node* node = scene->CreateChild("Cell " + String(x), LOCAL);
+    node->CreateChild("Content", LOCAL);
+
+    SharedPtr<SceneCell> cell(new SceneCell(context));
+    assert(cell->SetNode(node));
+    File file(context, resourceDir + "Cells/" + String(x) + "_0.bin", FILE_WRITE);
+    assert(cell->Save(file));
+}
+
+// Move the focus node and update streaming until all requested cells are instantiated
+void Stream(SceneStreamer* streamer, float x)
+{
+    streamer->GetFocusNode()->SetWorldPosition(Vector3(x, 0.f, 5.f));
+    streamer->Update();
+    for (i32 i = 0; i < 5000 && streamer->GetNumPendingCells(); ++i)
+    {
+        Time::Sleep(1);
+        // The resource cache finishes background loaded resources at the beginning of a frame
+        streamer->SendEvent(E_BEGINFRAME);
+        streamer->Update();
+    }
+    assert(!streamer->GetNumPendingCells());
+}
+
+}
+
+void Test_Scene_SceneStreamer()
+{
+    SharedPtr<Context> context(new Context());
+    context->RegisterSubsystem(new FileSystem(context));
+    context->RegisterSubsystem(new ResourceCache(context));
+    RegisterSceneLibrary(context);
+
+    auto* fileSystem = context->GetSubsystem<FileSystem>();
+    auto* cache = context->GetSubsystem<ResourceCache>();
+    const String resourceDir = fileSystem->GetTemporaryDir() + "Urho3DTestCells/";
+    assert(fileSystem->CreateDir(resourceDir + "Cells/"));
+
+    // A row of cells along the X axis, with cell 4 missing
+    const i32 existingCells[] = {0, 1, 2, 3, 5};
+    for (i32 x : existingCells)
+        WriteCell(context, resourceDir, x);
+    fileSystem->Delete(resourceDir + "Cells/4_0.bin");
+    assert(cache->AddResourceDir(resourceDir));
+
+    SharedPtr<Scene> scene(new Scene(context));
+    auto* streamer = scene->CreateComponent<SceneStreamer>();
+    streamer->SetFocusNode(scene->CreateChild("Focus", LOCAL));
+    streamer->SetCellSize(10.f);
+    streamer->SetLoadRadius(5.f);
+    streamer->SetUnloadRadius(15.f);
+
+    {
+        // Cells are loaded within the load radius only
+        Stream(streamer, 4.f);
+        assert(streamer->GetNumInstantiatedCells() == 1);
+        WeakPtr<Node> cell0(streamer->GetCellNode(IntVector2(0, 0)));
+        assert(cell0 && cell0->GetName() == "Cell 0");
+        assert(cell0->IsTemporary());
+        assert(cell0->GetNumChildren() == 1);
+        // The cell data is released once instantiated
+        assert(!cache->GetExistingResource<SceneCell>("Cells/0_0.bin"));
+
+        // Cells stay until they are beyond the unload radius
+        Stream(streamer, 14.f);
+        assert(streamer->GetNumInstantiatedCells() == 2);
+        Stream(streamer, 24.f);
+        assert(streamer->GetNumInstantiatedCells() == 3);
+        assert(streamer->GetCellNode(IntVector2(0, 0)) == cell0.Get());
+
+        Stream(streamer, 26.f);
+        assert(streamer->GetNumInstantiatedCells() == 3);
+        assert(!streamer->GetCellNode(IntVector2(0, 0)));
+        assert(!cell0);
+        assert(streamer->GetCellNode(IntVector2(3, 0)));
+
+        // Going back within the unload radius, but not the load radius, does not load an unloaded cell again
+        Stream(streamer, 24.f);
+        assert(!streamer->GetCellNode(IntVector2(0, 0)));
+        assert(streamer->GetNumInstantiatedCells() == 3);
+    }
+
+    {
+        // A cell without a file is not tracked, and the file is not looked up again
+        Stream(streamer, 44.f);
+        assert(!streamer->GetCellNode(IntVector2(4, 0)));
+        assert(streamer->GetCellNode(IntVector2(3, 0)));
+        WriteCell(context, resourceDir, 4);
+        Stream(streamer, 45.f);
+        assert(!streamer->GetCellNode(IntVector2(4, 0)));
+        assert(streamer->GetCellNode(IntVector2(5, 0)));
+
+        // Until the cell layout changes
+        streamer->SetCellSize(20.f);
+        assert(!streamer->GetNumInstantiatedCells());
+        streamer->SetCellSize(10.f);
+        Stream(streamer, 45.f);
+        assert(streamer->GetCellNode(IntVector2(4, 0))->GetName() == "Cell 4");
+    }
+
+    {
+        // Removing the streamer from the scene releases the cells which are loaded but not instantiated yet
+        streamer->UnloadAllCells();
+        streamer->GetFocusNode()->SetWorldPosition(Vector3(4.f, 0.f, 5.f));
+        streamer->Update();
+        assert(streamer->GetNumPendingCells() == 1);
+        for (i32 i = 0; i < 5000 && cache->GetNumBackgroundLoadResources(); ++i)
+        {
+            Time::Sleep(1);
+            streamer->SendEvent(E_BEGINFRAME);
+        }
+        assert(cache->GetExistingResource<SceneCell>("Cells/0_0.bin"));
+
+        SharedPtr<SceneStreamer> removed(streamer);
+        scene->RemoveComponent(streamer);
+        assert(!removed->GetNumPendingCells());
+        assert(!cache->GetExistingResource<SceneCell>("Cells/0_0.bin"));
+    }
+
+    for (i32 x = 0; x <= 5; ++x)
+        fileSystem->Delete(resourceDir + "Cells/" + String(x) + "_0.bin");
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Scene/Serializable.h>
+
+#include <utility>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+enum TestMode
+{
+    TM_FIRST = 0,
+    TM_SECOND,
+    TM_THIRD
+};
+
+const char* testModeNames[] =
+{
+    "First",
+    "Second",
+    "Third",
+    nullptr
+};
+
+class TestSerializable : public Serializable
+{
+    URHO3D_OBJECT(TestSerializable, Serializable);
+
+public:
+    explicit TestSerializable(Context* context) :
+        Serializable(context)
+    {
+    }
+
+    static void RegisterObject(Context* context);
+
+    String text_;
+    Vector3 position_;
+    TestMode mode_{TM_FIRST};
+    i32 numVariantSets_{};
+    i32 numTypedSets_{};
+};
+
+// Accessor that counts whether the value was set through a Variant or as its own type
+class CountingAccessor : public TypedAttributeAccessor<String>
+{
+public:
+    void Get(const Serializable* ptr, Variant& dest) const override { dest = static_cast<const TestSerializable*>(ptr)->text_; }
+
+    void Set(Serializable* ptr, const Variant& src) override
+    {
+        auto* object = static_cast<TestSerializable*>(ptr);
+        object->text_ = src.GetString();
+        ++object->numVariantSets_;
+    }
+
+    void GetValue(const Serializable* ptr, String& dest) const override { dest = static_cast<const TestSerializable*>(ptr)->text_; }
+
+    void SetValue(Serializable* ptr, String&& src) override
+    {
+        auto* object = static_cast<TestSerializable*>(ptr);
+        object->text_ = std::move(src);
+        ++object->numTypedSets_;
+    }
+};
+
+void TestSerializable::RegisterObject(Context* context)
+{
+    context->RegisterAttribute<TestSerializable>(AttributeInfo(VAR_STRING, "Text", SharedPtr<AttributeAccessor>(new CountingAccessor()),
+        nullptr, String::EMPTY, AM_DEFAULT));
+    URHO3D_ATTRIBUTE("Position", position_, Vector3::ZERO, AM_DEFAULT);
+    URHO3D_ENUM_ATTRIBUTE("Mode", mode_, testModeNames, TM_FIRST, AM_DEFAULT);
+}
+
+}
+
+void Test_Scene_Serializable()
+{
+    SharedPtr<Context> context(new Context());
+    TestSerializable::RegisterObject(context);
+
+    SharedPtr<TestSerializable> source(new TestSerializable(context));
+    source->text_ = "A text long enough to not fit the small string storage";
+    source->position_ = Vector3(1.f, 2.f, 3.f);
+    source->mode_ = TM_THIRD;
+
+    {
+        // Binary load sets the common types through the typed accessors, and the others through a Variant
+        VectorBuffer buffer;
+        assert(source->Save(buffer));
+        buffer.Seek(0);
+
+        SharedPtr<TestSerializable> object(new TestSerializable(context));
+        assert(object->Load(buffer));
+        assert(object->text_ == source->text_);
+        assert(object->numTypedSets_ == 1);
+        assert(object->numVariantSets_ == 0);
+        assert(object->position_ == source->position_);
+        assert(object->mode_ == TM_THIRD);
+        assert(buffer.IsEof());
+    }
+
+    {
+        // Values are read as their own type, or converted from a Variant if the attribute has no accessor of the type
+        String text;
+        assert(source->GetAttributeValue(0, text));
+        assert(text == source->text_);
+        Vector3 position;
+        assert(source->GetAttributeValue(1, position));
+        assert(position == source->position_);
+        i32 mode = 0;
+        assert(source->GetAttributeValue(2, mode));
+        assert(mode == TM_THIRD);
+        assert(!source->GetAttributeValue(3, mode));
+
+        SharedPtr<TestSerializable> object(new TestSerializable(context));
+        assert(object->SetAttributeValue(0, String("Moved")));
+        assert(object->text_ == "Moved");
+        assert(object->numTypedSets_ == 1);
+        assert(object->SetAttributeValue(2, (i32)TM_SECOND));
+        assert(object->mode_ == TM_SECOND);
+    }
+
+    {
+        // The accessor type is recorded at registration. Types which a Variant only converts to, like unsigned, are not
+        // accessed as their own type, and no other typed accessor can be mistaken for the one of the attribute
+        assert(context->GetAttribute<TestSerializable>("Text")->typedAccessorType_ == VAR_STRING);
+        assert(context->GetAttribute<TestSerializable>("Position")->GetTypedAccessor<Vector3>());
+        assert(!context->GetAttribute<TestSerializable>("Position")->GetTypedAccessor<Vector4>());
+        assert(context->GetAttribute<TestSerializable>("Mode")->typedAccessorType_ == VAR_NONE);
+
+        AttributeInfo info(VAR_INT, "Unsigned", MakeTypedAttributeAccessor<TestSerializable, unsigned>(
+            [](const TestSerializable& self) { return (unsigned)self.numTypedSets_; },
+            [](TestSerializable& self, unsigned value) { self.numTypedSets_ = (i32)value; }), nullptr, 0, AM_DEFAULT);
+        assert(info.typedAccessorType_ == VAR_NONE);
+        assert(!info.GetTypedAccessor<unsigned>());
+        assert(!info.GetTypedAccessor<i32>());
+    }
+}
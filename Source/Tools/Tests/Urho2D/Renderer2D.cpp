@@ -0,0 +1,83 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#ifdef URHO3D_URHO2D
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Urho2D/Drawable2D.h>
+#include <Urho3D/Urho2D/Renderer2D.h>
+
+#include <algorithm>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+void Test_Urho2D_Renderer2D()
+{
+    SharedPtr<Context> context(new Context());
+    context->RegisterSubsystem(new ResourceCache(context));
+
+    SharedPtr<Material> materials[3];
+    for (i32 i = 0; i < 3; ++i)
+    {
+        materials[i] = new Material(context);
+        materials[i]->SetName("Materials/Sprite" + String(i) + ".xml");
+    }
+
+    // Layers and orders in layer combine into the draw order the way Drawable2D does. Few distinct values make ties common
+    const i32 layers[] = {-2, 0, 3};
+    const i32 ordersInLayer[] = {0, 1, 70};
+    const float distances[] = {-1.5f, 0.0f, 0.25f, 4.0f, 1000.0f};
+
+    Vector<SourceBatch2D> batches(600);
+    for (i32 i = 0; i < batches.Size(); ++i)
+    {
+        batches[i].drawOrder_ = layers[i % 3] << 16 | ordersInLayer[i / 3 % 3];
+        batches[i].distance_ = distances[i / 9 % 5];
+        batches[i].material_ = materials[i / 45 % 3];
+    }
+
+    Vector<const SourceBatch2D*> sorted;
+    for (const SourceBatch2D& batch : batches)
+        sorted.Push(&batch);
+    Renderer2D::SortSourceBatches(sorted);
+
+    // Lower layers first, then lower orders in layer, then back to front, then grouped by material. Ties keep their order
+    std::vector<const SourceBatch2D*> expected;
+    for (const SourceBatch2D& batch : batches)
+        expected.push_back(&batch);
+    std::stable_sort(expected.begin(), expected.end(), [](const SourceBatch2D* lhs, const SourceBatch2D* rhs)
+    {
+        if (lhs->drawOrder_ != rhs->drawOrder_)
+            return lhs->drawOrder_ < rhs->drawOrder_;
+        if (lhs->distance_ != rhs->distance_)
+            return lhs->distance_ > rhs->distance_;
+        return lhs->material_->GetNameHash() < rhs->material_->GetNameHash();
+    });
+
+    assert(sorted.Size() == (i32)expected.size());
+    for (i32 i = 0; i < sorted.Size(); ++i)
+        assert(sorted[i] == expected[i]);
+
+    // A negative layer comes before layer 0, and an order in layer never outweighs a layer
+    assert(sorted.Front()->drawOrder_ == -2 << 16);
+    assert(sorted.Back()->drawOrder_ == (3 << 16 | 70));
+
+    // Sorting again keeps the result
+    Renderer2D::SortSourceBatches(sorted);
+    for (i32 i = 0; i < sorted.Size(); ++i)
+        assert(sorted[i] == expected[i]);
+}
+
+#else
+
+void Test_Urho2D_Renderer2D()
+{
+}
+
+#endif
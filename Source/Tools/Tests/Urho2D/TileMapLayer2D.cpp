@@ -0,0 +1,137 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../ForceAssert.h"
+
+#ifdef URHO3D_URHO2D
+
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/GraphicsAPI/Texture2D.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Urho2D/Sprite2D.h>
+#include <Urho3D/Urho2D/TileMap2D.h>
+#include <Urho3D/Urho2D/TileMapChunk2D.h>
+#include <Urho3D/Urho2D/TileMapLayer2D.h>
+#include <Urho3D/Urho2D/TmxFile2D.h>
+#include <Urho3D/Urho2D/Urho2D.h>
+
+#include <Urho3D/DebugNew.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+// Load a map with one empty tile layer, which needs no tile set textures
+SharedPtr<TmxFile2D> CreateEmptyMap(Context* context, const String& orientation, i32 width, i32 height)
+{
+    String data;
+    for (i32 i = 0; i < width * height; ++i)
+        data += i ? ",0" : "0";
+
+    String xml = "<map version=\"1.0\" orientation=\"" + orientation + "\" width=\"" + String(width) + "\" height=\"" +
+        String(height) + "\" tilewidth=\"64\" tileheight=\"32\"><layer name=\"Ground\" width=\"" + String(width) +
+        "\" height=\"" + String(height) + "\"><data encoding=\"csv\">" + data + "</data></layer></map>";
+
+    SharedPtr<TmxFile2D> tmxFile(new TmxFile2D(context));
+    MemoryBuffer buffer(xml.CString(), xml.Length());
+    assert(tmxFile->Load(buffer));
+    return tmxFile;
+}
+
+SharedPtr<Tile2D> CreateTile(Context* context, Texture2D* texture, const IntRect& rectangle)
+{
+    SharedPtr<Sprite2D> sprite(new Sprite2D(context));
+    sprite->SetTexture(texture);
+    sprite->SetRectangle(rectangle);
+
+    SharedPtr<Tile2D> tile(new Tile2D());
+    tile->SetSprite(sprite);
+    return tile;
+}
+
+Vector<TileMapChunk2D*> GetChunks(TileMapLayer2D* layer)
+{
+    Vector<TileMapChunk2D*> chunks;
+    layer->GetNode()->GetComponents<TileMapChunk2D>(chunks, true);
+    return chunks;
+}
+
+}
+
+void Test_Urho2D_TileMapLayer2D()
+{
+    SharedPtr<Context> context(new Context());
+    context->RegisterSubsystem(new ResourceCache(context));
+    RegisterSceneLibrary(context);
+    RegisterUrho2DLibrary(context);
+
+    SharedPtr<Texture2D> textures[2] = {SharedPtr<Texture2D>(new Texture2D(context)), SharedPtr<Texture2D>(new Texture2D(context))};
+    SharedPtr<Tile2D> tileA = CreateTile(context, textures[0], IntRect(0, 0, 64, 32));
+    SharedPtr<Tile2D> tileB = CreateTile(context, textures[1], IntRect(0, 0, 64, 32));
+    SharedPtr<Tile2D> tallTileA = CreateTile(context, textures[0], IntRect(0, 0, 64, 64));
+
+    SharedPtr<Scene> scene(new Scene(context));
+
+    {
+        // Orthogonal maps are divided into square chunks
+        auto* tileMap = scene->CreateChild()->CreateComponent<TileMap2D>();
+        tileMap->SetTmxFile(CreateEmptyMap(context, "orthogonal", 40, 3));
+        assert(GetChunks(tileMap->GetLayer(0)).Size() == 2);
+    }
+
+    {
+        // The other orientations are divided into strips of whole rows, so that tiles overlapping the next row are drawn
+        // before it
+        auto* tileMap = scene->CreateChild()->CreateComponent<TileMap2D>();
+        tileMap->SetTmxFile(CreateEmptyMap(context, "isometric", 40, 3));
+        TileMapLayer2D* layer = tileMap->GetLayer(0);
+        Vector<TileMapChunk2D*> chunks = GetChunks(layer);
+        assert(chunks.Size() == 1);
+        TileMapChunk2D* chunk = chunks[0];
+        assert(chunk->GetTileRect() == IntRect(0, 0, 40, 3));
+        assert(chunk->GetNumTiles() == 0);
+
+        // A run of tiles with the same texture is one batch, and a change of texture starts a new batch drawn after it
+        layer->SetTile(0, 0, tileA);
+        layer->SetTile(1, 0, tileA);
+        layer->SetTile(2, 0, tileB);
+        layer->SetTile(0, 1, tileA);
+        assert(chunk->GetNumTiles() == 4);
+        const Vector<SourceBatch2D>& batches = chunk->GetSourceBatches();
+        assert(batches.Size() == 3);
+        assert(batches[0].vertices_.Size() == 8 && batches[1].vertices_.Size() == 4 && batches[2].vertices_.Size() == 4);
+        assert(batches[0].drawOrder_ < batches[1].drawOrder_ && batches[1].drawOrder_ < batches[2].drawOrder_);
+        assert(batches[1].drawOrder_ - batches[0].drawOrder_ == 2);
+        assert(batches[0].material_ != batches[1].material_);
+
+        // A tile with the same texture is patched in place, and a removed tile becomes a degenerate quad
+        const float height = batches[0].vertices_[5].position_.y_ - batches[0].vertices_[4].position_.y_;
+        layer->SetTile(1, 0, tallTileA);
+        assert(batches.Size() == 3 && batches[0].vertices_.Size() == 8);
+        assert(Abs(batches[0].vertices_[5].position_.y_ - batches[0].vertices_[4].position_.y_ - 2.f * height) < M_EPSILON);
+
+        layer->SetTile(1, 0, nullptr);
+        assert(chunk->GetNumTiles() == 3);
+        assert(batches.Size() == 3 && batches[0].vertices_.Size() == 8);
+        for (i32 i = 4; i < 8; ++i)
+            assert(batches[0].vertices_[i].position_ == batches[0].vertices_[4].position_);
+
+        // A tile with another texture bakes the chunk again, which joins it to the run of the next tile
+        layer->SetTile(0, 0, tileB);
+        assert(chunk->GetNumTiles() == 3);
+        assert(chunk->GetSourceBatches().Size() == 2);
+        assert(chunk->GetSourceBatches()[0].vertices_.Size() == 8);
+        assert(layer->GetTile(0, 0) == tileB);
+    }
+}
+
+#else
+
+void Test_Urho2D_TileMapLayer2D()
+{
+}
+
+#endif
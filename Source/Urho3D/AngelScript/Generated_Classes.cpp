@@ -4605,11 +4605,11 @@ static PackageFile* PackageFile__PackageFile_Contextstar()
     return new PackageFile(context);
 }
 
-// PackageFile::PackageFile(Context* context, const String& fileName, unsigned startOffset = 0)
-static PackageFile* PackageFile__PackageFile_Contextstar_constspStringamp_unsigned(const String& fileName, unsigned startOffset)
+// PackageFile::PackageFile(Context* context, const String& fileName, unsigned startOffset = 0, bool memoryMapped = false)
+static PackageFile* PackageFile__PackageFile_Contextstar_constspStringamp_unsigned_bool(const String& fileName, unsigned startOffset, bool memoryMapped)
 {
     Context* context = GetScriptContext();
-    return new PackageFile(context, fileName, startOffset);
+    return new PackageFile(context, fileName, startOffset, memoryMapped);
 }
 
 // class PackageFile | File: ../IO/PackageFile.h
@@ -4617,8 +4617,8 @@ static void Register_PackageFile(asIScriptEngine* engine)
 {
     // explicit PackageFile::PackageFile(Context* context)
     engine->RegisterObjectBehaviour("PackageFile", asBEHAVE_FACTORY, "PackageFile@+ f()", AS_FUNCTION(PackageFile__PackageFile_Contextstar) , AS_CALL_CDECL);
-    // PackageFile::PackageFile(Context* context, const String& fileName, unsigned startOffset = 0)
-    engine->RegisterObjectBehaviour("PackageFile", asBEHAVE_FACTORY, "PackageFile@+ f(const String&in, uint = 0)", AS_FUNCTION(PackageFile__PackageFile_Contextstar_constspStringamp_unsigned) , AS_CALL_CDECL);
+    // PackageFile::PackageFile(Context* context, const String& fileName, unsigned startOffset = 0, bool memoryMapped = false)
+    engine->RegisterObjectBehaviour("PackageFile", asBEHAVE_FACTORY, "PackageFile@+ f(const String&in, uint = 0, bool = false)", AS_FUNCTION(PackageFile__PackageFile_Contextstar_constspStringamp_unsigned_bool) , AS_CALL_CDECL);
 
     RegisterSubclass<Object, PackageFile>(engine, "Object", "PackageFile");
     RegisterSubclass<RefCounted, PackageFile>(engine, "RefCounted", "PackageFile");
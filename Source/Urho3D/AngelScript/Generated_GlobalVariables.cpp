@@ -118,6 +118,9 @@ void ASRegisterGeneratedGlobalVariables(asIScriptEngine* engine)
     // static const String EP_MATERIAL_QUALITY | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_MATERIAL_QUALITY", (void*)&EP_MATERIAL_QUALITY);
 
+    // static const String EP_MEMORY_MAP_PACKAGES | File: ../Engine/EngineDefs.h
+    engine->RegisterGlobalProperty("const String EP_MEMORY_MAP_PACKAGES", (void*)&EP_MEMORY_MAP_PACKAGES);
+
     // static const String EP_MONITOR | File: ../Engine/EngineDefs.h
     engine->RegisterGlobalProperty("const String EP_MONITOR", (void*)&EP_MONITOR);
 
@@ -388,6 +388,12 @@ template <class T> void RegisterMembers_BatchQueue(asIScriptEngine* engine, cons
     // void BatchQueue::SortFrontToBack2Pass(Vector<Batch*>& batches)
     // Error: type "Vector<Batch*>&" can not automatically bind
 
+    // void BatchQueue::AddInstancedBatch(const Batch& batch, Technique* tech)
+    engine->RegisterObjectMethod(className, "void AddInstancedBatch(const Batch&in, Technique@+)", AS_METHODPR(T, AddInstancedBatch, (const Batch&, Technique*), void), AS_CALL_THISCALL);
+
+    // void BatchQueue::BuildBatchGroups(Renderer* renderer, i32 minInstances)
+    engine->RegisterObjectMethod(className, "void BuildBatchGroups(Renderer@+, int)", AS_METHODPR(T, BuildBatchGroups, (Renderer*, i32), void), AS_CALL_THISCALL);
+
     // void BatchQueue::Clear(int maxSortedInstances)
     engine->RegisterObjectMethod(className, "void Clear(int)", AS_METHODPR(T, Clear, (int), void), AS_CALL_THISCALL);
 
@@ -406,8 +412,12 @@ template <class T> void RegisterMembers_BatchQueue(asIScriptEngine* engine, cons
     // void BatchQueue::SortFrontToBack()
     engine->RegisterObjectMethod(className, "void SortFrontToBack()", AS_METHODPR(T, SortFrontToBack, (), void), AS_CALL_THISCALL);
 
-    // HashMap<BatchGroupKey, BatchGroup> BatchQueue::batchGroups_
-    // Error: type "HashMap<BatchGroupKey, BatchGroup>" can not automatically bind
+    // Vector<Batch> BatchQueue::instancedBatches_
+    // Error: type "Vector<Batch>" can not automatically bind
+    // Vector<Technique*> BatchQueue::instancedTechniques_
+    // Error: type "Vector<Technique*>" can not automatically bind
+    // Vector<BatchGroup> BatchQueue::batchGroups_
+    // Error: type "Vector<BatchGroup>" can not automatically bind
     // HashMap<hash32, hash32> BatchQueue::shaderRemapping_
     // Error: type "HashMap<hash32, hash32>" can not automatically bind
     // HashMap<hash16, hash16> BatchQueue::materialRemapping_
@@ -420,6 +430,10 @@ template <class T> void RegisterMembers_BatchQueue(asIScriptEngine* engine, cons
     // Error: type "Vector<Batch*>" can not automatically bind
     // Vector<BatchGroup*> BatchQueue::sortedBatchGroups_
     // Error: type "Vector<BatchGroup*>" can not automatically bind
+    // Vector<BatchSortKey> BatchQueue::sortKeys_
+    // Error: type "Vector<BatchSortKey>" can not automatically bind
+    // Vector<BatchSortKey> BatchQueue::sortTemp_
+    // Error: type "Vector<BatchSortKey>" can not automatically bind
 
     // i32 BatchQueue::maxSortedInstances_
     engine->RegisterObjectProperty(className, "int maxSortedInstances", offsetof(T, maxSortedInstances_));
@@ -9016,9 +9030,16 @@ template <class T> void RegisterMembers_Tile2D(asIScriptEngine* engine, const ch
     engine->RegisterObjectMethod(className, "bool GetSwapXY() const", AS_METHODPR(T, GetSwapXY, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_swapXY() const", AS_METHODPR(T, GetSwapXY, () const, bool), AS_CALL_THISCALL);
 
+    // bool Tile2D::HasProperties() const
+    engine->RegisterObjectMethod(className, "bool HasProperties() const", AS_METHODPR(T, HasProperties, () const, bool), AS_CALL_THISCALL);
+
     // bool Tile2D::HasProperty(const String& name) const
     engine->RegisterObjectMethod(className, "bool HasProperty(const String&in) const", AS_METHODPR(T, HasProperty, (const String&) const, bool), AS_CALL_THISCALL);
 
+    // void Tile2D::SetSprite(Sprite2D* sprite)
+    engine->RegisterObjectMethod(className, "void SetSprite(Sprite2D@+)", AS_METHODPR(T, SetSprite, (Sprite2D*), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_sprite(Sprite2D@+)", AS_METHODPR(T, SetSprite, (Sprite2D*), void), AS_CALL_THISCALL);
+
     #ifdef REGISTER_MEMBERS_MANUAL_PART_Tile2D
         REGISTER_MEMBERS_MANUAL_PART_Tile2D();
     #endif
@@ -9154,6 +9175,14 @@ template <class T> void RegisterMembers_Audio(asIScriptEngine* engine, const cha
     // void Audio::AddSoundSource(SoundSource* soundSource)
     engine->RegisterObjectMethod(className, "void AddSoundSource(SoundSource@+)", AS_METHODPR(T, AddSoundSource, (SoundSource*), void), AS_CALL_THISCALL);
 
+    // unsigned Audio::GetDecodeCacheBudget() const
+    engine->RegisterObjectMethod(className, "uint GetDecodeCacheBudget() const", AS_METHODPR(T, GetDecodeCacheBudget, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_decodeCacheBudget() const", AS_METHODPR(T, GetDecodeCacheBudget, () const, unsigned), AS_CALL_THISCALL);
+
+    // unsigned Audio::GetDecodeCacheUse() const
+    engine->RegisterObjectMethod(className, "uint GetDecodeCacheUse() const", AS_METHODPR(T, GetDecodeCacheUse, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_decodeCacheUse() const", AS_METHODPR(T, GetDecodeCacheUse, () const, unsigned), AS_CALL_THISCALL);
+
     // bool Audio::GetInterpolation() const
     engine->RegisterObjectMethod(className, "bool GetInterpolation() const", AS_METHODPR(T, GetInterpolation, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_interpolation() const", AS_METHODPR(T, GetInterpolation, () const, bool), AS_CALL_THISCALL);
@@ -9166,6 +9195,10 @@ template <class T> void RegisterMembers_Audio(asIScriptEngine* engine, const cha
     engine->RegisterObjectMethod(className, "float GetMasterGain(const String&in) const", AS_METHODPR(T, GetMasterGain, (const String&) const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_masterGain(const String&in) const", AS_METHODPR(T, GetMasterGain, (const String&) const, float), AS_CALL_THISCALL);
 
+    // i32 Audio::GetMaxVoices() const
+    engine->RegisterObjectMethod(className, "int GetMaxVoices() const", AS_METHODPR(T, GetMaxVoices, () const, i32), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_maxVoices() const", AS_METHODPR(T, GetMaxVoices, () const, i32), AS_CALL_THISCALL);
+
     // i32 Audio::GetMixRate() const
     engine->RegisterObjectMethod(className, "int GetMixRate() const", AS_METHODPR(T, GetMixRate, () const, i32), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_mixRate() const", AS_METHODPR(T, GetMixRate, () const, i32), AS_CALL_THISCALL);
@@ -9173,6 +9206,10 @@ template <class T> void RegisterMembers_Audio(asIScriptEngine* engine, const cha
     // Mutex& Audio::GetMutex()
     engine->RegisterObjectMethod(className, "Mutex& GetMutex()", AS_METHODPR(T, GetMutex, (), Mutex&), AS_CALL_THISCALL);
 
+    // i32 Audio::GetNumVirtualVoices() const
+    engine->RegisterObjectMethod(className, "int GetNumVirtualVoices() const", AS_METHODPR(T, GetNumVirtualVoices, () const, i32), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_numVirtualVoices() const", AS_METHODPR(T, GetNumVirtualVoices, () const, i32), AS_CALL_THISCALL);
+
     // u32 Audio::GetSampleSize() const
     engine->RegisterObjectMethod(className, "uint GetSampleSize() const", AS_METHODPR(T, GetSampleSize, () const, u32), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_sampleSize() const", AS_METHODPR(T, GetSampleSize, () const, u32), AS_CALL_THISCALL);
@@ -9183,6 +9220,9 @@ template <class T> void RegisterMembers_Audio(asIScriptEngine* engine, const cha
     // const Vector<SoundSource*>& Audio::GetSoundSources() const
     engine->RegisterObjectMethod(className, "Array<SoundSource@>@ GetSoundSources() const", AS_FUNCTION_OBJFIRST(Audio_constspVectorlesSoundSourcestargreamp_GetSoundSources_void_template<Audio>), AS_CALL_CDECL_OBJFIRST);
 
+    // i32 Audio::GetSoundTypeVoiceLimit(const String& type) const
+    engine->RegisterObjectMethod(className, "int GetSoundTypeVoiceLimit(const String&in) const", AS_METHODPR(T, GetSoundTypeVoiceLimit, (const String&) const, i32), AS_CALL_THISCALL);
+
     // bool Audio::HasMasterGain(const String& type) const
     engine->RegisterObjectMethod(className, "bool HasMasterGain(const String&in) const", AS_METHODPR(T, HasMasterGain, (const String&) const, bool), AS_CALL_THISCALL);
 
@@ -9216,6 +9256,10 @@ template <class T> void RegisterMembers_Audio(asIScriptEngine* engine, const cha
     // void Audio::ResumeSoundType(const String& type)
     engine->RegisterObjectMethod(className, "void ResumeSoundType(const String&in)", AS_METHODPR(T, ResumeSoundType, (const String&), void), AS_CALL_THISCALL);
 
+    // void Audio::SetDecodeCacheBudget(unsigned bytes)
+    engine->RegisterObjectMethod(className, "void SetDecodeCacheBudget(uint)", AS_METHODPR(T, SetDecodeCacheBudget, (unsigned), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_decodeCacheBudget(uint)", AS_METHODPR(T, SetDecodeCacheBudget, (unsigned), void), AS_CALL_THISCALL);
+
     // void Audio::SetListener(SoundListener* listener)
     engine->RegisterObjectMethod(className, "void SetListener(SoundListener@+)", AS_METHODPR(T, SetListener, (SoundListener*), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_listener(SoundListener@+)", AS_METHODPR(T, SetListener, (SoundListener*), void), AS_CALL_THISCALL);
@@ -9224,9 +9268,16 @@ template <class T> void RegisterMembers_Audio(asIScriptEngine* engine, const cha
     engine->RegisterObjectMethod(className, "void SetMasterGain(const String&in, float)", AS_METHODPR(T, SetMasterGain, (const String&, float), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_masterGain(const String&in, float)", AS_METHODPR(T, SetMasterGain, (const String&, float), void), AS_CALL_THISCALL);
 
+    // void Audio::SetMaxVoices(i32 voices)
+    engine->RegisterObjectMethod(className, "void SetMaxVoices(int)", AS_METHODPR(T, SetMaxVoices, (i32), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_maxVoices(int)", AS_METHODPR(T, SetMaxVoices, (i32), void), AS_CALL_THISCALL);
+
     // bool Audio::SetMode(i32 bufferLengthMSec, i32 mixRate, bool stereo, bool interpolation = true)
     engine->RegisterObjectMethod(className, "bool SetMode(int, int, bool, bool = true)", AS_METHODPR(T, SetMode, (i32, i32, bool, bool), bool), AS_CALL_THISCALL);
 
+    // void Audio::SetSoundTypeVoiceLimit(const String& type, i32 voices)
+    engine->RegisterObjectMethod(className, "void SetSoundTypeVoiceLimit(const String&in, int)", AS_METHODPR(T, SetSoundTypeVoiceLimit, (const String&, i32), void), AS_CALL_THISCALL);
+
     // void Audio::Stop()
     engine->RegisterObjectMethod(className, "void Stop()", AS_METHODPR(T, Stop, (), void), AS_CALL_THISCALL);
 
@@ -10292,9 +10343,17 @@ template <class T> void RegisterMembers_Graphics(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "const String& GetOrientations() const", AS_METHODPR(T, GetOrientations, () const, const String&), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "const String& get_orientations() const", AS_METHODPR(T, GetOrientations, () const, const String&), AS_CALL_THISCALL);
 
+    // bool Graphics::GetPersistentMappingSupport() const
+    engine->RegisterObjectMethod(className, "bool GetPersistentMappingSupport() const", AS_METHODPR(T, GetPersistentMappingSupport, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_persistentMappingSupport() const", AS_METHODPR(T, GetPersistentMappingSupport, () const, bool), AS_CALL_THISCALL);
+
     // ShaderVariation* Graphics::GetPixelShader() const
     engine->RegisterObjectMethod(className, "ShaderVariation@+ GetPixelShader() const", AS_METHODPR(T, GetPixelShader, () const, ShaderVariation*), AS_CALL_THISCALL);
 
+    // bool Graphics::GetProgramBinarySupport() const
+    engine->RegisterObjectMethod(className, "bool GetProgramBinarySupport() const", AS_METHODPR(T, GetProgramBinarySupport, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_programBinarySupport() const", AS_METHODPR(T, GetProgramBinarySupport, () const, bool), AS_CALL_THISCALL);
+
     // bool Graphics::GetReadableDepthSupport() const
     engine->RegisterObjectMethod(className, "bool GetReadableDepthSupport() const", AS_METHODPR(T, GetReadableDepthSupport, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_readableDepthSupport() const", AS_METHODPR(T, GetReadableDepthSupport, () const, bool), AS_CALL_THISCALL);
@@ -11287,12 +11346,20 @@ template <class T> void RegisterMembers_PackageFile(asIScriptEngine* engine, con
     engine->RegisterObjectMethod(className, "uint GetTotalSize() const", AS_METHODPR(T, GetTotalSize, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_totalSize() const", AS_METHODPR(T, GetTotalSize, () const, unsigned), AS_CALL_THISCALL);
 
+    // unsigned PackageFile::GetVersion() const
+    engine->RegisterObjectMethod(className, "uint GetVersion() const", AS_METHODPR(T, GetVersion, () const, unsigned), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "uint get_version() const", AS_METHODPR(T, GetVersion, () const, unsigned), AS_CALL_THISCALL);
+
     // bool PackageFile::IsCompressed() const
     engine->RegisterObjectMethod(className, "bool IsCompressed() const", AS_METHODPR(T, IsCompressed, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_compressed() const", AS_METHODPR(T, IsCompressed, () const, bool), AS_CALL_THISCALL);
 
-    // bool PackageFile::Open(const String& fileName, unsigned startOffset = 0)
-    engine->RegisterObjectMethod(className, "bool Open(const String&in, uint = 0)", AS_METHODPR(T, Open, (const String&, unsigned), bool), AS_CALL_THISCALL);
+    // bool PackageFile::IsMemoryMapped() const
+    engine->RegisterObjectMethod(className, "bool IsMemoryMapped() const", AS_METHODPR(T, IsMemoryMapped, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_memoryMapped() const", AS_METHODPR(T, IsMemoryMapped, () const, bool), AS_CALL_THISCALL);
+
+    // bool PackageFile::Open(const String& fileName, unsigned startOffset = 0, bool memoryMapped = false)
+    engine->RegisterObjectMethod(className, "bool Open(const String&in, uint = 0, bool = false)", AS_METHODPR(T, Open, (const String&, unsigned, bool), bool), AS_CALL_THISCALL);
 
     #ifdef REGISTER_MEMBERS_MANUAL_PART_PackageFile
         REGISTER_MEMBERS_MANUAL_PART_PackageFile();
@@ -11826,8 +11893,8 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     // bool ResourceCache::AddResourceDir(const String& pathName, i32 priority = PRIORITY_LAST)
     engine->RegisterObjectMethod(className, "bool AddResourceDir(const String&in, int = PRIORITY_LAST)", AS_METHODPR(T, AddResourceDir, (const String&, i32), bool), AS_CALL_THISCALL);
 
-    // bool ResourceCache::BackgroundLoadResource(StringHash type, const String& name, bool sendEventOnFailure = true, Resource* caller = nullptr)
-    engine->RegisterObjectMethod(className, "bool BackgroundLoadResource(StringHash, const String&in, bool = true, Resource@+ = null)", AS_METHODPR(T, BackgroundLoadResource, (StringHash, const String&, bool, Resource*), bool), AS_CALL_THISCALL);
+    // bool ResourceCache::BackgroundLoadResource(StringHash type, const String& name, bool sendEventOnFailure = true, Resource* caller = nullptr, i32 priority = 0)
+    engine->RegisterObjectMethod(className, "bool BackgroundLoadResource(StringHash, const String&in, bool = true, Resource@+ = null, int = 0)", AS_METHODPR(T, BackgroundLoadResource, (StringHash, const String&, bool, Resource*, i32), bool), AS_CALL_THISCALL);
 
     // bool ResourceCache::Exists(const String& name) const
     engine->RegisterObjectMethod(className, "bool Exists(const String&in) const", AS_METHODPR(T, Exists, (const String&) const, bool), AS_CALL_THISCALL);
@@ -11850,6 +11917,10 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "uint64 GetMemoryBudget(StringHash) const", AS_METHODPR(T, GetMemoryBudget, (StringHash) const, unsigned long long), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint64 get_memoryBudget(StringHash) const", AS_METHODPR(T, GetMemoryBudget, (StringHash) const, unsigned long long), AS_CALL_THISCALL);
 
+    // bool ResourceCache::GetMemoryMapPackages() const
+    engine->RegisterObjectMethod(className, "bool GetMemoryMapPackages() const", AS_METHODPR(T, GetMemoryMapPackages, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_memoryMapPackages() const", AS_METHODPR(T, GetMemoryMapPackages, () const, bool), AS_CALL_THISCALL);
+
     // unsigned long long ResourceCache::GetMemoryUse(StringHash type) const
     engine->RegisterObjectMethod(className, "uint64 GetMemoryUse(StringHash) const", AS_METHODPR(T, GetMemoryUse, (StringHash) const, unsigned long long), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint64 get_memoryUse(StringHash) const", AS_METHODPR(T, GetMemoryUse, (StringHash) const, unsigned long long), AS_CALL_THISCALL);
@@ -11858,6 +11929,10 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "uint GetNumBackgroundLoadResources() const", AS_METHODPR(T, GetNumBackgroundLoadResources, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_numBackgroundLoadResources() const", AS_METHODPR(T, GetNumBackgroundLoadResources, () const, unsigned), AS_CALL_THISCALL);
 
+    // i32 ResourceCache::GetNumBackgroundLoadThreads() const
+    engine->RegisterObjectMethod(className, "int GetNumBackgroundLoadThreads() const", AS_METHODPR(T, GetNumBackgroundLoadThreads, () const, i32), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_numBackgroundLoadThreads() const", AS_METHODPR(T, GetNumBackgroundLoadThreads, () const, i32), AS_CALL_THISCALL);
+
     // const Vector<SharedPtr<PackageFile>>& ResourceCache::GetPackageFiles() const
     engine->RegisterObjectMethod(className, "Array<PackageFile@>@ GetPackageFiles() const", AS_FUNCTION_OBJFIRST(ResourceCache_constspVectorlesSharedPtrlesPackageFilegregreamp_GetPackageFiles_void_template<ResourceCache>), AS_CALL_CDECL_OBJFIRST);
     engine->RegisterObjectMethod(className, "Array<PackageFile@>@ get_packageFiles() const", AS_FUNCTION_OBJFIRST(ResourceCache_constspVectorlesSharedPtrlesPackageFilegregreamp_GetPackageFiles_void_template<ResourceCache>), AS_CALL_CDECL_OBJFIRST);
@@ -11944,6 +12019,14 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     engine->RegisterObjectMethod(className, "void SetMemoryBudget(StringHash, uint64)", AS_METHODPR(T, SetMemoryBudget, (StringHash, unsigned long long), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_memoryBudget(StringHash, uint64)", AS_METHODPR(T, SetMemoryBudget, (StringHash, unsigned long long), void), AS_CALL_THISCALL);
 
+    // void ResourceCache::SetMemoryMapPackages(bool enable)
+    engine->RegisterObjectMethod(className, "void SetMemoryMapPackages(bool)", AS_METHODPR(T, SetMemoryMapPackages, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_memoryMapPackages(bool)", AS_METHODPR(T, SetMemoryMapPackages, (bool), void), AS_CALL_THISCALL);
+
+    // void ResourceCache::SetNumBackgroundLoadThreads(i32 num)
+    engine->RegisterObjectMethod(className, "void SetNumBackgroundLoadThreads(int)", AS_METHODPR(T, SetNumBackgroundLoadThreads, (i32), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_numBackgroundLoadThreads(int)", AS_METHODPR(T, SetNumBackgroundLoadThreads, (i32), void), AS_CALL_THISCALL);
+
     // void ResourceCache::SetReturnFailedResources(bool enable)
     engine->RegisterObjectMethod(className, "void SetReturnFailedResources(bool)", AS_METHODPR(T, SetReturnFailedResources, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_returnFailedResources(bool)", AS_METHODPR(T, SetReturnFailedResources, (bool), void), AS_CALL_THISCALL);
@@ -11955,7 +12038,7 @@ template <class T> void RegisterMembers_ResourceCache(asIScriptEngine* engine, c
     // void ResourceCache::StoreResourceDependency(Resource* resource, const String& dependency)
     engine->RegisterObjectMethod(className, "void StoreResourceDependency(Resource@+, const String&in)", AS_METHODPR(T, StoreResourceDependency, (Resource*, const String&), void), AS_CALL_THISCALL);
 
-    // template <class T> bool ResourceCache::BackgroundLoadResource(const String& name, bool sendEventOnFailure = true, Resource* caller = nullptr)
+    // template <class T> bool ResourceCache::BackgroundLoadResource(const String& name, bool sendEventOnFailure = true, Resource* caller = nullptr, i32 priority = 0)
     // Not registered because template
     // template <class T> T* ResourceCache::GetExistingResource(const String& name)
     // Not registered because template
@@ -16863,6 +16946,10 @@ template <class T> void RegisterMembers_UIElement(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "int GetPriority() const", AS_METHODPR(T, GetPriority, () const, int), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "int get_priority() const", AS_METHODPR(T, GetPriority, () const, int), AS_CALL_THISCALL);
 
+    // bool UIElement::GetRetainBatches() const
+    engine->RegisterObjectMethod(className, "bool GetRetainBatches() const", AS_METHODPR(T, GetRetainBatches, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_retainBatches() const", AS_METHODPR(T, GetRetainBatches, () const, bool), AS_CALL_THISCALL);
+
     // UIElement* UIElement::GetRoot() const
     engine->RegisterObjectMethod(className, "UIElement@+ GetRoot() const", AS_METHODPR(T, GetRoot, () const, UIElement*), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "UIElement@+ get_root() const", AS_METHODPR(T, GetRoot, () const, UIElement*), AS_CALL_THISCALL);
@@ -16987,6 +17074,9 @@ template <class T> void RegisterMembers_UIElement(asIScriptEngine* engine, const
     // bool UIElement::LoadXML(Deserializer& source)
     engine->RegisterObjectMethod(className, "bool LoadXML(Deserializer&)", AS_METHODPR(T, LoadXML, (Deserializer&), bool), AS_CALL_THISCALL);
 
+    // void UIElement::MarkBatchesDirty()
+    engine->RegisterObjectMethod(className, "void MarkBatchesDirty()", AS_METHODPR(T, MarkBatchesDirty, (), void), AS_CALL_THISCALL);
+
     // virtual void UIElement::OnClickBegin(const IntVector2& position, const IntVector2& screenPosition, MouseButton button, MouseButtonFlags buttons, QualifierFlags qualifiers, Cursor* cursor)
     engine->RegisterObjectMethod(className, "void OnClickBegin(const IntVector2&in, const IntVector2&in, MouseButton, MouseButtonFlags, QualifierFlags, Cursor@+)", AS_METHODPR(T, OnClickBegin, (const IntVector2&, const IntVector2&, MouseButton, MouseButtonFlags, QualifierFlags, Cursor*), void), AS_CALL_THISCALL);
 
@@ -17264,6 +17354,10 @@ template <class T> void RegisterMembers_UIElement(asIScriptEngine* engine, const
     // void UIElement::SetRenderTexture(Texture2D* texture)
     engine->RegisterObjectMethod(className, "void SetRenderTexture(Texture2D@+)", AS_METHODPR(T, SetRenderTexture, (Texture2D*), void), AS_CALL_THISCALL);
 
+    // void UIElement::SetRetainBatches(bool enable)
+    engine->RegisterObjectMethod(className, "void SetRetainBatches(bool)", AS_METHODPR(T, SetRetainBatches, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_retainBatches(bool)", AS_METHODPR(T, SetRetainBatches, (bool), void), AS_CALL_THISCALL);
+
     // void UIElement::SetSelected(bool enable)
     engine->RegisterObjectMethod(className, "void SetSelected(bool)", AS_METHODPR(T, SetSelected, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_selected(bool)", AS_METHODPR(T, SetSelected, (bool), void), AS_CALL_THISCALL);
@@ -18222,12 +18316,18 @@ template <class T> void RegisterMembers_LogicComponent(asIScriptEngine* engine,
     // bool LogicComponent::IsDelayedStartCalled() const
     engine->RegisterObjectMethod(className, "bool IsDelayedStartCalled() const", AS_METHODPR(T, IsDelayedStartCalled, () const, bool), AS_CALL_THISCALL);
 
+    // bool LogicComponent::IsUpdateParallelSafe() const
+    engine->RegisterObjectMethod(className, "bool IsUpdateParallelSafe() const", AS_METHODPR(T, IsUpdateParallelSafe, () const, bool), AS_CALL_THISCALL);
+
     // virtual void LogicComponent::PostUpdate(float timeStep)
     engine->RegisterObjectMethod(className, "void PostUpdate(float)", AS_METHODPR(T, PostUpdate, (float), void), AS_CALL_THISCALL);
 
     // void LogicComponent::SetUpdateEventMask(LogicComponentEvents mask)
     engine->RegisterObjectMethod(className, "void SetUpdateEventMask(LogicComponentEvents)", AS_METHODPR(T, SetUpdateEventMask, (LogicComponentEvents), void), AS_CALL_THISCALL);
 
+    // void LogicComponent::SetUpdateParallelSafe(bool enable)
+    engine->RegisterObjectMethod(className, "void SetUpdateParallelSafe(bool)", AS_METHODPR(T, SetUpdateParallelSafe, (bool), void), AS_CALL_THISCALL);
+
     // virtual void LogicComponent::Start()
     engine->RegisterObjectMethod(className, "void Start()", AS_METHODPR(T, Start, (), void), AS_CALL_THISCALL);
 
@@ -18707,6 +18807,9 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     // virtual void Component::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
     engine->RegisterObjectMethod(className, "void DrawDebugGeometry(DebugRenderer@+, bool)", AS_METHODPR(T, DrawDebugGeometry, (DebugRenderer*, bool), void), AS_CALL_THISCALL);
 
+    // float SoundSource::GetAudibility() const
+    engine->RegisterObjectMethod(className, "float GetAudibility() const", AS_METHODPR(T, GetAudibility, () const, float), AS_CALL_THISCALL);
+
     // float SoundSource::GetAttenuation() const
     engine->RegisterObjectMethod(className, "float GetAttenuation() const", AS_METHODPR(T, GetAttenuation, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_attenuation() const", AS_METHODPR(T, GetAttenuation, () const, float), AS_CALL_THISCALL);
@@ -18727,6 +18830,10 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     engine->RegisterObjectMethod(className, "float GetPanning() const", AS_METHODPR(T, GetPanning, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_panning() const", AS_METHODPR(T, GetPanning, () const, float), AS_CALL_THISCALL);
 
+    // i32 SoundSource::GetPriority() const
+    engine->RegisterObjectMethod(className, "int GetPriority() const", AS_METHODPR(T, GetPriority, () const, i32), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "int get_priority() const", AS_METHODPR(T, GetPriority, () const, i32), AS_CALL_THISCALL);
+
     // int SoundSource::GetPositionAttr() const
     engine->RegisterObjectMethod(className, "int GetPositionAttr() const", AS_METHODPR(T, GetPositionAttr, () const, int), AS_CALL_THISCALL);
 
@@ -18741,6 +18848,9 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     engine->RegisterObjectMethod(className, "String GetSoundType() const", AS_METHODPR(T, GetSoundType, () const, String), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "String get_soundType() const", AS_METHODPR(T, GetSoundType, () const, String), AS_CALL_THISCALL);
 
+    // StringHash SoundSource::GetSoundTypeHash() const
+    engine->RegisterObjectMethod(className, "StringHash GetSoundTypeHash() const", AS_METHODPR(T, GetSoundTypeHash, () const, StringHash), AS_CALL_THISCALL);
+
     // float SoundSource::GetTimePosition() const
     engine->RegisterObjectMethod(className, "float GetTimePosition() const", AS_METHODPR(T, GetTimePosition, () const, float), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "float get_timePosition() const", AS_METHODPR(T, GetTimePosition, () const, float), AS_CALL_THISCALL);
@@ -18749,6 +18859,10 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     engine->RegisterObjectMethod(className, "bool IsPlaying() const", AS_METHODPR(T, IsPlaying, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_playing() const", AS_METHODPR(T, IsPlaying, () const, bool), AS_CALL_THISCALL);
 
+    // bool SoundSource::IsVirtual() const
+    engine->RegisterObjectMethod(className, "bool IsVirtual() const", AS_METHODPR(T, IsVirtual, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_virtual() const", AS_METHODPR(T, IsVirtual, () const, bool), AS_CALL_THISCALL);
+
     // void SoundSource::Play(Sound* sound)
     engine->RegisterObjectMethod(className, "void Play(Sound@+)", AS_METHODPR(T, Play, (Sound*), void), AS_CALL_THISCALL);
 
@@ -18792,6 +18906,10 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     // void SoundSource::SetPositionAttr(int value)
     engine->RegisterObjectMethod(className, "void SetPositionAttr(int)", AS_METHODPR(T, SetPositionAttr, (int), void), AS_CALL_THISCALL);
 
+    // void SoundSource::SetPriority(i32 priority)
+    engine->RegisterObjectMethod(className, "void SetPriority(int)", AS_METHODPR(T, SetPriority, (i32), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_priority(int)", AS_METHODPR(T, SetPriority, (i32), void), AS_CALL_THISCALL);
+
     // void SoundSource::SetSoundAttr(const ResourceRef& value)
     engine->RegisterObjectMethod(className, "void SetSoundAttr(const ResourceRef&in)", AS_METHODPR(T, SetSoundAttr, (const ResourceRef&), void), AS_CALL_THISCALL);
 
@@ -18799,6 +18917,9 @@ template <class T> void RegisterMembers_SoundSource(asIScriptEngine* engine, con
     engine->RegisterObjectMethod(className, "void SetSoundType(const String&in)", AS_METHODPR(T, SetSoundType, (const String&), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_soundType(const String&in)", AS_METHODPR(T, SetSoundType, (const String&), void), AS_CALL_THISCALL);
 
+    // void SoundSource::SetVirtual(bool enable)
+    engine->RegisterObjectMethod(className, "void SetVirtual(bool)", AS_METHODPR(T, SetVirtual, (bool), void), AS_CALL_THISCALL);
+
     // void SoundSource::Stop()
     engine->RegisterObjectMethod(className, "void Stop()", AS_METHODPR(T, Stop, (), void), AS_CALL_THISCALL);
 
@@ -19735,6 +19856,10 @@ template <class T> void RegisterMembers_IKSolver(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "uint GetMaximumIterations() const", AS_METHODPR(T, GetMaximumIterations, () const, unsigned), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "uint get_maximumIterations() const", AS_METHODPR(T, GetMaximumIterations, () const, unsigned), AS_CALL_THISCALL);
 
+    // bool IKSolver::GetSIMD_FABRIK() const
+    engine->RegisterObjectMethod(className, "bool GetSIMD_FABRIK() const", AS_METHODPR(T, GetSIMD_FABRIK, () const, bool), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "bool get_SIMD_FABRIK() const", AS_METHODPR(T, GetSIMD_FABRIK, () const, bool), AS_CALL_THISCALL);
+
     // bool IKSolver::GetTARGET_ROTATIONS() const
     engine->RegisterObjectMethod(className, "bool GetTARGET_ROTATIONS() const", AS_METHODPR(T, GetTARGET_ROTATIONS, () const, bool), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "bool get_TARGET_ROTATIONS() const", AS_METHODPR(T, GetTARGET_ROTATIONS, () const, bool), AS_CALL_THISCALL);
@@ -19777,6 +19902,10 @@ template <class T> void RegisterMembers_IKSolver(asIScriptEngine* engine, const
     engine->RegisterObjectMethod(className, "void SetMaximumIterations(uint)", AS_METHODPR(T, SetMaximumIterations, (unsigned), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_maximumIterations(uint)", AS_METHODPR(T, SetMaximumIterations, (unsigned), void), AS_CALL_THISCALL);
 
+    // void IKSolver::SetSIMD_FABRIK(bool enable)
+    engine->RegisterObjectMethod(className, "void SetSIMD_FABRIK(bool)", AS_METHODPR(T, SetSIMD_FABRIK, (bool), void), AS_CALL_THISCALL);
+    engine->RegisterObjectMethod(className, "void set_SIMD_FABRIK(bool)", AS_METHODPR(T, SetSIMD_FABRIK, (bool), void), AS_CALL_THISCALL);
+
     // void IKSolver::SetTARGET_ROTATIONS(bool enable)
     engine->RegisterObjectMethod(className, "void SetTARGET_ROTATIONS(bool)", AS_METHODPR(T, SetTARGET_ROTATIONS, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_TARGET_ROTATIONS(bool)", AS_METHODPR(T, SetTARGET_ROTATIONS, (bool), void), AS_CALL_THISCALL);
@@ -21920,6 +22049,9 @@ template <class T> void RegisterMembers_TileMapLayer2D(asIScriptEngine* engine,
     engine->RegisterObjectMethod(className, "void SetDrawOrder(int)", AS_METHODPR(T, SetDrawOrder, (int), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_drawOrder(int)", AS_METHODPR(T, SetDrawOrder, (int), void), AS_CALL_THISCALL);
 
+    // void TileMapLayer2D::SetTile(int x, int y, Tile2D* tile)
+    engine->RegisterObjectMethod(className, "void SetTile(int, int, Tile2D@+)", AS_METHODPR(T, SetTile, (int, int, Tile2D*), void), AS_CALL_THISCALL);
+
     // void TileMapLayer2D::SetVisible(bool visible)
     engine->RegisterObjectMethod(className, "void SetVisible(bool)", AS_METHODPR(T, SetVisible, (bool), void), AS_CALL_THISCALL);
     engine->RegisterObjectMethod(className, "void set_visible(bool)", AS_METHODPR(T, SetVisible, (bool), void), AS_CALL_THISCALL);
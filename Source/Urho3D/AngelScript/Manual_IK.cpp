@@ -29,6 +29,7 @@ void ASRegisterManualFirst_IK(asIScriptEngine* engine)
     engine->RegisterEnumValue("IKFeature", "USE_ORIGINAL_POSE", IKSolver::USE_ORIGINAL_POSE);
     engine->RegisterEnumValue("IKFeature", "CONSTRAINTS", IKSolver::CONSTRAINTS);
     engine->RegisterEnumValue("IKFeature", "AUTO_SOLVE", IKSolver::AUTO_SOLVE);
+    engine->RegisterEnumValue("IKFeature", "SIMD_FABRIK", IKSolver::SIMD_FABRIK);
 }
 
 // This function is called after ASRegisterGenerated()
@@ -134,6 +134,8 @@ public:
     Vector<byte> GetScriptNetworkDataAttr() const;
 
 protected:
+    /// Return false, as OnSetAttribute() and OnGetAttribute() also handle the stored and the ID attributes.
+    bool IsTypedAttributeAccessSupported() const override { return false; }
     /// Handle scene being assigned.
     void OnSceneSet(Scene* scene) override;
     /// Handle node transform being dirtied.
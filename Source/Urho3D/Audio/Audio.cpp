@@ -15,6 +15,10 @@
 
 #include <SDL/SDL.h>
 
+#ifdef URHO3D_SSE
+#include <emmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -29,8 +33,17 @@ static const StringHash SOUND_MASTER_HASH("Master");
 
 static void SDLAudioCallback(void* userdata, Uint8* stream, i32 len);
 
+/// Compare sound sources for voice allocation: higher priority first, then louder.
+static bool CompareVoices(SoundSource* lhs, SoundSource* rhs)
+{
+    if (lhs->GetPriority() != rhs->GetPriority())
+        return lhs->GetPriority() > rhs->GetPriority();
+    return lhs->GetAudibility() > rhs->GetAudibility();
+}
+
 Audio::Audio(Context* context) :
-    Object(context)
+    Object(context),
+    decoder_(new SoundDecoder())
 {
     context_->RequireSDL(SDL_INIT_AUDIO);
 
@@ -118,6 +131,8 @@ bool Audio::SetMode(i32 bufferLengthMSec, i32 mixRate, bool stereo, bool interpo
 
 void Audio::Update(float timeStep)
 {
+    decoder_->Update();
+
     if (!playing_)
         return;
 
@@ -159,24 +174,42 @@ void Audio::SetMasterGain(const String& type, float gain)
 
 void Audio::PauseSoundType(const String& type)
 {
-    MutexLock lock(audioMutex_);
     pausedSoundTypes_.Insert(type);
+    QueueCommand(AUDIO_CMD_PAUSE_SOUND_TYPE, type);
 }
 
 void Audio::ResumeSoundType(const String& type)
 {
-    MutexLock lock(audioMutex_);
     pausedSoundTypes_.Erase(type);
-    // Update sound sources before resuming playback to make sure 3D positions are up to date
-    // Done under mutex to ensure no mixing happens before we are ready
+    // Update sound sources before resuming playback to make sure 3D positions are up to date. The audio thread resumes
+    // mixing only once it receives the command, which ensures no mixing happens before we are ready
     UpdateInternal(0.0f);
+    QueueCommand(AUDIO_CMD_RESUME_SOUND_TYPE, type);
 }
 
 void Audio::ResumeAll()
 {
-    MutexLock lock(audioMutex_);
     pausedSoundTypes_.Clear();
     UpdateInternal(0.0f);
+    QueueCommand(AUDIO_CMD_RESUME_ALL);
+}
+
+void Audio::SetMaxVoices(i32 voices)
+{
+    maxVoices_ = Max(voices, 0);
+}
+
+void Audio::SetSoundTypeVoiceLimit(const String& type, i32 voices)
+{
+    if (voices > 0)
+        voiceLimits_[type] = voices;
+    else
+        voiceLimits_.Erase(type);
+}
+
+void Audio::SetDecodeCacheBudget(unsigned bytes)
+{
+    decoder_->SetCacheBudget(bytes);
 }
 
 void Audio::SetListener(SoundListener* listener)
@@ -203,6 +236,12 @@ float Audio::GetMasterGain(const String& type) const
     return findIt->second_.GetFloat();
 }
 
+i32 Audio::GetSoundTypeVoiceLimit(const String& type) const
+{
+    HashMap<StringHash, i32>::ConstIterator i = voiceLimits_.Find(type);
+    return i != voiceLimits_.End() ? i->second_ : 0;
+}
+
 bool Audio::IsSoundTypePaused(const String& type) const
 {
     return pausedSoundTypes_.Contains(type);
@@ -255,6 +294,10 @@ void SDLAudioCallback(void* userdata, Uint8* stream, i32 len)
 
 void Audio::MixOutput(void* dest, u32 samples)
 {
+    AudioCommand command;
+    while (commands_.Pop(command))
+        ApplyCommand(command);
+
     if (!playing_ || !clipBuffer_)
     {
         memset(dest, 0, samples * (size_t)sampleSize_);
@@ -279,9 +322,9 @@ void Audio::MixOutput(void* dest, u32 samples)
             SoundSource* source = *i;
 
             // Check for pause if necessary
-            if (!pausedSoundTypes_.Empty())
+            if (!mixPausedSoundTypes_.Empty())
             {
-                if (pausedSoundTypes_.Contains(source->GetSoundType()))
+                if (mixPausedSoundTypes_.Contains(source->GetSoundType()))
                     continue;
             }
 
@@ -289,6 +332,17 @@ void Audio::MixOutput(void* dest, u32 samples)
         }
         // Copy output from clip buffer to destination
         auto* destPtr = (short*)dest;
+#ifdef URHO3D_SSE
+        // Pack with signed saturation, which clamps to the 16-bit range
+        for (; clipSamples >= 8; clipSamples -= 8)
+        {
+            __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(clipPtr));
+            __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(clipPtr + 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destPtr), _mm_packs_epi32(low, high));
+            clipPtr += 8;
+            destPtr += 8;
+        }
+#endif
         while (clipSamples--)
             *destPtr++ = (short)Clamp(*clipPtr++, -32768, 32767);
         samples -= workSamples;
@@ -333,6 +387,105 @@ void Audio::UpdateInternal(float timeStep)
 
         source->Update(timeStep);
     }
+
+    UpdateVoices();
+}
+
+void Audio::UpdateVoices()
+{
+    // Rank the sources which could be heard. Silent ones are virtualized without taking up a voice
+    voiceRanking_.Clear();
+    numVirtualVoices_ = 0;
+
+    for (SoundSource* source : soundSources_)
+    {
+        if (!source->IsPlaying() || !source->IsEnabledEffective() ||
+            (!pausedSoundTypes_.Empty() && pausedSoundTypes_.Contains(source->GetSoundTypeHash())))
+        {
+            source->SetVirtual(false);
+            continue;
+        }
+
+        if (source->GetAudibility() <= 0.0f)
+        {
+            source->SetVirtual(true);
+            ++numVirtualVoices_;
+        }
+        else
+            voiceRanking_.Push(source);
+    }
+
+    if (!maxVoices_ && voiceLimits_.Empty())
+    {
+        for (SoundSource* source : voiceRanking_)
+            source->SetVirtual(false);
+        return;
+    }
+
+    Sort(voiceRanking_.Begin(), voiceRanking_.End(), CompareVoices);
+
+    voiceCounts_.Clear();
+    i32 numVoices = 0;
+
+    for (SoundSource* source : voiceRanking_)
+    {
+        bool mixed = !maxVoices_ || numVoices < maxVoices_;
+
+        if (mixed && !voiceLimits_.Empty())
+        {
+            HashMap<StringHash, i32>::ConstIterator limit = voiceLimits_.Find(source->GetSoundTypeHash());
+            if (limit != voiceLimits_.End())
+            {
+                i32& count = voiceCounts_[source->GetSoundTypeHash()];
+                if (count < limit->second_)
+                    ++count;
+                else
+                    mixed = false;
+            }
+        }
+
+        source->SetVirtual(!mixed);
+        if (mixed)
+            ++numVoices;
+        else
+            ++numVirtualVoices_;
+    }
+}
+
+void Audio::QueueCommand(AudioCommandType type, StringHash soundType)
+{
+    AudioCommand command;
+    command.type_ = type;
+    command.soundType_ = soundType;
+
+    if (!commands_.Push(command))
+    {
+        // The audio thread is not draining the queue. It only pops commands while holding the mutex, so apply the queued
+        // commands and this one in order under the mutex
+        MutexLock lock(audioMutex_);
+        AudioCommand queued;
+        while (commands_.Pop(queued))
+            ApplyCommand(queued);
+        ApplyCommand(command);
+    }
+}
+
+void Audio::ApplyCommand(const AudioCommand& command)
+{
+    switch (command.type_)
+    {
+    case AUDIO_CMD_PAUSE_SOUND_TYPE:
+        mixPausedSoundTypes_.Insert(command.soundType_);
+        break;
+
+    case AUDIO_CMD_RESUME_SOUND_TYPE:
+        mixPausedSoundTypes_.Erase(command.soundType_);
+        break;
+
+    case AUDIO_CMD_RESUME_ALL:
+        mixPausedSoundTypes_.Clear();
+        break;
+    }
 }
 
 void RegisterAudioLibrary(Context* context)
@@ -4,8 +4,10 @@
 #pragma once
 
 #include "../Audio/AudioDefs.h"
+#include "../Audio/SoundDecoder.h"
 #include "../Container/ArrayPtr.h"
 #include "../Container/HashSet.h"
+#include "../Container/SPSCQueue.h"
 #include "../Core/Mutex.h"
 #include "../Core/Object.h"
 
@@ -17,6 +19,32 @@ class Sound;
 class SoundListener;
 class SoundSource;
 
+/// %Audio command from the main thread to the audio thread. Sound source playback does not go through the queue: Play()
+/// and Stop() replace the sound, stream and position the mixer reads and must be visible to IsPlaying() when they return,
+/// so they lock the audio mutex, and only when the source is already playing. Gain, attenuation and panning are single
+/// floats that the mixer reads once per mix call, so they are written without locking.
+enum AudioCommandType
+{
+    AUDIO_CMD_PAUSE_SOUND_TYPE = 0,
+    AUDIO_CMD_RESUME_SOUND_TYPE,
+    AUDIO_CMD_RESUME_ALL
+};
+
+/// %Audio command with its argument.
+struct AudioCommand
+{
+    /// Command type.
+    AudioCommandType type_;
+    /// Sound type hash.
+    StringHash soundType_;
+};
+
+/// Default maximum number of mixed voices, 0 for no limit.
+static const i32 DEFAULT_MAX_VOICES = 0;
+
+/// Capacity of the audio command queue.
+static const i32 AUDIO_COMMAND_QUEUE_SIZE = 64;
+
 /// %Audio subsystem.
 class URHO3D_API Audio : public Object
 {
@@ -50,6 +78,14 @@ public:
     void SetListener(SoundListener* listener);
     /// Stop any sound source playing a certain sound clip.
     void StopSound(Sound* sound);
+    /// Set maximum number of mixed voices, 0 for no limit. The remaining sound sources are virtualized.
+    /// @property
+    void SetMaxVoices(i32 voices);
+    /// Set maximum number of mixed voices of a specific sound type, 0 for no limit.
+    void SetSoundTypeVoiceLimit(const String& type, i32 voices);
+    /// Set memory budget in bytes for short compressed sounds kept decoded in full, 0 to disable.
+    /// @property
+    void SetDecodeCacheBudget(unsigned bytes);
 
     /// Return byte size of one sample.
     /// @property
@@ -79,6 +115,29 @@ public:
     /// @property
     float GetMasterGain(const String& type) const;
 
+    /// Return maximum number of mixed voices.
+    /// @property
+    i32 GetMaxVoices() const { return maxVoices_; }
+
+    /// Return maximum number of mixed voices of a specific sound type, 0 if not limited.
+    i32 GetSoundTypeVoiceLimit(const String& type) const;
+
+    /// Return number of virtualized sound sources on the last update.
+    /// @property
+    i32 GetNumVirtualVoices() const { return numVirtualVoices_; }
+
+    /// Return memory budget for decoded sounds in bytes.
+    /// @property
+    unsigned GetDecodeCacheBudget() const { return decoder_->GetCacheBudget(); }
+
+    /// Return memory use of decoded sounds in bytes.
+    /// @property
+    unsigned GetDecodeCacheUse() const { return decoder_->GetCacheUse(); }
+
+    /// Return the decoder of compressed sounds.
+    /// @nobind
+    SoundDecoder* GetSoundDecoder() const { return decoder_; }
+
     /// Return whether specific sound type has been paused.
     bool IsSoundTypePaused(const String& type) const;
 
@@ -113,6 +172,12 @@ private:
     void Release();
     /// Actually update sound sources with the specific timestep. Called internally.
     void UpdateInternal(float timeStep);
+    /// Rank the playing sound sources and virtualize the ones beyond the voice limits.
+    void UpdateVoices();
+    /// Queue a command for the audio thread. If the queue is full, apply it under the audio mutex instead.
+    void QueueCommand(AudioCommandType type, StringHash soundType = StringHash());
+    /// Apply a command to the state of the audio thread.
+    void ApplyCommand(const AudioCommand& command);
 
     /// Clipping buffer for mixing.
     SharedArrayPtr<i32> clipBuffer_;
@@ -136,10 +201,26 @@ private:
     HashMap<StringHash, Variant> masterGain_;
     /// Paused sound types.
     HashSet<StringHash> pausedSoundTypes_;
+    /// Paused sound types as seen by the audio thread.
+    HashSet<StringHash> mixPausedSoundTypes_;
+    /// Commands from the main thread to the audio thread.
+    SPSCQueue<AudioCommand, AUDIO_COMMAND_QUEUE_SIZE> commands_;
     /// Sound sources.
     Vector<SoundSource*> soundSources_;
+    /// Playing sound sources ranked by importance.
+    Vector<SoundSource*> voiceRanking_;
+    /// Voice limits by sound type.
+    HashMap<StringHash, i32> voiceLimits_;
+    /// Mixed voice counts by sound type during ranking.
+    HashMap<StringHash, i32> voiceCounts_;
+    /// Maximum number of mixed voices.
+    i32 maxVoices_{DEFAULT_MAX_VOICES};
+    /// Number of virtualized sound sources.
+    i32 numVirtualVoices_{};
     /// Sound listener.
     WeakPtr<SoundListener> listener_;
+    /// Decoder of compressed sounds.
+    SharedPtr<SoundDecoder> decoder_;
 };
 
 /// Register Audio library objects.
@@ -0,0 +1,63 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../Precompiled.h"
+
+#include "../Audio/DecodedSoundStream.h"
+#include "../Audio/Sound.h"
+
+#include <cstring>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+DecodedSoundStream::DecodedSoundStream(const Sound* sound, const SharedArrayPtr<signed char>& data, unsigned dataSize) :
+    data_(data),
+    dataSize_(dataSize),
+    position_(0)
+{
+    assert(sound);
+
+    SetFormat(sound->GetIntFrequency(), sound->IsSixteenBit(), sound->IsStereo());
+    // If the sound is looped, the stream will automatically rewind at end
+    SetStopAtEnd(!sound->IsLooped());
+}
+
+DecodedSoundStream::~DecodedSoundStream() = default;
+
+bool DecodedSoundStream::Seek(unsigned sample_number)
+{
+    unsigned position = sample_number * GetSampleSize();
+    if (position > dataSize_)
+        return false;
+
+    position_ = position;
+    return true;
+}
+
+unsigned DecodedSoundStream::GetData(signed char* dest, unsigned numBytes)
+{
+    unsigned outBytes = 0;
+
+    while (outBytes < numBytes)
+    {
+        // Rewind if is looping and at end
+        if (position_ >= dataSize_)
+        {
+            if (stopAtEnd_ || !dataSize_)
+                break;
+            position_ = 0;
+        }
+
+        unsigned copyBytes = Min(numBytes - outBytes, dataSize_ - position_);
+        memcpy(dest + outBytes, data_.Get() + position_, copyBytes);
+        position_ += copyBytes;
+        outBytes += copyBytes;
+    }
+
+    return outBytes;
+}
+
+}
@@ -0,0 +1,38 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../Audio/SoundStream.h"
+#include "../Container/ArrayPtr.h"
+
+namespace Urho3D
+{
+
+class Sound;
+
+/// %Sound stream that plays a compressed sound from its data decoded in full by the sound decoder.
+/// @nobind
+class URHO3D_API DecodedSoundStream : public SoundStream
+{
+public:
+    /// Construct from a compressed sound and its decoded data.
+    DecodedSoundStream(const Sound* sound, const SharedArrayPtr<signed char>& data, unsigned dataSize);
+    /// Destruct.
+    ~DecodedSoundStream() override;
+
+    /// Seek to sample number. Return true on success. Call with the audio mutex held.
+    bool Seek(unsigned sample_number) override;
+    /// Produce sound data into destination. Return number of bytes produced. Called by SoundSource from the mixing thread.
+    unsigned GetData(signed char* dest, unsigned numBytes) override;
+
+private:
+    /// Decoded sound data.
+    SharedArrayPtr<signed char> data_;
+    /// Decoded sound data size in bytes.
+    unsigned dataSize_;
+    /// Byte position.
+    unsigned position_;
+};
+
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../Precompiled.h"
+
+#include "../Audio/PrefetchSoundStream.h"
+#include "../Core/Condition.h"
+
+#include <cstring>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+PrefetchSoundStream::PrefetchSoundStream(SoundStream* source, unsigned bufferLengthMSec, Condition* dataNeeded) :
+    source_(source),
+    dataNeeded_(dataNeeded)
+{
+    assert(source);
+
+    SetFormat(source->GetIntFrequency(), source->IsSixteenBit(), source->IsStereo());
+    SetStopAtEnd(source->GetStopAtEnd());
+
+    unsigned sampleSize = GetSampleSize();
+    bufferSize_ = Max(frequency_ * bufferLengthMSec / 1000, 1u) * sampleSize;
+    buffer_ = new signed char[bufferSize_];
+}
+
+PrefetchSoundStream::~PrefetchSoundStream() = default;
+
+bool PrefetchSoundStream::Seek(unsigned sample_number)
+{
+    MutexLock lock(sourceMutex_);
+
+    if (!source_->Seek(sample_number))
+        return false;
+
+    // The mixing thread is not running, so the buffered data can be discarded directly. Leave decoding to the decoder
+    // thread, as the audio mutex is held
+    readPosition_.store(writePosition_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    finished_.store(false, std::memory_order_relaxed);
+    if (dataNeeded_)
+        dataNeeded_->Set();
+    else
+        FillLocked();
+    return true;
+}
+
+unsigned PrefetchSoundStream::GetData(signed char* dest, unsigned numBytes)
+{
+    const unsigned read = readPosition_.load(std::memory_order_relaxed);
+    const unsigned available = Distance(read, writePosition_.load(std::memory_order_acquire));
+    const unsigned outBytes = Min(numBytes, available);
+
+    // Copy in up to two parts, as the data may wrap around the end of the buffer
+    const unsigned offset = read % bufferSize_;
+    const unsigned firstBytes = Min(outBytes, bufferSize_ - offset);
+    memcpy(dest, buffer_.Get() + offset, firstBytes);
+    if (outBytes > firstBytes)
+        memcpy(dest + firstBytes, buffer_.Get(), outBytes - firstBytes);
+
+    readPosition_.store(Advance(read, outBytes), std::memory_order_release);
+
+    // Wake up the decoder thread when half of the buffer has been played
+    if (dataNeeded_ && available - outBytes < bufferSize_ / 2 && !finished_.load(std::memory_order_relaxed))
+        dataNeeded_->Set();
+
+    // If the decoder fell behind, output silence instead of stopping playback
+    if (outBytes < numBytes && !finished_.load(std::memory_order_acquire))
+    {
+        memset(dest + outBytes, 0, numBytes - outBytes);
+        return numBytes;
+    }
+
+    return outBytes;
+}
+
+unsigned PrefetchSoundStream::Fill()
+{
+    MutexLock lock(sourceMutex_);
+
+    return FillLocked();
+}
+
+unsigned PrefetchSoundStream::GetBufferNumBytes() const
+{
+    return Distance(readPosition_.load(std::memory_order_acquire), writePosition_.load(std::memory_order_acquire));
+}
+
+unsigned PrefetchSoundStream::Advance(unsigned position, unsigned numBytes) const
+{
+    position += numBytes;
+    return position < bufferSize_ * 2 ? position : position - bufferSize_ * 2;
+}
+
+unsigned PrefetchSoundStream::Distance(unsigned from, unsigned to) const
+{
+    return to >= from ? to - from : to + bufferSize_ * 2 - from;
+}
+
+unsigned PrefetchSoundStream::FillLocked()
+{
+    unsigned totalBytes = 0;
+
+    while (!finished_.load(std::memory_order_relaxed))
+    {
+        const unsigned write = writePosition_.load(std::memory_order_relaxed);
+        const unsigned freeBytes = bufferSize_ - Distance(readPosition_.load(std::memory_order_acquire), write);
+        const unsigned offset = write % bufferSize_;
+        // Decode up to the end of the buffer, then continue from the start
+        const unsigned numBytes = Min(freeBytes, bufferSize_ - offset);
+        if (!numBytes)
+            break;
+
+        const unsigned outBytes = source_->GetData(buffer_.Get() + offset, numBytes);
+        if (!outBytes)
+        {
+            if (source_->GetStopAtEnd())
+                finished_.store(true, std::memory_order_release);
+            break;
+        }
+
+        writePosition_.store(Advance(write, outBytes), std::memory_order_release);
+        totalBytes += outBytes;
+
+        if (outBytes < numBytes)
+            break;
+    }
+
+    return totalBytes;
+}
+
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../Audio/SoundStream.h"
+#include "../Container/ArrayPtr.h"
+#include "../Container/Ptr.h"
+#include "../Core/Mutex.h"
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+class Condition;
+
+/// %Sound stream that plays data decoded ahead from another stream by the sound decoder thread, so that the mixing thread
+/// only copies data. Outputs silence if the decoder falls behind.
+/// @nobind
+class URHO3D_API PrefetchSoundStream : public SoundStream
+{
+public:
+    /// Construct with the stream to decode from, the length of the decode buffer in milliseconds and the condition to set
+    /// when the buffer runs low. The condition must outlive mixing of the stream.
+    PrefetchSoundStream(SoundStream* source, unsigned bufferLengthMSec, Condition* dataNeeded = nullptr);
+    /// Destruct.
+    ~PrefetchSoundStream() override;
+
+    /// Seek to sample number and discard the decoded data. The decoder thread decodes ahead from there. Return true on success. Call with the audio mutex held.
+    bool Seek(unsigned sample_number) override;
+    /// Produce sound data into destination. Return number of bytes produced. Called by SoundSource from the mixing thread.
+    unsigned GetData(signed char* dest, unsigned numBytes) override;
+
+    /// Decode from the source stream into the free buffer space. Called by the sound decoder thread. Return number of bytes decoded.
+    unsigned Fill();
+
+    /// Return the source stream.
+    SoundStream* GetSource() const { return source_; }
+
+    /// Return amount of decoded (unplayed) sound data in bytes.
+    unsigned GetBufferNumBytes() const;
+
+private:
+    /// Decode into the free buffer space. Called with the source mutex held.
+    unsigned FillLocked();
+    /// Return position advanced by a number of bytes.
+    unsigned Advance(unsigned position, unsigned numBytes) const;
+    /// Return number of bytes between two positions.
+    unsigned Distance(unsigned from, unsigned to) const;
+
+    /// Source stream.
+    SharedPtr<SoundStream> source_;
+    /// Decode buffer.
+    SharedArrayPtr<signed char> buffer_;
+    /// Decode buffer size in bytes, a multiple of the sample size.
+    unsigned bufferSize_;
+    /// Condition to set when the buffer runs low.
+    Condition* dataNeeded_;
+    /// Read position of the mixing thread. Positions run over twice the buffer size to tell a full buffer from an empty one.
+    std::atomic<unsigned> readPosition_{};
+    /// Write position of the decoder thread.
+    std::atomic<unsigned> writePosition_{};
+    /// Source stream has ended flag.
+    std::atomic<bool> finished_{};
+    /// Mutex for the source stream.
+    Mutex sourceMutex_;
+};
+
+}
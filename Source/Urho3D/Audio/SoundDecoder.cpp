@@ -0,0 +1,259 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../Precompiled.h"
+
+#include "../Audio/DecodedSoundStream.h"
+#include "../Audio/PrefetchSoundStream.h"
+#include "../Audio/Sound.h"
+#include "../Audio/SoundDecoder.h"
+#include "../Core/Profiler.h"
+
+#include <cstring>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Bytes to decode at a time when decoding a sound in full.
+static const unsigned DECODE_CHUNK_SIZE = 64 * 1024;
+
+SoundDecoder::SoundDecoder() :
+    cacheBudget_(DEFAULT_DECODE_CACHE_BUDGET),
+    cacheUse_(0),
+    useCounter_(0)
+{
+}
+
+SoundDecoder::~SoundDecoder()
+{
+    // Wake up the thread so that it sees the running flag cleared
+    shouldRun_ = false;
+    dataNeeded_.Set();
+    Stop();
+}
+
+void SoundDecoder::ThreadFunction()
+{
+    URHO3D_PROFILE_THREAD("SoundDecoder Thread");
+
+    while (shouldRun_)
+    {
+        if (!DecodeNext())
+            dataNeeded_.Wait();
+    }
+}
+
+SharedPtr<SoundStream> SoundDecoder::GetStream(Sound* sound)
+{
+    if (!sound || !sound->IsCompressed())
+        return SharedPtr<SoundStream>();
+
+    HashMap<Sound*, DecodedSound>::Iterator i = cache_.Find(sound);
+    if (i != cache_.End())
+    {
+        if (i->second_.source_ == sound->GetData())
+        {
+            i->second_.lastUse_ = ++useCounter_;
+            return SharedPtr<SoundStream>(new DecodedSoundStream(sound, i->second_.data_, i->second_.dataSize_));
+        }
+
+        // The sound has been reloaded since it was decoded
+        cacheUse_ -= i->second_.dataSize_;
+        cache_.Erase(i);
+    }
+
+    if (IsCacheable(sound))
+    {
+        MutexLock lock(decoderMutex_);
+
+        bool queued = false;
+        for (const SoundDecodeItem& item : decodeQueue_)
+        {
+            if (item.sound_ == sound)
+            {
+                queued = true;
+                break;
+            }
+        }
+
+        if (!queued)
+        {
+            SoundDecodeItem item;
+            item.sound_ = sound;
+            item.stream_ = sound->GetDecoderStream();
+            item.stream_->SetStopAtEnd(true);
+            item.decoded_.source_ = sound->GetData();
+            decodeQueue_.Push(item);
+            dataNeeded_.Set();
+        }
+    }
+
+    SharedPtr<SoundStream> stream = sound->GetDecoderStream();
+
+    // Without a decoder thread the stream is decoded by the mixing thread
+    if (!IsStarted() && !Run())
+        return stream;
+
+    SharedPtr<PrefetchSoundStream> prefetchStream(new PrefetchSoundStream(stream, PREFETCH_BUFFER_LENGTH, &dataNeeded_));
+    // Decode the start right away so that playback does not begin with silence
+    prefetchStream->Fill();
+
+    MutexLock lock(decoderMutex_);
+    streams_.Push(prefetchStream);
+    return SharedPtr<SoundStream>(prefetchStream);
+}
+
+void SoundDecoder::Update()
+{
+    // Without a decoder thread, decode the queued sounds here
+    if (!IsStarted())
+        DecodeNext();
+
+    MutexLock lock(decoderMutex_);
+
+    // Release the streams that are no longer referenced by sound sources. Wait for a later update if the decoder thread
+    // is filling them
+    if (!filling_)
+    {
+        for (Vector<SharedPtr<PrefetchSoundStream>>::Iterator i = streams_.Begin(); i != streams_.End();)
+        {
+            if (i->Refs() == 1)
+                i = streams_.Erase(i);
+            else
+                ++i;
+        }
+    }
+
+    for (Vector<SoundDecodeItem>::Iterator i = decodeQueue_.Begin(); i != decodeQueue_.End();)
+    {
+        if (!i->finished_)
+        {
+            ++i;
+            continue;
+        }
+
+        const unsigned dataSize = i->decoded_.dataSize_;
+        if (dataSize && dataSize <= cacheBudget_)
+        {
+            HashMap<Sound*, DecodedSound>::Iterator j = cache_.Find(i->sound_);
+            if (j != cache_.End())
+            {
+                cacheUse_ -= j->second_.dataSize_;
+                cache_.Erase(j);
+            }
+
+            Evict(dataSize);
+            i->decoded_.lastUse_ = ++useCounter_;
+            cache_[i->sound_] = i->decoded_;
+            cacheUse_ += dataSize;
+        }
+
+        i = decodeQueue_.Erase(i);
+    }
+}
+
+void SoundDecoder::SetCacheBudget(unsigned bytes)
+{
+    cacheBudget_ = bytes;
+    Evict(0);
+}
+
+bool SoundDecoder::DecodeNext()
+{
+    bool decoded = false;
+
+    SoundStream* stream = nullptr;
+
+    {
+        MutexLock lock(decoderMutex_);
+
+        fillStreams_.Clear();
+        for (const SharedPtr<PrefetchSoundStream>& prefetchStream : streams_)
+            fillStreams_.Push(prefetchStream.Get());
+        filling_ = true;
+
+        for (const SoundDecodeItem& item : decodeQueue_)
+        {
+            if (!item.finished_)
+            {
+                stream = item.stream_.Get();
+                break;
+            }
+        }
+    }
+
+    // Keep the playing streams ahead of the mixing thread first. Fill without holding the mutex, so that starting playback
+    // on the main thread does not wait for decoding
+    for (PrefetchSoundStream* prefetchStream : fillStreams_)
+    {
+        if (prefetchStream->Fill())
+            decoded = true;
+    }
+
+    {
+        MutexLock lock(decoderMutex_);
+        filling_ = false;
+    }
+
+    if (!stream)
+        return decoded;
+
+    // Decode without holding the mutex. The stream is released by the main thread only after the item is finished
+    Vector<signed char> buffer;
+    unsigned dataSize = 0;
+    for (;;)
+    {
+        buffer.Resize(dataSize + DECODE_CHUNK_SIZE);
+        unsigned outBytes = stream->GetData(buffer.Buffer() + dataSize, DECODE_CHUNK_SIZE);
+        if (!outBytes)
+            break;
+        dataSize += outBytes;
+    }
+
+    MutexLock lock(decoderMutex_);
+
+    for (SoundDecodeItem& item : decodeQueue_)
+    {
+        if (item.stream_.Get() == stream)
+        {
+            if (dataSize)
+            {
+                item.decoded_.data_ = new signed char[dataSize];
+                memcpy(item.decoded_.data_.Get(), buffer.Buffer(), dataSize);
+                item.decoded_.dataSize_ = dataSize;
+            }
+            item.finished_ = true;
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool SoundDecoder::IsCacheable(Sound* sound) const
+{
+    if (!cacheBudget_ || sound->GetLength() > MAX_CACHED_SOUND_LENGTH)
+        return false;
+
+    return (unsigned)(sound->GetLength() * sound->GetFrequency()) * sound->GetSampleSize() <= cacheBudget_;
+}
+
+void SoundDecoder::Evict(unsigned bytes)
+{
+    while (!cache_.Empty() && cacheUse_ + bytes > cacheBudget_)
+    {
+        HashMap<Sound*, DecodedSound>::Iterator oldest = cache_.Begin();
+        for (HashMap<Sound*, DecodedSound>::Iterator i = cache_.Begin(); i != cache_.End(); ++i)
+        {
+            if (i->second_.lastUse_ < oldest->second_.lastUse_)
+                oldest = i;
+        }
+
+        cacheUse_ -= oldest->second_.dataSize_;
+        cache_.Erase(oldest);
+    }
+}
+
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../Container/ArrayPtr.h"
+#include "../Container/HashMap.h"
+#include "../Container/Ptr.h"
+#include "../Container/RefCounted.h"
+#include "../Container/Vector.h"
+#include "../Core/Condition.h"
+#include "../Core/Mutex.h"
+#include "../Core/Thread.h"
+
+namespace Urho3D
+{
+
+class PrefetchSoundStream;
+class Sound;
+class SoundStream;
+
+/// Length of the decode buffer of streamed sounds in milliseconds.
+static const unsigned PREFETCH_BUFFER_LENGTH = 500;
+/// Maximum length of sounds that are decoded into the decoded sound cache, in seconds.
+static const float MAX_CACHED_SOUND_LENGTH = 5.0f;
+/// Default memory budget of the decoded sound cache in bytes.
+static const unsigned DEFAULT_DECODE_CACHE_BUDGET = 8 * 1024 * 1024;
+
+/// Compressed sound decoded in full.
+struct DecodedSound
+{
+    /// Compressed data it was decoded from. Detects reloading of the sound.
+    SharedArrayPtr<signed char> source_;
+    /// Decoded data.
+    SharedArrayPtr<signed char> data_;
+    /// Decoded data size in bytes.
+    unsigned dataSize_{};
+    /// Use counter value on last use.
+    unsigned lastUse_{};
+};
+
+/// Queue item for decoding a compressed sound in full.
+struct SoundDecodeItem
+{
+    /// Sound. Used only as the cache key.
+    Sound* sound_{};
+    /// Decoder stream. Only referenced from the main thread.
+    SharedPtr<SoundStream> stream_;
+    /// Result.
+    DecodedSound decoded_;
+    /// Finished flag.
+    bool finished_{};
+};
+
+/// Decoder of compressed sounds. Owned by Audio. Decodes the streams of playing sounds ahead of the mixing thread on its
+/// own thread, and decodes short sounds in full into a least recently used cache with a memory budget, so that the mixing
+/// thread does not run codecs. The thread sleeps until a stream runs low or a sound is queued. Reference counts are only
+/// touched from the main thread.
+/// @nobind
+class URHO3D_API SoundDecoder : public RefCounted, public Thread
+{
+public:
+    /// Construct. Does not start the thread yet.
+    SoundDecoder();
+    /// Destruct. Stop the thread.
+    ~SoundDecoder() override;
+
+    /// Decoding loop.
+    void ThreadFunction() override;
+
+    /// Return a stream for playing a compressed sound. Plays from the cache if decoded already, otherwise decodes ahead on
+    /// the decoder thread. Queues short sounds for decoding into the cache. Decodes the start of the stream right away, so
+    /// call without the audio mutex held.
+    SharedPtr<SoundStream> GetStream(Sound* sound);
+    /// Move decoded sounds into the cache and release the streams that have stopped playing. Called from the main thread.
+    void Update();
+    /// Set memory budget of the decoded sound cache in bytes. 0 disables the cache.
+    void SetCacheBudget(unsigned bytes);
+
+    /// Return memory budget of the decoded sound cache in bytes.
+    unsigned GetCacheBudget() const { return cacheBudget_; }
+
+    /// Return memory use of the decoded sound cache in bytes.
+    unsigned GetCacheUse() const { return cacheUse_; }
+
+    /// Return number of sounds in the decoded sound cache.
+    i32 GetNumCachedSounds() const { return cache_.Size(); }
+
+private:
+    /// Decode the streams ahead and the next queued sound in full. Return true if decoded anything.
+    bool DecodeNext();
+    /// Return true if the sound should be decoded into the cache.
+    bool IsCacheable(Sound* sound) const;
+    /// Evict least recently used sounds until the cache has room for a number of bytes.
+    void Evict(unsigned bytes);
+
+    /// Mutex for the streams, the filling flag and the decode queue.
+    Mutex decoderMutex_;
+    /// Condition set when a stream runs low or a sound is queued.
+    Condition dataNeeded_;
+    /// Streams to decode ahead.
+    Vector<SharedPtr<PrefetchSoundStream>> streams_;
+    /// Streams being filled by the decoder thread without the mutex held. Only accessed by the decoding thread.
+    Vector<PrefetchSoundStream*> fillStreams_;
+    /// Streams are being filled flag. The main thread does not release streams meanwhile.
+    bool filling_{};
+    /// Sounds to decode in full.
+    Vector<SoundDecodeItem> decodeQueue_;
+    /// Decoded sounds.
+    HashMap<Sound*, DecodedSound> cache_;
+    /// Memory budget of the decoded sound cache.
+    unsigned cacheBudget_;
+    /// Memory use of the decoded sound cache.
+    unsigned cacheUse_;
+    /// Use counter for least recently used eviction.
+    unsigned useCounter_;
+};
+
+}
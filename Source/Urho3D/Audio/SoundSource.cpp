@@ -14,6 +14,10 @@
 #include "../Scene/Node.h"
 #include "../Scene/ReplicationState.h"
 
+#ifdef URHO3D_SSE
+#include <emmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -75,6 +79,60 @@ namespace Urho3D
 
 #define GET_IP_SAMPLE_RIGHT() (((((int)pos[3] - (int)pos[1]) * fractPos) / 65536) + (int)pos[1])
 
+#ifdef URHO3D_SSE
+/// Divide 32-bit products by 256, rounding toward zero like the scalar mixing routines.
+static inline __m128i DivideBy256(__m128i value)
+{
+    __m128i bias = _mm_and_si128(_mm_srai_epi32(value, 31), _mm_set1_epi32(255));
+    return _mm_srai_epi32(_mm_add_epi32(value, bias), 8);
+}
+
+/// Multiply eight 16-bit samples by 16-bit volumes and add the 32-bit results to a buffer.
+static inline void MixProducts(int* dest, __m128i samples, __m128i volume)
+{
+    __m128i low = _mm_mullo_epi16(samples, volume);
+    __m128i high = _mm_mulhi_epi16(samples, volume);
+    auto* out = reinterpret_cast<__m128i*>(dest);
+    _mm_storeu_si128(out, _mm_add_epi32(_mm_loadu_si128(out), DivideBy256(_mm_unpacklo_epi16(low, high))));
+    _mm_storeu_si128(out + 1, _mm_add_epi32(_mm_loadu_si128(out + 1), DivideBy256(_mm_unpackhi_epi16(low, high))));
+}
+#endif
+
+/// Mix 16-bit samples into a buffer with the same layout.
+static void MixSamples16(int* dest, const short* src, unsigned count, int vol)
+{
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    const __m128i volume = _mm_set1_epi16((short)vol);
+    for (; i + 8 <= count; i += 8)
+        MixProducts(dest + i, _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), volume);
+#endif
+    for (; i < count; ++i)
+        dest[i] += (src[i] * vol) / 256;
+}
+
+/// Mix 16-bit mono samples into a stereo buffer.
+static void MixMonoToStereo16(int* dest, const short* src, unsigned count, int leftVol, int rightVol)
+{
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    const __m128i volume = _mm_set_epi16((short)rightVol, (short)leftVol, (short)rightVol, (short)leftVol, (short)rightVol,
+        (short)leftVol, (short)rightVol, (short)leftVol);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        // Duplicate each sample for the left and right channel
+        MixProducts(dest + i * 2, _mm_unpacklo_epi16(samples, samples), volume);
+        MixProducts(dest + i * 2 + 8, _mm_unpackhi_epi16(samples, samples), volume);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        dest[i * 2] += (src[i] * leftVol) / 256;
+        dest[i * 2 + 1] += (src[i] * rightVol) / 256;
+    }
+}
+
 static const int STREAM_SAFETY_SAMPLES = 4;
 
 extern const char* AUDIO_CATEGORY;
@@ -123,6 +181,7 @@ void SoundSource::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Is Playing", IsPlaying, SetPlayingAttr, false, AM_DEFAULT);
     URHO3D_ENUM_ATTRIBUTE("Autoremove Mode", autoRemove_, autoRemoveModeNames, REMOVE_DISABLED, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Play Position", GetPositionAttr, SetPositionAttr, 0, AM_FILE);
+    URHO3D_ATTRIBUTE("Priority", priority_, 0, AM_DEFAULT);
 }
 
 void SoundSource::Seek(float seekTime)
@@ -141,7 +200,8 @@ void SoundSource::Seek(float seekTime)
     }
     else
     {
-        // Ogg format
+        // Ogg format. The stream must not be mixed while seeking
+        MutexLock lock(audio_->GetMutex());
         if (soundStream_->Seek((unsigned)(seekTime * soundStream_->GetFrequency())))
         {
             timePosition_ = seekTime;
@@ -158,14 +218,19 @@ void SoundSource::Play(Sound* sound)
     if (frequency_ == 0.0f && sound)
         SetFrequency(sound->GetFrequency());
 
+    // Get the stream of a compressed sound before locking the audio mutex, as the decoder decodes its start right away
+    SharedPtr<SoundStream> decoderStream;
+    if (sound && sound->IsCompressed())
+        decoderStream = audio_->GetSoundDecoder()->GetStream(sound);
+
     // If sound source is currently playing, have to lock the audio mutex
     if (position_)
     {
         MutexLock lock(audio_->GetMutex());
-        PlayLockless(sound);
+        PlayLockless(sound, decoderStream);
     }
     else
-        PlayLockless(sound);
+        PlayLockless(sound, decoderStream);
 
     // Forget the Sound & Is Playing attribute previous values so that they will be sent again, triggering
     // the sound correctly on network clients even after the initial playback
@@ -286,6 +351,12 @@ void SoundSource::SetPanning(float panning)
     MarkNetworkUpdate();
 }
 
+void SoundSource::SetPriority(i32 priority)
+{
+    priority_ = priority;
+    MarkNetworkUpdate();
+}
+
 void SoundSource::SetAutoRemoveMode(AutoRemoveMode mode)
 {
     autoRemove_ = mode;
@@ -382,39 +453,45 @@ void SoundSource::Mix(int* dest, unsigned samples, int mixRate, bool stereo, boo
     if (!sound)
         return;
 
-    // Choose the correct mixing routine
-    if (!sound->IsStereo())
-    {
-        if (interpolation)
-        {
-            if (stereo)
-                MixMonoToStereoIP(sound, dest, samples, mixRate);
-            else
-                MixMonoToMonoIP(sound, dest, samples, mixRate);
-        }
-        else
-        {
-            if (stereo)
-                MixMonoToStereo(sound, dest, samples, mixRate);
-            else
-                MixMonoToMono(sound, dest, samples, mixRate);
-        }
-    }
-    else
+    // Choose the correct mixing routine. Without resampling, 16-bit data is mixed with vectorized kernels. A virtualized
+    // source only advances, so that it resumes at the right position when it becomes audible again
+    if (IsVirtual())
+        MixZeroVolume(sound, samples, mixRate);
+    else if (!MixUnitRate(sound, dest, samples, mixRate, stereo))
     {
-        if (interpolation)
+        if (!sound->IsStereo())
         {
-            if (stereo)
-                MixStereoToStereoIP(sound, dest, samples, mixRate);
+            if (interpolation)
+            {
+                if (stereo)
+                    MixMonoToStereoIP(sound, dest, samples, mixRate);
+                else
+                    MixMonoToMonoIP(sound, dest, samples, mixRate);
+            }
             else
-                MixStereoToMonoIP(sound, dest, samples, mixRate);
+            {
+                if (stereo)
+                    MixMonoToStereo(sound, dest, samples, mixRate);
+                else
+                    MixMonoToMono(sound, dest, samples, mixRate);
+            }
         }
         else
         {
-            if (stereo)
-                MixStereoToStereo(sound, dest, samples, mixRate);
+            if (interpolation)
+            {
+                if (stereo)
+                    MixStereoToStereoIP(sound, dest, samples, mixRate);
+                else
+                    MixStereoToMonoIP(sound, dest, samples, mixRate);
+            }
             else
-                MixStereoToMono(sound, dest, samples, mixRate);
+            {
+                if (stereo)
+                    MixStereoToStereo(sound, dest, samples, mixRate);
+                else
+                    MixStereoToMono(sound, dest, samples, mixRate);
+            }
         }
     }
 
@@ -489,10 +566,11 @@ int SoundSource::GetPositionAttr() const
         return 0;
 }
 
-void SoundSource::PlayLockless(Sound* sound)
+void SoundSource::PlayLockless(Sound* sound, const SharedPtr<SoundStream>& decoderStream)
 {
-    // Reset the time position in any case
+    // Reset the time position in any case. Audio decides again whether the new playback is virtualized
     timePosition_ = 0.0f;
+    SetVirtual(false);
 
     if (sound)
     {
@@ -514,8 +592,8 @@ void SoundSource::PlayLockless(Sound* sound)
         }
         else
         {
-            // Compressed sound start
-            PlayLockless(sound->GetDecoderStream());
+            // Compressed sound start. The decoder plays it decoded ahead or from its cache of decoded sounds
+            PlayLockless(decoderStream);
             sound_ = sound;
             return;
         }
@@ -528,8 +606,9 @@ void SoundSource::PlayLockless(Sound* sound)
 
 void SoundSource::PlayLockless(const SharedPtr<SoundStream>& stream)
 {
-    // Reset the time position in any case
+    // Reset the time position in any case. Audio decides again whether the new playback is virtualized
     timePosition_ = 0.0f;
+    SetVirtual(false);
 
     if (stream)
     {
@@ -558,6 +637,7 @@ void SoundSource::StopLockless()
 {
     position_ = nullptr;
     timePosition_ = 0.0f;
+    SetVirtual(false);
 
     // Free the sound stream and decode buffer if a stream was playing
     soundStream_.Reset();
@@ -583,6 +663,63 @@ void SoundSource::SetPlayPositionLockless(signed char* pos)
     timePosition_ = ((float)(int)(size_t)(pos - sound_->GetStart())) / (sound_->GetSampleSize() * sound_->GetFrequency());
 }
 
+bool SoundSource::MixUnitRate(Sound* sound, int* dest, unsigned samples, int mixRate, bool stereo)
+{
+    // Interpolation has no effect without a fractional position, so it does not need to be checked
+    if (!sound->IsSixteenBit() || fractPosition_ || (sound->IsStereo() && !stereo))
+        return false;
+
+    float add = frequency_ / (float)mixRate;
+    if ((int)add != 1 || (int)((add - floorf(add)) * 65536.0f))
+        return false;
+
+    float totalGain = masterGain_ * attenuation_ * gain_;
+    int leftVol, rightVol;
+    if (stereo && !sound->IsStereo())
+    {
+        leftVol = (int)((-panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
+        rightVol = (int)((panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
+    }
+    else
+        leftVol = rightVol = RoundToInt(256.0f * totalGain);
+
+    // Leave silence and volumes which do not fit the 16-bit multiplies to the regular routines
+    if ((!leftVol && !rightVol) || Max(leftVol, rightVol) > 32767)
+        return false;
+
+    const int channels = sound->IsStereo() ? 2 : 1;
+    auto* pos = (short*)position_;
+    auto* end = (short*)sound->GetEnd();
+    auto* repeat = (short*)sound->GetRepeat();
+
+    while (samples)
+    {
+        auto count = Min(samples, (unsigned)((end - pos) / channels));
+        if (stereo && channels == 1)
+            MixMonoToStereo16(dest, pos, count, leftVol, rightVol);
+        else
+            MixSamples16(dest, pos, count * channels, leftVol);
+
+        dest += stereo ? count * 2 : count;
+        pos += count * channels;
+        samples -= count;
+
+        if (pos + channels > end)
+        {
+            if (!sound->IsLooped())
+            {
+                pos = nullptr;
+                break;
+            }
+            while (pos + channels > end)
+                pos -= (end - repeat);
+        }
+    }
+
+    position_ = (signed char*)pos;
+    return true;
+}
+
 void SoundSource::MixMonoToMono(Sound* sound, int* dest, unsigned samples, int mixRate)
 {
     float totalGain = masterGain_ * attenuation_ * gain_;
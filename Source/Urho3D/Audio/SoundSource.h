@@ -6,6 +6,8 @@
 #include "../Audio/AudioDefs.h"
 #include "../Scene/Component.h"
 
+#include <atomic>
+
 namespace Urho3D
 {
 
@@ -58,6 +60,9 @@ public:
     /// Set stereo panning. -1.0 is full left and 1.0 is full right.
     /// @property
     void SetPanning(float panning);
+    /// Set voice priority. When there are more sound sources playing than voices, higher priority sources are mixed first, then louder ones.
+    /// @property
+    void SetPriority(i32 priority);
     /// Set to remove either the sound source component or its owner node from the scene automatically on sound playback completion. Disabled by default.
     /// @property
     void SetAutoRemoveMode(AutoRemoveMode mode);
@@ -75,6 +80,9 @@ public:
     /// @property
     String GetSoundType() const { return soundType_; }
 
+    /// Return sound type hash.
+    StringHash GetSoundTypeHash() const { return soundTypeHash_; }
+
     /// Return playback time position.
     /// @property
     float GetTimePosition() const { return timePosition_; }
@@ -95,6 +103,17 @@ public:
     /// @property
     float GetPanning() const { return panning_; }
 
+    /// Return voice priority.
+    /// @property
+    i32 GetPriority() const { return priority_; }
+
+    /// Return effective gain, which determines how audible the sound source is.
+    float GetAudibility() const { return masterGain_ * attenuation_ * gain_; }
+
+    /// Return whether playback is virtualized, which advances the play position without mixing.
+    /// @property
+    bool IsVirtual() const { return virtual_.load(std::memory_order_relaxed); }
+
     /// Return automatic removal mode on sound playback completion.
     /// @property
     AutoRemoveMode GetAutoRemoveMode() const { return autoRemove_; }
@@ -109,6 +128,8 @@ public:
     void Mix(int* dest, unsigned samples, int mixRate, bool stereo, bool interpolation);
     /// Update the effective master gain. Called internally and by Audio when the master gain changes.
     void UpdateMasterGain();
+    /// Set whether playback is virtualized. Called by Audio.
+    void SetVirtual(bool enable) { virtual_.store(enable, std::memory_order_relaxed); }
 
     /// Set sound attribute.
     void SetSoundAttr(const ResourceRef& value);
@@ -142,16 +163,20 @@ protected:
     bool sendFinishedEvent_;
     /// Automatic removal mode.
     AutoRemoveMode autoRemove_;
+    /// Voice priority.
+    i32 priority_{};
 
 private:
-    /// Play a sound without locking the audio mutex. Called internally.
-    void PlayLockless(Sound* sound);
+    /// Play a sound without locking the audio mutex, with the decoder stream of a compressed sound. Called internally.
+    void PlayLockless(Sound* sound, const SharedPtr<SoundStream>& decoderStream);
     /// Play a sound stream without locking the audio mutex. Called internally.
     void PlayLockless(const SharedPtr<SoundStream>& stream);
     /// Stop sound without locking the audio mutex. Called internally.
     void StopLockless();
     /// Set new playback position without locking the audio mutex. Called internally.
     void SetPlayPositionLockless(signed char* pos);
+    /// Mix 16-bit samples with vectorized kernels when they need no resampling. Return false if not applicable.
+    bool MixUnitRate(Sound* sound, int* dest, unsigned samples, int mixRate, bool stereo);
     /// Mix mono sample to mono buffer.
     void MixMonoToMono(Sound* sound, int* dest, unsigned samples, int mixRate);
     /// Mix mono sample to stereo buffer.
@@ -187,6 +212,8 @@ private:
     SharedPtr<Sound> streamBuffer_;
     /// Unused stream bytes from previous frame.
     int unusedStreamSize_;
+    /// Virtualized playback flag.
+    std::atomic<bool> virtual_{};
 };
 
 }
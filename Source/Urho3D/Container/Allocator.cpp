@@ -3,6 +3,10 @@
 
 #include "../Precompiled.h"
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -101,4 +105,180 @@ void AllocatorFree(AllocatorBlock* allocator, void* ptr)
     allocator->free_ = node;
 }
 
+/// Free slot of the size-class pool.
+struct PoolNode
+{
+    /// Next free slot.
+    PoolNode* next_;
+};
+
+/// Memory chunk of the pool. The slots follow the header.
+struct alignas(16) PoolChunk
+{
+    /// Next chunk of the same size class.
+    PoolChunk* next_;
+};
+
+/// Size class of the pool.
+struct PoolSizeClass
+{
+    /// Lock. A spin lock, as it is held only to unlink or link a slot.
+    std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
+    /// First free slot.
+    PoolNode* free_{};
+    /// First chunk.
+    PoolChunk* chunks_{};
+};
+
+/// Size of the memory chunks divided into slots.
+static const i32 POOL_CHUNK_SIZE = 64 * 1024;
+/// Number of size classes with 16 byte steps up to 256 bytes.
+static const i32 POOL_NUM_SMALL_CLASSES = 16;
+/// Number of size classes with 64 byte steps from 256 bytes to the maximum size.
+static const i32 POOL_NUM_LARGE_CLASSES = (POOL_MAX_SIZE - 256) / 64;
+
+static PoolSizeClass poolSizeClasses[POOL_NUM_SMALL_CLASSES + POOL_NUM_LARGE_CLASSES];
+
+static i32 GetPoolSizeClass(size_t size, i32& slotSize)
+{
+    if (size <= 256)
+    {
+        i32 index = size ? (i32)((size - 1) >> 4u) : 0;
+        slotSize = (index + 1) << 4;
+        return index;
+    }
+
+    i32 index = (i32)((size - 257) >> 6u);
+    slotSize = 256 + ((index + 1) << 6);
+    return POOL_NUM_SMALL_CLASSES + index;
+}
+
+void* PoolAllocate(size_t size)
+{
+    if (size > (size_t)POOL_MAX_SIZE)
+        return ::operator new(size);
+
+    i32 slotSize;
+    PoolSizeClass& sizeClass = poolSizeClasses[GetPoolSizeClass(size, slotSize)];
+
+    while (sizeClass.lock_.test_and_set(std::memory_order_acquire))
+    {
+    }
+
+    if (!sizeClass.free_)
+    {
+        // Chunks are allocated with new, so they are aligned to 16 bytes like the header and the slots after it
+        i32 numSlots = POOL_CHUNK_SIZE / slotSize;
+        PoolChunk* chunk = reinterpret_cast<PoolChunk*>(new u8[sizeof(PoolChunk) + (size_t)numSlots * slotSize]);
+        chunk->next_ = sizeClass.chunks_;
+        sizeClass.chunks_ = chunk;
+        u8* slots = reinterpret_cast<u8*>(chunk + 1);
+        for (i32 i = numSlots - 1; i >= 0; --i)
+        {
+            PoolNode* node = reinterpret_cast<PoolNode*>(slots + (size_t)i * slotSize);
+            node->next_ = sizeClass.free_;
+            sizeClass.free_ = node;
+        }
+    }
+
+    PoolNode* node = sizeClass.free_;
+    sizeClass.free_ = node->next_;
+    sizeClass.lock_.clear(std::memory_order_release);
+
+    return node;
+}
+
+void PoolFree(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (size > (size_t)POOL_MAX_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    i32 slotSize;
+    PoolSizeClass& sizeClass = poolSizeClasses[GetPoolSizeClass(size, slotSize)];
+    PoolNode* node = static_cast<PoolNode*>(ptr);
+
+    while (sizeClass.lock_.test_and_set(std::memory_order_acquire))
+    {
+    }
+
+    node->next_ = sizeClass.free_;
+    sizeClass.free_ = node;
+    sizeClass.lock_.clear(std::memory_order_release);
+}
+
+size_t PoolTrim()
+{
+    size_t released = 0;
+    // Chunks of the size class sorted by address, with the number of free slots in each
+    std::vector<std::pair<PoolChunk*, i32>> chunks;
+
+    for (i32 i = 0; i < POOL_NUM_SMALL_CLASSES + POOL_NUM_LARGE_CLASSES; ++i)
+    {
+        i32 slotSize = i < POOL_NUM_SMALL_CLASSES ? (i + 1) << 4 : 256 + ((i - POOL_NUM_SMALL_CLASSES + 1) << 6);
+        i32 numSlots = POOL_CHUNK_SIZE / slotSize;
+        PoolSizeClass& sizeClass = poolSizeClasses[i];
+
+        while (sizeClass.lock_.test_and_set(std::memory_order_acquire))
+        {
+        }
+
+        chunks.clear();
+        for (PoolChunk* chunk = sizeClass.chunks_; chunk; chunk = chunk->next_)
+            chunks.emplace_back(chunk, 0);
+        std::sort(chunks.begin(), chunks.end());
+
+        // The chunk of a slot is the last one starting before it
+        auto findChunk = [&chunks](PoolNode* node)
+        {
+            auto it = std::upper_bound(chunks.begin(), chunks.end(), std::make_pair(reinterpret_cast<PoolChunk*>(node), 0),
+                [](const std::pair<PoolChunk*, i32>& lhs, const std::pair<PoolChunk*, i32>& rhs) { return lhs.first < rhs.first; });
+            return --it;
+        };
+
+        bool anyUnused = false;
+        for (PoolNode* node = sizeClass.free_; node; node = node->next_)
+        {
+            if (++findChunk(node)->second == numSlots)
+                anyUnused = true;
+        }
+
+        if (anyUnused)
+        {
+            // Unlink the free slots of the unused chunks, then the chunks themselves
+            PoolNode** freeLink = &sizeClass.free_;
+            while (*freeLink)
+            {
+                if (findChunk(*freeLink)->second == numSlots)
+                    *freeLink = (*freeLink)->next_;
+                else
+                    freeLink = &(*freeLink)->next_;
+            }
+
+            PoolChunk** chunkLink = &sizeClass.chunks_;
+            while (*chunkLink)
+            {
+                PoolChunk* chunk = *chunkLink;
+                if (findChunk(reinterpret_cast<PoolNode*>(chunk))->second == numSlots)
+                {
+                    *chunkLink = chunk->next_;
+                    delete[] reinterpret_cast<u8*>(chunk);
+                    released += sizeof(PoolChunk) + (size_t)numSlots * slotSize;
+                }
+                else
+                    chunkLink = &chunk->next_;
+            }
+        }
+
+        sizeClass.lock_.clear(std::memory_order_release);
+    }
+
+    return released;
+}
+
 }
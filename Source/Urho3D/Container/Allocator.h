@@ -60,6 +60,19 @@ URHO3D_API void* AllocatorReserve(AllocatorBlock* allocator);
 /// Free a node. Does not free any blocks.
 URHO3D_API void AllocatorFree(AllocatorBlock* allocator, void* ptr);
 
+/// Largest object size served by the size-class pool. Larger objects are allocated from the heap.
+inline constexpr i32 POOL_MAX_SIZE = 1024;
+
+/// Allocate memory from the thread-safe size-class pool. The memory is aligned to 16 bytes. Memory freed to the pool is reused for objects of the same size class, and is returned to the system only by PoolTrim().
+URHO3D_API void* PoolAllocate(size_t size);
+
+/// Free memory allocated with PoolAllocate(). The size must be the one given when allocating.
+URHO3D_API void PoolFree(void* ptr, size_t size);
+
+/// Return the pool memory chunks that have no allocated objects to the system, for example after unloading a scene. Return the number of bytes released.
+URHO3D_API size_t PoolTrim();
+
+
 /// %Allocator template class. Allocates objects of a specific class.
 template <class T> class Allocator
 {
@@ -121,3 +134,19 @@ public:
 };
 
 }
+
+#if !defined(URHO3D_POOL_ALLOCATION)
+/// Pool allocation is disabled by the build, so the objects of a class are allocated from the heap.
+#define URHO3D_POOL_ALLOCATED()
+#elif defined(_MSC_VER) && defined(_DEBUG)
+/// Allocate the objects of a class and its subclasses from the size-class pool. Also define the operator used by DebugNew.h.
+#define URHO3D_POOL_ALLOCATED() \
+    static void* operator new(size_t size) { return Urho3D::PoolAllocate(size); } \
+    static void* operator new(size_t size, int, const char*, int) { return Urho3D::PoolAllocate(size); } \
+    static void operator delete(void* ptr, size_t size) { Urho3D::PoolFree(ptr, size); }
+#else
+/// Allocate the objects of a class and its subclasses from the size-class pool.
+#define URHO3D_POOL_ALLOCATED() \
+    static void* operator new(size_t size) { return Urho3D::PoolAllocate(size); } \
+    static void operator delete(void* ptr, size_t size) { Urho3D::PoolFree(ptr, size); }
+#endif
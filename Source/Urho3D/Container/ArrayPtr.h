@@ -140,10 +140,10 @@ public:
     T* Get() const { return ptr_; }
 
     /// Return the array's reference count, or 0 if the pointer is null.
-    int Refs() const { return refCount_ ? refCount_->refs_ : 0; }
+    int Refs() const { return refCount_ ? (int)refCount_->refs_ : 0; }
 
     /// Return the array's weak reference count, or 0 if the pointer is null.
-    int WeakRefs() const { return refCount_ ? refCount_->weakRefs_ : 0; }
+    int WeakRefs() const { return refCount_ ? (int)refCount_->weakRefs_ : 0; }
 
     /// Return pointer to the RefCount structure.
     RefCount* RefCountPtr() const { return refCount_; }
@@ -357,10 +357,10 @@ public:
     bool NotNull() const { return refCount_ != 0; }
 
     /// Return the array's reference count, or 0 if null pointer or if array has expired.
-    int Refs() const { return (refCount_ && refCount_->refs_ >= 0) ? refCount_->refs_ : 0; }
+    int Refs() const { return (refCount_ && refCount_->refs_ >= 0) ? (int)refCount_->refs_ : 0; }
 
     /// Return the array's weak reference count.
-    int WeakRefs() const { return refCount_ ? refCount_->weakRefs_ : 0; }
+    int WeakRefs() const { return refCount_ ? (int)refCount_->weakRefs_ : 0; }
 
     /// Return whether the array has expired. If null pointer, always return true.
     bool Expired() const { return refCount_ ? refCount_->refs_ < 0 : true; }
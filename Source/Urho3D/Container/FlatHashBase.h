@@ -0,0 +1,283 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#ifdef URHO3D_IS_BUILDING
+#include "Urho3D.h"
+#else
+#include <Urho3D/Urho3D.h>
+#endif
+
+#include "../Container/Hash.h"
+#include "../Container/Swap.h"
+
+#ifdef URHO3D_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include <cstring>
+
+namespace Urho3D
+{
+
+/// Number of slots whose control bytes are compared at once.
+inline constexpr i32 FLAT_HASH_GROUP_SIZE = 16;
+
+/// Control byte of an empty slot.
+inline constexpr i8 FLAT_HASH_EMPTY = (i8)0x80;
+/// Control byte of an erased slot. Probing continues past it.
+inline constexpr i8 FLAT_HASH_DELETED = (i8)0xfe;
+
+/// Bit mask of the slots of a group that matched a test.
+class FlatHashMask
+{
+public:
+    /// Construct.
+    explicit FlatHashMask(u32 bits) :
+        bits_(bits)
+    {
+    }
+
+    /// Return whether any slot matched.
+    explicit operator bool() const { return bits_ != 0; }
+
+    /// Return the index of the lowest matching slot. Do not call if none matched.
+    i32 Lowest() const
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, bits_);
+        return (i32)index;
+#else
+        return __builtin_ctz(bits_);
+#endif
+    }
+
+    /// Return the index of the lowest matching slot and remove it from the mask.
+    i32 Next()
+    {
+        i32 index = Lowest();
+        bits_ &= bits_ - 1;
+        return index;
+    }
+
+private:
+    /// Bits.
+    u32 bits_;
+};
+
+/// Group of control bytes.
+struct FlatHashGroup
+{
+    /// Load from control bytes, which must be aligned to the group size.
+    explicit FlatHashGroup(const i8* ctrl) :
+        ctrl_(ctrl)
+    {
+    }
+
+    /// Return the slots whose control byte equals the value.
+    FlatHashMask Match(i8 value) const
+    {
+#ifdef URHO3D_SSE
+        __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(ctrl_));
+        return FlatHashMask((u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), ctrl)));
+#else
+        u32 bits = 0;
+        for (i32 i = 0; i < FLAT_HASH_GROUP_SIZE; ++i)
+        {
+            if (ctrl_[i] == value)
+                bits |= 1u << i;
+        }
+        return FlatHashMask(bits);
+#endif
+    }
+
+    /// Return the empty slots.
+    FlatHashMask MatchEmpty() const { return Match(FLAT_HASH_EMPTY); }
+
+    /// Return the empty and erased slots, which have the high bit set.
+    FlatHashMask MatchFree() const
+    {
+#ifdef URHO3D_SSE
+        __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(ctrl_));
+        return FlatHashMask((u32)_mm_movemask_epi8(ctrl));
+#else
+        u32 bits = 0;
+        for (i32 i = 0; i < FLAT_HASH_GROUP_SIZE; ++i)
+        {
+            if (ctrl_[i] < 0)
+                bits |= 1u << i;
+        }
+        return FlatHashMask(bits);
+#endif
+    }
+
+    /// Control bytes.
+    const i8* ctrl_;
+};
+
+/// Open addressing hash set/map base class. The slots are divided into groups of 16, whose one byte per slot control
+/// bytes hold 7 bits of the key hash, so that a lookup usually compares a single key. The control bytes of a group are
+/// compared at once with SSE2 when enabled.
+/** Note that to prevent extra memory use due to vtable pointer, %FlatHashBase intentionally does not declare a virtual destructor
+    and therefore %FlatHashBase pointers should never be used.
+  */
+class URHO3D_API FlatHashBase
+{
+public:
+    /// Construct.
+    FlatHashBase() :
+        ctrl_(nullptr),
+        ctrlBuffer_(nullptr),
+        size_(0),
+        capacity_(0),
+        growthLeft_(0)
+    {
+    }
+
+    /// Swap with another hash set or map.
+    void Swap(FlatHashBase& rhs)
+    {
+        Urho3D::Swap(ctrl_, rhs.ctrl_);
+        Urho3D::Swap(ctrlBuffer_, rhs.ctrlBuffer_);
+        Urho3D::Swap(size_, rhs.size_);
+        Urho3D::Swap(capacity_, rhs.capacity_);
+        Urho3D::Swap(growthLeft_, rhs.growthLeft_);
+    }
+
+    /// Return number of elements.
+    i32 Size() const { return size_; }
+
+    /// Return number of slots.
+    i32 Capacity() const { return capacity_; }
+
+    /// Return whether has no elements.
+    bool Empty() const { return size_ == 0; }
+
+protected:
+    /// Maximum number of elements per 8 slots before growing.
+    static constexpr i32 MAX_LOAD_EIGHTHS = 7;
+
+    /// Mix a key hash, as MakeHash() of a pointer or an integer leaves the high bits mostly unused.
+    static hash32 Mix(hash32 hash)
+    {
+        hash ^= hash >> 16u;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13u;
+        hash *= 0xc2b2ae35u;
+        hash ^= hash >> 16u;
+        return hash;
+    }
+
+    /// Return the control byte of a mixed hash.
+    static i8 ControlByte(hash32 hash) { return (i8)(hash >> 25u); }
+
+    /// Return the first group to probe for a mixed hash.
+    i32 FirstGroup(hash32 hash) const { return (i32)(hash & (u32)(capacity_ / FLAT_HASH_GROUP_SIZE - 1)); }
+
+    /// Return the group to probe after the one given. Triangular steps visit every group once as the group count is a power of two.
+    i32 NextGroup(i32 group, i32 step) const { return (group + step) & (capacity_ / FLAT_HASH_GROUP_SIZE - 1); }
+
+    /// Return the number of slots needed for a number of elements.
+    static i32 CapacityFor(i32 numElements)
+    {
+        i32 capacity = FLAT_HASH_GROUP_SIZE;
+        while (capacity * MAX_LOAD_EIGHTHS / 8 < numElements)
+            capacity <<= 1;
+        return capacity;
+    }
+
+    /// Find a free slot for a mixed hash, assuming the key is not present. Return slot index.
+    i32 FindFreeSlot(hash32 hash) const
+    {
+        i32 group = FirstGroup(hash);
+        for (i32 step = 1;; ++step)
+        {
+            FlatHashMask free = FlatHashGroup(ctrl_ + group * FLAT_HASH_GROUP_SIZE).MatchFree();
+            if (free)
+                return group * FLAT_HASH_GROUP_SIZE + free.Lowest();
+            group = NextGroup(group, step);
+        }
+    }
+
+    /// Set the control byte of an occupied slot.
+    void Occupy(i32 index, i8 control)
+    {
+        if (ctrl_[index] == FLAT_HASH_EMPTY)
+            --growthLeft_;
+        ctrl_[index] = control;
+        ++size_;
+    }
+
+    /// Set the control byte of an erased slot. An erased slot can become empty if its group has empty slots, as then no probe continues past the group.
+    void Vacate(i32 index)
+    {
+        const i8* group = ctrl_ + (index & ~(FLAT_HASH_GROUP_SIZE - 1));
+        if (FlatHashGroup(group).MatchEmpty())
+        {
+            ctrl_[index] = FLAT_HASH_EMPTY;
+            ++growthLeft_;
+        }
+        else
+            ctrl_[index] = FLAT_HASH_DELETED;
+        --size_;
+    }
+
+    /// Return the index of the first occupied slot at or after the index, or capacity if none.
+    i32 NextOccupied(i32 index) const
+    {
+        while (index < capacity_ && ctrl_[index] < 0)
+            ++index;
+        return index;
+    }
+
+    /// Allocate control bytes for a power of two capacity of at least the group size and mark them empty.
+    void AllocateControl(i32 capacity)
+    {
+        // Allocate an extra group so that the control bytes can be aligned to the group size
+        ctrlBuffer_ = new i8[capacity + FLAT_HASH_GROUP_SIZE];
+        ctrl_ = reinterpret_cast<i8*>(((size_t)ctrlBuffer_ + FLAT_HASH_GROUP_SIZE - 1) & ~(size_t)(FLAT_HASH_GROUP_SIZE - 1));
+        memset(ctrl_, FLAT_HASH_EMPTY, capacity);
+        capacity_ = capacity;
+        growthLeft_ = capacity * MAX_LOAD_EIGHTHS / 8;
+        size_ = 0;
+    }
+
+    /// Mark all slots empty.
+    void ResetControl()
+    {
+        if (ctrl_)
+            memset(ctrl_, FLAT_HASH_EMPTY, capacity_);
+        size_ = 0;
+        growthLeft_ = capacity_ * MAX_LOAD_EIGHTHS / 8;
+    }
+
+    /// Free the control bytes.
+    void FreeControl()
+    {
+        delete[] ctrlBuffer_;
+        ctrlBuffer_ = nullptr;
+        ctrl_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+        growthLeft_ = 0;
+    }
+
+    /// Control bytes, aligned to the group size.
+    i8* ctrl_;
+    /// Allocated control byte buffer.
+    i8* ctrlBuffer_;
+    /// Number of elements.
+    i32 size_;
+    /// Number of slots. Zero or a power of two of at least the group size.
+    i32 capacity_;
+    /// Number of empty slots that can still be occupied before growing.
+    i32 growthLeft_;
+};
+
+}
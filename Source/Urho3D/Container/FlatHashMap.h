@@ -0,0 +1,475 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../Container/FlatHashBase.h"
+#include "../Container/Pair.h"
+#include "../Container/Vector.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+namespace Urho3D
+{
+
+/// Open addressing hash map template class. Faster to search and iterate than HashMap, as the pairs are stored in a
+/// flat array without per-node allocations. Unlike HashMap, inserting may move the pairs, which invalidates pointers and
+/// iterators to them, and the iteration order is not the insertion order.
+template <class T, class U> class FlatHashMap : public FlatHashBase
+{
+public:
+    using KeyType = T;
+    using ValueType = U;
+
+    /// Hash map key-value pair with const key.
+    class KeyValue
+    {
+    public:
+        /// Construct with key and value.
+        KeyValue(const T& first, const U& second) :
+            first_(first),
+            second_(second)
+        {
+        }
+
+        /// Copy-construct.
+        KeyValue(const KeyValue& value) :
+            first_(value.first_),
+            second_(value.second_)
+        {
+        }
+
+        /// Move-construct. The key is copied as it is const.
+        KeyValue(KeyValue&& value) noexcept :
+            first_(value.first_),
+            second_(std::move(value.second_))
+        {
+        }
+
+        /// Prevent assignment.
+        KeyValue& operator =(const KeyValue& rhs) = delete;
+
+        /// Test for equality with another pair.
+        bool operator ==(const KeyValue& rhs) const { return first_ == rhs.first_ && second_ == rhs.second_; }
+        /// Test for inequality with another pair.
+        bool operator !=(const KeyValue& rhs) const { return first_ != rhs.first_ || second_ != rhs.second_; }
+
+        /// Key.
+        const T first_;
+        /// Value.
+        U second_;
+    };
+
+    /// Flat hash map iterator.
+    template <class V> struct IteratorBase
+    {
+        /// Construct.
+        IteratorBase() = default;
+
+        /// Construct with a slot, its control byte and the end of the control bytes.
+        IteratorBase(V* slot, const i8* ctrl, const i8* ctrlEnd) :
+            slot_(slot),
+            ctrl_(ctrl),
+            ctrlEnd_(ctrlEnd)
+        {
+        }
+
+        /// Construct from a non-const iterator.
+        template <class W> IteratorBase(const IteratorBase<W>& rhs) :    // NOLINT(google-explicit-constructor)
+            slot_(rhs.slot_),
+            ctrl_(rhs.ctrl_),
+            ctrlEnd_(rhs.ctrlEnd_)
+        {
+        }
+
+        /// Test for equality with another iterator.
+        template <class W> bool operator ==(const IteratorBase<W>& rhs) const { return slot_ == rhs.slot_; }
+        /// Test for inequality with another iterator.
+        template <class W> bool operator !=(const IteratorBase<W>& rhs) const { return slot_ != rhs.slot_; }
+
+        /// Preincrement to the next pair.
+        IteratorBase& operator ++()
+        {
+            do
+            {
+                ++slot_;
+                ++ctrl_;
+            }
+            while (ctrl_ != ctrlEnd_ && *ctrl_ < 0);
+            return *this;
+        }
+
+        /// Postincrement to the next pair.
+        IteratorBase operator ++(int)
+        {
+            IteratorBase it = *this;
+            ++*this;
+            return it;
+        }
+
+        /// Point to the pair.
+        V* operator ->() const { return slot_; }
+
+        /// Dereference the pair.
+        V& operator *() const { return *slot_; }
+
+        /// Slot.
+        V* slot_{};
+        /// Control byte of the slot.
+        const i8* ctrl_{};
+        /// End of the control bytes.
+        const i8* ctrlEnd_{};
+    };
+
+    /// Flat hash map iterator.
+    using Iterator = IteratorBase<KeyValue>;
+    /// Flat hash map const iterator.
+    using ConstIterator = IteratorBase<const KeyValue>;
+
+    /// Construct empty.
+    FlatHashMap() :
+        slots_(nullptr)
+    {
+    }
+
+    /// Construct from another hash map.
+    FlatHashMap(const FlatHashMap<T, U>& map) :
+        slots_(nullptr)
+    {
+        *this = map;
+    }
+
+    /// Move-construct from another hash map.
+    FlatHashMap(FlatHashMap<T, U>&& map) noexcept :
+        slots_(nullptr)
+    {
+        Swap(map);
+    }
+
+    /// Aggregate initialization constructor.
+    FlatHashMap(const std::initializer_list<Pair<T, U>>& list) :
+        slots_(nullptr)
+    {
+        Reserve((i32)list.size());
+        for (const Pair<T, U>& pair : list)
+            Insert(pair);
+    }
+
+    /// Destruct.
+    ~FlatHashMap()
+    {
+        Free();
+    }
+
+    /// Assign a hash map.
+    FlatHashMap& operator =(const FlatHashMap<T, U>& rhs)
+    {
+        // In case of self-assignment do nothing
+        if (&rhs != this)
+        {
+            Clear();
+            Reserve(rhs.Size());
+            for (ConstIterator i = rhs.Begin(); i != rhs.End(); ++i)
+                InsertNew(i->first_, i->second_);
+        }
+        return *this;
+    }
+
+    /// Move-assign a hash map.
+    FlatHashMap& operator =(FlatHashMap<T, U>&& rhs) noexcept
+    {
+        Swap(rhs);
+        return *this;
+    }
+
+    /// Test for equality with another hash map.
+    bool operator ==(const FlatHashMap<T, U>& rhs) const
+    {
+        if (rhs.Size() != Size())
+            return false;
+
+        for (ConstIterator i = Begin(); i != End(); ++i)
+        {
+            ConstIterator j = rhs.Find(i->first_);
+            if (j == rhs.End() || j->second_ != i->second_)
+                return false;
+        }
+
+        return true;
+    }
+
+    /// Test for inequality with another hash map.
+    bool operator !=(const FlatHashMap<T, U>& rhs) const { return !(*this == rhs); }
+
+    /// Index the map. Create a new pair if key not found.
+    U& operator [](const T& key)
+    {
+        hash32 hash = Mix(MakeHash(key));
+        i32 index = FindSlot(key, hash);
+        if (index == NINDEX)
+            index = InsertSlot(key, U(), hash);
+        return slots_[index].second_;
+    }
+
+    /// Index the map. Return null if key is not found, does not create a new pair.
+    U* operator [](const T& key) const
+    {
+        i32 index = FindSlot(key, Mix(MakeHash(key)));
+        return index != NINDEX ? &slots_[index].second_ : nullptr;
+    }
+
+    /// Insert a pair. Return an iterator to it.
+    Iterator Insert(const Pair<T, U>& pair)
+    {
+        bool exists;
+        return Insert(pair, exists);
+    }
+
+    /// Insert a pair. Return iterator and set exists flag according to whether the key already existed.
+    Iterator Insert(const Pair<T, U>& pair, bool& exists)
+    {
+        hash32 hash = Mix(MakeHash(pair.first_));
+        i32 index = FindSlot(pair.first_, hash);
+        exists = index != NINDEX;
+        if (exists)
+            slots_[index].second_ = pair.second_;
+        else
+            index = InsertSlot(pair.first_, pair.second_, hash);
+        return IteratorAt(index);
+    }
+
+    /// Insert a map.
+    void Insert(const FlatHashMap<T, U>& map)
+    {
+        for (ConstIterator i = map.Begin(); i != map.End(); ++i)
+            Insert(MakePair(i->first_, i->second_));
+    }
+
+    /// Erase a pair by key. Return true if was found.
+    bool Erase(const T& key)
+    {
+        i32 index = FindSlot(key, Mix(MakeHash(key)));
+        if (index == NINDEX)
+            return false;
+
+        EraseSlot(index);
+        return true;
+    }
+
+    /// Erase a pair by iterator. Return iterator to the next pair. Erasing does not move the other pairs.
+    Iterator Erase(const Iterator& it)
+    {
+        if (it == End())
+            return End();
+
+        Iterator next = it;
+        ++next;
+        EraseSlot((i32)(it.slot_ - slots_));
+        return next;
+    }
+
+    /// Clear the map. Keep the allocated slots.
+    void Clear()
+    {
+        DestructSlots();
+        ResetControl();
+    }
+
+    /// Reserve slots for a number of pairs.
+    void Reserve(i32 numPairs)
+    {
+        if (numPairs > size_ + growthLeft_)
+            Rehash(CapacityFor(numPairs));
+    }
+
+    /// Swap with another hash map.
+    void Swap(FlatHashMap<T, U>& rhs)
+    {
+        FlatHashBase::Swap(rhs);
+        Urho3D::Swap(slots_, rhs.slots_);
+    }
+
+    /// Return iterator to the pair with key, or end iterator if not found.
+    Iterator Find(const T& key)
+    {
+        i32 index = FindSlot(key, Mix(MakeHash(key)));
+        return index != NINDEX ? IteratorAt(index) : End();
+    }
+
+    /// Return const iterator to the pair with key, or end iterator if not found.
+    ConstIterator Find(const T& key) const
+    {
+        i32 index = FindSlot(key, Mix(MakeHash(key)));
+        return index != NINDEX ? ConstIterator(IteratorAt(index)) : End();
+    }
+
+    /// Return whether contains a pair with key.
+    bool Contains(const T& key) const { return FindSlot(key, Mix(MakeHash(key))) != NINDEX; }
+
+    /// Try to copy value to output. Return true if was found.
+    bool TryGetValue(const T& key, U& out) const
+    {
+        i32 index = FindSlot(key, Mix(MakeHash(key)));
+        if (index == NINDEX)
+            return false;
+
+        out = slots_[index].second_;
+        return true;
+    }
+
+    /// Return all the keys.
+    Vector<T> Keys() const
+    {
+        Vector<T> result;
+        result.Reserve(Size());
+        for (ConstIterator i = Begin(); i != End(); ++i)
+            result.Push(i->first_);
+        return result;
+    }
+
+    /// Return all the values.
+    Vector<U> Values() const
+    {
+        Vector<U> result;
+        result.Reserve(Size());
+        for (ConstIterator i = Begin(); i != End(); ++i)
+            result.Push(i->second_);
+        return result;
+    }
+
+    /// Return iterator to the beginning.
+    Iterator Begin() { return IteratorAt(NextOccupied(0)); }
+
+    /// Return iterator to the beginning.
+    ConstIterator Begin() const { return const_cast<FlatHashMap*>(this)->Begin(); }
+
+    /// Return iterator to the end.
+    Iterator End() { return IteratorAt(capacity_); }
+
+    /// Return iterator to the end.
+    ConstIterator End() const { return const_cast<FlatHashMap*>(this)->End(); }
+
+private:
+    /// Return iterator to a slot.
+    Iterator IteratorAt(i32 index) const { return Iterator(slots_ + index, ctrl_ + index, ctrl_ + capacity_); }
+
+    /// Find the slot of a key. Return slot index or NINDEX if not found.
+    i32 FindSlot(const T& key, hash32 hash) const
+    {
+        if (!size_)
+            return NINDEX;
+
+        i8 control = ControlByte(hash);
+        i32 group = FirstGroup(hash);
+        for (i32 step = 1;; ++step)
+        {
+            const i8* groupCtrl = ctrl_ + group * FLAT_HASH_GROUP_SIZE;
+            FlatHashGroup groupBytes(groupCtrl);
+            for (FlatHashMask match = groupBytes.Match(control); match;)
+            {
+                i32 index = group * FLAT_HASH_GROUP_SIZE + match.Next();
+                if (slots_[index].first_ == key)
+                    return index;
+            }
+
+            if (groupBytes.MatchEmpty())
+                return NINDEX;
+
+            group = NextGroup(group, step);
+        }
+    }
+
+    /// Insert a key that is not present. Return slot index.
+    i32 InsertSlot(const T& key, const U& value, hash32 hash)
+    {
+        i32 index = capacity_ ? FindFreeSlot(hash) : NINDEX;
+        if (index == NINDEX || (!growthLeft_ && ctrl_[index] == FLAT_HASH_EMPTY))
+        {
+            // Grow, or only drop the erased slots if they make up much of the map
+            Rehash(CapacityFor(size_ * 2 >= capacity_ * MAX_LOAD_EIGHTHS / 8 ? size_ * 2 + 1 : size_ + 1));
+            index = FindFreeSlot(hash);
+        }
+
+        new(slots_ + index) KeyValue(key, value);
+        Occupy(index, ControlByte(hash));
+        return index;
+    }
+
+    /// Insert a key that is not present without checking for growth. Used when copying.
+    void InsertNew(const T& key, const U& value)
+    {
+        hash32 hash = Mix(MakeHash(key));
+        i32 index = FindFreeSlot(hash);
+        new(slots_ + index) KeyValue(key, value);
+        Occupy(index, ControlByte(hash));
+    }
+
+    /// Destruct the pair of a slot and mark it erased.
+    void EraseSlot(i32 index)
+    {
+        (slots_ + index)->~KeyValue();
+        Vacate(index);
+    }
+
+    /// Reallocate to a capacity and move the pairs.
+    void Rehash(i32 capacity)
+    {
+        i8* oldCtrl = ctrl_;
+        i8* oldCtrlBuffer = ctrlBuffer_;
+        KeyValue* oldSlots = slots_;
+        i32 oldCapacity = capacity_;
+
+        AllocateControl(capacity);
+        slots_ = reinterpret_cast<KeyValue*>(new u8[(size_t)capacity * sizeof(KeyValue)]);
+
+        for (i32 i = 0; i < oldCapacity; ++i)
+        {
+            if (oldCtrl[i] >= 0)
+            {
+                KeyValue& pair = oldSlots[i];
+                hash32 hash = Mix(MakeHash(pair.first_));
+                i32 index = FindFreeSlot(hash);
+                new(slots_ + index) KeyValue(std::move(pair));
+                Occupy(index, ControlByte(hash));
+                pair.~KeyValue();
+            }
+        }
+
+        delete[] oldCtrlBuffer;
+        delete[] reinterpret_cast<u8*>(oldSlots);
+    }
+
+    /// Destruct all pairs.
+    void DestructSlots()
+    {
+        for (i32 i = 0; i < capacity_; ++i)
+        {
+            if (ctrl_[i] >= 0)
+                (slots_ + i)->~KeyValue();
+        }
+    }
+
+    /// Destruct all pairs and free the memory.
+    void Free()
+    {
+        DestructSlots();
+        FreeControl();
+        delete[] reinterpret_cast<u8*>(slots_);
+        slots_ = nullptr;
+    }
+
+    /// Slots. Only the slots with non-negative control bytes are constructed.
+    KeyValue* slots_;
+};
+
+template <class T, class U> typename Urho3D::FlatHashMap<T, U>::ConstIterator begin(const Urho3D::FlatHashMap<T, U>& v) { return v.Begin(); }
+
+template <class T, class U> typename Urho3D::FlatHashMap<T, U>::ConstIterator end(const Urho3D::FlatHashMap<T, U>& v) { return v.End(); }
+
+template <class T, class U> typename Urho3D::FlatHashMap<T, U>::Iterator begin(Urho3D::FlatHashMap<T, U>& v) { return v.Begin(); }
+
+template <class T, class U> typename Urho3D::FlatHashMap<T, U>::Iterator end(Urho3D::FlatHashMap<T, U>& v) { return v.End(); }
+}
@@ -0,0 +1,350 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../Container/FlatHashBase.h"
+#include "../Container/Vector.h"
+
+#include <cassert>
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+namespace Urho3D
+{
+
+/// Open addressing hash set template class. Faster to search and iterate than HashSet, as the keys are stored in a flat
+/// array without per-node allocations. Unlike HashSet, inserting may move the keys, which invalidates pointers and
+/// iterators to them, and the iteration order is not the insertion order.
+template <class T> class FlatHashSet : public FlatHashBase
+{
+public:
+    /// Flat hash set iterator.
+    struct ConstIterator
+    {
+        /// Construct.
+        ConstIterator() = default;
+
+        /// Construct with a slot, its control byte and the end of the control bytes.
+        ConstIterator(const T* slot, const i8* ctrl, const i8* ctrlEnd) :
+            slot_(slot),
+            ctrl_(ctrl),
+            ctrlEnd_(ctrlEnd)
+        {
+        }
+
+        /// Test for equality with another iterator.
+        bool operator ==(const ConstIterator& rhs) const { return slot_ == rhs.slot_; }
+        /// Test for inequality with another iterator.
+        bool operator !=(const ConstIterator& rhs) const { return slot_ != rhs.slot_; }
+
+        /// Preincrement to the next key.
+        ConstIterator& operator ++()
+        {
+            do
+            {
+                ++slot_;
+                ++ctrl_;
+            }
+            while (ctrl_ != ctrlEnd_ && *ctrl_ < 0);
+            return *this;
+        }
+
+        /// Postincrement to the next key.
+        ConstIterator operator ++(int)
+        {
+            ConstIterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        /// Point to the key.
+        const T* operator ->() const { return slot_; }
+
+        /// Dereference the key.
+        const T& operator *() const { return *slot_; }
+
+        /// Slot.
+        const T* slot_{};
+        /// Control byte of the slot.
+        const i8* ctrl_{};
+        /// End of the control bytes.
+        const i8* ctrlEnd_{};
+    };
+
+    /// Keys are immutable, so both iterators are const.
+    using Iterator = ConstIterator;
+
+    /// Construct empty.
+    FlatHashSet() :
+        slots_(nullptr)
+    {
+    }
+
+    /// Construct from another hash set.
+    FlatHashSet(const FlatHashSet<T>& set) :
+        slots_(nullptr)
+    {
+        *this = set;
+    }
+
+    /// Move-construct from another hash set.
+    FlatHashSet(FlatHashSet<T>&& set) noexcept :
+        slots_(nullptr)
+    {
+        Swap(set);
+    }
+
+    /// Aggregate initialization constructor.
+    FlatHashSet(const std::initializer_list<T>& list) :
+        slots_(nullptr)
+    {
+        Reserve((i32)list.size());
+        for (const T& key : list)
+            Insert(key);
+    }
+
+    /// Destruct.
+    ~FlatHashSet()
+    {
+        Free();
+    }
+
+    /// Assign a hash set.
+    FlatHashSet& operator =(const FlatHashSet<T>& rhs)
+    {
+        // In case of self-assignment do nothing
+        if (&rhs != this)
+        {
+            Clear();
+            Reserve(rhs.Size());
+            for (ConstIterator i = rhs.Begin(); i != rhs.End(); ++i)
+                Insert(*i);
+        }
+        return *this;
+    }
+
+    /// Move-assign a hash set.
+    FlatHashSet& operator =(FlatHashSet<T>&& rhs) noexcept
+    {
+        Swap(rhs);
+        return *this;
+    }
+
+    /// Test for equality with another hash set.
+    bool operator ==(const FlatHashSet<T>& rhs) const
+    {
+        if (rhs.Size() != Size())
+            return false;
+
+        for (ConstIterator i = Begin(); i != End(); ++i)
+        {
+            if (!rhs.Contains(*i))
+                return false;
+        }
+
+        return true;
+    }
+
+    /// Test for inequality with another hash set.
+    bool operator !=(const FlatHashSet<T>& rhs) const { return !(*this == rhs); }
+
+    /// Insert a key. Return an iterator to it.
+    Iterator Insert(const T& key)
+    {
+        bool exists;
+        return Insert(key, exists);
+    }
+
+    /// Insert a key. Return iterator and set exists flag according to whether the key already existed.
+    Iterator Insert(const T& key, bool& exists)
+    {
+        hash32 hash = Mix(MakeHash(key));
+        i32 index = FindSlot(key, hash);
+        exists = index != NINDEX;
+        if (!exists)
+        {
+            index = capacity_ ? FindFreeSlot(hash) : NINDEX;
+            if (index == NINDEX || (!growthLeft_ && ctrl_[index] == FLAT_HASH_EMPTY))
+            {
+                // Grow, or only drop the erased slots if they make up much of the set
+                Rehash(CapacityFor(size_ * 2 >= capacity_ * MAX_LOAD_EIGHTHS / 8 ? size_ * 2 + 1 : size_ + 1));
+                index = FindFreeSlot(hash);
+            }
+
+            new(slots_ + index) T(key);
+            Occupy(index, ControlByte(hash));
+        }
+        return IteratorAt(index);
+    }
+
+    /// Insert a set.
+    void Insert(const FlatHashSet<T>& set)
+    {
+        for (ConstIterator i = set.Begin(); i != set.End(); ++i)
+            Insert(*i);
+    }
+
+    /// Erase a key. Return true if was found.
+    bool Erase(const T& key)
+    {
+        i32 index = FindSlot(key, Mix(MakeHash(key)));
+        if (index == NINDEX)
+            return false;
+
+        EraseSlot(index);
+        return true;
+    }
+
+    /// Erase a key by iterator. Return iterator to the next key. Erasing does not move the other keys.
+    Iterator Erase(const Iterator& it)
+    {
+        if (it == End())
+            return End();
+
+        Iterator next = it;
+        ++next;
+        EraseSlot((i32)(it.slot_ - slots_));
+        return next;
+    }
+
+    /// Clear the set. Keep the allocated slots.
+    void Clear()
+    {
+        DestructSlots();
+        ResetControl();
+    }
+
+    /// Reserve slots for a number of keys.
+    void Reserve(i32 numKeys)
+    {
+        if (numKeys > size_ + growthLeft_)
+            Rehash(CapacityFor(numKeys));
+    }
+
+    /// Swap with another hash set.
+    void Swap(FlatHashSet<T>& rhs)
+    {
+        FlatHashBase::Swap(rhs);
+        Urho3D::Swap(slots_, rhs.slots_);
+    }
+
+    /// Return iterator to the key, or end iterator if not found.
+    Iterator Find(const T& key) const
+    {
+        i32 index = FindSlot(key, Mix(MakeHash(key)));
+        return index != NINDEX ? IteratorAt(index) : End();
+    }
+
+    /// Return whether contains a key.
+    bool Contains(const T& key) const { return FindSlot(key, Mix(MakeHash(key))) != NINDEX; }
+
+    /// Return all the keys.
+    Vector<T> Keys() const
+    {
+        Vector<T> result;
+        result.Reserve(Size());
+        for (ConstIterator i = Begin(); i != End(); ++i)
+            result.Push(*i);
+        return result;
+    }
+
+    /// Return iterator to the beginning.
+    Iterator Begin() const { return IteratorAt(NextOccupied(0)); }
+
+    /// Return iterator to the end.
+    Iterator End() const { return IteratorAt(capacity_); }
+
+private:
+    /// Return iterator to a slot.
+    Iterator IteratorAt(i32 index) const { return Iterator(slots_ + index, ctrl_ + index, ctrl_ + capacity_); }
+
+    /// Find the slot of a key. Return slot index or NINDEX if not found.
+    i32 FindSlot(const T& key, hash32 hash) const
+    {
+        if (!size_)
+            return NINDEX;
+
+        i8 control = ControlByte(hash);
+        i32 group = FirstGroup(hash);
+        for (i32 step = 1;; ++step)
+        {
+            FlatHashGroup groupBytes(ctrl_ + group * FLAT_HASH_GROUP_SIZE);
+            for (FlatHashMask match = groupBytes.Match(control); match;)
+            {
+                i32 index = group * FLAT_HASH_GROUP_SIZE + match.Next();
+                if (slots_[index] == key)
+                    return index;
+            }
+
+            if (groupBytes.MatchEmpty())
+                return NINDEX;
+
+            group = NextGroup(group, step);
+        }
+    }
+
+    /// Destruct the key of a slot and mark it erased.
+    void EraseSlot(i32 index)
+    {
+        (slots_ + index)->~T();
+        Vacate(index);
+    }
+
+    /// Reallocate to a capacity and move the keys.
+    void Rehash(i32 capacity)
+    {
+        i8* oldCtrl = ctrl_;
+        i8* oldCtrlBuffer = ctrlBuffer_;
+        T* oldSlots = slots_;
+        i32 oldCapacity = capacity_;
+
+        AllocateControl(capacity);
+        slots_ = reinterpret_cast<T*>(new u8[(size_t)capacity * sizeof(T)]);
+
+        for (i32 i = 0; i < oldCapacity; ++i)
+        {
+            if (oldCtrl[i] >= 0)
+            {
+                T& key = oldSlots[i];
+                hash32 hash = Mix(MakeHash(key));
+                i32 index = FindFreeSlot(hash);
+                new(slots_ + index) T(std::move(key));
+                Occupy(index, ControlByte(hash));
+                key.~T();
+            }
+        }
+
+        delete[] oldCtrlBuffer;
+        delete[] reinterpret_cast<u8*>(oldSlots);
+    }
+
+    /// Destruct all keys.
+    void DestructSlots()
+    {
+        for (i32 i = 0; i < capacity_; ++i)
+        {
+            if (ctrl_[i] >= 0)
+                (slots_ + i)->~T();
+        }
+    }
+
+    /// Destruct all keys and free the memory.
+    void Free()
+    {
+        DestructSlots();
+        FreeControl();
+        delete[] reinterpret_cast<u8*>(slots_);
+        slots_ = nullptr;
+    }
+
+    /// Slots. Only the slots with non-negative control bytes are constructed.
+    T* slots_;
+};
+
+template <class T> typename Urho3D::FlatHashSet<T>::ConstIterator begin(const Urho3D::FlatHashSet<T>& v) { return v.Begin(); }
+
+template <class T> typename Urho3D::FlatHashSet<T>::ConstIterator end(const Urho3D::FlatHashSet<T>& v) { return v.End(); }
+
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../Precompiled.h"
+
+#include "../Container/FrameArena.h"
+
+#include <atomic>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Size of the first block of an arena.
+static const i32 FIRST_BLOCK_SIZE = 64 * 1024;
+
+/// Frame number, advanced at the end of each frame.
+static std::atomic<unsigned> arenaFrameNumber{1};
+
+FrameArena::FrameArena() :
+    block_(nullptr),
+    offset_(0),
+    used_(0),
+    capacity_(0),
+    frameNumber_(arenaFrameNumber.load(std::memory_order_relaxed))
+{
+}
+
+FrameArena::~FrameArena()
+{
+    FreeBlocks();
+}
+
+void* FrameArena::Allocate(i32 size, i32 alignment)
+{
+    assert(size >= 0 && alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    if (block_)
+    {
+        u8* memory = reinterpret_cast<u8*>(block_ + 1);
+        size_t address = ((size_t)(memory + offset_) + alignment - 1) & ~(size_t)(alignment - 1);
+        i32 offset = (i32)(address - (size_t)memory);
+        if (offset + size <= block_->size_)
+        {
+            used_ += offset + size - offset_;
+            offset_ = offset + size;
+            return reinterpret_cast<void*>(address);
+        }
+    }
+
+    // Double the block size, so that the number of blocks stays small until the blocks are merged
+    i32 blockSize = block_ ? block_->size_ * 2 : FIRST_BLOCK_SIZE;
+    while (blockSize < size + alignment)
+        blockSize *= 2;
+
+    AddBlock(blockSize);
+    return Allocate(size, alignment);
+}
+
+void FrameArena::Release(void* ptr, i32 size)
+{
+    if (!block_)
+        return;
+
+    u8* memory = reinterpret_cast<u8*>(block_ + 1);
+    u8* allocation = static_cast<u8*>(ptr);
+    if (allocation >= memory && allocation + size == memory + offset_)
+    {
+        offset_ = (i32)(allocation - memory);
+        used_ -= size;
+    }
+}
+
+void FrameArena::Reset()
+{
+    // Replace several blocks with one, so that the next frame of the same size does not allocate
+    if (block_ && block_->previous_)
+    {
+        i32 capacity = capacity_;
+        FreeBlocks();
+        AddBlock(capacity);
+    }
+
+    offset_ = 0;
+    used_ = 0;
+}
+
+FrameArena& FrameArena::GetThreadArena()
+{
+    thread_local FrameArena arena;
+
+    unsigned frameNumber = arenaFrameNumber.load(std::memory_order_relaxed);
+    if (arena.frameNumber_ != frameNumber)
+    {
+        arena.Reset();
+        arena.frameNumber_ = frameNumber;
+    }
+
+    return arena;
+}
+
+void FrameArena::EndFrame()
+{
+    arenaFrameNumber.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameArena::AddBlock(i32 size)
+{
+    // Blocks are allocated with new, so they are aligned for any fundamental type
+    Block* block = reinterpret_cast<Block*>(new u8[sizeof(Block) + size]);
+    block->previous_ = block_;
+    block->size_ = size;
+    block_ = block;
+    offset_ = 0;
+    capacity_ += size;
+}
+
+void FrameArena::FreeBlocks()
+{
+    while (block_)
+    {
+        Block* previous = block_->previous_;
+        delete[] reinterpret_cast<u8*>(block_);
+        block_ = previous;
+    }
+
+    offset_ = 0;
+    capacity_ = 0;
+}
+
+}
@@ -0,0 +1,249 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+/// \file
+/// @nobindfile
+
+#pragma once
+
+#ifdef URHO3D_IS_BUILDING
+#include "Urho3D.h"
+#else
+#include <Urho3D/Urho3D.h>
+#endif
+
+#include "../Base/PrimitiveTypes.h"
+
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace Urho3D
+{
+
+/// Linear allocator for temporary data that is needed until the end of the frame at most. Each thread has its own
+/// arena, which is rewound on its first use after the frame has ended. Allocating only advances a pointer, and after
+/// the first frames the memory of the peak frame is reused without heap allocations. Do not use the memory in work that
+/// may continue over the end of the frame, such as background resource loading.
+class URHO3D_API FrameArena
+{
+public:
+    /// Construct.
+    FrameArena();
+    /// Destruct. Free the memory.
+    ~FrameArena();
+
+    /// Prevent copy construction.
+    FrameArena(const FrameArena& rhs) = delete;
+    /// Prevent assignment.
+    FrameArena& operator =(const FrameArena& rhs) = delete;
+
+    /// Allocate memory. The alignment must be a power of two.
+    void* Allocate(i32 size, i32 alignment = 16);
+    /// Give back the most recent allocation so that nested scopes reuse the memory. Other allocations are left until the arena is rewound.
+    void Release(void* ptr, i32 size);
+    /// Rewind to the beginning. If more than one block was needed, replace the blocks with one block of the combined size.
+    void Reset();
+
+    /// Return number of bytes allocated since the last rewind.
+    i32 GetUsed() const { return used_; }
+
+    /// Return number of bytes in the blocks.
+    i32 GetCapacity() const { return capacity_; }
+
+    /// Return the arena of the calling thread. Rewind it first if the frame has ended since its last use.
+    static FrameArena& GetThreadArena();
+    /// Make the thread arenas rewind on their next use. Called by Time at the end of the frame.
+    static void EndFrame();
+
+private:
+    /// Memory block. The memory follows.
+    struct Block
+    {
+        /// Previous block.
+        Block* previous_;
+        /// Size of the memory.
+        i32 size_;
+    };
+
+    /// Allocate a new block and make it the current block.
+    void AddBlock(i32 size);
+    /// Free all blocks.
+    void FreeBlocks();
+
+    /// Current block.
+    Block* block_;
+    /// Offset of the free memory in the current block.
+    i32 offset_;
+    /// Bytes allocated since the last rewind.
+    i32 used_;
+    /// Bytes in the blocks.
+    i32 capacity_;
+    /// Frame number of the last rewind.
+    unsigned frameNumber_;
+};
+
+/// Vector that allocates from a frame arena, for temporary arrays that would otherwise allocate every frame. The
+/// elements are destructed, but the memory is only released when the arena is rewound, so the vector must not be used
+/// after the end of the frame.
+template <class T> class FrameVector
+{
+public:
+    /// Construct with the arena of the calling thread.
+    FrameVector() :
+        FrameVector(FrameArena::GetThreadArena())
+    {
+    }
+
+    /// Construct with an arena.
+    explicit FrameVector(FrameArena& arena) :
+        arena_(arena),
+        buffer_(nullptr),
+        size_(0),
+        capacity_(0)
+    {
+    }
+
+    /// Destruct. Give the buffer back to the arena if nothing was allocated after it.
+    ~FrameVector()
+    {
+        Clear();
+        if (buffer_)
+            arena_.Release(buffer_, capacity_ * (i32)sizeof(T));
+    }
+
+    /// Prevent copy construction.
+    FrameVector(const FrameVector<T>& rhs) = delete;
+    /// Prevent assignment.
+    FrameVector<T>& operator =(const FrameVector<T>& rhs) = delete;
+
+    /// Return element at index.
+    T& operator [](i32 index)
+    {
+        assert(index >= 0 && index < size_);
+        return buffer_[index];
+    }
+
+    /// Return const element at index.
+    const T& operator [](i32 index) const
+    {
+        assert(index >= 0 && index < size_);
+        return buffer_[index];
+    }
+
+    /// Add an element at the end.
+    void Push(const T& value)
+    {
+        if (size_ == capacity_)
+            Reserve(capacity_ ? capacity_ * 2 : 16);
+        new(buffer_ + size_) T(value);
+        ++size_;
+    }
+
+    /// Remove the last element.
+    void Pop()
+    {
+        assert(size_ > 0);
+        buffer_[--size_].~T();
+    }
+
+    /// Resize, default-constructing the new elements.
+    void Resize(i32 newSize)
+    {
+        assert(newSize >= 0);
+        if (newSize > capacity_)
+            Reserve(Max(newSize, capacity_ * 2));
+        for (i32 i = size_; i < newSize; ++i)
+            new(buffer_ + i) T();
+        for (i32 i = newSize; i < size_; ++i)
+            buffer_[i].~T();
+        size_ = newSize;
+    }
+
+    /// Reserve space for elements. The old space is left unused until the arena is rewound.
+    void Reserve(i32 newCapacity)
+    {
+        if (newCapacity <= capacity_)
+            return;
+
+        T* newBuffer = static_cast<T*>(arena_.Allocate(newCapacity * (i32)sizeof(T), (i32)alignof(T)));
+        for (i32 i = 0; i < size_; ++i)
+        {
+            new(newBuffer + i) T(std::move(buffer_[i]));
+            buffer_[i].~T();
+        }
+
+        buffer_ = newBuffer;
+        capacity_ = newCapacity;
+    }
+
+    /// Remove all elements.
+    void Clear()
+    {
+        for (i32 i = 0; i < size_; ++i)
+            buffer_[i].~T();
+        size_ = 0;
+    }
+
+    /// Return whether contains a specific value.
+    bool Contains(const T& value) const
+    {
+        for (i32 i = 0; i < size_; ++i)
+        {
+            if (buffer_[i] == value)
+                return true;
+        }
+        return false;
+    }
+
+    /// Return iterator to the beginning.
+    T* Begin() { return buffer_; }
+
+    /// Return const iterator to the beginning.
+    const T* Begin() const { return buffer_; }
+
+    /// Return iterator to the end.
+    T* End() { return buffer_ + size_; }
+
+    /// Return const iterator to the end.
+    const T* End() const { return buffer_ + size_; }
+
+    /// Return last element.
+    T& Back()
+    {
+        assert(size_ > 0);
+        return buffer_[size_ - 1];
+    }
+
+    /// Return number of elements.
+    i32 Size() const { return size_; }
+
+    /// Return capacity.
+    i32 Capacity() const { return capacity_; }
+
+    /// Return whether has no elements.
+    bool Empty() const { return size_ == 0; }
+
+private:
+    /// Return the larger of two values.
+    static i32 Max(i32 lhs, i32 rhs) { return lhs > rhs ? lhs : rhs; }
+
+    /// Arena.
+    FrameArena& arena_;
+    /// Elements.
+    T* buffer_;
+    /// Number of elements.
+    i32 size_;
+    /// Number of elements that fit in the buffer.
+    i32 capacity_;
+};
+
+template <class T> T* begin(FrameVector<T>& v) { return v.Begin(); }
+
+template <class T> T* end(FrameVector<T>& v) { return v.End(); }
+
+template <class T> const T* begin(const FrameVector<T>& v) { return v.Begin(); }
+
+template <class T> const T* end(const FrameVector<T>& v) { return v.End(); }
+
+}
@@ -5,6 +5,7 @@
 
 #include "../Container/ListBase.h"
 #include <initializer_list>
+#include <utility>
 
 namespace Urho3D
 {
@@ -20,8 +21,8 @@ public:
         Node() = default;
 
         /// Construct with value.
-        explicit Node(const T& value) :
-            value_(value)
+        template <class U> explicit Node(U&& value) :
+            value_(std::forward<U>(value))
         {
         }
 
@@ -259,6 +260,9 @@ public:
     /// Insert an element to the end.
     void Push(const T& value) { InsertNode(Tail(), value); }
 
+    /// Move-insert an element at the end.
+    void Push(T&& value) { InsertNode(Tail(), std::move(value)); }
+
     /// Insert an element to the beginning.
     void PushFront(const T& value) { InsertNode(Head(), value); }
 
@@ -408,12 +412,12 @@ private:
     Node* Tail() const { return static_cast<Node*>(tail_); }
 
     /// Allocate and insert a node into the list.
-    void InsertNode(Node* dest, const T& value)
+    template <class U> void InsertNode(Node* dest, U&& value)
     {
         if (!dest)
             return;
 
-        Node* newNode = ReserveNode(value);
+        Node* newNode = ReserveNode(std::forward<U>(value));
         Node* prev = dest->Prev();
         newNode->next_ = dest;
         newNode->prev_ = prev;
@@ -460,10 +464,10 @@ private:
     }
 
     /// Reserve a node with initial value.
-    Node* ReserveNode(const T& value)
+    template <class U> Node* ReserveNode(U&& value)
     {
         auto* newNode = static_cast<Node*>(AllocatorReserve(allocator_));
-        new(newNode) Node(value);
+        new(newNode) Node(std::forward<U>(value));
         return newNode;
     }
 
@@ -51,6 +51,13 @@ public:
         AddRef();
     }
 
+    /// Move-construct from another shared pointer allowing implicit upcasting.
+    template <class U> SharedPtr(SharedPtr<U>&& rhs) noexcept :    // NOLINT(google-explicit-constructor)
+        ptr_(rhs.ptr_)
+    {
+        rhs.ptr_ = nullptr;
+    }
+
     /// Construct from a raw pointer.
     explicit SharedPtr(T* ptr) noexcept :
         ptr_(ptr)
@@ -97,6 +104,15 @@ public:
         return *this;
     }
 
+    /// Move-assign from another shared pointer allowing implicit upcasting.
+    template <class U> SharedPtr<T>& operator =(SharedPtr<U>&& rhs)
+    {
+        SharedPtr<T> copy(std::move(rhs));
+        Swap(copy);
+
+        return *this;
+    }
+
     /// Assign from a raw pointer.
     SharedPtr<T>& operator =(T* ptr)
     {
@@ -372,10 +388,30 @@ public:
     /// Convert to a shared pointer. If expired, return a null shared pointer.
     SharedPtr<T> Lock() const
     {
+#ifdef URHO3D_THREAD_SAFE_REFCOUNT
+        // Add a reference only if the object still has one, as otherwise it may be being destroyed in another thread.
+        // Unlike without atomic reference counting, an object that is not held by shared pointers can not be locked
+        if (!refCount_)
+            return SharedPtr<T>();
+
+        int refs = refCount_->refs_.load(std::memory_order_relaxed);
+        do
+        {
+            if (refs <= 0)
+                return SharedPtr<T>();
+        }
+        while (!refCount_->refs_.compare_exchange_weak(refs, refs + 1, std::memory_order_acquire, std::memory_order_relaxed));
+
+        // The extra reference keeps the object alive until the shared pointer holds its own
+        SharedPtr<T> ret(ptr_);
+        ptr_->ReleaseRef();
+        return ret;
+#else
         if (Expired())
             return SharedPtr<T>();
         else
             return SharedPtr<T>(ptr_);
+#endif
     }
 
     /// Return raw pointer. If expired, return null.
@@ -465,7 +501,7 @@ public:
     bool NotNull() const { return refCount_ != nullptr; }
 
     /// Return the object's reference count, or 0 if null pointer or if object has expired.
-    int Refs() const { return (refCount_ && refCount_->refs_ >= 0) ? refCount_->refs_ : 0; }
+    int Refs() const { return (refCount_ && refCount_->refs_ >= 0) ? (int)refCount_->refs_ : 0; }
 
     /// Return the object's weak reference count.
     int WeakRefs() const
@@ -473,7 +509,7 @@ public:
         if (!Expired())
             return ptr_->WeakRefs();
         else
-            return refCount_ ? refCount_->weakRefs_ : 0;
+            return refCount_ ? (int)refCount_->weakRefs_ : 0;
     }
 
     /// Return whether the object has expired. If null pointer, always return true.
@@ -504,9 +540,9 @@ private:
         if (refCount_)
         {
             assert(refCount_->weakRefs_ > 0);
-            --(refCount_->weakRefs_);
 
-            if (Expired() && !refCount_->weakRefs_)
+            // Test the result of the decrement, as with atomic reference counting the object may be destroyed concurrently
+            if (!--(refCount_->weakRefs_) && Expired())
                 delete refCount_;
         }
 
@@ -23,10 +23,10 @@ RefCounted::~RefCounted()
     assert(refCount_->refs_ == 0);
     assert(refCount_->weakRefs_ > 0);
 
-    // Mark object as expired, release the self weak ref and delete the refcount if no other weak refs exist
+    // Mark object as expired, release the self weak ref and delete the refcount if no other weak refs exist.
+    // Test the result of the decrement, as with atomic reference counting a weak pointer may be released concurrently
     refCount_->refs_ = -1;
-    (refCount_->weakRefs_)--;
-    if (!refCount_->weakRefs_)
+    if (!--(refCount_->weakRefs_))
         delete refCount_;
 
     refCount_ = nullptr;
@@ -41,8 +41,7 @@ void RefCounted::AddRef()
 void RefCounted::ReleaseRef()
 {
     assert(refCount_->refs_ > 0);
-    (refCount_->refs_)--;
-    if (!refCount_->refs_)
+    if (!--(refCount_->refs_))
         delete this;
 }
 
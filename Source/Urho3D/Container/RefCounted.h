@@ -9,9 +9,21 @@
 #include <Urho3D/Urho3D.h>
 #endif
 
+#ifdef URHO3D_THREAD_SAFE_REFCOUNT
+#include <atomic>
+#endif
+
 namespace Urho3D
 {
 
+#ifdef URHO3D_THREAD_SAFE_REFCOUNT
+/// Reference counter. Atomic, so that shared and weak pointers to the same object can be copied and released in several threads.
+using RefCounter = std::atomic<int>;
+#else
+/// Reference counter.
+using RefCounter = int;
+#endif
+
 /// Reference count structure.
 struct RefCount
 {
@@ -31,9 +43,9 @@ struct RefCount
     }
 
     /// Reference count. If below zero, the object has been destroyed.
-    int refs_;
+    RefCounter refs_;
     /// Weak reference count.
-    int weakRefs_;
+    RefCounter weakRefs_;
 };
 
 /// Base class for intrusively reference-counted objects. These are noncopyable and non-assignable.
@@ -0,0 +1,63 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../Base/PrimitiveTypes.h"
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+/// Fixed-capacity lock-free queue for passing values from one producer thread to one consumer thread. Capacity must be a power of two.
+template <class T, i32 Capacity> class SPSCQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /// Construct empty.
+    SPSCQueue() = default;
+
+    /// Prevent copy construction.
+    SPSCQueue(const SPSCQueue& queue) = delete;
+    /// Prevent assignment.
+    SPSCQueue& operator =(const SPSCQueue& rhs) = delete;
+
+    /// Add a value at the back. Call only from the producer thread. Return false if the queue is full.
+    bool Push(const T& value)
+    {
+        const u32 tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == (u32)Capacity)
+            return false;
+
+        buffer_[tail & (Capacity - 1)] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Remove a value from the front. Call only from the consumer thread. Return false if the queue is empty.
+    bool Pop(T& value)
+    {
+        const u32 head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return false;
+
+        value = buffer_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Return whether is empty. Exact only when called from the consumer thread.
+    bool Empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+private:
+    /// Values.
+    T buffer_[Capacity]{};
+    /// Read position, written by the consumer. Kept on its own cache line to avoid false sharing with the producer.
+    alignas(64) std::atomic<u32> head_{};
+    /// Write position, written by the producer.
+    alignas(64) std::atomic<u32> tail_{};
+};
+
+}
@@ -122,4 +122,55 @@ template <class T, class U> void Sort(RandomAccessIterator<T> begin, RandomAcces
     InsertionSort(begin, end, compare);
 }
 
+/// Perform a stable least significant digit radix sort in ascending order of the 64-bit key_ member of the elements, 8 bits per pass. Passes over digits which are the same in all keys are skipped. The temporary array must hold as many elements as are sorted.
+template <class T> void RadixSort(RandomAccessIterator<T> begin, RandomAccessIterator<T> end, RandomAccessIterator<T> temp)
+{
+    const i32 count = (i32)(end - begin);
+    if (count < 2)
+        return;
+
+    // Count the digits of all passes at once
+    i32 offsets[8][256]{};
+    for (RandomAccessIterator<T> i = begin; i != end; ++i)
+    {
+        u64 key = i->key_;
+        for (i32 pass = 0; pass < 8; ++pass)
+            ++offsets[pass][(key >> (pass * 8)) & 0xffu];
+    }
+
+    RandomAccessIterator<T> src = begin;
+    RandomAccessIterator<T> dest = temp;
+
+    for (i32 pass = 0; pass < 8; ++pass)
+    {
+        i32* passOffsets = offsets[pass];
+        const u32 shift = (u32)(pass * 8);
+        if (passOffsets[(begin->key_ >> shift) & 0xffu] == count)
+            continue;
+
+        i32 offset = 0;
+        for (i32 digit = 0; digit < 256; ++digit)
+        {
+            i32 digitCount = passOffsets[digit];
+            passOffsets[digit] = offset;
+            offset += digitCount;
+        }
+
+        for (i32 i = 0; i < count; ++i)
+        {
+            const T& element = *(src + i);
+            *(dest + passOffsets[(element.key_ >> shift) & 0xffu]++) = element;
+        }
+
+        Swap(src, dest);
+    }
+
+    // Copy back if the result ended up in the temporary array
+    if (src != begin)
+    {
+        for (i32 i = 0; i < count; ++i)
+            *(begin + i) = *(src + i);
+    }
+}
+
 }
@@ -9,6 +9,8 @@
 #include "../Container/Ptr.h"
 #include "../Core/Variant.h"
 
+#include <type_traits>
+
 namespace Urho3D
 {
 
@@ -39,6 +41,61 @@ URHO3D_FLAGSET(AttributeMode, AttributeModeFlags);
 
 class Serializable;
 
+/// Return the Variant type which stores exactly the type T, or VAR_NONE if T is only converted to and from a Variant type. Tells typed attribute accessors apart without a dynamic cast.
+template <class T> constexpr VariantType GetTypedAttributeAccessorType()
+{
+    if constexpr (std::is_same_v<T, i32>)
+        return VAR_INT;
+    else if constexpr (std::is_same_v<T, bool>)
+        return VAR_BOOL;
+    else if constexpr (std::is_same_v<T, float>)
+        return VAR_FLOAT;
+    else if constexpr (std::is_same_v<T, double>)
+        return VAR_DOUBLE;
+    else if constexpr (std::is_same_v<T, i64>)
+        return VAR_INT64;
+    else if constexpr (std::is_same_v<T, Vector2>)
+        return VAR_VECTOR2;
+    else if constexpr (std::is_same_v<T, Vector3>)
+        return VAR_VECTOR3;
+    else if constexpr (std::is_same_v<T, Vector4>)
+        return VAR_VECTOR4;
+    else if constexpr (std::is_same_v<T, Quaternion>)
+        return VAR_QUATERNION;
+    else if constexpr (std::is_same_v<T, Color>)
+        return VAR_COLOR;
+    else if constexpr (std::is_same_v<T, String>)
+        return VAR_STRING;
+    else if constexpr (std::is_same_v<T, Vector<byte>>)
+        return VAR_BUFFER;
+    else if constexpr (std::is_same_v<T, ResourceRef>)
+        return VAR_RESOURCEREF;
+    else if constexpr (std::is_same_v<T, ResourceRefList>)
+        return VAR_RESOURCEREFLIST;
+    else if constexpr (std::is_same_v<T, VariantVector>)
+        return VAR_VARIANTVECTOR;
+    else if constexpr (std::is_same_v<T, StringVector>)
+        return VAR_STRINGVECTOR;
+    else if constexpr (std::is_same_v<T, VariantMap>)
+        return VAR_VARIANTMAP;
+    else if constexpr (std::is_same_v<T, Rect>)
+        return VAR_RECT;
+    else if constexpr (std::is_same_v<T, IntRect>)
+        return VAR_INTRECT;
+    else if constexpr (std::is_same_v<T, IntVector2>)
+        return VAR_INTVECTOR2;
+    else if constexpr (std::is_same_v<T, IntVector3>)
+        return VAR_INTVECTOR3;
+    else if constexpr (std::is_same_v<T, Matrix3>)
+        return VAR_MATRIX3;
+    else if constexpr (std::is_same_v<T, Matrix3x4>)
+        return VAR_MATRIX3X4;
+    else if constexpr (std::is_same_v<T, Matrix4>)
+        return VAR_MATRIX4;
+    else
+        return VAR_NONE;
+}
+
 /// Abstract base class for invoking attribute accessors.
 class URHO3D_API AttributeAccessor : public RefCounted
 {
@@ -47,6 +104,26 @@ public:
     virtual void Get(const Serializable* ptr, Variant& dest) const = 0;
     /// Set the attribute.
     virtual void Set(Serializable* ptr, const Variant& src) = 0;
+
+    /// Return the value type if this is a typed accessor of the exact type a Variant type stores, otherwise VAR_NONE.
+    VariantType GetTypedValueType() const { return typedValueType_; }
+
+protected:
+    /// Value type of a typed accessor.
+    VariantType typedValueType_{VAR_NONE};
+};
+
+/// Abstract base class for attribute accessors that can also read and write the attribute as its own type without a Variant.
+template <class T> class TypedAttributeAccessor : public AttributeAccessor
+{
+public:
+    /// Construct.
+    TypedAttributeAccessor() { typedValueType_ = GetTypedAttributeAccessorType<T>(); }
+
+    /// Get the attribute as its own type.
+    virtual void GetValue(const Serializable* ptr, T& dest) const = 0;
+    /// Set the attribute from its own type. The value is moved from.
+    virtual void SetValue(Serializable* ptr, T&& src) = 0;
 };
 
 /// Description of an automatically serializable variable.
@@ -61,11 +138,21 @@ struct AttributeInfo
         name_(name),
         enumNames_(enumNames),
         accessor_(accessor),
+        typedAccessorType_(accessor ? accessor->GetTypedValueType() : VAR_NONE),
         defaultValue_(defaultValue),
         mode_(mode)
     {
     }
 
+    /// Return the accessor as a typed accessor of T, or null if it is not one. Checks the type recorded at registration instead of a dynamic cast.
+    template <class T> TypedAttributeAccessor<T>* GetTypedAccessor() const
+    {
+        constexpr VariantType type = GetTypedAttributeAccessorType<T>();
+        if (type == VAR_NONE || typedAccessorType_ != type)
+            return nullptr;
+        return static_cast<TypedAttributeAccessor<T>*>(accessor_.Get());
+    }
+
     /// Get attribute metadata.
     const Variant& GetMetadata(const StringHash& key) const
     {
@@ -87,6 +174,8 @@ struct AttributeInfo
     const char** enumNames_ = nullptr;
     /// Helper object for accessor mode.
     SharedPtr<AttributeAccessor> accessor_;
+    /// Value type of the accessor if it is a typed accessor, otherwise VAR_NONE.
+    VariantType typedAccessorType_ = VAR_NONE;
     /// Default value for network replication.
     Variant defaultValue_;
     /// Attribute mode: whether to use for serialization, network replication, or both.
@@ -0,0 +1,98 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../Precompiled.h"
+
+#include "../Container/Sort.h"
+#include "../Core/AttributeNameTable.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Number of seeds tried for a bucket before giving up.
+static const u32 MAX_BUCKET_SEEDS = 65536;
+
+bool AttributeNameTable::Build(const Vector<AttributeInfo>& attributes)
+{
+    slots_.Clear();
+    seeds_.Clear();
+
+    const i32 numAttributes = attributes.Size();
+    if (!numAttributes)
+        return false;
+
+    // Keep the table at most half full and place about two names per bucket, so that seeds are quickly found
+    const u32 numSlots = NextPowerOfTwo((u32)numAttributes) * 2;
+    const u32 numBuckets = Max(NextPowerOfTwo((u32)numAttributes) / 2, 1u);
+    slotShift_ = 32 - LogBaseTwo(numSlots);
+    bucketMask_ = numBuckets - 1;
+
+    Vector<StringHash> hashes(numAttributes);
+    Vector<Vector<i32>> buckets(numBuckets);
+    for (i32 i = 0; i < numAttributes; ++i)
+    {
+        hashes[i] = StringHash(attributes[i].name_);
+        Vector<i32>& bucket = buckets[GetBucket(hashes[i].Value())];
+
+        // Same hashes can never be placed apart
+        for (i32 index : bucket)
+        {
+            if (hashes[index] == hashes[i])
+                return false;
+        }
+
+        bucket.Push(i);
+    }
+
+    // Place the largest buckets first while the table is emptiest
+    Vector<u32> order(numBuckets);
+    for (u32 i = 0; i < numBuckets; ++i)
+        order[i] = i;
+    Sort(order.Begin(), order.End(), [&buckets](u32 lhs, u32 rhs) { return buckets[lhs].Size() > buckets[rhs].Size(); });
+
+    slots_.Resize(numSlots);
+    seeds_.Resize(numBuckets, 0);
+
+    for (u32 bucketIndex : order)
+    {
+        const Vector<i32>& bucket = buckets[bucketIndex];
+        if (bucket.Empty())
+            break;
+
+        u32 seed = 0;
+        for (; seed < MAX_BUCKET_SEEDS; ++seed)
+        {
+            // Claim the slots, and give them back if one of them is taken
+            i32 numPlaced = 0;
+            for (; numPlaced < bucket.Size(); ++numPlaced)
+            {
+                Slot& slot = slots_[GetSlot(hashes[bucket[numPlaced]].Value(), seed)];
+                if (slot.index_ != NINDEX)
+                    break;
+                slot.hash_ = hashes[bucket[numPlaced]];
+                slot.index_ = bucket[numPlaced];
+            }
+
+            if (numPlaced == bucket.Size())
+                break;
+
+            for (i32 i = 0; i < numPlaced; ++i)
+                slots_[GetSlot(hashes[bucket[i]].Value(), seed)] = Slot();
+        }
+
+        if (seed == MAX_BUCKET_SEEDS)
+        {
+            slots_.Clear();
+            seeds_.Clear();
+            return false;
+        }
+
+        seeds_[bucketIndex] = seed;
+    }
+
+    return true;
+}
+
+}
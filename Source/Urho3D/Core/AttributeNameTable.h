@@ -0,0 +1,59 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+/// \file
+
+#pragma once
+
+#include "../Core/Attribute.h"
+
+namespace Urho3D
+{
+
+/// Perfect hash table from attribute name hashes to indices in the attribute descriptions of an object type. Names are hashed to buckets, and each bucket has a seed that places its names to free slots without collisions, so a lookup reads exactly one slot.
+/// @nobind
+class URHO3D_API AttributeNameTable
+{
+public:
+    /// Build for attribute descriptions. Return false and leave the table empty if two names have the same hash.
+    bool Build(const Vector<AttributeInfo>& attributes);
+
+    /// Return index of the attribute whose name has the hash, or NINDEX if not found. The name strings are not compared.
+    i32 Find(StringHash nameHash) const
+    {
+        if (slots_.Empty())
+            return NINDEX;
+
+        const Slot& slot = slots_[GetSlot(nameHash.Value(), seeds_[GetBucket(nameHash.Value())])];
+        return slot.hash_ == nameHash ? slot.index_ : NINDEX;
+    }
+
+    /// Return number of slots. Zero if not built.
+    i32 GetNumSlots() const { return slots_.Size(); }
+
+private:
+    /// Slot of the table.
+    struct Slot
+    {
+        /// Attribute name hash.
+        StringHash hash_;
+        /// Attribute index, or NINDEX if the slot is free.
+        i32 index_{NINDEX};
+    };
+
+    /// Return bucket of a name hash.
+    u32 GetBucket(hash32 hash) const { return ((hash * 0x85ebca6bu) >> 16u) & bucketMask_; }
+    /// Return slot of a name hash with the seed of its bucket.
+    u32 GetSlot(hash32 hash, u32 seed) const { return ((hash ^ seed) * 0x9e3779b1u) >> slotShift_; }
+
+    /// Slots.
+    Vector<Slot> slots_;
+    /// Seeds per bucket.
+    Vector<u32> seeds_;
+    /// Mask for bucket index.
+    u32 bucketMask_{};
+    /// Shift for slot index.
+    u32 slotShift_{};
+};
+
+}
@@ -42,6 +42,7 @@ void Condition::Wait()
 
 Condition::Condition() :
     mutex_(new pthread_mutex_t),
+    signaled_(false),
     event_(new pthread_cond_t)
 {
     pthread_mutex_init((pthread_mutex_t*)mutex_, nullptr);
@@ -63,7 +64,12 @@ Condition::~Condition()
 
 void Condition::Set()
 {
+    auto* mutex = (pthread_mutex_t*)mutex_;
+
+    pthread_mutex_lock(mutex);
+    signaled_ = true;
     pthread_cond_signal((pthread_cond_t*)event_);
+    pthread_mutex_unlock(mutex);
 }
 
 void Condition::Wait()
@@ -72,7 +78,10 @@ void Condition::Wait()
     auto* mutex = (pthread_mutex_t*)mutex_;
 
     pthread_mutex_lock(mutex);
-    pthread_cond_wait(cond, mutex);
+    // Also guards against spurious wakeups
+    while (!signaled_)
+        pthread_cond_wait(cond, mutex);
+    signaled_ = false;
     pthread_mutex_unlock(mutex);
 }
 
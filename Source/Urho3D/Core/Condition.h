@@ -32,6 +32,8 @@ private:
 #ifndef _WIN32
     /// Mutex for the event, necessary for pthreads-based implementation.
     void* mutex_;
+    /// Set flag, necessary for pthreads-based implementation so that a set before waiting is not lost.
+    bool signaled_;
 #endif
     /// Operating system specific event.
     void* event_;
@@ -5,6 +5,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/EventProfiler.h"
+#include "../Core/TypedEvent.h"
 #include "../IO/Log.h"
 
 #ifndef MINI_URHO
@@ -130,6 +131,10 @@ Context::~Context()
     for (Vector<VariantMap*>::Iterator i = eventDataMaps_.Begin(); i != eventDataMaps_.End(); ++i)
         delete *i;
     eventDataMaps_.Clear();
+
+    for (FlatHashMap<StringHash, TypedEventChannelBase*>::Iterator i = typedEventChannels_.Begin(); i != typedEventChannels_.End(); ++i)
+        delete i->second_;
+    typedEventChannels_.Clear();
 }
 
 SharedPtr<Object> Context::CreateObject(StringHash objectType)
@@ -190,6 +195,7 @@ AttributeHandle Context::RegisterAttribute(StringHash objectType, const Attribut
     Vector<AttributeInfo>& objectAttributes = attributes_[objectType];
     objectAttributes.Push(attr);
     handle.attributeInfo_ = &objectAttributes.Back();
+    MarkAttributeNameTableDirty(objectType);
 
     if (attr.mode_ & AM_NET)
     {
@@ -204,12 +210,14 @@ void Context::RemoveAttribute(StringHash objectType, const char* name)
 {
     RemoveNamedAttribute(attributes_, objectType, name);
     RemoveNamedAttribute(networkAttributes_, objectType, name);
+    MarkAttributeNameTableDirty(objectType);
 }
 
 void Context::RemoveAllAttributes(StringHash objectType)
 {
     attributes_.Erase(objectType);
     networkAttributes_.Erase(objectType);
+    MarkAttributeNameTableDirty(objectType);
 }
 
 void Context::UpdateAttributeDefaultValue(StringHash objectType, const char* name, const Variant& defaultValue)
@@ -329,6 +337,8 @@ void Context::CopyBaseAttributes(StringHash baseType, StringHash derivedType)
             if (attr.mode_ & AM_NET)
                 networkAttributes_[derivedType].Push(attr);
         }
+
+        MarkAttributeNameTableDirty(derivedType);
     }
 }
 
@@ -375,6 +385,14 @@ AttributeInfo* Context::GetAttribute(StringHash objectType, const char* name)
 
     Vector<AttributeInfo>& infos = i->second_;
 
+    // Names are unique when the name table exists, so the name needs to be compared only once
+    const AttributeNameTable* nameTable = GetAttributeNameTable(objectType);
+    if (nameTable)
+    {
+        i32 index = nameTable->Find(StringHash(name));
+        return index != NINDEX && !infos[index].name_.Compare(name, true) ? &infos[index] : nullptr;
+    }
+
     for (Vector<AttributeInfo>::Iterator j = infos.Begin(); j != infos.End(); ++j)
     {
         if (!j->name_.Compare(name, true))
@@ -384,6 +402,25 @@ AttributeInfo* Context::GetAttribute(StringHash objectType, const char* name)
     return nullptr;
 }
 
+const AttributeNameTable* Context::GetAttributeNameTable(StringHash type) const
+{
+    MutexLock lock(attributeNameTableMutex_);
+
+    if (!dirtyAttributeNameTables_.Empty() && dirtyAttributeNameTables_.Erase(type))
+    {
+        // Build over the existing table instead of erasing it, so that it stays at the same address. The table is left
+        // empty when the names can not be hashed perfectly, and name lookups search linearly instead
+        const Vector<AttributeInfo>* attributes = GetAttributes(type);
+        if (attributes)
+            attributeNameTables_[type].Build(*attributes);
+        else
+            attributeNameTables_.Erase(type);
+    }
+
+    HashMap<StringHash, AttributeNameTable>::ConstIterator i = attributeNameTables_.Find(type);
+    return i != attributeNameTables_.End() && i->second_.GetNumSlots() ? &i->second_ : nullptr;
+}
+
 void Context::AddEventReceiver(Object* receiver, StringHash eventType)
 {
     SharedPtr<EventReceiverGroup>& group = eventReceivers_[eventType];
@@ -402,10 +439,10 @@ void Context::AddEventReceiver(Object* receiver, Object* sender, StringHash even
 
 void Context::RemoveEventSender(Object* sender)
 {
-    HashMap<Object*, HashMap<StringHash, SharedPtr<EventReceiverGroup>>>::Iterator i = specificEventReceivers_.Find(sender);
+    FlatHashMap<Object*, FlatHashMap<StringHash, SharedPtr<EventReceiverGroup>>>::Iterator i = specificEventReceivers_.Find(sender);
     if (i != specificEventReceivers_.End())
     {
-        for (HashMap<StringHash, SharedPtr<EventReceiverGroup>>::Iterator j = i->second_.Begin(); j != i->second_.End(); ++j)
+        for (FlatHashMap<StringHash, SharedPtr<EventReceiverGroup>>::Iterator j = i->second_.Begin(); j != i->second_.End(); ++j)
         {
             for (Vector<Object*>::Iterator k = j->second_->receivers_.Begin(); k != j->second_->receivers_.End(); ++k)
             {
@@ -432,6 +469,18 @@ void Context::RemoveEventReceiver(Object* receiver, Object* sender, StringHash e
         group->Remove(receiver);
 }
 
+void Context::RemoveTypedEventReceiver(Object* receiver)
+{
+    for (FlatHashMap<StringHash, TypedEventChannelBase*>::Iterator i = typedEventChannels_.Begin(); i != typedEventChannels_.End(); ++i)
+        i->second_->RemoveReceiver(receiver);
+}
+
+void Context::RemoveTypedEventSender(Object* sender)
+{
+    for (FlatHashMap<StringHash, TypedEventChannelBase*>::Iterator i = typedEventChannels_.Begin(); i != typedEventChannels_.End(); ++i)
+        i->second_->RemoveSender(sender);
+}
+
 void Context::BeginSendEvent(Object* sender, StringHash eventType)
 {
 #ifdef URHO3D_PROFILING
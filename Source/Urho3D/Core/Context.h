@@ -3,13 +3,18 @@
 
 #pragma once
 
+#include "../Container/FlatHashMap.h"
 #include "../Container/HashSet.h"
-#include "../Core/Attribute.h"
+#include "../Core/AttributeNameTable.h"
+#include "../Core/Mutex.h"
 #include "../Core/Object.h"
 
 namespace Urho3D
 {
 
+class TypedEventChannelBase;
+template <class E> class TypedEventChannel;
+
 /// Tracking structure for event receivers.
 class URHO3D_API EventReceiverGroup : public RefCounted
 {
@@ -161,16 +166,20 @@ public:
         return i != networkAttributes_.End() ? &i->second_ : nullptr;
     }
 
+    /// Return the perfect hash table from attribute names to indices for an object type, or null if none defined or two attribute names have the same hash. The table is rebuilt here if the attributes changed since. Safe to call from worker threads while no attributes are registered, and the table stays at the same address for as long as the type has attributes.
+    /// @nobind
+    const AttributeNameTable* GetAttributeNameTable(StringHash type) const;
+
     /// Return all registered attributes.
     const HashMap<StringHash, Vector<AttributeInfo>>& GetAllAttributes() const { return attributes_; }
 
     /// Return event receivers for a sender and event type, or null if they do not exist.
     EventReceiverGroup* GetEventReceivers(Object* sender, StringHash eventType)
     {
-        HashMap<Object*, HashMap<StringHash, SharedPtr<EventReceiverGroup>>>::Iterator i = specificEventReceivers_.Find(sender);
+        FlatHashMap<Object*, FlatHashMap<StringHash, SharedPtr<EventReceiverGroup>>>::Iterator i = specificEventReceivers_.Find(sender);
         if (i != specificEventReceivers_.End())
         {
-            HashMap<StringHash, SharedPtr<EventReceiverGroup>>::Iterator j = i->second_.Find(eventType);
+            FlatHashMap<StringHash, SharedPtr<EventReceiverGroup>>::Iterator j = i->second_.Find(eventType);
             return j != i->second_.End() ? j->second_ : nullptr;
         }
         else
@@ -180,10 +189,15 @@ public:
     /// Return event receivers for an event type, or null if they do not exist.
     EventReceiverGroup* GetEventReceivers(StringHash eventType)
     {
-        HashMap<StringHash, SharedPtr<EventReceiverGroup>>::Iterator i = eventReceivers_.Find(eventType);
+        FlatHashMap<StringHash, SharedPtr<EventReceiverGroup>>::Iterator i = eventReceivers_.Find(eventType);
         return i != eventReceivers_.End() ? i->second_ : nullptr;
     }
 
+    /// Return the channel of a typed event struct, or null if nothing has subscribed to it yet. Defined in TypedEvent.h.
+    template <class E> TypedEventChannel<E>* GetTypedEventChannel() const;
+    /// Return the channel of a typed event struct. Create if necessary. Defined in TypedEvent.h.
+    template <class E> TypedEventChannel<E>* RequireTypedEventChannel();
+
 private:
     /// Add event receiver.
     void AddEventReceiver(Object* receiver, StringHash eventType);
@@ -199,6 +213,21 @@ private:
     void BeginSendEvent(Object* sender, StringHash eventType);
     /// End event send. Clean up event receivers removed in the meanwhile.
     void EndSendEvent();
+    /// Begin typed event send.
+    void BeginSendTypedEvent(Object* sender) { eventSenders_.Push(sender); }
+    /// End typed event send.
+    void EndSendTypedEvent() { eventSenders_.Pop(); }
+    /// Remove a receiver from all typed event channels.
+    void RemoveTypedEventReceiver(Object* receiver);
+    /// Remove a sender from all typed event channels. Called on its destruction.
+    void RemoveTypedEventSender(Object* sender);
+
+    /// Mark the attribute name table of an object type to be rebuilt when next needed, after its attributes changed.
+    void MarkAttributeNameTableDirty(StringHash objectType)
+    {
+        MutexLock lock(attributeNameTableMutex_);
+        dirtyAttributeNameTables_.Insert(objectType);
+    }
 
     /// Set current event handler. Called by Object.
     void SetEventHandler(EventHandler* handler) { eventHandler_ = handler; }
@@ -211,14 +240,22 @@ private:
     HashMap<StringHash, Vector<AttributeInfo>> attributes_;
     /// Network replication attribute descriptions per object type.
     HashMap<StringHash, Vector<AttributeInfo>> networkAttributes_;
+    /// Attribute name tables per object type. Node-based so that returned tables stay in place when tables of other types are built.
+    mutable HashMap<StringHash, AttributeNameTable> attributeNameTables_;
+    /// Object types whose attribute name tables need to be rebuilt. Registering attributes one by one only marks the type, so that the table is built once.
+    mutable HashSet<StringHash> dirtyAttributeNameTables_;
+    /// Attribute name table mutex, as the tables are built on lookup, which background loading may do.
+    mutable Mutex attributeNameTableMutex_;
     /// Event receivers for non-specific events.
-    HashMap<StringHash, SharedPtr<EventReceiverGroup>> eventReceivers_;
+    FlatHashMap<StringHash, SharedPtr<EventReceiverGroup>> eventReceivers_;
     /// Event receivers for specific senders' events.
-    HashMap<Object*, HashMap<StringHash, SharedPtr<EventReceiverGroup>>> specificEventReceivers_;
+    FlatHashMap<Object*, FlatHashMap<StringHash, SharedPtr<EventReceiverGroup>>> specificEventReceivers_;
     /// Event sender stack.
     Vector<Object*> eventSenders_;
     /// Event data stack.
     Vector<VariantMap*> eventDataMaps_;
+    /// Typed event channels by typed event type.
+    FlatHashMap<StringHash, TypedEventChannelBase*> typedEventChannels_;
     /// Active event handler. Not stored in a stack for performance reasons; is needed only in esoteric cases.
     EventHandler* eventHandler_;
     /// Object categories.
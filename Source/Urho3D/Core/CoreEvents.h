@@ -27,6 +27,32 @@ URHO3D_EVENT(E_POSTUPDATE, PostUpdate)
     URHO3D_PARAM(P_TIMESTEP, TimeStep);            // float
 }
 
+/// Typed version of E_UPDATE, sent without a VariantMap to SubscribeToTypedEvent() subscribers.
+/// @nobind
+struct UpdateEvent
+{
+    URHO3D_TYPED_EVENT_BRIDGE(UpdateEvent, E_UPDATE)
+
+    /// Fill the parameters of E_UPDATE.
+    void ToEventData(VariantMap& eventData) const { eventData[Update::P_TIMESTEP] = timeStep_; }
+
+    /// Timestep.
+    float timeStep_;
+};
+
+/// Typed version of E_POSTUPDATE.
+/// @nobind
+struct PostUpdateEvent
+{
+    URHO3D_TYPED_EVENT_BRIDGE(PostUpdateEvent, E_POSTUPDATE)
+
+    /// Fill the parameters of E_POSTUPDATE.
+    void ToEventData(VariantMap& eventData) const { eventData[PostUpdate::P_TIMESTEP] = timeStep_; }
+
+    /// Timestep.
+    float timeStep_;
+};
+
 /// Render update event.
 URHO3D_EVENT(E_RENDERUPDATE, RenderUpdate)
 {
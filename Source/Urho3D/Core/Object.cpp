@@ -3,12 +3,17 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/FrameArena.h"
+#include "../Container/Sort.h"
 #include "../Core/Context.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/Thread.h"
+#include "../Core/TypedEvent.h"
 #include "../Core/Profiler.h"
 #include "../IO/Log.h"
 
+#include <algorithm>
+
 #include "../DebugNew.h"
 
 
@@ -57,7 +62,8 @@ bool TypeInfo::IsTypeOf(const TypeInfo* typeInfo) const
 
 Object::Object(Context* context) :
     context_(context),
-    blockEvents_(false)
+    blockEvents_(false),
+    hasTypedEvents_(false)
 {
     assert(context_);
 }
@@ -66,6 +72,8 @@ Object::~Object()
 {
     UnsubscribeFromAllEvents();
     context_->RemoveEventSender(this);
+    if (hasTypedEvents_)
+        context_->RemoveTypedEventSender(this);
 }
 
 void Object::OnEvent(Object* sender, StringHash eventType, VariantMap& eventData)
@@ -245,6 +253,9 @@ void Object::UnsubscribeFromAllEvents()
         else
             break;
     }
+
+    if (hasTypedEvents_)
+        context_->RemoveTypedEventReceiver(this);
 }
 
 void Object::UnsubscribeFromAllEventsExcept(const Vector<StringHash>& exceptions, bool onlyUserData)
@@ -300,7 +311,8 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
     // Make a weak pointer to self to check for destruction during event handling
     WeakPtr<Object> self(this);
     Context* context = context_;
-    HashSet<Object*> processed;
+    // Receivers that got the event as specific receivers. Allocated from the frame arena, as most events have none
+    FrameVector<Object*> processed;
 
     context->BeginSendEvent(this, eventType);
 
@@ -329,7 +341,7 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
                 return;
             }
 
-            processed.Insert(receiver);
+            processed.Push(receiver);
         }
 
         group->EndSendEvent();
@@ -363,11 +375,13 @@ void Object::SendEvent(StringHash eventType, VariantMap& eventData)
         else
         {
             // If there were specific receivers, check that the event is not sent doubly to them
+            Sort(RandomAccessIterator<Object*>(processed.Begin()), RandomAccessIterator<Object*>(processed.End()));
+
             const unsigned numReceivers = group->receivers_.Size();
             for (unsigned i = 0; i < numReceivers; ++i)
             {
                 Object* receiver = group->receivers_[i];
-                if (!receiver || processed.Contains(receiver))
+                if (!receiver || std::binary_search(processed.Begin(), processed.End(), receiver))
                     continue;
 
                 receiver->OnEvent(this, eventType, eventData);
@@ -125,6 +125,15 @@ public:
         SendEvent(eventType, GetEventDataMap().Populate(args...));
     }
 
+    /// Subscribe a member function void Handler(E& event) of this object to a typed event struct E, sent by a specific sender or by any sender when null. Defined in TypedEvent.h.
+    template <auto Handler> void SubscribeToTypedEvent(Object* sender = nullptr);
+    /// Unsubscribe from a typed event struct. Defined in TypedEvent.h.
+    template <class E> void UnsubscribeFromTypedEvent(Object* sender = nullptr);
+    /// Return whether has subscribed to a typed event struct. Defined in TypedEvent.h.
+    template <class E> bool HasSubscribedToTypedEvent(Object* sender = nullptr) const;
+    /// Send a typed event struct to its subscribers without allocating. If the struct is bridged to a VariantMap event, send that as well when it has subscribers. Defined in TypedEvent.h.
+    template <class E> void SendTypedEvent(E& event);
+
     /// Return execution context.
     Context* GetContext() const { return context_; }
     /// Return global variable based on key.
@@ -180,6 +189,8 @@ private:
 
     /// Block object from sending and receiving any events.
     bool blockEvents_;
+    /// Has subscribed to, or been subscribed to as sender of, typed events.
+    bool hasTypedEvents_;
 };
 
 template <class T> T* Object::GetSubsystem() const { return static_cast<T*>(GetSubsystem(T::GetTypeStatic())); }
@@ -350,8 +361,16 @@ URHO3D_API StringHashRegister& GetEventNameRegister();
 
 /// Describe an event's hash ID and begin a namespace in which to define its parameters.
 #define URHO3D_EVENT(eventID, eventName) static const Urho3D::StringHash eventID(Urho3D::GetEventNameRegister().RegisterString(#eventName)); namespace eventName
-/// Describe an event's parameter hash ID. Should be used inside an event namespace.
+/// Describe an event's parameter hash ID. Should be used inside an event namespace. The hash is computed at compile time unless hash debugging registers the name.
+#ifdef URHO3D_HASH_DEBUG
 #define URHO3D_PARAM(paramID, paramName) static const Urho3D::StringHash paramID(#paramName)
+#else
+#define URHO3D_PARAM(paramID, paramName) static constexpr Urho3D::StringHash paramID(#paramName)
+#endif
+/// Declare a typed event struct. Should be used inside the struct. The struct is identified by the hash of its name, which is the same in every module, so the name must be unique among typed events.
+#define URHO3D_TYPED_EVENT(typeName) static constexpr Urho3D::StringHash GetTypedEventType() { return Urho3D::StringHash(#typeName); }
+/// Declare a typed event struct bridged to a URHO3D_EVENT event: sending the struct also sends the event to its VariantMap subscribers, if there are any. Should be used inside the struct, which must also define void ToEventData(VariantMap& eventData) const.
+#define URHO3D_TYPED_EVENT_BRIDGE(typeName, eventID) URHO3D_TYPED_EVENT(typeName) static Urho3D::StringHash GetBridgedEventType() { return eventID; }
 /// Convenience macro to construct an EventHandler that points to a receiver object and its member function.
 #define URHO3D_HANDLER(className, function) (new Urho3D::EventHandlerImpl<className>(this, &className::function))
 /// Convenience macro to construct an EventHandler that points to a receiver object and its member function, and also defines a userdata pointer.
@@ -3,6 +3,7 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/FrameArena.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
 
@@ -119,6 +120,9 @@ void Time::EndFrame()
         SendEvent(E_ENDFRAME);
     }
 
+    // Rewind the frame arenas of all threads on their next use
+    FrameArena::EndFrame();
+
 #ifdef URHO3D_PROFILING
     auto* profiler = GetSubsystem<Profiler>();
     if (profiler)
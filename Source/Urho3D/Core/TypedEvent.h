@@ -0,0 +1,262 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../Core/Context.h"
+#include "../Core/Thread.h"
+#include "../IO/Log.h"
+
+#include <type_traits>
+
+namespace Urho3D
+{
+
+/// Base class of typed event channels, which the context stores by index.
+/// @nobind
+class URHO3D_API TypedEventChannelBase
+{
+public:
+    /// Destruct.
+    virtual ~TypedEventChannelBase() = default;
+
+    /// Remove the subscriptions of a receiver.
+    virtual void RemoveReceiver(Object* receiver) = 0;
+    /// Remove the subscriptions to a specific sender. Called on its destruction.
+    virtual void RemoveSender(Object* sender) = 0;
+};
+
+/// Receivers of one typed event struct. Sending iterates a flat array and calls the handlers directly, without
+/// building a VariantMap or allocating memory.
+/// @nobind
+template <class E> class TypedEventChannel : public TypedEventChannelBase
+{
+public:
+    /// Handler function. Receives the receiver object and the event.
+    using HandlerFunction = void (*)(Object* receiver, E& event);
+
+    /// Subscription.
+    struct Subscription
+    {
+        /// Receiver. Null if removed during send.
+        Object* receiver_;
+        /// Sender, or null to receive from any sender.
+        Object* sender_;
+        /// Handler function.
+        HandlerFunction function_;
+    };
+
+    /// Add a subscription, or replace the handler of an existing one with the same receiver and sender.
+    void Subscribe(Object* receiver, Object* sender, HandlerFunction function)
+    {
+        for (Subscription& subscription : subscriptions_)
+        {
+            if (subscription.receiver_ == receiver && subscription.sender_ == sender)
+            {
+                subscription.function_ = function;
+                return;
+            }
+        }
+
+        subscriptions_.Push(Subscription{receiver, sender, function});
+    }
+
+    /// Remove a subscription.
+    void Unsubscribe(Object* receiver, Object* sender)
+    {
+        for (i32 i = 0; i < subscriptions_.Size(); ++i)
+        {
+            if (subscriptions_[i].receiver_ == receiver && subscriptions_[i].sender_ == sender)
+            {
+                RemoveAt(i);
+                return;
+            }
+        }
+    }
+
+    /// Remove the subscriptions of a receiver.
+    void RemoveReceiver(Object* receiver) override
+    {
+        for (i32 i = subscriptions_.Size() - 1; i >= 0; --i)
+        {
+            if (subscriptions_[i].receiver_ == receiver)
+                RemoveAt(i);
+        }
+    }
+
+    /// Remove the subscriptions to a specific sender.
+    void RemoveSender(Object* sender) override
+    {
+        for (i32 i = subscriptions_.Size() - 1; i >= 0; --i)
+        {
+            if (subscriptions_[i].sender_ == sender)
+                RemoveAt(i);
+        }
+    }
+
+    /// Call the handlers subscribed to all senders or to this sender. Receivers added during send do not receive the event.
+    void Send(Object* sender, E& event)
+    {
+        ++inSend_;
+
+        const i32 numSubscriptions = subscriptions_.Size();
+        for (i32 i = 0; i < numSubscriptions; ++i)
+        {
+            // Copy, as the array may be reallocated by the handler
+            const Subscription subscription = subscriptions_[i];
+            if (!subscription.receiver_ || (subscription.sender_ && subscription.sender_ != sender) ||
+                subscription.receiver_->GetBlockEvents())
+                continue;
+
+            subscription.function_(subscription.receiver_, event);
+        }
+
+        if (--inSend_ == 0 && dirty_)
+        {
+            // Keep the receiver order
+            for (i32 i = subscriptions_.Size() - 1; i >= 0; --i)
+            {
+                if (!subscriptions_[i].receiver_)
+                    subscriptions_.Erase(i);
+            }
+
+            dirty_ = false;
+        }
+    }
+
+    /// Return whether has any subscriptions.
+    bool HasSubscriptions() const { return !subscriptions_.Empty(); }
+
+    /// Return whether a receiver has subscribed, to a specific sender or to all senders when sender is null.
+    bool HasSubscribed(Object* receiver, Object* sender) const
+    {
+        for (const Subscription& subscription : subscriptions_)
+        {
+            if (subscription.receiver_ == receiver && subscription.sender_ == sender)
+                return true;
+        }
+
+        return false;
+    }
+
+private:
+    /// Remove a subscription. Leave a hole during send.
+    void RemoveAt(i32 index)
+    {
+        if (inSend_)
+        {
+            subscriptions_[index].receiver_ = nullptr;
+            subscriptions_[index].sender_ = nullptr;
+            dirty_ = true;
+        }
+        else
+            subscriptions_.Erase(index);
+    }
+
+    /// Subscriptions. May contain holes during send.
+    Vector<Subscription> subscriptions_;
+    /// "In send" recursion counter.
+    unsigned inSend_{};
+    /// Cleanup required flag.
+    bool dirty_{};
+};
+
+/// Split a typed event handler member function pointer into its class and event struct.
+template <class> struct TypedEventHandlerTraits;
+
+template <class T, class E> struct TypedEventHandlerTraits<void (T::*)(E&)>
+{
+    using ClassType = T;
+    using EventType = E;
+};
+
+/// Detect whether a typed event struct is bridged to a VariantMap event.
+template <class E, class = void> struct IsBridgedTypedEvent : std::false_type {};
+
+template <class E> struct IsBridgedTypedEvent<E, std::void_t<decltype(E::GetBridgedEventType())>> : std::true_type {};
+
+template <class E> TypedEventChannel<E>* Context::GetTypedEventChannel() const
+{
+    FlatHashMap<StringHash, TypedEventChannelBase*>::ConstIterator i = typedEventChannels_.Find(E::GetTypedEventType());
+    return i != typedEventChannels_.End() ? static_cast<TypedEventChannel<E>*>(i->second_) : nullptr;
+}
+
+template <class E> TypedEventChannel<E>* Context::RequireTypedEventChannel()
+{
+    TypedEventChannelBase*& channel = typedEventChannels_[E::GetTypedEventType()];
+    if (!channel)
+        channel = new TypedEventChannel<E>();
+
+    return static_cast<TypedEventChannel<E>*>(channel);
+}
+
+template <auto Handler> void Object::SubscribeToTypedEvent(Object* sender)
+{
+    using Traits = TypedEventHandlerTraits<decltype(Handler)>;
+    using T = typename Traits::ClassType;
+    using E = typename Traits::EventType;
+
+    // Capture the member function at compile time, so that the channel stores a plain function pointer
+    context_->RequireTypedEventChannel<E>()->Subscribe(this, sender, [](Object* receiver, E& event)
+    {
+        (static_cast<T*>(receiver)->*Handler)(event);
+    });
+
+    hasTypedEvents_ = true;
+    if (sender)
+        sender->hasTypedEvents_ = true;
+}
+
+template <class E> void Object::UnsubscribeFromTypedEvent(Object* sender)
+{
+    TypedEventChannel<E>* channel = context_->GetTypedEventChannel<E>();
+    if (channel)
+        channel->Unsubscribe(this, sender);
+}
+
+template <class E> bool Object::HasSubscribedToTypedEvent(Object* sender) const
+{
+    TypedEventChannel<E>* channel = context_->GetTypedEventChannel<E>();
+    return channel && channel->HasSubscribed(const_cast<Object*>(this), sender);
+}
+
+template <class E> void Object::SendTypedEvent(E& event)
+{
+    if (!Thread::IsMainThread())
+    {
+        URHO3D_LOGERROR("Sending events is only supported from the main thread");
+        return;
+    }
+
+    if (blockEvents_)
+        return;
+
+    // Make a weak pointer to self to check for destruction during event handling
+    WeakPtr<Object> self(this);
+    Context* context = context_;
+
+    TypedEventChannel<E>* channel = context->GetTypedEventChannel<E>();
+    if (channel && channel->HasSubscriptions())
+    {
+        context->BeginSendTypedEvent(this);
+        channel->Send(this, event);
+        context->EndSendTypedEvent();
+
+        if (self.Expired())
+            return;
+    }
+
+    if constexpr (IsBridgedTypedEvent<E>::value)
+    {
+        // Fill the VariantMap only if the event has VariantMap subscribers
+        const StringHash eventType = E::GetBridgedEventType();
+        if (context->GetEventReceivers(this, eventType) || context->GetEventReceivers(eventType))
+        {
+            VariantMap& eventData = GetEventDataMap();
+            event.ToEventData(eventData);
+            SendEvent(eventType, eventData);
+        }
+    }
+}
+
+}
@@ -121,6 +121,27 @@ Variant& Variant::operator =(const Variant& rhs)
     return *this;
 }
 
+Variant& Variant::operator =(Variant&& rhs) noexcept
+{
+    if (&rhs == this)
+        return *this;
+
+    // A custom value stored in the variant may point into itself, so copy it instead
+    if (rhs.type_ == VAR_CUSTOM_STACK)
+    {
+        *this = static_cast<const Variant&>(rhs);
+        return *this;
+    }
+
+    // The other values do not point into the variant, so they can be moved by copying the bytes
+    SetType(VAR_NONE);
+    memcpy(&value_, &rhs.value_, sizeof(VariantValue));     // NOLINT(bugprone-undefined-memory-manipulation)
+    type_ = rhs.type_;
+    rhs.type_ = VAR_NONE;
+
+    return *this;
+}
+
 Variant& Variant::operator =(const VectorBuffer& rhs)
 {
     SetType(VAR_BUFFER);
@@ -14,6 +14,7 @@
 #include "../Math/StringHash.h"
 
 #include <typeinfo>
+#include <utility>
 
 namespace Urho3D
 {
@@ -551,6 +552,12 @@ public:
         *this = value;
     }
 
+    /// Move-construct from another variant. The other variant becomes empty.
+    Variant(Variant&& value) noexcept
+    {
+        *this = std::move(value);
+    }
+
     /// Destruct.
     ~Variant()
     {
@@ -565,6 +572,8 @@ public:
 
     /// Assign from another variant.
     Variant& operator =(const Variant& rhs);
+    /// Move-assign from another variant. The other variant becomes empty.
+    Variant& operator =(Variant&& rhs) noexcept;
 
     /// Assign from an integer.
     Variant& operator =(int rhs)
@@ -98,7 +98,7 @@ SharedPtr<WorkItem> WorkQueue::GetFreeItem()
 {
     if (poolItems_.Size() > 0)
     {
-        SharedPtr<WorkItem> item = poolItems_.Front();
+        SharedPtr<WorkItem> item = std::move(poolItems_.Front());
         poolItems_.PopFront();
         return item;
     }
@@ -389,7 +389,8 @@ void WorkQueue::ReturnToPool(SharedPtr<WorkItem>& item)
         item->sendEvent_ = false;
         item->completed_ = false;
 
-        poolItems_.Push(item);
+        // The caller erases the item from its list afterward, so move it to the pool
+        poolItems_.Push(std::move(item));
     }
 }
 
@@ -105,7 +105,7 @@ private:
     void PurgeCompleted(i32 priority);
     /// Purge the pool to reduce allocation where its unneeded.
     void PurgePool();
-    /// Return a work item to the pool.
+    /// Return a work item to the pool. A pooled item is moved from.
     void ReturnToPool(SharedPtr<WorkItem>& item);
     /// Handle frame start event. Purge completed work from the main thread queue, and perform work if no threads at all.
     void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
@@ -7,6 +7,7 @@
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/EventProfiler.h"
+#include "../Core/TypedEvent.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/WorkQueue.h"
 #include "../Engine/Console.h"
@@ -359,6 +360,8 @@ bool Engine::InitializeResourceCache(const VariantMap& parameters, bool removeOl
             cache->RemovePackageFile(packageFiles[i]);
     }
 
+    cache->SetMemoryMapPackages(GetParameter(parameters, EP_MEMORY_MAP_PACKAGES, false).GetBool());
+
     // Add resource paths
     Vector<String> resourcePrefixPaths = GetParameter(parameters, EP_RESOURCE_PREFIX_PATHS, String::EMPTY).GetString().Split(';', true);
     for (unsigned i = 0; i < resourcePrefixPaths.Size(); ++i)
@@ -714,14 +717,17 @@ void Engine::Update()
     URHO3D_PROFILE(Update);
 
     // Logic update event
+    UpdateEvent update{timeStep_};
+    SendTypedEvent(update);
+
+    // Logic post-update event
+    PostUpdateEvent postUpdate{timeStep_};
+    SendTypedEvent(postUpdate);
+
     using namespace Update;
 
     VariantMap& eventData = GetEventDataMap();
     eventData[P_TIMESTEP] = timeStep_;
-    SendEvent(E_UPDATE, eventData);
-
-    // Logic post-update event
-    SendEvent(E_POSTUPDATE, eventData);
 
     // Rendering update event
     SendEvent(E_RENDERUPDATE, eventData);
@@ -22,44 +22,77 @@
 namespace Urho3D
 {
 
-inline bool CompareBatchesState(Batch* lhs, Batch* rhs)
+inline bool CompareInstancesFrontToBack(const InstanceData& lhs, const InstanceData& rhs)
 {
-    if (lhs->renderOrder_ != rhs->renderOrder_)
-        return lhs->renderOrder_ < rhs->renderOrder_;
-    else if (lhs->sortKey_ != rhs->sortKey_)
-        return lhs->sortKey_ < rhs->sortKey_;
-    else
-        return lhs->distance_ < rhs->distance_;
+    return lhs.distance_ < rhs.distance_;
 }
 
-inline bool CompareBatchesFrontToBack(Batch* lhs, Batch* rhs)
+/// Return render order as an unsigned 8-bit key which sorts in the same order.
+inline u64 GetRenderOrderKey(i8 renderOrder)
 {
-    if (lhs->renderOrder_ != rhs->renderOrder_)
-        return lhs->renderOrder_ < rhs->renderOrder_;
-    else if (lhs->distance_ != rhs->distance_)
-        return lhs->distance_ < rhs->distance_;
-    else
-        return lhs->sortKey_ < rhs->sortKey_;
+    return (u8)(renderOrder + 128);
 }
 
-inline bool CompareBatchesBackToFront(Batch* lhs, Batch* rhs)
+/// Return distance as an unsigned 32-bit key which sorts in the same order.
+inline u64 GetDistanceKey(float distance)
 {
-    if (lhs->renderOrder_ != rhs->renderOrder_)
-        return lhs->renderOrder_ < rhs->renderOrder_;
-    else if (lhs->distance_ != rhs->distance_)
-        return lhs->distance_ > rhs->distance_;
-    else
-        return lhs->sortKey_ < rhs->sortKey_;
+    u32 bits;
+    memcpy(&bits, &distance, sizeof(bits));
+    // Flip all bits of negative values and only the sign bit of positive values
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
 }
 
-inline bool CompareInstancesFrontToBack(const InstanceData& lhs, const InstanceData& rhs)
+/// Return key for sorting by render order, then state. Requires the shader ID of the sort key to have been remapped to 23 bits.
+inline u64 GetStateKey(const Batch& batch)
 {
-    return lhs.distance_ < rhs.distance_;
+    return (GetRenderOrderKey(batch.renderOrder_) << 56u) | ((batch.sortKey_ >> 8u) & 0x0080000000000000ull) |
+           (batch.sortKey_ & 0x007fffffffffffffull);
+}
+
+/// Return key for sorting by render order, then distance front to back, then the highest bits of the state.
+inline u64 GetFrontToBackKey(const Batch& batch)
+{
+    return (GetRenderOrderKey(batch.renderOrder_) << 56u) | (GetDistanceKey(batch.distance_) << 24u) | (batch.sortKey_ >> 40u);
+}
+
+/// Return key for sorting by render order, then distance back to front, then the highest bits of the state.
+inline u64 GetBackToFrontKey(const Batch& batch)
+{
+    return (GetRenderOrderKey(batch.renderOrder_) << 56u) | ((~GetDistanceKey(batch.distance_) & 0xffffffffu) << 24u) |
+           (batch.sortKey_ >> 40u);
 }
 
-inline bool CompareBatchGroupOrder(BatchGroup* lhs, BatchGroup* rhs)
+/// Return key which is the same for the batches of an instanced draw call group. Different groups may rarely share a key.
+inline u64 GetGroupKey(const Batch& batch)
 {
-    return lhs->renderOrder_ < rhs->renderOrder_;
+    const u64 multiplier = 0x9e3779b97f4a7c15ull;
+    u64 key = (u64)(size_t)batch.zone_;
+    key = key * multiplier ^ (u64)(size_t)batch.lightQueue_;
+    key = key * multiplier ^ (u64)(size_t)batch.pass_;
+    key = key * multiplier ^ (u64)(size_t)batch.material_;
+    key = key * multiplier ^ (u64)(size_t)batch.geometry_;
+    key = key * multiplier ^ GetRenderOrderKey(batch.renderOrder_);
+    return key;
+}
+
+/// Stable sort draw calls by keys calculated from them, using the key arrays as scratch.
+template <class T> void RadixSortBatches(Vector<Batch*>& batches, Vector<BatchSortKey>& keys, Vector<BatchSortKey>& temp, T getKey)
+{
+    const i32 count = batches.Size();
+    keys.Resize(count);
+    temp.Resize(count);
+
+    for (i32 i = 0; i < count; ++i)
+    {
+        Batch* batch = batches[i];
+        keys[i].key_ = getKey(*batch);
+        keys[i].batch_ = batch;
+    }
+
+    RadixSort(keys.Begin(), keys.End(), temp.Begin());
+
+    for (i32 i = 0; i < count; ++i)
+        batches[i] = keys[i].batch_;
 }
 
 void CalculateShadowMatrix(Matrix4& dest, LightBatchQueue* queue, i32 split, Renderer* renderer)
@@ -714,10 +747,81 @@ void BatchQueue::Clear(int maxSortedInstances)
 {
     batches_.Clear();
     sortedBatches_.Clear();
+    instancedBatches_.Clear();
+    instancedTechniques_.Clear();
     batchGroups_.Clear();
     maxSortedInstances_ = maxSortedInstances;
 }
 
+void BatchQueue::AddInstancedBatch(const Batch& batch, Technique* tech)
+{
+    instancedBatches_.Push(batch);
+    instancedTechniques_.Push(tech);
+}
+
+void BatchQueue::BuildBatchGroups(Renderer* renderer, i32 minInstances)
+{
+    batchGroups_.Clear();
+
+    const i32 count = instancedBatches_.Size();
+    if (!count)
+        return;
+
+    // Sort by group, so that the batches of each group become adjacent while keeping their order
+    sortKeys_.Resize(count);
+    sortTemp_.Resize(count);
+    for (i32 i = 0; i < count; ++i)
+    {
+        sortKeys_[i].key_ = GetGroupKey(instancedBatches_[i]);
+        sortKeys_[i].batch_ = &instancedBatches_[i];
+    }
+    RadixSort(sortKeys_.Begin(), sortKeys_.End(), sortTemp_.Begin());
+
+    i32 runStart = 0;
+    while (runStart < count)
+    {
+        i32 runEnd = runStart + 1;
+        while (runEnd < count && sortKeys_[runEnd].key_ == sortKeys_[runStart].key_)
+            ++runEnd;
+
+        // Batches with the same key normally form one group. Separate the groups which happen to share the key
+        i32 firstGroup = batchGroups_.Size();
+        for (i32 i = runStart; i < runEnd; ++i)
+        {
+            const Batch& batch = *sortKeys_[i].batch_;
+            BatchGroupKey key(batch);
+
+            i32 groupIndex = firstGroup;
+            while (groupIndex < batchGroups_.Size() && BatchGroupKey(batchGroups_[groupIndex]) != key)
+                ++groupIndex;
+
+            if (groupIndex == batchGroups_.Size())
+            {
+                // The temporary sort buffer is free now. Remember the first batch of each group there for its technique
+                sortTemp_[groupIndex].batch_ = sortKeys_[i].batch_;
+                batchGroups_.Push(BatchGroup(batch));
+            }
+
+            batchGroups_[groupIndex].AddTransforms(batch);
+        }
+
+        runStart = runEnd;
+    }
+
+    // Use instancing shaders only when the instancing limit is reached
+    for (i32 i = 0; i < batchGroups_.Size(); ++i)
+    {
+        BatchGroup& group = batchGroups_[i];
+        Technique* tech = instancedTechniques_[(i32)(sortTemp_[i].batch_ - instancedBatches_.Buffer())];
+        group.geometryType_ = group.instances_.Size() >= minInstances ? GEOM_INSTANCED : GEOM_STATIC;
+        renderer->SetBatchShaders(group, tech, true, *this);
+        group.CalculateSortKey();
+    }
+
+    instancedBatches_.Clear();
+    instancedTechniques_.Clear();
+}
+
 void BatchQueue::SortBackToFront()
 {
     sortedBatches_.Resize(batches_.Size());
@@ -725,15 +829,15 @@ void BatchQueue::SortBackToFront()
     for (i32 i = 0; i < batches_.Size(); ++i)
         sortedBatches_[i] = &batches_[i];
 
-    Sort(sortedBatches_.Begin(), sortedBatches_.End(), CompareBatchesBackToFront);
+    RadixSortBatches(sortedBatches_, sortKeys_, sortTemp_, GetBackToFrontKey);
 
     sortedBatchGroups_.Resize(batchGroups_.Size());
 
-    unsigned index = 0;
-    for (HashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
-        sortedBatchGroups_[index++] = &i->second_;
+    for (i32 i = 0; i < batchGroups_.Size(); ++i)
+        sortedBatchGroups_[i] = &batchGroups_[i];
 
-    Sort(sortedBatchGroups_.Begin(), sortedBatchGroups_.End(), CompareBatchGroupOrder);
+    RadixSortBatches(reinterpret_cast<Vector<Batch*>& >(sortedBatchGroups_), sortKeys_, sortTemp_,
+        [](const Batch& batch) { return GetRenderOrderKey(batch.renderOrder_); });
 }
 
 void BatchQueue::SortFrontToBack()
@@ -746,28 +850,27 @@ void BatchQueue::SortFrontToBack()
     SortFrontToBack2Pass(sortedBatches_);
 
     // Sort each group front to back
-    for (HashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
+    for (BatchGroup& group : batchGroups_)
     {
-        if (i->second_.instances_.Size() <= maxSortedInstances_)
+        if (group.instances_.Size() <= maxSortedInstances_)
         {
-            Sort(i->second_.instances_.Begin(), i->second_.instances_.End(), CompareInstancesFrontToBack);
-            if (i->second_.instances_.Size())
-                i->second_.distance_ = i->second_.instances_[0].distance_;
+            Sort(group.instances_.Begin(), group.instances_.End(), CompareInstancesFrontToBack);
+            if (group.instances_.Size())
+                group.distance_ = group.instances_[0].distance_;
         }
         else
         {
             float minDistance = M_INFINITY;
-            for (Vector<InstanceData>::ConstIterator j = i->second_.instances_.Begin(); j != i->second_.instances_.End(); ++j)
-                minDistance = Min(minDistance, j->distance_);
-            i->second_.distance_ = minDistance;
+            for (const InstanceData& instance : group.instances_)
+                minDistance = Min(minDistance, instance.distance_);
+            group.distance_ = minDistance;
         }
     }
 
     sortedBatchGroups_.Resize(batchGroups_.Size());
 
-    unsigned index = 0;
-    for (HashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
-        sortedBatchGroups_[index++] = &i->second_;
+    for (i32 i = 0; i < batchGroups_.Size(); ++i)
+        sortedBatchGroups_[i] = &batchGroups_[i];
 
     SortFrontToBack2Pass(reinterpret_cast<Vector<Batch*>& >(sortedBatchGroups_));
 }
@@ -775,13 +878,15 @@ void BatchQueue::SortFrontToBack()
 void BatchQueue::SortFrontToBack2Pass(Vector<Batch*>& batches)
 {
     // Mobile devices likely use a tiled deferred approach, with which front-to-back sorting is irrelevant. The 2-pass
-    // method is also time consuming, so just sort with state having priority
+    // method is also time consuming, so just sort with state having priority. Being stable, each sort keeps the order of
+    // the previous ones among equal keys
 #ifdef MOBILE_GRAPHICS
-    Sort(batches.Begin(), batches.End(), CompareBatchesState);
+    RadixSortBatches(batches, sortKeys_, sortTemp_, [](const Batch& batch) { return GetDistanceKey(batch.distance_); });
+    RadixSortBatches(batches, sortKeys_, sortTemp_, [](const Batch& batch) { return batch.sortKey_; });
+    RadixSortBatches(batches, sortKeys_, sortTemp_, [](const Batch& batch) { return GetRenderOrderKey(batch.renderOrder_); });
 #else
     // For desktop, first sort by distance and remap shader/material/geometry IDs in the sort key
-    Sort(batches.Begin(), batches.End(), CompareBatchesFrontToBack);
-
+    RadixSortBatches(batches, sortKeys_, sortTemp_, GetFrontToBackKey);
     hash32 freeShaderID = 0;
     hash16 freeMaterialID = 0;
     hash16 freeGeometryID = 0;
@@ -791,7 +896,7 @@ void BatchQueue::SortFrontToBack2Pass(Vector<Batch*>& batches)
         Batch* batch = *i;
 
         hash32 shaderID = (hash32)(batch->sortKey_ >> 32u);
-        HashMap<hash32, hash32>::ConstIterator j = shaderRemapping_.Find(shaderID);
+        FlatHashMap<hash32, hash32>::ConstIterator j = shaderRemapping_.Find(shaderID);
         if (j != shaderRemapping_.End())
             shaderID = j->second_;
         else
@@ -801,7 +906,7 @@ void BatchQueue::SortFrontToBack2Pass(Vector<Batch*>& batches)
         }
 
         hash16 materialID = (hash16)((batch->sortKey_ & 0xffff0000) >> 16u);
-        HashMap<hash16, hash16>::ConstIterator k = materialRemapping_.Find(materialID);
+        FlatHashMap<hash16, hash16>::ConstIterator k = materialRemapping_.Find(materialID);
         if (k != materialRemapping_.End())
             materialID = k->second_;
         else
@@ -811,7 +916,7 @@ void BatchQueue::SortFrontToBack2Pass(Vector<Batch*>& batches)
         }
 
         hash16 geometryID = (hash16)(batch->sortKey_ & 0xffffu);
-        HashMap<hash16, hash16>::ConstIterator l = geometryRemapping_.Find(geometryID);
+        FlatHashMap<hash16, hash16>::ConstIterator l = geometryRemapping_.Find(geometryID);
         if (l != geometryRemapping_.End())
             geometryID = l->second_;
         else
@@ -827,16 +932,16 @@ void BatchQueue::SortFrontToBack2Pass(Vector<Batch*>& batches)
     materialRemapping_.Clear();
     geometryRemapping_.Clear();
 
-    // Finally sort again with the rewritten ID's
-    Sort(batches.Begin(), batches.End(), CompareBatchesState);
+    // Finally sort again with the rewritten ID's, which keeps the distance order among equal states
+    RadixSortBatches(batches, sortKeys_, sortTemp_, GetStateKey);
 #endif
 }
 
 void BatchQueue::SetInstancingData(void* lockedData, i32 stride, i32& freeIndex)
 {
     assert(stride >= 0);
-    for (HashMap<BatchGroupKey, BatchGroup>::Iterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
-        i->second_.SetInstancingData(lockedData, stride, freeIndex);
+    for (BatchGroup& group : batchGroups_)
+        group.SetInstancingData(lockedData, stride, freeIndex);
 }
 
 void BatchQueue::Draw(View* view, Camera* camera, bool markToStencil, bool usingLightOptimization, bool allowDepthWrite) const
@@ -886,10 +991,10 @@ i32 BatchQueue::GetNumInstances() const
 {
     i32 total = 0;
 
-    for (HashMap<BatchGroupKey, BatchGroup>::ConstIterator i = batchGroups_.Begin(); i != batchGroups_.End(); ++i)
+    for (const BatchGroup& group : batchGroups_)
     {
-        if (i->second_.geometryType_ == GEOM_INSTANCED)
-            total += i->second_.instances_.Size();
+        if (group.geometryType_ == GEOM_INSTANCED)
+            total += group.instances_.Size();
     }
 
     return total;
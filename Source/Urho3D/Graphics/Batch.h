@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "../Container/FlatHashMap.h"
 #include "../Container/Ptr.h"
 #include "../Graphics/Drawable.h"
 #include "../Graphics/Material.h"
@@ -20,7 +21,9 @@ class Light;
 class Material;
 class Matrix3x4;
 class Pass;
+class Renderer;
 class ShaderVariation;
+class Technique;
 class Texture2D;
 class VertexBuffer;
 class View;
@@ -203,12 +206,25 @@ struct BatchGroupKey
     hash32 ToHash() const;
 };
 
+/// Packed sort key of a draw call for radix sorting.
+struct BatchSortKey
+{
+    /// Sort key.
+    u64 key_;
+    /// Draw call.
+    Batch* batch_;
+};
+
 /// Queue that contains both instanced and non-instanced draw calls.
 struct BatchQueue
 {
 public:
     /// Clear for new frame by clearing all groups and batches.
     void Clear(int maxSortedInstances);
+    /// Queue an instanced draw call. Grouped when BuildBatchGroups() is called.
+    void AddInstancedBatch(const Batch& batch, Technique* tech);
+    /// Build instanced draw call groups from the queued instanced draw calls by sorting them by group, and set up their shaders. Groups with fewer instances than the minimum use non-instanced shaders.
+    void BuildBatchGroups(Renderer* renderer, i32 minInstances);
     /// Sort non-instanced draw calls back to front.
     void SortBackToFront();
     /// Sort instanced and non-instanced draw calls front to back.
@@ -223,16 +239,20 @@ public:
     i32 GetNumInstances() const;
 
     /// Return whether the batch group is empty.
-    bool IsEmpty() const { return batches_.Empty() && batchGroups_.Empty(); }
+    bool IsEmpty() const { return batches_.Empty() && batchGroups_.Empty() && instancedBatches_.Empty(); }
 
+    /// Instanced draw calls waiting to be grouped.
+    Vector<Batch> instancedBatches_;
+    /// Techniques of the instanced draw calls waiting to be grouped.
+    Vector<Technique*> instancedTechniques_;
     /// Instanced draw calls.
-    HashMap<BatchGroupKey, BatchGroup> batchGroups_;
+    Vector<BatchGroup> batchGroups_;
     /// Shader remapping table for 2-pass state and distance sort.
-    HashMap<hash32, hash32> shaderRemapping_;
+    FlatHashMap<hash32, hash32> shaderRemapping_;
     /// Material remapping table for 2-pass state and distance sort.
-    HashMap<hash16, hash16> materialRemapping_;
+    FlatHashMap<hash16, hash16> materialRemapping_;
     /// Geometry remapping table for 2-pass state and distance sort.
-    HashMap<hash16, hash16> geometryRemapping_;
+    FlatHashMap<hash16, hash16> geometryRemapping_;
 
     /// Unsorted non-instanced draw calls.
     Vector<Batch> batches_;
@@ -240,6 +260,10 @@ public:
     Vector<Batch*> sortedBatches_;
     /// Sorted instanced draw calls.
     Vector<BatchGroup*> sortedBatchGroups_;
+    /// Sort keys of the draw calls being sorted.
+    Vector<BatchSortKey> sortKeys_;
+    /// Temporary buffer for radix sorting.
+    Vector<BatchSortKey> sortTemp_;
     /// Maximum sorted instances.
     i32 maxSortedInstances_;
     /// Whether the pass command contains extra shader defines.
@@ -481,6 +481,14 @@ public:
     /// @property
     bool GetSRGBWriteSupport() const { return sRGBWriteSupport_; }
 
+    /// Return whether linked shader programs can be stored as program binaries in the shader cache directory. OpenGL only.
+    /// @property
+    bool GetProgramBinarySupport() const { return programBinarySupport_; }
+
+    /// Return whether dynamic vertex and index buffers are persistently mapped, so that their data is written directly into GPU-visible memory. OpenGL only.
+    /// @property
+    bool GetPersistentMappingSupport() const { return persistentMappingSupport_; }
+
     /// Return supported fullscreen resolutions (third component is refreshRate). Will be empty if listing the resolutions is not supported on the platform (e.g. Web).
     /// @property
     Vector<IntVector3> GetResolutions(int monitor) const;
@@ -531,6 +539,9 @@ public:
 
     /// Clean up shader parameters when a shader variation is released or destroyed.
     void CleanupShaderPrograms_OGL(ShaderVariation* variation);
+
+    /// Start building the program binaries missing from the shader cache directory in a background thread with a shared context. Remove the combinations being built, so that the rest can be precached in the main thread.
+    void BuildProgramBinaries_OGL(Vector<Pair<ShaderVariation*, ShaderVariation*>>& combinations);
 #endif
 
 #ifdef URHO3D_D3D11
@@ -647,6 +658,9 @@ public:
     /// Mark the FBO needing an update. Used only on OpenGL.
     void MarkFBODirty_OGL();
 
+    /// Mark the vertex attribute pointers needing an update. Used only on OpenGL.
+    void MarkVertexBuffersDirty_OGL();
+
     /// Bind a VBO, avoiding redundant operation. Used only on OpenGL.
     void SetVBO_OGL(unsigned object);
 
@@ -1083,6 +1097,10 @@ private:
     bool sRGBSupport_{};
     /// sRGB conversion on write support flag.
     bool sRGBWriteSupport_{};
+    /// Program binary support flag.
+    bool programBinarySupport_{};
+    /// Persistently mapped buffer support flag.
+    bool persistentMappingSupport_{};
     /// Number of primitives this frame.
     unsigned numPrimitives_{};
     /// Number of batches this frame.
@@ -263,6 +263,14 @@ void SpriteBatch::DrawString(const String& text, Font* font, float fontSize, con
     for (; i >= 0 && i < unicodeText.Size(); i += step)
     {
         const FontGlyph* glyph = face->GetGlyph(unicodeText[i]);
+
+        // Глиф ещё не загружен в текстуру
+        if (glyph->page_ == NINDEX)
+        {
+            charOrig.x_ -= (float)glyph->advanceX_;
+            continue;
+        }
+
         float gx = (float)glyph->x_;
         float gy = (float)glyph->y_;
         float gw = (float)glyph->width_;
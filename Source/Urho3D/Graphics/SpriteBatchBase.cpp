@@ -145,10 +145,12 @@ SpriteBatchBase::SpriteBatchBase(Context* context) : Object(context)
     qIndexBuffer_ = new IndexBuffer(context_);
     qIndexBuffer_->SetShadowed(true);
 
-    // Индексный буфер всегда содержит набор четырёхугольников, поэтому его можно сразу заполнить
-    qIndexBuffer_->SetSize(MAX_QUADS_IN_PORTION * INDICES_PER_QUAD, false);
+    // Индексный буфер всегда содержит набор четырёхугольников, поэтому его можно сразу заполнить.
+    // Он покрывает весь вершинный буфер, чтобы порцию можно было отрисовать из любого места буфера
+    static_assert(Q_RING_SIZE <= 0x10000, "Indices must fit in 16 bits");
+    qIndexBuffer_->SetSize(Q_RING_SIZE / VERTICES_PER_QUAD * INDICES_PER_QUAD, false);
     GpuIndex16* buffer = (GpuIndex16*)qIndexBuffer_->Lock(0, qIndexBuffer_->GetIndexCount());
-    for (i32 i = 0; i < MAX_QUADS_IN_PORTION; i++)
+    for (i32 i = 0; i < Q_RING_SIZE / VERTICES_PER_QUAD; i++)
     {
         // Первый треугольник четырёхугольника
         buffer[i * INDICES_PER_QUAD + 0] = i * VERTICES_PER_QUAD + 0;
@@ -163,15 +165,26 @@ SpriteBatchBase::SpriteBatchBase(Context* context) : Object(context)
     qIndexBuffer_->Unlock();
 
     qVertexBuffer_ = new VertexBuffer(context_);
-    qVertexBuffer_->SetSize(MAX_QUADS_IN_PORTION * VERTICES_PER_QUAD, VertexElements::Position | VertexElements::Color | VertexElements::TexCoord1, true);
+    qVertexBuffer_->SetSize(Q_RING_SIZE, VertexElements::Position | VertexElements::Color | VertexElements::TexCoord1, true);
 
     tVertexBuffer_ = new VertexBuffer(context_);
-    tVertexBuffer_->SetSize(MAX_TRIANGLES_IN_PORTION * VERTICES_PER_TRIANGLE, VertexElements::Position | VertexElements::Color, true);
+    tVertexBuffer_->SetSize(T_RING_SIZE, VertexElements::Position | VertexElements::Color, true);
     tVertexShader_ = graphics_->GetShader(VS, "TriangleBatch");
     tPixelShader_ = graphics_->GetShader(PS, "TriangleBatch");
     SetShapeColor(Color::WHITE);
 }
 
+i32 SpriteBatchBase::PlaceInRing(i32& ringOffset, i32 numVertices, i32 ringSize, bool& discard)
+{
+    discard = ringOffset + numVertices > ringSize;
+    if (discard)
+        ringOffset = 0;
+
+    i32 offset = ringOffset;
+    ringOffset += numVertices;
+    return offset;
+}
+
 void SpriteBatchBase::Flush()
 {
     if (tNumVertices_ > 0)
@@ -196,13 +209,18 @@ void SpriteBatchBase::Flush()
         graphics_->SetShaderParameter(VSP_MODEL, Matrix3x4::IDENTITY);
         UpdateViewProjMatrix();
 
-        // Копируем накопленную геометрию в память видеокарты
-        TVertex* buffer = (TVertex*)tVertexBuffer_->Lock(0, tNumVertices_, true);
+        // Копируем накопленную геометрию в свободную часть буфера в памяти видеокарты.
+        // Если места не осталось, то отбрасываем содержимое буфера и пишем в начало
+        bool discard;
+        i32 offset = PlaceInRing(tRingOffset_, tNumVertices_, tVertexBuffer_->GetVertexCount(), discard);
+
+        TVertex* buffer = discard ? (TVertex*)tVertexBuffer_->Lock(0, tNumVertices_, true)
+                                  : (TVertex*)tVertexBuffer_->LockNoOverwrite(offset, tNumVertices_);
         memcpy(buffer, tVertices_, tNumVertices_ * sizeof(TVertex));
         tVertexBuffer_->Unlock();
 
         // И отрисовываем её
-        graphics_->Draw(TRIANGLE_LIST, 0, tNumVertices_);
+        graphics_->Draw(TRIANGLE_LIST, offset, tNumVertices_);
 
         // Начинаем новую порцию
         tNumVertices_ = 0;
@@ -232,14 +250,21 @@ void SpriteBatchBase::Flush()
         // Мы используем только цвета вершин. Но это значение требует шейдер Basic
         graphics_->SetShaderParameter(PSP_MATDIFFCOLOR, Color::WHITE);
 
-        // Копируем накопленную геометрию в память видеокарты
-        QVertex* buffer = (QVertex*)qVertexBuffer_->Lock(0, qNumVertices_, true);
+        // Копируем накопленную геометрию в свободную часть буфера в памяти видеокарты.
+        // Если места не осталось, то отбрасываем содержимое буфера и пишем в начало
+        bool discard;
+        i32 offset = PlaceInRing(qRingOffset_, qNumVertices_, qVertexBuffer_->GetVertexCount(), discard);
+
+        QVertex* buffer = discard ? (QVertex*)qVertexBuffer_->Lock(0, qNumVertices_, true)
+                                  : (QVertex*)qVertexBuffer_->LockNoOverwrite(offset, qNumVertices_);
         memcpy(buffer, qVertices_, qNumVertices_ * sizeof(QVertex));
         qVertexBuffer_->Unlock();
 
-        // И отрисовываем её
+        // И отрисовываем её. Индексы в индексном буфере абсолютные, поэтому начинаем с индексов
+        // первого четырёхугольника порции
         i32 numQuads = qNumVertices_ / VERTICES_PER_QUAD;
-        graphics_->Draw(TRIANGLE_LIST, 0, numQuads * INDICES_PER_QUAD, 0, qNumVertices_);
+        i32 firstQuad = offset / VERTICES_PER_QUAD;
+        graphics_->Draw(TRIANGLE_LIST, firstQuad * INDICES_PER_QUAD, numQuads * INDICES_PER_QUAD, offset, qNumVertices_);
 
         // Начинаем новую порцию
         qNumVertices_ = 0;
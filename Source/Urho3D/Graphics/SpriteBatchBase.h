@@ -50,6 +50,9 @@ private:
     // Вершинный буфер для треугольников (индексный буфер не используется)
     SharedPtr<VertexBuffer> tVertexBuffer_;
 
+    // Начало свободной части буфера tVertexBuffer_ (в вершинах)
+    i32 tRingOffset_ = 0;
+
 protected:
 
     // Данные для функции AddTriangle().
@@ -111,6 +114,9 @@ private:
     SharedPtr<IndexBuffer> qIndexBuffer_;
     SharedPtr<VertexBuffer> qVertexBuffer_;
 
+    // Начало свободной части буфера qVertexBuffer_ (в вершинах)
+    i32 qRingOffset_ = 0;
+
 protected:
 
     // Данные для функции AddQuad().
@@ -136,6 +142,22 @@ private:
     void UpdateViewProjMatrix();
     IntRect GetViewportRect();
 
+public:
+
+    // Сколько порций помещается в вершинный буфер. Порции записываются в буфер друг за другом,
+    // не затирая предыдущие, поэтому не нужно ждать, пока видеокарта их отрисует.
+    // Когда буфер заполнен, его содержимое отбрасывается и запись начинается с начала
+    inline static constexpr i32 PORTIONS_IN_RING = 8;
+
+    // Размеры кольцевых буферов треугольников и четырёхугольников (в вершинах)
+    inline static constexpr i32 T_RING_SIZE = MAX_TRIANGLES_IN_PORTION * VERTICES_PER_TRIANGLE * PORTIONS_IN_RING;
+    inline static constexpr i32 Q_RING_SIZE = MAX_QUADS_IN_PORTION * VERTICES_PER_QUAD * PORTIONS_IN_RING;
+
+    // Находит место для порции из numVertices вершин в кольцевом буфере из ringSize вершин и возвращает начало порции.
+    // Если порция не помещается в конец буфера, то она записывается в начало, а discard становится true
+    // (содержимое буфера нужно отбросить). ringOffset сдвигается за конец порции
+    static i32 PlaceInRing(i32& ringOffset, i32 numVertices, i32 ringSize, bool& discard);
+
 protected:
 
     // Кешируем доступ к подсистеме. Инициализируется в конструкторе
@@ -954,6 +954,7 @@ void View::GetBatches()
     ProcessLights();
     GetLightBatches();
     GetBaseBatches();
+    GetBatchGroups();
 }
 
 void View::ProcessLights()
@@ -1256,6 +1257,22 @@ void View::GetBaseBatches()
     }
 }
 
+void View::GetBatchGroups()
+{
+    URHO3D_PROFILE(GetBatchGroups);
+
+    for (HashMap<i32, BatchQueue>::Iterator i = batchQueues_.Begin(); i != batchQueues_.End(); ++i)
+        i->second_.BuildBatchGroups(renderer_, minInstances_);
+
+    for (LightBatchQueue& lightQueue : lightQueues_)
+    {
+        for (ShadowBatchQueue& shadowSplit : lightQueue.shadowSplits_)
+            shadowSplit.shadowBatches_.BuildBatchGroups(renderer_, minInstances_);
+        lightQueue.litBaseBatches_.BuildBatchGroups(renderer_, minInstances_);
+        lightQueue.litBatches_.BuildBatchGroups(renderer_, minInstances_);
+    }
+}
+
 void View::UpdateGeometries()
 {
     // Update geometries in the source view if necessary (prepare order may differ from render order)
@@ -2878,36 +2895,12 @@ void View::AddBatchToQueue(BatchQueue& queue, Batch& batch, Technique* tech, boo
     if (!batch.material_)
         batch.material_ = renderer_->GetDefaultMaterial();
 
-    // Convert to instanced if possible
-    if (allowInstancing && batch.geometryType_ == GEOM_STATIC && batch.geometry_->GetIndexBuffer())
+    // Convert to instanced if possible. Groups are set up once all batches have been queued, and always allow shadows
+    if (allowInstancing && allowShadows && batch.geometryType_ == GEOM_STATIC && batch.geometry_->GetIndexBuffer())
         batch.geometryType_ = GEOM_INSTANCED;
 
     if (batch.geometryType_ == GEOM_INSTANCED)
-    {
-        BatchGroupKey key(batch);
-
-        HashMap<BatchGroupKey, BatchGroup>::Iterator i = queue.batchGroups_.Find(key);
-        if (i == queue.batchGroups_.End())
-        {
-            // Create a new group based on the batch
-            // In case the group remains below the instancing limit, do not enable instancing shaders yet
-            BatchGroup newGroup(batch);
-            newGroup.geometryType_ = GEOM_STATIC;
-            renderer_->SetBatchShaders(newGroup, tech, allowShadows, queue);
-            newGroup.CalculateSortKey();
-            i = queue.batchGroups_.Insert(MakePair(key, newGroup));
-        }
-
-        int oldSize = i->second_.instances_.Size();
-        i->second_.AddTransforms(batch);
-        // Convert to using instancing shaders when the instancing limit is reached
-        if (oldSize < minInstances_ && (int)i->second_.instances_.Size() >= minInstances_)
-        {
-            i->second_.geometryType_ = GEOM_INSTANCED;
-            renderer_->SetBatchShaders(i->second_, tech, allowShadows, queue);
-            i->second_.CalculateSortKey();
-        }
-    }
+        queue.AddInstancedBatch(batch, tech);
     else
     {
         renderer_->SetBatchShaders(batch, tech, allowShadows, queue);
@@ -186,6 +186,8 @@ private:
     void GetLightBatches();
     /// Get unlit batches.
     void GetBaseBatches();
+    /// Build the instanced draw call groups of all batch queues.
+    void GetBatchGroups();
     /// Update geometries and sort batches.
     void UpdateGeometries();
     /// Get pixel lit batches for a certain light and drawable.
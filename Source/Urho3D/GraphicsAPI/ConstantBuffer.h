@@ -42,6 +42,12 @@ public:
     /// Return whether has unapplied data.
     bool IsDirty() const { return dirty_; }
 
+    /// Return byte offset of the data in the constant buffer ring. Used only on OpenGL.
+    unsigned GetRingOffset_OGL() const { return ringOffset_; }
+
+    /// Return frame number of the constant buffer ring when the data was last written into it. Used only on OpenGL.
+    unsigned GetRingFrame_OGL() const { return ringFrame_; }
+
 private:
 #ifdef URHO3D_OPENGL
     void Release_OGL();
@@ -61,6 +67,10 @@ private:
     SharedArrayPtr<unsigned char> shadowData_;
     /// Buffer byte size.
     unsigned size_{};
+    /// Byte offset of the data in the constant buffer ring. Used by OpenGL only.
+    unsigned ringOffset_{};
+    /// Ring frame number when the data was last written into the ring, zero if never. Used by OpenGL only.
+    unsigned ringFrame_{};
     /// Dirty flag.
     bool dirty_{};
 };
@@ -998,7 +998,7 @@ void Graphics::SetShaderParameter_D3D11(StringHash param, const float* data, uns
 {
     GraphicsImpl_D3D11* impl = GetImpl_D3D11();
 
-    HashMap<StringHash, ShaderParameter>::Iterator i;
+    FlatHashMap<StringHash, ShaderParameter>::Iterator i;
     if (!impl->shaderProgram_ || (i = impl->shaderProgram_->parameters_.Find(param)) == impl->shaderProgram_->parameters_.End())
         return;
 
@@ -1012,7 +1012,7 @@ void Graphics::SetShaderParameter_D3D11(StringHash param, float value)
 {
     GraphicsImpl_D3D11* impl = GetImpl_D3D11();
 
-    HashMap<StringHash, ShaderParameter>::Iterator i;
+    FlatHashMap<StringHash, ShaderParameter>::Iterator i;
     if (!impl->shaderProgram_ || (i = impl->shaderProgram_->parameters_.Find(param)) == impl->shaderProgram_->parameters_.End())
         return;
 
@@ -1026,7 +1026,7 @@ void Graphics::SetShaderParameter_D3D11(StringHash param, int value)
 {
     GraphicsImpl_D3D11* impl = GetImpl_D3D11();
 
-    HashMap<StringHash, ShaderParameter>::Iterator i;
+    FlatHashMap<StringHash, ShaderParameter>::Iterator i;
     if (!impl->shaderProgram_ || (i = impl->shaderProgram_->parameters_.Find(param)) == impl->shaderProgram_->parameters_.End())
         return;
 
@@ -1040,7 +1040,7 @@ void Graphics::SetShaderParameter_D3D11(StringHash param, bool value)
 {
     GraphicsImpl_D3D11* impl = GetImpl_D3D11();
 
-    HashMap<StringHash, ShaderParameter>::Iterator i;
+    FlatHashMap<StringHash, ShaderParameter>::Iterator i;
     if (!impl->shaderProgram_ || (i = impl->shaderProgram_->parameters_.Find(param)) == impl->shaderProgram_->parameters_.End())
         return;
 
@@ -1054,7 +1054,7 @@ void Graphics::SetShaderParameter_D3D11(StringHash param, const Color& color)
 {
     GraphicsImpl_D3D11* impl = GetImpl_D3D11();
 
-    HashMap<StringHash, ShaderParameter>::Iterator i;
+    FlatHashMap<StringHash, ShaderParameter>::Iterator i;
     if (!impl->shaderProgram_ || (i = impl->shaderProgram_->parameters_.Find(param)) == impl->shaderProgram_->parameters_.End())
         return;
 
@@ -1068,7 +1068,7 @@ void Graphics::SetShaderParameter_D3D11(StringHash param, const Vector2& vector)
 {
     GraphicsImpl_D3D11* impl = GetImpl_D3D11();
 
-    HashMap<StringHash, ShaderParameter>::Iterator i;
+    FlatHashMap<StringHash, ShaderParameter>::Iterator i;
     if (!impl->shaderProgram_ || (i = impl->shaderProgram_->parameters_.Find(param)) == impl->shaderProgram_->parameters_.End())
         return;
 
@@ -1082,7 +1082,7 @@ void Graphics::SetShaderParameter_D3D11(StringHash param, const Matrix3& matrix)
 {
     GraphicsImpl_D3D11* impl = GetImpl_D3D11();
 
-    HashMap<StringHash, ShaderParameter>::Iterator i;
+    FlatHashMap<StringHash, ShaderParameter>::Iterator i;
     if (!impl->shaderProgram_ || (i = impl->shaderProgram_->parameters_.Find(param)) == impl->shaderProgram_->parameters_.End())
         return;
 
@@ -1096,7 +1096,7 @@ void Graphics::SetShaderParameter_D3D11(StringHash param, const Vector3& vector)
 {
     GraphicsImpl_D3D11* impl = GetImpl_D3D11();
 
-    HashMap<StringHash, ShaderParameter>::Iterator i;
+    FlatHashMap<StringHash, ShaderParameter>::Iterator i;
     if (!impl->shaderProgram_ || (i = impl->shaderProgram_->parameters_.Find(param)) == impl->shaderProgram_->parameters_.End())
         return;
 
@@ -1110,7 +1110,7 @@ void Graphics::SetShaderParameter_D3D11(StringHash param, const Matrix4& matrix)
 {
     GraphicsImpl_D3D11* impl = GetImpl_D3D11();
 
-    HashMap<StringHash, ShaderParameter>::Iterator i;
+    FlatHashMap<StringHash, ShaderParameter>::Iterator i;
     if (!impl->shaderProgram_ || (i = impl->shaderProgram_->parameters_.Find(param)) == impl->shaderProgram_->parameters_.End())
         return;
 
@@ -1124,7 +1124,7 @@ void Graphics::SetShaderParameter_D3D11(StringHash param, const Vector4& vector)
 {
     GraphicsImpl_D3D11* impl = GetImpl_D3D11();
 
-    HashMap<StringHash, ShaderParameter>::Iterator i;
+    FlatHashMap<StringHash, ShaderParameter>::Iterator i;
     if (!impl->shaderProgram_ || (i = impl->shaderProgram_->parameters_.Find(param)) == impl->shaderProgram_->parameters_.End())
         return;
 
@@ -1138,7 +1138,7 @@ void Graphics::SetShaderParameter_D3D11(StringHash param, const Matrix3x4& matri
 {
     GraphicsImpl_D3D11* impl = GetImpl_D3D11();
 
-    HashMap<StringHash, ShaderParameter>::Iterator i;
+    FlatHashMap<StringHash, ShaderParameter>::Iterator i;
     if (!impl->shaderProgram_ || (i = impl->shaderProgram_->parameters_.Find(param)) == impl->shaderProgram_->parameters_.End())
         return;
 
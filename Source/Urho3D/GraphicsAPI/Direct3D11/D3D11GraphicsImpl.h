@@ -19,7 +19,7 @@ namespace Urho3D
 
 #define URHO3D_LOGD3DERROR(msg, hr) URHO3D_LOGERRORF("%s (HRESULT %x)", msg, (unsigned)hr)
 
-using ShaderProgramMap_D3D11 = HashMap<Pair<ShaderVariation*, ShaderVariation*>, SharedPtr<ShaderProgram_D3D11>>;
+using ShaderProgramMap_D3D11 = FlatHashMap<Pair<ShaderVariation*, ShaderVariation*>, SharedPtr<ShaderProgram_D3D11>>;
 using VertexDeclarationMap_D3D11 = HashMap<hash64, SharedPtr<VertexDeclaration_D3D11>>;
 using ConstantBufferMap = HashMap<hash32, SharedPtr<ConstantBuffer>>;
 
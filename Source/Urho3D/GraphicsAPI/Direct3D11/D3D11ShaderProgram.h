@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "../../Container/FlatHashMap.h"
 #include "../../Container/HashMap.h"
 #include "../../Graphics/Graphics.h"
 #include "../../GraphicsAPI/ConstantBuffer.h"
@@ -47,10 +48,6 @@ public:
             parameters_[i->first_] = i->second_;
             parameters_[i->first_].bufferPtr_ = psConstantBuffers_[i->second_.buffer_].Get();
         }
-
-        // Optimize shader parameter lookup by rehashing to next power of two
-        parameters_.Rehash(NextPowerOfTwo(parameters_.Size()));
-
     }
 
     /// Destruct.
@@ -59,7 +56,7 @@ public:
     }
 
     /// Combined parameters from the vertex and pixel shader.
-    HashMap<StringHash, ShaderParameter> parameters_;
+    FlatHashMap<StringHash, ShaderParameter> parameters_;
     /// Vertex shader constant buffers.
     SharedPtr<ConstantBuffer> vsConstantBuffers_[MAX_SHADER_PARAMETER_GROUPS];
     /// Pixel shader constant buffers.
@@ -148,7 +148,7 @@ bool VertexBuffer::SetDataRange_D3D11(const void* data, i32 start, i32 count, bo
     return true;
 }
 
-void* VertexBuffer::Lock_D3D11(i32 start, i32 count, bool discard)
+void* VertexBuffer::Lock_D3D11(i32 start, i32 count, bool discard, bool noOverwrite)
 {
     assert(start >= 0 && count >= 0);
 
@@ -178,7 +178,7 @@ void* VertexBuffer::Lock_D3D11(i32 start, i32 count, bool discard)
 
     // Because shadow data must be kept in sync, can only lock hardware buffer if not shadowed
     if (object_.ptr_ && !shadowData_ && dynamic_)
-        return MapBuffer_D3D11(start, count, discard);
+        return noOverwrite ? MapBufferNoOverwrite_D3D11(start, count) : MapBuffer_D3D11(start, count, discard);
     else if (shadowData_)
     {
         lockState_ = LOCK_SHADOW;
@@ -279,6 +279,31 @@ void* VertexBuffer::MapBuffer_D3D11(i32 start, i32 count, bool discard)
     return hwData;
 }
 
+void* VertexBuffer::MapBufferNoOverwrite_D3D11(i32 start, i32 count)
+{
+    assert(start >= 0 && count >= 0);
+    void* hwData = nullptr;
+
+    if (object_.ptr_)
+    {
+        D3D11_MAPPED_SUBRESOURCE mappedData;
+        mappedData.pData = nullptr;
+
+        HRESULT hr = graphics_->GetImpl_D3D11()->GetDeviceContext()->Map((ID3D11Buffer*)object_.ptr_, 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0,
+            &mappedData);
+        if (FAILED(hr) || !mappedData.pData)
+            URHO3D_LOGD3DERROR("Failed to map vertex buffer", hr);
+        else
+        {
+            // The whole buffer is mapped
+            hwData = (byte*)mappedData.pData + (intptr_t)start * vertexSize_;
+            lockState_ = LOCK_HARDWARE;
+        }
+    }
+
+    return hwData;
+}
+
 void VertexBuffer::UnmapBuffer_D3D11()
 {
     if (object_.ptr_ && lockState_ == LOCK_HARDWARE)
@@ -23,6 +23,7 @@ IndexBuffer::IndexBuffer(Context* context, bool forceHeadless) :
     lockStart_(0),
     lockCount_(0),
     lockScratchData_(nullptr),
+    persistentBuffer_(nullptr),
     shadowed_(false),
     dynamic_(false),
     discardLock_(false)
@@ -11,6 +11,8 @@
 namespace Urho3D
 {
 
+class PersistentBuffer_OGL;
+
 /// Hardware index buffer.
 class URHO3D_API IndexBuffer : public Object, public GPUObject
 {
@@ -71,14 +73,17 @@ public:
     /// Return shared array pointer to the CPU memory shadow data.
     SharedArrayPtr<byte> GetShadowDataShared() const { return shadowData_; }
 
+    /// Return persistently mapped ring of a dynamic buffer, or null if not used. Used only on OpenGL.
+    PersistentBuffer_OGL* GetPersistentBuffer_OGL() const { return persistentBuffer_; }
+
 private:
     /// Create buffer.
     bool Create();
     /// Update the shadow data to the GPU buffer.
     bool UpdateToGPU();
-    /// Map the GPU buffer into CPU memory. Not used on OpenGL.
+    /// Map the GPU buffer into CPU memory. On OpenGL only for persistently mapped dynamic buffers, may return null if the memory is in use.
     void* MapBuffer(i32 start, i32 count, bool discard);
-    /// Unmap the GPU buffer. Not used on OpenGL.
+    /// Unmap the GPU buffer.
     void UnmapBuffer();
 
 #ifdef URHO3D_OPENGL
@@ -123,6 +128,8 @@ private:
     i32 lockCount_;
     /// Scratch buffer for fallback locking.
     void* lockScratchData_;
+    /// Persistently mapped ring of a dynamic buffer. Used by OpenGL only.
+    PersistentBuffer_OGL* persistentBuffer_;
     /// Dynamic flag.
     bool dynamic_;
     /// Shadowed flag.
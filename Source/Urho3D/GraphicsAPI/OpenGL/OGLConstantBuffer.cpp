@@ -69,6 +69,32 @@ bool ConstantBuffer::SetSize_OGL(unsigned size)
 
 void ConstantBuffer::Apply_OGL()
 {
+#ifndef GL_ES_VERSION_2_0
+    ConstantBufferRing_OGL* ring = graphics_ ? graphics_->GetImpl_OGL()->GetConstantBufferRing() : nullptr;
+    if (ring)
+    {
+        // Data written into the ring stays valid until the end of the frame
+        if (!dirty_ && ringFrame_ == ring->GetFrameNumber())
+            return;
+
+        unsigned offset = ring->Write(shadowData_.Get(), size_);
+        if (offset != M_MAX_UNSIGNED)
+        {
+            ringOffset_ = offset;
+            ringFrame_ = ring->GetFrameNumber();
+            dirty_ = false;
+            return;
+        }
+
+        // Out of ring space for this frame, so use the own buffer object. Its data is stale if the ring was used last
+        if (ringFrame_)
+        {
+            ringFrame_ = 0;
+            dirty_ = true;
+        }
+    }
+#endif
+
     if (dirty_ && object_.name_)
     {
 #ifndef GL_ES_VERSION_2_0
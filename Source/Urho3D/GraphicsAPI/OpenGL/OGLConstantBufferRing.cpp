@@ -0,0 +1,174 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../../Precompiled.h"
+
+#include "../../Graphics/Graphics.h"
+#include "../../GraphicsAPI/GraphicsImpl.h"
+#include "../../GraphicsAPI/OpenGL/OGLConstantBufferRing.h"
+#include "../../IO/Log.h"
+
+#include "../../DebugNew.h"
+
+namespace Urho3D
+{
+
+/// Initial data size of a frame.
+static const unsigned DEFAULT_FRAME_SIZE = 1024 * 1024;
+/// Maximum data size of a frame.
+static const unsigned MAX_FRAME_SIZE = 32 * 1024 * 1024;
+/// Nanoseconds to wait for the GPU to finish reading a region before writing into it anyway.
+static const GLuint64 FENCE_TIMEOUT = 1000000000;
+
+ConstantBufferRing_OGL::ConstantBufferRing_OGL(Graphics* graphics) :
+    graphics_(graphics)
+{
+#ifndef GL_ES_VERSION_2_0
+    int alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment_ = (unsigned)Max(alignment, 16);
+
+    Allocate(DEFAULT_FRAME_SIZE);
+#endif
+}
+
+ConstantBufferRing_OGL::~ConstantBufferRing_OGL()
+{
+    Release();
+}
+
+void ConstantBufferRing_OGL::BeginFrame()
+{
+#ifndef GL_ES_VERSION_2_0
+    ++frameNumber_;
+    position_ = 0;
+
+    if (overflow_)
+    {
+        overflow_ = false;
+        if (frameSize_ < MAX_FRAME_SIZE)
+        {
+            URHO3D_LOGDEBUGF("Growing constant buffer ring to %u bytes per frame", frameSize_ * 2);
+            Allocate(frameSize_ * 2);
+            return;
+        }
+    }
+
+    if (data_)
+    {
+        region_ = (region_ + 1) % NUM_CONSTANT_BUFFER_RING_FRAMES;
+        if (fences_[region_])
+        {
+            glClientWaitSync((GLsync)fences_[region_], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+            glDeleteSync((GLsync)fences_[region_]);
+            fences_[region_] = nullptr;
+        }
+    }
+    else if (object_)
+    {
+        // Orphan the storage of the previous frame, which the GPU may still be reading
+        graphics_->SetUBO_OGL(object_);
+        glBufferData(GL_UNIFORM_BUFFER, frameSize_, nullptr, GL_STREAM_DRAW);
+    }
+#endif
+}
+
+void ConstantBufferRing_OGL::EndFrame()
+{
+#ifndef GL_ES_VERSION_2_0
+    if (data_ && !fences_[region_])
+        fences_[region_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+}
+
+unsigned ConstantBufferRing_OGL::Write(const void* data, unsigned size)
+{
+#ifndef GL_ES_VERSION_2_0
+    unsigned position = (position_ + alignment_ - 1) / alignment_ * alignment_;
+    if (!object_ || position + size > frameSize_)
+    {
+        overflow_ = true;
+        return M_MAX_UNSIGNED;
+    }
+
+    position_ = position + size;
+    unsigned offset = region_ * frameSize_ + position;
+    if (data_)
+        memcpy(data_ + offset, data, size);
+    else
+    {
+        graphics_->SetUBO_OGL(object_);
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+    }
+
+    return offset;
+#else
+    return M_MAX_UNSIGNED;
+#endif
+}
+
+void ConstantBufferRing_OGL::Allocate(unsigned frameSize)
+{
+#ifndef GL_ES_VERSION_2_0
+    Release();
+
+    // Keep the regions aligned for binding
+    frameSize_ = (frameSize + alignment_ - 1) / alignment_ * alignment_;
+    region_ = 0;
+    position_ = 0;
+
+    glGenBuffers(1, &object_);
+    if (!object_)
+    {
+        URHO3D_LOGERROR("Failed to create constant buffer ring");
+        return;
+    }
+
+    graphics_->SetUBO_OGL(object_);
+
+    if (graphics_->GetPersistentMappingSupport())
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_UNIFORM_BUFFER, (GLsizeiptr)frameSize_ * NUM_CONSTANT_BUFFER_RING_FRAMES, nullptr, flags);
+        data_ = (byte*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, (GLsizeiptr)frameSize_ * NUM_CONSTANT_BUFFER_RING_FRAMES, flags);
+        if (data_)
+            return;
+
+        // Immutable storage can not be respecified, so start over with a new buffer object
+        URHO3D_LOGWARNING("Failed to map constant buffer ring, falling back to orphaning");
+        graphics_->SetUBO_OGL(0);
+        glDeleteBuffers(1, &object_);
+        glGenBuffers(1, &object_);
+        graphics_->SetUBO_OGL(object_);
+    }
+
+    glBufferData(GL_UNIFORM_BUFFER, frameSize_, nullptr, GL_STREAM_DRAW);
+#endif
+}
+
+void ConstantBufferRing_OGL::Release()
+{
+#ifndef GL_ES_VERSION_2_0
+    if (graphics_ && !graphics_->IsDeviceLost())
+    {
+        for (void*& fence : fences_)
+        {
+            if (fence)
+                glDeleteSync((GLsync)fence);
+        }
+
+        if (object_)
+        {
+            graphics_->SetUBO_OGL(0);
+            glDeleteBuffers(1, &object_);
+        }
+    }
+#endif
+
+    for (void*& fence : fences_)
+        fence = nullptr;
+    object_ = 0;
+    data_ = nullptr;
+}
+
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../../Container/Ptr.h"
+
+namespace Urho3D
+{
+
+class Graphics;
+
+/// Number of frames whose constant data can be in flight in the constant buffer ring.
+static const i32 NUM_CONSTANT_BUFFER_RING_FRAMES = 3;
+
+/// Uniform buffer into which the constant buffer data of each frame is packed, so that draw calls bind ranges of one buffer instead of respecifying the data of each constant buffer. Persistently mapped with a region per frame in flight if supported, otherwise the storage is orphaned at the start of each frame. If a frame runs out of space, the ring grows on the next frame.
+class ConstantBufferRing_OGL
+{
+public:
+    /// Construct and allocate the buffer.
+    explicit ConstantBufferRing_OGL(Graphics* graphics);
+    /// Destruct. Delete the buffer and fences unless the graphics context has been lost.
+    ~ConstantBufferRing_OGL();
+
+    /// Begin a frame. Move to the region of the frame, waiting for the GPU to finish reading it if necessary.
+    void BeginFrame();
+    /// End a frame. Fence the region of the frame.
+    void EndFrame();
+    /// Copy constant data into the current frame. Return byte offset within the buffer, or M_MAX_UNSIGNED if the frame is out of space.
+    unsigned Write(const void* data, unsigned size);
+
+    /// Return buffer object name.
+    unsigned GetGPUObjectName() const { return object_; }
+
+    /// Return frame number, which changes on each BeginFrame(). Data written on earlier frames must not be used.
+    unsigned GetFrameNumber() const { return frameNumber_; }
+
+    /// Return data size of a frame in bytes.
+    unsigned GetFrameSize() const { return frameSize_; }
+
+private:
+    /// Allocate the buffer with a given frame size. Release the previous buffer.
+    void Allocate(unsigned frameSize);
+    /// Release the buffer and the fences.
+    void Release();
+
+    /// Graphics subsystem.
+    WeakPtr<Graphics> graphics_;
+    /// Buffer object name.
+    unsigned object_{};
+    /// Persistently mapped memory of all regions, or null if not mapped.
+    byte* data_{};
+    /// Data size of a frame.
+    unsigned frameSize_{};
+    /// Required alignment of buffer offsets when binding.
+    unsigned alignment_{};
+    /// Current region, when persistently mapped.
+    unsigned region_{};
+    /// Write position within the current frame.
+    unsigned position_{};
+    /// Frame number.
+    unsigned frameNumber_{1};
+    /// Fences of the regions. GLsync objects, which do not exist on OpenGL ES 2.
+    void* fences_[NUM_CONSTANT_BUFFER_RING_FRAMES]{};
+    /// Current frame ran out of space flag.
+    bool overflow_{};
+};
+
+}
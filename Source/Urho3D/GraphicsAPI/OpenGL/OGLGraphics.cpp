@@ -12,6 +12,8 @@
 #include "../../GraphicsAPI/ConstantBuffer.h"
 #include "../../GraphicsAPI/IndexBuffer.h"
 #include "../../GraphicsAPI/OpenGL/OGLGraphicsImpl.h"
+#include "../../GraphicsAPI/OpenGL/OGLPersistentBuffer.h"
+#include "../../GraphicsAPI/OpenGL/OGLProgramBinaryBuilder.h"
 #include "../../GraphicsAPI/OpenGL/OGLShaderProgram.h"
 #include "../../GraphicsAPI/RenderSurface.h"
 #include "../../GraphicsAPI/Shader.h"
@@ -21,6 +23,7 @@
 #include "../../GraphicsAPI/TextureCube.h"
 #include "../../GraphicsAPI/VertexBuffer.h"
 #include "../../IO/File.h"
+#include "../../IO/FileSystem.h"
 #include "../../IO/Log.h"
 #include "../../Resource/ResourceCache.h"
 
@@ -274,6 +277,13 @@ static void GetGLPrimitiveType(unsigned elementCount, PrimitiveType type, unsign
     }
 }
 
+static intptr_t GetIndexDataOffset(IndexBuffer* buffer)
+{
+    // Persistently mapped index data is in the current region of the ring
+    PersistentBuffer_OGL* persistentBuffer = buffer->GetPersistentBuffer_OGL();
+    return persistentBuffer ? persistentBuffer->GetOffset() : 0;
+}
+
 void Graphics::Constructor_OGL()
 {
     impl_ = new GraphicsImpl_OGL();
@@ -618,6 +628,18 @@ bool Graphics::BeginFrame_OGL()
     numPrimitives_ = 0;
     numBatches_ = 0;
 
+    GraphicsImpl_OGL* impl = GetImpl_OGL();
+    if (impl->constantBufferRing_)
+    {
+        impl->constantBufferRing_->BeginFrame();
+        // The ring buffer object may have been reallocated, so bind the ranges again
+        for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS * 2; ++i)
+        {
+            impl->constantBufferObjects_[i] = 0;
+            impl->constantBufferOffsets_[i] = 0;
+        }
+    }
+
     SendEvent(E_BEGINRENDERING);
 
     return true;
@@ -632,6 +654,10 @@ void Graphics::EndFrame_OGL()
 
     SendEvent(E_ENDRENDERING);
 
+    GraphicsImpl_OGL* impl = GetImpl_OGL();
+    if (impl->constantBufferRing_)
+        impl->constantBufferRing_->EndFrame();
+
     SDL_GL_SwapWindow(window_);
 
     // Clean up too large scratch buffers
@@ -879,7 +905,7 @@ void Graphics::Draw_OGL(PrimitiveType type, unsigned indexStart, unsigned indexC
 
     GetGLPrimitiveType(indexCount, type, primitiveCount, glPrimitiveType);
     GLenum indexType = indexSize == sizeof(unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
-    intptr_t offset = (intptr_t)indexStart * indexSize;
+    intptr_t offset = (intptr_t)indexStart * indexSize + GetIndexDataOffset(indexBuffer_);
     glDrawElements(glPrimitiveType, indexCount, indexType, (const void*)offset);
 
     numPrimitives_ += primitiveCount;
@@ -900,7 +926,7 @@ void Graphics::Draw_OGL(PrimitiveType type, unsigned indexStart, unsigned indexC
 
     GetGLPrimitiveType(indexCount, type, primitiveCount, glPrimitiveType);
     GLenum indexType = indexSize == sizeof(unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
-    intptr_t offset = (intptr_t)indexStart * indexSize;
+    intptr_t offset = (intptr_t)indexStart * indexSize + GetIndexDataOffset(indexBuffer_);
     glDrawElementsBaseVertex(glPrimitiveType, indexCount, indexType, (const void*)offset, baseVertexIndex);
 
     numPrimitives_ += primitiveCount;
@@ -923,7 +949,7 @@ void Graphics::DrawInstanced_OGL(PrimitiveType type, unsigned indexStart, unsign
 
     GetGLPrimitiveType(indexCount, type, primitiveCount, glPrimitiveType);
     GLenum indexType = indexSize == sizeof(unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
-    intptr_t offset = (intptr_t)indexStart * indexSize;
+    intptr_t offset = (intptr_t)indexStart * indexSize + GetIndexDataOffset(indexBuffer_);
 #ifdef __EMSCRIPTEN__
     glDrawElementsInstancedANGLE(glPrimitiveType, indexCount, indexType, (const void*)offset, instanceCount);
 #else
@@ -959,7 +985,7 @@ void Graphics::DrawInstanced_OGL(PrimitiveType type, unsigned indexStart, unsign
 
     GetGLPrimitiveType(indexCount, type, primitiveCount, glPrimitiveType);
     GLenum indexType = indexSize == sizeof(unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
-    intptr_t offset = (intptr_t)indexStart * indexSize;
+    intptr_t offset = (intptr_t)indexStart * indexSize + GetIndexDataOffset(indexBuffer_);
     glDrawElementsInstancedBaseVertex(glPrimitiveType, indexCount, indexType, (const void*)offset, instanceCount, baseVertexIndex);
 
     numPrimitives_ += instanceCount * primitiveCount;
@@ -1025,47 +1051,68 @@ void Graphics::SetShaders_OGL(ShaderVariation* vs, ShaderVariation* ps)
     if (vs == vertexShader_ && ps == pixelShader_)
         return;
 
-    // Compile the shaders now if not yet compiled. If already attempted, do not retry
-    if (vs && !vs->GetGPUObjectName())
+    GraphicsImpl_OGL* impl = GetImpl_OGL();
+    Pair<ShaderVariation*, ShaderVariation*> combination(vs, ps);
+    ShaderProgramMap_OGL::Iterator i = impl->shaderPrograms_.Find(combination);
+
+    // Try to create a new combination from a stored program binary first, which does not need the shaders compiled.
+    // Generating the code, hashing it and checking the file is done only once per combination, so that a combination
+    // which failed to compile or link does not access the disk every time it is set
+    if (i == impl->shaderPrograms_.End() && vs && ps && programBinarySupport_ && !impl->programBinaryFileNames_.Contains(combination))
     {
-        if (vs->GetCompilerOutput().Empty())
-        {
-            URHO3D_PROFILE(CompileVertexShader);
+        const String fileName = ShaderProgram_OGL::GetBinaryFileName(this, vs->GetShaderCode_OGL(), ps->GetShaderCode_OGL());
+        impl->programBinaryFileNames_.Insert(MakePair(combination, fileName));
 
-            bool success = vs->Create();
-            if (success)
-                URHO3D_LOGDEBUG("Compiled vertex shader " + vs->GetFullName());
-            else
-            {
-                URHO3D_LOGERROR("Failed to compile vertex shader " + vs->GetFullName() + ":\n" + vs->GetCompilerOutput());
-                vs = nullptr;
-            }
+        SharedPtr<ShaderProgram_OGL> newProgram(new ShaderProgram_OGL(this, vs, ps));
+        if (newProgram->LoadBinary(fileName))
+        {
+            URHO3D_LOGDEBUG("Loaded program binary for vertex shader " + vs->GetFullName() + " and pixel shader " + ps->GetFullName());
+            i = impl->shaderPrograms_.Insert(MakePair(combination, newProgram));
         }
-        else
-            vs = nullptr;
     }
 
-    if (ps && !ps->GetGPUObjectName())
+    if (i == impl->shaderPrograms_.End())
     {
-        if (ps->GetCompilerOutput().Empty())
+        // Compile the shaders now if not yet compiled. If already attempted, do not retry
+        if (vs && !vs->GetGPUObjectName())
         {
-            URHO3D_PROFILE(CompilePixelShader);
+            if (vs->GetCompilerOutput().Empty())
+            {
+                URHO3D_PROFILE(CompileVertexShader);
 
-            bool success = ps->Create();
-            if (success)
-                URHO3D_LOGDEBUG("Compiled pixel shader " + ps->GetFullName());
+                bool success = vs->Create();
+                if (success)
+                    URHO3D_LOGDEBUG("Compiled vertex shader " + vs->GetFullName());
+                else
+                {
+                    URHO3D_LOGERROR("Failed to compile vertex shader " + vs->GetFullName() + ":\n" + vs->GetCompilerOutput());
+                    vs = nullptr;
+                }
+            }
             else
+                vs = nullptr;
+        }
+
+        if (ps && !ps->GetGPUObjectName())
+        {
+            if (ps->GetCompilerOutput().Empty())
             {
-                URHO3D_LOGERROR("Failed to compile pixel shader " + ps->GetFullName() + ":\n" + ps->GetCompilerOutput());
-                ps = nullptr;
+                URHO3D_PROFILE(CompilePixelShader);
+
+                bool success = ps->Create();
+                if (success)
+                    URHO3D_LOGDEBUG("Compiled pixel shader " + ps->GetFullName());
+                else
+                {
+                    URHO3D_LOGERROR("Failed to compile pixel shader " + ps->GetFullName() + ":\n" + ps->GetCompilerOutput());
+                    ps = nullptr;
+                }
             }
+            else
+                ps = nullptr;
         }
-        else
-            ps = nullptr;
     }
 
-    GraphicsImpl_OGL* impl = GetImpl_OGL();
-
     if (!vs || !ps)
     {
         glUseProgram(0);
@@ -1078,9 +1125,6 @@ void Graphics::SetShaders_OGL(ShaderVariation* vs, ShaderVariation* ps)
         vertexShader_ = vs;
         pixelShader_ = ps;
 
-        Pair<ShaderVariation*, ShaderVariation*> combination(vs, ps);
-        ShaderProgramMap_OGL::Iterator i = impl->shaderPrograms_.Find(combination);
-
         if (i != impl->shaderPrograms_.End())
         {
             // Use the existing linked program
@@ -1107,6 +1151,13 @@ void Graphics::SetShaders_OGL(ShaderVariation* vs, ShaderVariation* ps)
                 // Note: Link() calls glUseProgram() to set the texture sampler uniforms,
                 // so it is not necessary to call it again
                 impl->shaderProgram_ = newProgram;
+
+                if (programBinarySupport_)
+                {
+                    ProgramBinaryFileMap_OGL::Iterator j = impl->programBinaryFileNames_.Find(combination);
+                    newProgram->SaveBinary(j != impl->programBinaryFileNames_.End() ? j->second_ :
+                        ShaderProgram_OGL::GetBinaryFileName(this, vs->GetShaderCode_OGL(), ps->GetShaderCode_OGL()));
+                }
             }
             else
             {
@@ -1130,10 +1181,14 @@ void Graphics::SetShaders_OGL(ShaderVariation* vs, ShaderVariation* ps)
             ConstantBuffer* buffer = constantBuffers[i].Get();
             if (buffer != impl->constantBuffers_[i])
             {
-                unsigned object = buffer ? buffer->GetGPUObjectName() : 0;
-                glBindBufferBase(GL_UNIFORM_BUFFER, i, object);
-                // Calling glBindBufferBase also affects the generic buffer binding point
-                impl->boundUBO_ = object;
+                // With the constant buffer ring the binding is by range and is done before drawing
+                if (!impl->constantBufferRing_)
+                {
+                    unsigned object = buffer ? buffer->GetGPUObjectName() : 0;
+                    glBindBufferBase(GL_UNIFORM_BUFFER, i, object);
+                    // Calling glBindBufferBase also affects the generic buffer binding point
+                    impl->boundUBO_ = object;
+                }
                 impl->constantBuffers_[i] = buffer;
                 ShaderProgram_OGL::ClearGlobalParameterSource((ShaderParameterGroup)(i % MAX_SHADER_PARAMETER_GROUPS));
             }
@@ -2368,6 +2423,65 @@ void Graphics::CleanupRenderSurface_OGL(RenderSurface* surface)
         BindFramebuffer_OGL(impl->boundFBO_);
 }
 
+void Graphics::BuildProgramBinaries_OGL(Vector<Pair<ShaderVariation*, ShaderVariation*>>& combinations)
+{
+#ifdef URHO3D_GL_PROGRAM_BINARY
+    GraphicsImpl_OGL* impl = GetImpl_OGL();
+    if (!programBinarySupport_ || !window_ || !impl->context_)
+        return;
+
+    // Let a previous build finish first
+    if (impl->programBinaryBuilder_)
+    {
+        if (!impl->programBinaryBuilder_->IsFinished())
+            return;
+        impl->programBinaryBuilder_.Reset();
+    }
+
+    auto* fileSystem = GetSubsystem<FileSystem>();
+    Vector<ProgramBinaryJob_OGL> jobs;
+    Vector<Pair<ShaderVariation*, ShaderVariation*>> remaining;
+
+    for (const Pair<ShaderVariation*, ShaderVariation*>& combination : combinations)
+    {
+        if (combination.first_ && combination.second_ && !impl->shaderPrograms_.Contains(combination))
+        {
+            ProgramBinaryJob_OGL job;
+            job.vsCode_ = combination.first_->GetShaderCode_OGL();
+            job.psCode_ = combination.second_->GetShaderCode_OGL();
+            job.fileName_ = ShaderProgram_OGL::GetBinaryFileName(this, job.vsCode_, job.psCode_);
+            if (!job.fileName_.Empty() && !fileSystem->FileExists(job.fileName_))
+            {
+                jobs.Push(job);
+                continue;
+            }
+        }
+
+        remaining.Push(combination);
+    }
+
+    if (jobs.Empty())
+        return;
+
+    // Creating the shared context makes it current, so restore the main context afterward
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+    SDL_GLContext context = SDL_GL_CreateContext(window_);
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+    SDL_GL_MakeCurrent(window_, impl->context_);
+
+    if (!context)
+    {
+        URHO3D_LOGWARNING("Could not create shared OpenGL context for building program binaries: " + String(SDL_GetError()));
+        return;
+    }
+
+    URHO3D_LOGDEBUG("Building " + String(jobs.Size()) + " program binaries in the background");
+    impl->programBinaryBuilder_ = new ProgramBinaryBuilder_OGL(this, window_, context, jobs);
+    impl->programBinaryBuilder_->Run();
+    combinations = remaining;
+#endif
+}
+
 void Graphics::CleanupShaderPrograms_OGL(ShaderVariation* variation)
 {
     GraphicsImpl_OGL* impl = GetImpl_OGL();
@@ -2380,6 +2494,14 @@ void Graphics::CleanupShaderPrograms_OGL(ShaderVariation* variation)
             ++i;
     }
 
+    for (ProgramBinaryFileMap_OGL::Iterator i = impl->programBinaryFileNames_.Begin(); i != impl->programBinaryFileNames_.End();)
+    {
+        if (i->first_.first_ == variation || i->first_.second_ == variation)
+            i = impl->programBinaryFileNames_.Erase(i);
+        else
+            ++i;
+    }
+
     if (vertexShader_ == variation || pixelShader_ == variation)
         impl->shaderProgram_ = nullptr;
 }
@@ -2408,6 +2530,10 @@ void Graphics::Release_OGL(bool clearGPUObjects, bool closeWindow)
 
     GraphicsImpl_OGL* impl = GetImpl_OGL();
 
+    // Stop building program binaries before the contexts go away
+    impl->programBinaryBuilder_.Reset();
+    impl->constantBufferRing_.reset();
+
     {
         MutexLock lock(gpuObjectMutex_);
 
@@ -2416,6 +2542,7 @@ void Graphics::Release_OGL(bool clearGPUObjects, bool closeWindow)
             // Shutting down: release all GPU objects that still exist
             // Shader programs are also GPU objects; clear them first to avoid list modification during iteration
             impl->shaderPrograms_.Clear();
+            impl->programBinaryFileNames_.Clear();
 
             for (Vector<GPUObject*>::Iterator i = gpuObjects_.Begin(); i != gpuObjects_.End(); ++i)
                 (*i)->Release();
@@ -2430,6 +2557,7 @@ void Graphics::Release_OGL(bool clearGPUObjects, bool closeWindow)
             // In this case clear shader programs last so that they do not attempt to delete their OpenGL program
             // from a context that may no longer exist
             impl->shaderPrograms_.Clear();
+            impl->programBinaryFileNames_.Clear();
 
             SendEvent(E_DEVICELOST);
         }
@@ -2583,6 +2711,11 @@ void Graphics::MarkFBODirty_OGL()
     GetImpl_OGL()->fboDirty_ = true;
 }
 
+void Graphics::MarkVertexBuffersDirty_OGL()
+{
+    GetImpl_OGL()->vertexBuffersDirty_ = true;
+}
+
 void Graphics::SetVBO_OGL(unsigned object)
 {
     GraphicsImpl_OGL* impl = GetImpl_OGL();
@@ -2845,6 +2978,23 @@ void Graphics::CheckFeatureSupport_OGL()
     if (numSupportedRTs >= 4)
         deferredSupport_ = true;
 
+    // Program binaries are core since OpenGL 4.1. Some drivers expose the functions but no binary formats
+    programBinarySupport_ = false;
+    if (glGetProgramBinary && glProgramBinary && glProgramParameteri)
+    {
+        int numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        programBinarySupport_ = numFormats > 0;
+    }
+
+    // Buffer storage is core since OpenGL 4.4. Copies between the ring regions also need OpenGL 3.1
+    persistentMappingSupport_ = gl3Support && glBufferStorage && glMapBufferRange && glCopyBufferSubData && glFenceSync;
+
+    // Constant buffer data is packed into one uniform buffer per frame, which makes using constant buffers worthwhile
+    GraphicsImpl_OGL* impl = GetImpl_OGL();
+    if (gl3Support && !impl->constantBufferRing_)
+        impl->constantBufferRing_ = std::make_unique<ConstantBufferRing_OGL>(this);
+
 #if defined(__APPLE__) && !defined(IOS) && !defined(TVOS)
     // On macOS check for an Intel driver and use shadow map RGBA dummy color textures, because mixing
     // depth-only FBO rendering and backbuffer rendering will bug, resulting in a black screen in full
@@ -2878,6 +3028,9 @@ void Graphics::CheckFeatureSupport_OGL()
     if (numSupportedRTs >= 4)
         deferredSupport_ = true;
     anisotropySupport_ = CheckExtension("EXT_texture_filter_anisotropic");
+    int numFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+    programBinarySupport_ = numFormats > 0;
 #endif
 #endif
 
@@ -2924,13 +3077,52 @@ void Graphics::PrepareDraw_OGL()
 {
     GraphicsImpl_OGL* impl = GetImpl_OGL();
 
+    // Later writes into persistently mapped buffers must not overwrite the data this draw call reads
+    if (persistentMappingSupport_)
+    {
+        for (VertexBuffer* buffer : vertexBuffers_)
+        {
+            if (buffer && buffer->GetPersistentBuffer_OGL())
+                buffer->GetPersistentBuffer_OGL()->MarkDrawn();
+        }
+        if (indexBuffer_ && indexBuffer_->GetPersistentBuffer_OGL())
+            indexBuffer_->GetPersistentBuffer_OGL()->MarkDrawn();
+    }
+
 #ifndef URHO3D_GLES2
 #ifndef GL_ES_VERSION_3_0
     if (gl3Support)
 #endif
     {
-        for (Vector<ConstantBuffer*>::Iterator i = impl->dirtyConstantBuffers_.Begin(); i != impl->dirtyConstantBuffers_.End(); ++i)
-            (*i)->Apply();
+        ConstantBufferRing_OGL* ring = impl->constantBufferRing_.get();
+        if (ring)
+        {
+            // Pack the data of the bound constant buffers into the ring and bind it by range
+            for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS * 2; ++i)
+            {
+                ConstantBuffer* buffer = impl->constantBuffers_[i];
+                if (!buffer)
+                    continue;
+
+                buffer->Apply();
+                bool inRing = buffer->GetRingFrame_OGL() == ring->GetFrameNumber();
+                unsigned object = inRing ? ring->GetGPUObjectName() : buffer->GetGPUObjectName();
+                unsigned offset = inRing ? buffer->GetRingOffset_OGL() : 0;
+                if (object != impl->constantBufferObjects_[i] || offset != impl->constantBufferOffsets_[i])
+                {
+                    glBindBufferRange(GL_UNIFORM_BUFFER, i, object, offset, buffer->GetSize());
+                    // Calling glBindBufferRange also affects the generic buffer binding point
+                    impl->boundUBO_ = object;
+                    impl->constantBufferObjects_[i] = object;
+                    impl->constantBufferOffsets_[i] = offset;
+                }
+            }
+        }
+        else
+        {
+            for (Vector<ConstantBuffer*>::Iterator i = impl->dirtyConstantBuffers_.Begin(); i != impl->dirtyConstantBuffers_.End(); ++i)
+                (*i)->Apply();
+        }
         impl->dirtyConstantBuffers_.Clear();
     }
 #endif
@@ -3217,6 +3409,10 @@ void Graphics::PrepareDraw_OGL()
                         }
                     }
 
+                    PersistentBuffer_OGL* persistentBuffer = buffer->GetPersistentBuffer_OGL();
+                    if (persistentBuffer)
+                        dataStart += persistentBuffer->GetOffset();
+
                     SetVBO_OGL(buffer->GetGPUObjectName());
                     glVertexAttribPointer(location, glElementComponents[element.type_], glElementTypes[element.type_],
                         element.type_ == TYPE_UBYTE4_NORM ? GL_TRUE : GL_FALSE, (unsigned)buffer->GetVertexSize(),
@@ -3335,6 +3531,11 @@ void Graphics::ResetCachedState_OGL()
 
     for (auto& constantBuffer : impl->constantBuffers_)
         constantBuffer = nullptr;
+    for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS * 2; ++i)
+    {
+        impl->constantBufferObjects_[i] = 0;
+        impl->constantBufferOffsets_[i] = 0;
+    }
     impl->dirtyConstantBuffers_.Clear();
 }
 
@@ -3,13 +3,17 @@
 
 #pragma once
 
+#include "../../Container/FlatHashMap.h"
 #include "../../Container/HashMap.h"
 #include "../../Core/Timer.h"
 #include "../../GraphicsAPI/ConstantBuffer.h"
+#include "../../GraphicsAPI/OpenGL/OGLConstantBufferRing.h"
 #include "../../GraphicsAPI/OpenGL/OGLShaderProgram.h"
 #include "../../GraphicsAPI/Texture2D.h"
 #include "../../Math/Color.h"
 
+#include <memory>
+
 #if defined(IOS) || defined(TVOS)
 #if URHO3D_GLES3
 #include <OpenGLES/ES3/gl.h>
@@ -73,15 +77,22 @@
 #define COMPRESSED_RGBA_PVRTC_2BPPV1_IMG 0x8c03
 #endif
 
+// Program binaries are not available on OpenGL ES 2 and WebGL
+#if !defined(URHO3D_GLES2) && !defined(__EMSCRIPTEN__)
+#define URHO3D_GL_PROGRAM_BINARY
+#endif
+
 using SDL_GLContext = void *;
 
 namespace Urho3D
 {
 
 class Context;
+class ProgramBinaryBuilder_OGL;
 
 using ConstantBufferMap = HashMap<unsigned, SharedPtr<ConstantBuffer>>;
-using ShaderProgramMap_OGL = HashMap<Pair<ShaderVariation*, ShaderVariation*>, SharedPtr<ShaderProgram_OGL>>;
+using ShaderProgramMap_OGL = FlatHashMap<Pair<ShaderVariation*, ShaderVariation*>, SharedPtr<ShaderProgram_OGL>>;
+using ProgramBinaryFileMap_OGL = FlatHashMap<Pair<ShaderVariation*, ShaderVariation*>, String>;
 
 /// Cached state of a frame buffer object.
 struct FrameBufferObject
@@ -110,6 +121,9 @@ public:
     /// Return the GL Context.
     const SDL_GLContext& GetGLContext() { return context_; }
 
+    /// Return the ring buffer constant buffer data is packed into, or null if not used.
+    ConstantBufferRing_OGL* GetConstantBufferRing() const { return constantBufferRing_.get(); }
+
 private:
     /// SDL OpenGL context.
     SDL_GLContext context_{};
@@ -147,6 +161,12 @@ private:
     ConstantBuffer* constantBuffers_[MAX_SHADER_PARAMETER_GROUPS * 2]{};
     /// Dirty constant buffers.
     Vector<ConstantBuffer*> dirtyConstantBuffers_;
+    /// Ring buffer the constant buffer data of each frame is packed into.
+    std::unique_ptr<ConstantBufferRing_OGL> constantBufferRing_;
+    /// Buffer objects bound to the constant buffer binding points when using the ring buffer.
+    unsigned constantBufferObjects_[MAX_SHADER_PARAMETER_GROUPS * 2]{};
+    /// Byte offsets bound to the constant buffer binding points when using the ring buffer.
+    unsigned constantBufferOffsets_[MAX_SHADER_PARAMETER_GROUPS * 2]{};
     /// Last used instance data offset.
     unsigned lastInstanceOffset_{};
     /// Map for additional depth textures, to emulate Direct3D9 ability to mix render texture and backbuffer rendering.
@@ -155,6 +175,10 @@ private:
     ShaderProgram_OGL* shaderProgram_{};
     /// Linked shader programs.
     ShaderProgramMap_OGL shaderPrograms_;
+    /// Program binary file names of the shader combinations which have been looked up. A combination found here is not looked up again until its shaders are released, even if the binary was missing or rejected.
+    ProgramBinaryFileMap_OGL programBinaryFileNames_;
+    /// Background builder of missing program binaries.
+    SharedPtr<ProgramBinaryBuilder_OGL> programBinaryBuilder_;
     /// Need FBO commit flag.
     bool fboDirty_{};
     /// Need vertex attribute pointer update flag.
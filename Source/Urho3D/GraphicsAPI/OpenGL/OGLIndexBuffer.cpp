@@ -6,6 +6,7 @@
 #include "../../Core/Context.h"
 #include "../../Graphics/Graphics.h"
 #include "../../GraphicsAPI/GraphicsImpl.h"
+#include "../../GraphicsAPI/OpenGL/OGLPersistentBuffer.h"
 #include "../../GraphicsAPI/IndexBuffer.h"
 #include "../../IO/Log.h"
 
@@ -16,6 +17,9 @@ namespace Urho3D
 
 void IndexBuffer::OnDeviceLost_OGL()
 {
+    delete persistentBuffer_;
+    persistentBuffer_ = nullptr;
+
     if (object_.name_ && !graphics_->IsDeviceLost())
         glDeleteBuffers(1, &object_.name_);
 
@@ -39,6 +43,9 @@ void IndexBuffer::Release_OGL()
 {
     Unlock_OGL();
 
+    delete persistentBuffer_;
+    persistentBuffer_ = nullptr;
+
     if (object_.name_)
     {
         if (!graphics_)
@@ -77,8 +84,19 @@ bool IndexBuffer::SetData_OGL(const void* data)
     {
         if (!graphics_->IsDeviceLost())
         {
-            graphics_->SetIndexBuffer(this);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)indexCount_ * indexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            if (persistentBuffer_)
+            {
+                void* dest = MapBuffer_OGL(0, indexCount_, true);
+                if (dest)
+                    memcpy(dest, data, (size_t)indexCount_ * indexSize_);
+                else
+                    persistentBuffer_->SetDataRange(data, 0, indexCount_ * indexSize_);
+            }
+            else
+            {
+                graphics_->SetIndexBuffer(this);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)indexCount_ * indexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            }
         }
         else
         {
@@ -127,11 +145,22 @@ bool IndexBuffer::SetDataRange_OGL(const void* data, i32 start, i32 count, bool
     {
         if (!graphics_->IsDeviceLost())
         {
-            graphics_->SetIndexBuffer(this);
-            if (!discard || start != 0)
-                glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)start * indexSize_, (GLsizeiptr)count * indexSize_, data);
+            if (persistentBuffer_)
+            {
+                void* dest = MapBuffer_OGL(start, count, discard);
+                if (dest)
+                    memcpy(dest, data, (size_t)count * indexSize_);
+                else
+                    persistentBuffer_->SetDataRange(data, start * indexSize_, count * indexSize_);
+            }
             else
-                glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)count * indexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            {
+                graphics_->SetIndexBuffer(this);
+                // Orphan the old storage so that the driver does not need to wait for the GPU to finish reading it
+                if (discard)
+                    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)indexCount_ * indexSize_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+                glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)start * indexSize_, (GLsizeiptr)count * indexSize_, data);
+            }
         }
         else
         {
@@ -177,7 +206,19 @@ void* IndexBuffer::Lock_OGL(i32 start, i32 count, bool discard)
         lockState_ = LOCK_SHADOW;
         return shadowData_.Get() + (intptr_t)start * indexSize_;
     }
-    else if (graphics_)
+
+    // Write directly into persistently mapped memory if it is not in use by the GPU
+    if (persistentBuffer_ && !graphics_->IsDeviceLost())
+    {
+        void* hwData = MapBuffer_OGL(start, count, discard);
+        if (hwData)
+        {
+            lockState_ = LOCK_HARDWARE;
+            return hwData;
+        }
+    }
+
+    if (graphics_)
     {
         lockState_ = LOCK_SCRATCH;
         lockScratchData_ = graphics_->ReserveScratchBuffer(count * indexSize_);
@@ -191,6 +232,11 @@ void IndexBuffer::Unlock_OGL()
 {
     switch (lockState_)
     {
+    case LOCK_HARDWARE:
+        UnmapBuffer_OGL();
+        lockState_ = LOCK_NONE;
+        break;
+
     case LOCK_SHADOW:
         SetDataRange_OGL(shadowData_.Get() + (intptr_t)lockStart_ * indexSize_, lockStart_, lockCount_, discardLock_);
         lockState_ = LOCK_NONE;
@@ -225,6 +271,10 @@ bool IndexBuffer::Create_OGL()
             return true;
         }
 
+        // Persistently mapped storage is immutable, so a new buffer object is needed on resize
+        if (persistentBuffer_)
+            Release_OGL();
+
         if (!object_.name_)
             glGenBuffers(1, &object_.name_);
 
@@ -234,8 +284,21 @@ bool IndexBuffer::Create_OGL()
             return false;
         }
 
-        graphics_->SetIndexBuffer(this);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)indexCount_ * indexSize_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+        if (dynamic_ && graphics_->GetPersistentMappingSupport())
+        {
+            persistentBuffer_ = new PersistentBuffer_OGL(graphics_, object_.name_, indexCount_ * indexSize_);
+            if (!persistentBuffer_->IsValid())
+            {
+                URHO3D_LOGERROR("Failed to map dynamic index buffer");
+                Release_OGL();
+                return false;
+            }
+        }
+        else
+        {
+            graphics_->SetIndexBuffer(this);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)indexCount_ * indexSize_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+        }
     }
 
     return true;
@@ -251,13 +314,13 @@ bool IndexBuffer::UpdateToGPU_OGL()
 
 void* IndexBuffer::MapBuffer_OGL(i32 start, i32 count, bool discard)
 {
-    // Never called on OpenGL
-    return nullptr;
+    // The region offset is applied by Graphics on each indexed draw call
+    return persistentBuffer_ ? persistentBuffer_->Map(start * indexSize_, count * indexSize_, discard) : nullptr;
 }
 
 void IndexBuffer::UnmapBuffer_OGL()
 {
-    // Never called on OpenGL
+    // Persistently mapped memory is coherent, so there is nothing to flush
 }
 
 } // namespace Urho3D
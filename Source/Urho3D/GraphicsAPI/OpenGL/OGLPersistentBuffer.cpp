@@ -0,0 +1,161 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../../Precompiled.h"
+
+#include "../../Graphics/Graphics.h"
+#include "../../GraphicsAPI/GraphicsImpl.h"
+#include "../../GraphicsAPI/OpenGL/OGLPersistentBuffer.h"
+
+#include "../../DebugNew.h"
+
+namespace Urho3D
+{
+
+PersistentBuffer_OGL::PersistentBuffer_OGL(Graphics* graphics, unsigned object, i32 size) :
+    graphics_(graphics),
+    object_(object),
+    size_(size),
+    // Keep the regions aligned for vertex attribute and index data offsets
+    stride_((size + 15) & ~15)
+{
+#ifndef GL_ES_VERSION_2_0
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, object_);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, (GLsizeiptr)stride_ * NUM_PERSISTENT_BUFFER_REGIONS, nullptr, flags | GL_DYNAMIC_STORAGE_BIT);
+    data_ = (byte*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, (GLsizeiptr)stride_ * NUM_PERSISTENT_BUFFER_REGIONS, flags);
+#endif
+}
+
+PersistentBuffer_OGL::~PersistentBuffer_OGL()
+{
+#ifndef GL_ES_VERSION_2_0
+    if (!graphics_ || graphics_->IsDeviceLost())
+        return;
+
+    for (void* fence : regionFences_)
+    {
+        if (fence)
+            glDeleteSync((GLsync)fence);
+    }
+    if (pendingFence_)
+        glDeleteSync((GLsync)pendingFence_);
+#endif
+}
+
+byte* PersistentBuffer_OGL::Map(i32 start, i32 count, bool discard)
+{
+    assert(start >= 0 && count >= 0 && start + count <= size_);
+
+    if (drawn_)
+    {
+        if (!NextRegion(start, count, discard))
+            return nullptr;
+    }
+    else if (pendingFence_)
+    {
+        // The driver may still be copying into the region, and would overwrite what the CPU writes now
+        if (!IsSignaled(pendingFence_))
+            return nullptr;
+#ifndef GL_ES_VERSION_2_0
+        glDeleteSync((GLsync)pendingFence_);
+#endif
+        pendingFence_ = nullptr;
+    }
+
+    return data_ + GetOffset() + start;
+}
+
+byte* PersistentBuffer_OGL::MapNoOverwrite(i32 start, i32 count)
+{
+    assert(start >= 0 && count >= 0 && start + count <= size_);
+
+    if (pendingFence_)
+    {
+        if (!IsSignaled(pendingFence_))
+            return nullptr;
+#ifndef GL_ES_VERSION_2_0
+        glDeleteSync((GLsync)pendingFence_);
+#endif
+        pendingFence_ = nullptr;
+    }
+
+    return data_ + GetOffset() + start;
+}
+
+void PersistentBuffer_OGL::SetDataRange(const void* data, i32 start, i32 count)
+{
+    assert(start >= 0 && count >= 0 && start + count <= size_);
+
+#ifndef GL_ES_VERSION_2_0
+    glBindBuffer(GL_COPY_WRITE_BUFFER, object_);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)GetOffset() + start, count, data);
+    FencePendingWrites();
+#endif
+}
+
+bool PersistentBuffer_OGL::NextRegion(i32 start, i32 count, bool discard)
+{
+#ifndef GL_ES_VERSION_2_0
+    i32 next = (region_ + 1) % NUM_PERSISTENT_BUFFER_REGIONS;
+    if (regionFences_[next])
+    {
+        if (!IsSignaled(regionFences_[next]))
+            return false;
+        glDeleteSync((GLsync)regionFences_[next]);
+        regionFences_[next] = nullptr;
+    }
+
+    // The region fence also covers any GL commands still writing into the region being left
+    if (pendingFence_)
+    {
+        glDeleteSync((GLsync)pendingFence_);
+        pendingFence_ = nullptr;
+    }
+    regionFences_[region_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    i32 source = GetOffset();
+    region_ = next;
+    drawn_ = false;
+
+    // Carry over the data outside the written range on the GPU. The ranges do not overlap what the CPU writes next
+    if (!discard)
+    {
+        i32 dest = GetOffset();
+        i32 end = start + count;
+        glBindBuffer(GL_COPY_READ_BUFFER, object_);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, object_);
+        if (start > 0)
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, source, dest, start);
+        if (end < size_)
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)source + end, (GLintptr)dest + end, size_ - end);
+        if (start > 0 || end < size_)
+            FencePendingWrites();
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PersistentBuffer_OGL::FencePendingWrites()
+{
+#ifndef GL_ES_VERSION_2_0
+    if (pendingFence_)
+        glDeleteSync((GLsync)pendingFence_);
+    pendingFence_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+}
+
+bool PersistentBuffer_OGL::IsSignaled(void* fence)
+{
+#ifndef GL_ES_VERSION_2_0
+    // Flush so that the fence is eventually signaled even if nothing else is submitted
+    return glClientWaitSync((GLsync)fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0) != GL_TIMEOUT_EXPIRED;
+#else
+    return true;
+#endif
+}
+
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../../Container/Ptr.h"
+
+namespace Urho3D
+{
+
+class Graphics;
+
+/// Number of regions in the ring of a persistently mapped dynamic buffer.
+static const i32 NUM_PERSISTENT_BUFFER_REGIONS = 3;
+
+/// Ring of persistently mapped regions backing a dynamic vertex or index buffer. A write after the buffer has been drawn from moves to the next region, so that the CPU writes directly into GPU-visible memory while the GPU may still read the previous regions. Fences keep a region from being written before the GPU is done with it.
+class PersistentBuffer_OGL
+{
+public:
+    /// Construct. Allocate immutable storage for the ring into a buffer object which has no storage yet and map it.
+    PersistentBuffer_OGL(Graphics* graphics, unsigned object, i32 size);
+    /// Destruct. Delete the fences unless the graphics context has been lost. The buffer object is deleted by the owner.
+    ~PersistentBuffer_OGL();
+
+    /// Return pointer for writing a byte range of the data, moving to the next region first if the current one has been drawn from. Data outside the range is carried over unless discarded. Return null if the GPU may still access the memory, in which case SetDataRange() writes through the driver instead.
+    byte* Map(i32 start, i32 count, bool discard);
+    /// Return pointer for writing a byte range of the data in the current region, even if it has been drawn from. No submitted draw call may read the range. Return null if the driver may still be writing into the region.
+    byte* MapNoOverwrite(i32 start, i32 count);
+    /// Write a byte range of the data through the driver into the current region.
+    void SetDataRange(const void* data, i32 start, i32 count);
+
+    /// Mark the current region drawn from. Called by Graphics before each draw call.
+    void MarkDrawn() { drawn_ = true; }
+
+    /// Return whether the storage was allocated and mapped.
+    bool IsValid() const { return data_ != nullptr; }
+
+    /// Return byte offset of the current region within the buffer object.
+    i32 GetOffset() const { return region_ * stride_; }
+
+private:
+    /// Move to the next region if the GPU is done with it. Return true if successful.
+    bool NextRegion(i32 start, i32 count, bool discard);
+    /// Insert a fence after the GL commands which write into the current region.
+    void FencePendingWrites();
+    /// Return true if a fence has been signaled. Does not wait.
+    static bool IsSignaled(void* fence);
+
+    /// Graphics subsystem.
+    WeakPtr<Graphics> graphics_;
+    /// Buffer object name.
+    unsigned object_;
+    /// Mapped memory of the whole ring.
+    byte* data_{};
+    /// Data size of one region.
+    i32 size_;
+    /// Distance between regions in bytes.
+    i32 stride_;
+    /// Current region.
+    i32 region_{};
+    /// Fences of the regions drawn from and left, null when the region is free. GLsync objects, which do not exist on OpenGL ES 2.
+    void* regionFences_[NUM_PERSISTENT_BUFFER_REGIONS]{};
+    /// Fence of GL commands which write into the current region. The CPU must not write into it before the fence is signaled.
+    void* pendingFence_{};
+    /// Current region drawn from flag.
+    bool drawn_{};
+};
+
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../../Precompiled.h"
+
+#include "../../Core/Profiler.h"
+#include "../../Graphics/Graphics.h"
+#include "../../GraphicsAPI/GraphicsImpl.h"
+#include "../../IO/Log.h"
+#include "OGLProgramBinaryBuilder.h"
+
+#include <SDL/SDL.h>
+
+#include "../../DebugNew.h"
+
+namespace Urho3D
+{
+
+#ifdef URHO3D_GL_PROGRAM_BINARY
+static unsigned CompileShader(GLenum type, const String& code)
+{
+    unsigned shader = glCreateShader(type);
+    if (!shader)
+        return 0;
+
+    const char* codeCStr = code.CString();
+    glShaderSource(shader, 1, &codeCStr, nullptr);
+    glCompileShader(shader);
+
+    int compiled;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled)
+    {
+        glDeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+#endif
+
+ProgramBinaryBuilder_OGL::ProgramBinaryBuilder_OGL(Graphics* graphics, SDL_Window* window, void* context,
+    const Vector<ProgramBinaryJob_OGL>& jobs) :
+    graphics_(graphics),
+    window_(window),
+    context_(context),
+    jobs_(jobs),
+    finished_(false)
+{
+}
+
+ProgramBinaryBuilder_OGL::~ProgramBinaryBuilder_OGL()
+{
+    Stop();
+
+    if (context_)
+        SDL_GL_DeleteContext(context_);
+}
+
+void ProgramBinaryBuilder_OGL::ThreadFunction()
+{
+    URHO3D_PROFILE_THREAD("ProgramBinaryBuilder Thread");
+
+#ifdef URHO3D_GL_PROGRAM_BINARY
+    if (SDL_GL_MakeCurrent(window_, context_) != 0)
+    {
+        URHO3D_LOGERROR("Could not make shared OpenGL context current: " + String(SDL_GetError()));
+        finished_.store(true, std::memory_order_release);
+        return;
+    }
+
+    HiresTimer timer;
+    unsigned numBuilt = 0;
+    for (const ProgramBinaryJob_OGL& job : jobs_)
+    {
+        if (!shouldRun_)
+            break;
+        if (BuildProgram(job))
+            ++numBuilt;
+    }
+
+    SDL_GL_MakeCurrent(window_, nullptr);
+
+    URHO3D_LOGDEBUG("Built " + String(numBuilt) + " of " + String(jobs_.Size()) + " program binaries in " +
+        String(timer.GetUSec(false) / 1000) + " ms");
+#endif
+
+    finished_.store(true, std::memory_order_release);
+}
+
+bool ProgramBinaryBuilder_OGL::BuildProgram(const ProgramBinaryJob_OGL& job)
+{
+#ifdef URHO3D_GL_PROGRAM_BINARY
+    // Compile errors are not logged here, as the main thread will report them when it compiles the shaders
+    unsigned vs = CompileShader(GL_VERTEX_SHADER, job.vsCode_);
+    unsigned ps = CompileShader(GL_FRAGMENT_SHADER, job.psCode_);
+
+    bool success = false;
+    if (vs && ps)
+    {
+        unsigned program = glCreateProgram();
+        if (program)
+        {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+            glAttachShader(program, vs);
+            glAttachShader(program, ps);
+            glLinkProgram(program);
+
+            int linked;
+            glGetProgramiv(program, GL_LINK_STATUS, &linked);
+            if (linked)
+                success = ShaderProgram_OGL::WriteBinaryFile(graphics_, job.fileName_, program);
+
+            glDeleteProgram(program);
+        }
+    }
+
+    if (vs)
+        glDeleteShader(vs);
+    if (ps)
+        glDeleteShader(ps);
+
+    return success;
+#else
+    return false;
+#endif
+}
+
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../../Container/RefCounted.h"
+#include "../../Container/Str.h"
+#include "../../Container/Vector.h"
+#include "../../Core/Thread.h"
+
+#include <atomic>
+
+struct SDL_Window;
+
+namespace Urho3D
+{
+
+class Graphics;
+
+/// Shader program to be built by the program binary builder.
+struct ProgramBinaryJob_OGL
+{
+    /// Vertex shader code with defines.
+    String vsCode_;
+    /// Pixel shader code with defines.
+    String psCode_;
+    /// Program binary file to write.
+    String fileName_;
+};
+
+/// Background thread which compiles and links shader programs in an OpenGL context shared with the main context and writes their program binaries to the shader cache directory, so that the main thread only needs to load them.
+class URHO3D_API ProgramBinaryBuilder_OGL : public RefCounted, public Thread
+{
+public:
+    /// Construct. Takes ownership of the shared context, which must not be current in any thread.
+    ProgramBinaryBuilder_OGL(Graphics* graphics, SDL_Window* window, void* context, const Vector<ProgramBinaryJob_OGL>& jobs);
+    /// Destruct. Stop the thread and delete the shared context.
+    ~ProgramBinaryBuilder_OGL() override;
+
+    /// Build the programs.
+    void ThreadFunction() override;
+
+    /// Return whether all programs have been processed.
+    bool IsFinished() const { return finished_.load(std::memory_order_acquire); }
+
+private:
+    /// Compile and link one program and write its binary. Return true if successful.
+    bool BuildProgram(const ProgramBinaryJob_OGL& job);
+
+    /// Graphics subsystem.
+    Graphics* graphics_;
+    /// Window the shared context is made current with.
+    SDL_Window* window_;
+    /// Shared context.
+    void* context_;
+    /// Programs to build.
+    Vector<ProgramBinaryJob_OGL> jobs_;
+    /// Finished flag.
+    std::atomic<bool> finished_;
+};
+
+}
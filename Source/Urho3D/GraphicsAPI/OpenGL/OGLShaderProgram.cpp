@@ -3,10 +3,13 @@
 
 #include "../../Precompiled.h"
 
+#include "../../Core/Thread.h"
 #include "../../Graphics/Graphics.h"
 #include "../../GraphicsAPI/ConstantBuffer.h"
 #include "../../GraphicsAPI/GraphicsImpl.h"
 #include "../../GraphicsAPI/ShaderVariation.h"
+#include "../../IO/File.h"
+#include "../../IO/FileSystem.h"
 #include "../../IO/Log.h"
 #include "OGLShaderProgram.h"
 
@@ -36,6 +39,13 @@ static unsigned NumberPostfix(const String& str)
     return M_MAX_UNSIGNED;
 }
 
+#ifdef URHO3D_GL_PROGRAM_BINARY
+static StringHash GetDriverHash(Graphics* graphics)
+{
+    return StringHash(graphics->GetRendererName() + " " + graphics->GetVersionString());
+}
+#endif
+
 i32 ShaderProgram_OGL::globalFrameNumber = 0;
 const void* ShaderProgram_OGL::globalParameterSources[MAX_SHADER_PARAMETER_GROUPS];
 
@@ -108,6 +118,11 @@ bool ShaderProgram_OGL::Link()
         return false;
     }
 
+#ifdef URHO3D_GL_PROGRAM_BINARY
+    if (graphics_->GetProgramBinarySupport())
+        glProgramParameteri(object_.name_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
     glAttachShader(object_.name_, vertexShader_->GetGPUObjectName());
     glAttachShader(object_.name_, pixelShader_->GetGPUObjectName());
     glLinkProgram(object_.name_);
@@ -129,6 +144,131 @@ bool ShaderProgram_OGL::Link()
     if (!object_.name_)
         return false;
 
+    ParseParameters();
+    return true;
+}
+
+bool ShaderProgram_OGL::LoadBinary(const String& fileName)
+{
+#ifdef URHO3D_GL_PROGRAM_BINARY
+    Release();
+
+    if (fileName.Empty() || !vertexShader_ || !pixelShader_)
+        return false;
+
+    if (!graphics_->GetSubsystem<FileSystem>()->FileExists(fileName))
+        return false;
+
+    File file(graphics_->GetContext(), fileName);
+    if (!file.IsOpen() || file.ReadFileID() != "UGLP" || file.ReadU32() != GetDriverHash(graphics_).Value())
+        return false;
+
+    GLenum format = file.ReadU32();
+    Vector<byte> data((i32)(file.GetSize() - file.GetPosition()));
+    if (data.Empty() || file.Read(&data[0], data.Size()) != data.Size())
+        return false;
+
+    object_.name_ = glCreateProgram();
+    if (!object_.name_)
+        return false;
+
+    glProgramBinary(object_.name_, format, &data[0], data.Size());
+
+    // The driver may reject an otherwise valid binary, for example after a driver update. The caller will then link
+    // from source instead
+    int linked;
+    glGetProgramiv(object_.name_, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        glDeleteProgram(object_.name_);
+        object_.name_ = 0;
+        return false;
+    }
+
+    linkerOutput_.Clear();
+    ParseParameters();
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ShaderProgram_OGL::SaveBinary(const String& fileName) const
+{
+    if (fileName.Empty() || !object_.name_)
+        return false;
+
+    return WriteBinaryFile(graphics_, fileName, object_.name_);
+}
+
+String ShaderProgram_OGL::GetBinaryFileName(Graphics* graphics, const String& vsCode, const String& psCode)
+{
+#ifdef URHO3D_GL_PROGRAM_BINARY
+    const String& cacheDir = graphics->GetShaderCacheDir();
+    if (!graphics->GetProgramBinarySupport() || !IsAbsolutePath(cacheDir))
+        return String::EMPTY;
+
+    // Include the code lengths in addition to the hashes to make collisions less likely
+    return cacheDir + "Program_" + GetDriverHash(graphics).ToString() + "_" + StringHash(vsCode).ToString() +
+        ToStringHex(vsCode.Length()) + "_" + StringHash(psCode).ToString() + ToStringHex(psCode.Length()) + ".glb";
+#else
+    return String::EMPTY;
+#endif
+}
+
+bool ShaderProgram_OGL::WriteBinaryFile(Graphics* graphics, const String& fileName, unsigned program)
+{
+#ifdef URHO3D_GL_PROGRAM_BINARY
+    int length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+
+    Vector<byte> data(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, &data[0]);
+    if (length <= 0)
+        return false;
+
+    auto* fileSystem = graphics->GetSubsystem<FileSystem>();
+    String path = GetPath(fileName);
+    if (!fileSystem->DirExists(path))
+        fileSystem->CreateDir(path);
+
+    // Write to a temporary file first, so that a partially written binary is never read by another thread or a later
+    // run. The main thread and the program binary builder use different temporary files
+    String tempFileName = fileName + (Thread::IsMainThread() ? ".tmp" : ".tmp2");
+    {
+        File file(graphics->GetContext(), tempFileName, FILE_WRITE);
+        if (!file.IsOpen())
+            return false;
+
+        file.WriteFileID("UGLP");
+        file.WriteU32(GetDriverHash(graphics).Value());
+        file.WriteU32(format);
+        if (file.Write(&data[0], (i32)length) != (i32)length)
+        {
+            file.Close();
+            fileSystem->Delete(tempFileName);
+            return false;
+        }
+    }
+
+    if (!fileSystem->Rename(tempFileName, fileName))
+    {
+        // Renaming fails on Windows if the other thread already stored the same program
+        fileSystem->Delete(tempFileName);
+        return false;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ShaderProgram_OGL::ParseParameters()
+{
     const int MAX_NAME_LENGTH = 256;
     char nameBuffer[MAX_NAME_LENGTH];
     int attributeCount, uniformCount, elementCount, nameLength;
@@ -294,11 +434,8 @@ bool ShaderProgram_OGL::Link()
         }
     }
 
-    // Rehash the parameter & vertex attributes maps to ensure minimal load factor
+    // Rehash the vertex attributes map to ensure minimal load factor
     vertexAttributes_.Rehash(NextPowerOfTwo(vertexAttributes_.Size()));
-    shaderParameters_.Rehash(NextPowerOfTwo(shaderParameters_.Size()));
-
-    return true;
 }
 
 ShaderVariation* ShaderProgram_OGL::GetVertexShader() const
@@ -318,7 +455,7 @@ bool ShaderProgram_OGL::HasParameter(StringHash param) const
 
 const ShaderParameter* ShaderProgram_OGL::GetParameter(StringHash param) const
 {
-    HashMap<StringHash, ShaderParameter>::ConstIterator i = shaderParameters_.Find(param);
+    FlatHashMap<StringHash, ShaderParameter>::ConstIterator i = shaderParameters_.Find(param);
     if (i != shaderParameters_.End())
         return &i->second_;
     else
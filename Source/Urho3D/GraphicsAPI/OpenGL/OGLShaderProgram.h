@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "../../Container/FlatHashMap.h"
 #include "../../Container/HashMap.h"
 #include "../../Container/RefCounted.h"
 #include "../../GraphicsAPI/GPUObject.h"
@@ -31,6 +32,10 @@ public:
 
     /// Link the shaders and examine the uniforms and samplers used. Return true if successful.
     bool Link();
+    /// Create from a program binary file written by SaveBinary() and examine the uniforms and samplers used. The shaders do not need to be compiled. Return true if successful.
+    bool LoadBinary(const String& fileName);
+    /// Write the linked program to a program binary file. Return true if successful.
+    bool SaveBinary(const String& fileName) const;
 
     /// Return the vertex shader.
     ShaderVariation* GetVertexShader() const;
@@ -66,14 +71,21 @@ public:
     static void ClearParameterSources();
     /// Clear a global parameter source when constant buffers change.
     static void ClearGlobalParameterSource(ShaderParameterGroup group);
+    /// Return program binary file name in the shader cache directory for shader source code, keyed by the driver and the source. Return empty if program binaries are not supported.
+    static String GetBinaryFileName(Graphics* graphics, const String& vsCode, const String& psCode);
+    /// Write a program binary file from a linked program object. Can be called from outside the main thread with a shared context current. Return true if successful.
+    static bool WriteBinaryFile(Graphics* graphics, const String& fileName, unsigned program);
 
 private:
+    /// Examine the vertex attributes, uniforms and samplers of the linked program.
+    void ParseParameters();
+
     /// Vertex shader.
     WeakPtr<ShaderVariation> vertexShader_;
     /// Pixel shader.
     WeakPtr<ShaderVariation> pixelShader_;
     /// Shader parameters.
-    HashMap<StringHash, ShaderParameter> shaderParameters_;
+    FlatHashMap<StringHash, ShaderParameter> shaderParameters_;
     /// Texture unit use.
     bool useTextureUnits_[MAX_TEXTURE_UNITS]{};
     /// Vertex attributes.
@@ -40,11 +40,13 @@ void ShaderVariation::OnDeviceLost_OGL()
 
 void ShaderVariation::Release_OGL()
 {
-    if (object_.name_)
-    {
-        if (!graphics_)
-            return;
+    if (object_.name_ && !graphics_)
+        return;
 
+    // Shader programs may also have been created from a program binary without compiling this variation, so check
+    // for them regardless of the GPU object
+    if (graphics_)
+    {
         if (!graphics_->IsDeviceLost())
         {
             if (type_ == VS)
@@ -58,7 +60,8 @@ void ShaderVariation::Release_OGL()
                     graphics_->SetShaders(nullptr, nullptr);
             }
 
-            glDeleteShader(object_.name_);
+            if (object_.name_)
+                glDeleteShader(object_.name_);
         }
 
         object_.name_ = 0;
@@ -70,7 +73,9 @@ void ShaderVariation::Release_OGL()
 
 bool ShaderVariation::Create_OGL()
 {
-    Release_OGL();
+    // Programs created from program binaries are kept if this variation was not compiled before
+    if (object_.name_)
+        Release_OGL();
 
     if (!owner_)
     {
@@ -85,6 +90,46 @@ bool ShaderVariation::Create_OGL()
         return false;
     }
 
+    String shaderCode = GetShaderCode_OGL();
+
+    // In debug mode, check that all defines are referenced by the shader code
+#ifdef _DEBUG
+    const String& originalShaderCode = owner_->GetSourceCode(type_);
+    Vector<String> defineVec = defines_.Split(' ');
+    for (unsigned i = 0; i < defineVec.Size(); ++i)
+    {
+        String defineCheck = defineVec[i].Split('=')[0];
+        if (originalShaderCode.Find(defineCheck) == String::NPOS)
+            URHO3D_LOGWARNING("Shader " + GetFullName() + " does not use the define " + defineCheck);
+    }
+#endif
+
+    const char* shaderCStr = shaderCode.CString();
+    glShaderSource(object_.name_, 1, &shaderCStr, nullptr);
+    glCompileShader(object_.name_);
+
+    int compiled, length;
+    glGetShaderiv(object_.name_, GL_COMPILE_STATUS, &compiled);
+    if (!compiled)
+    {
+        glGetShaderiv(object_.name_, GL_INFO_LOG_LENGTH, &length);
+        compilerOutput_.Resize((unsigned)length);
+        int outLength;
+        glGetShaderInfoLog(object_.name_, length, &outLength, &compilerOutput_[0]);
+        glDeleteShader(object_.name_);
+        object_.name_ = 0;
+    }
+    else
+        compilerOutput_.Clear();
+
+    return object_.name_ != 0;
+}
+
+String ShaderVariation::GetShaderCode_OGL() const
+{
+    if (!owner_)
+        return String::EMPTY;
+
     const String& originalShaderCode = owner_->GetSourceCode(type_);
     String shaderCode;
 
@@ -132,18 +177,7 @@ bool ShaderVariation::Create_OGL()
     // Prepend the defines to the shader code
     Vector<String> defineVec = defines_.Split(' ');
     for (unsigned i = 0; i < defineVec.Size(); ++i)
-    {
-        // Add extra space for the checking code below
-        String defineString = "#define " + defineVec[i].Replaced('=', ' ') + " \n";
-        shaderCode += defineString;
-
-        // In debug mode, check that all defines are referenced by the shader code
-#ifdef _DEBUG
-        String defineCheck = defineString.Substring(8, defineString.Find(' ', 8) - 8);
-        if (originalShaderCode.Find(defineCheck) == String::NPOS)
-            URHO3D_LOGWARNING("Shader " + GetFullName() + " does not use the define " + defineCheck);
-#endif
-    }
+        shaderCode += "#define " + defineVec[i].Replaced('=', ' ') + " \n";
 
 #ifdef RPI
     if (type_ == VS)
@@ -154,6 +188,9 @@ bool ShaderVariation::Create_OGL()
 #endif
     if (Graphics::GetGL3Support())
         shaderCode += "#define GL3\n";
+    // Constant buffers are worth using only when their data is packed into the ring buffer
+    if (graphics_ && graphics_->GetImpl_OGL()->GetConstantBufferRing())
+        shaderCode += "#define USE_CBUFFERS\n";
 
     // When version define found, do not insert it a second time
     if (verEnd > 0)
@@ -161,25 +198,7 @@ bool ShaderVariation::Create_OGL()
     else
         shaderCode += originalShaderCode;
 
-    const char* shaderCStr = shaderCode.CString();
-    glShaderSource(object_.name_, 1, &shaderCStr, nullptr);
-    glCompileShader(object_.name_);
-
-    int compiled, length;
-    glGetShaderiv(object_.name_, GL_COMPILE_STATUS, &compiled);
-    if (!compiled)
-    {
-        glGetShaderiv(object_.name_, GL_INFO_LOG_LENGTH, &length);
-        compilerOutput_.Resize((unsigned)length);
-        int outLength;
-        glGetShaderInfoLog(object_.name_, length, &outLength, &compilerOutput_[0]);
-        glDeleteShader(object_.name_);
-        object_.name_ = 0;
-    }
-    else
-        compilerOutput_.Clear();
-
-    return object_.name_ != 0;
+    return shaderCode;
 }
 
 void ShaderVariation::SetDefines_OGL(const String& defines)
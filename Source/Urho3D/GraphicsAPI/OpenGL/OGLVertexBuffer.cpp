@@ -5,6 +5,7 @@
 
 #include "../../Graphics/Graphics.h"
 #include "../../GraphicsAPI/GraphicsImpl.h"
+#include "../../GraphicsAPI/OpenGL/OGLPersistentBuffer.h"
 #include "../../GraphicsAPI/VertexBuffer.h"
 #include "../../IO/Log.h"
 
@@ -15,6 +16,9 @@ namespace Urho3D
 
 void VertexBuffer::OnDeviceLost_OGL()
 {
+    delete persistentBuffer_;
+    persistentBuffer_ = nullptr;
+
     if (object_.name_ && !graphics_->IsDeviceLost())
         glDeleteBuffers(1, &object_.name_);
 
@@ -38,6 +42,9 @@ void VertexBuffer::Release_OGL()
 {
     Unlock_OGL();
 
+    delete persistentBuffer_;
+    persistentBuffer_ = nullptr;
+
     if (object_.name_)
     {
         if (!graphics_)
@@ -80,8 +87,19 @@ bool VertexBuffer::SetData_OGL(const void* data)
     {
         if (!graphics_->IsDeviceLost())
         {
-            graphics_->SetVBO_OGL(object_.name_);
-            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertexCount_ * vertexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            if (persistentBuffer_)
+            {
+                void* dest = MapBuffer_OGL(0, vertexCount_, true);
+                if (dest)
+                    memcpy(dest, data, (size_t)vertexCount_ * vertexSize_);
+                else
+                    persistentBuffer_->SetDataRange(data, 0, vertexCount_ * vertexSize_);
+            }
+            else
+            {
+                graphics_->SetVBO_OGL(object_.name_);
+                glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertexCount_ * vertexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            }
         }
         else
         {
@@ -130,11 +148,22 @@ bool VertexBuffer::SetDataRange_OGL(const void* data, i32 start, i32 count, bool
     {
         if (!graphics_->IsDeviceLost())
         {
-            graphics_->SetVBO_OGL(object_.name_);
-            if (!discard || start != 0)
-                glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)start * vertexSize_, (GLsizeiptr)count * vertexSize_, data);
+            if (persistentBuffer_)
+            {
+                void* dest = MapBuffer_OGL(start, count, discard);
+                if (dest)
+                    memcpy(dest, data, (size_t)count * vertexSize_);
+                else
+                    persistentBuffer_->SetDataRange(data, start * vertexSize_, count * vertexSize_);
+            }
             else
-                glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)count * vertexSize_, data, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+            {
+                graphics_->SetVBO_OGL(object_.name_);
+                // Orphan the old storage so that the driver does not need to wait for the GPU to finish reading it
+                if (discard)
+                    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertexCount_ * vertexSize_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+                glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)start * vertexSize_, (GLsizeiptr)count * vertexSize_, data);
+            }
         }
         else
         {
@@ -146,7 +175,7 @@ bool VertexBuffer::SetDataRange_OGL(const void* data, i32 start, i32 count, bool
     return true;
 }
 
-void* VertexBuffer::Lock_OGL(i32 start, i32 count, bool discard)
+void* VertexBuffer::Lock_OGL(i32 start, i32 count, bool discard, bool noOverwrite)
 {
     assert(start >= 0 && count >= 0);
 
@@ -174,13 +203,28 @@ void* VertexBuffer::Lock_OGL(i32 start, i32 count, bool discard)
     lockStart_ = start;
     lockCount_ = count;
     discardLock_ = discard;
+    noOverwriteLock_ = noOverwrite;
 
     if (shadowData_)
     {
         lockState_ = LOCK_SHADOW;
         return shadowData_.Get() + (intptr_t)start * vertexSize_;
     }
-    else if (graphics_)
+
+    // Write directly into persistently mapped memory if it is not in use by the GPU. When not overwriting anything the GPU
+    // may read, stay in the current region
+    if (persistentBuffer_ && !graphics_->IsDeviceLost())
+    {
+        void* hwData = noOverwrite ? persistentBuffer_->MapNoOverwrite(start * vertexSize_, count * vertexSize_) :
+            MapBuffer_OGL(start, count, discard);
+        if (hwData)
+        {
+            lockState_ = LOCK_HARDWARE;
+            return hwData;
+        }
+    }
+
+    if (graphics_)
     {
         lockState_ = LOCK_SCRATCH;
         lockScratchData_ = graphics_->ReserveScratchBuffer(count * vertexSize_);
@@ -194,13 +238,21 @@ void VertexBuffer::Unlock_OGL()
 {
     switch (lockState_)
     {
+    case LOCK_HARDWARE:
+        UnmapBuffer_OGL();
+        lockState_ = LOCK_NONE;
+        break;
+
     case LOCK_SHADOW:
         SetDataRange_OGL(shadowData_.Get() + (intptr_t)lockStart_ * vertexSize_, lockStart_, lockCount_, discardLock_);
         lockState_ = LOCK_NONE;
         break;
 
     case LOCK_SCRATCH:
-        SetDataRange_OGL(lockScratchData_, lockStart_, lockCount_, discardLock_);
+        if (noOverwriteLock_ && persistentBuffer_ && !graphics_->IsDeviceLost())
+            persistentBuffer_->SetDataRange(lockScratchData_, lockStart_ * vertexSize_, lockCount_ * vertexSize_);
+        else
+            SetDataRange_OGL(lockScratchData_, lockStart_, lockCount_, discardLock_);
         if (graphics_)
             graphics_->FreeScratchBuffer(lockScratchData_);
         lockScratchData_ = nullptr;
@@ -228,6 +280,10 @@ bool VertexBuffer::Create_OGL()
             return true;
         }
 
+        // Persistently mapped storage is immutable, so a new buffer object is needed on resize
+        if (persistentBuffer_)
+            Release_OGL();
+
         if (!object_.name_)
             glGenBuffers(1, &object_.name_);
         if (!object_.name_)
@@ -236,8 +292,21 @@ bool VertexBuffer::Create_OGL()
             return false;
         }
 
-        graphics_->SetVBO_OGL(object_.name_);
-        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertexCount_ * vertexSize_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+        if (dynamic_ && graphics_->GetPersistentMappingSupport())
+        {
+            persistentBuffer_ = new PersistentBuffer_OGL(graphics_, object_.name_, vertexCount_ * vertexSize_);
+            if (!persistentBuffer_->IsValid())
+            {
+                URHO3D_LOGERROR("Failed to map dynamic vertex buffer");
+                Release_OGL();
+                return false;
+            }
+        }
+        else
+        {
+            graphics_->SetVBO_OGL(object_.name_);
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertexCount_ * vertexSize_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+        }
     }
 
     return true;
@@ -253,13 +322,31 @@ bool VertexBuffer::UpdateToGPU_OGL()
 
 void* VertexBuffer::MapBuffer_OGL(i32 start, i32 count, bool discard)
 {
-    // Never called on OpenGL
-    return nullptr;
+    if (!persistentBuffer_)
+        return nullptr;
+
+    i32 oldOffset = persistentBuffer_->GetOffset();
+    void* hwData = persistentBuffer_->Map(start * vertexSize_, count * vertexSize_, discard);
+
+    // Vertex attribute pointers include the region offset, so they need to be set again if the buffer is bound
+    if (persistentBuffer_->GetOffset() != oldOffset)
+    {
+        for (i32 i = 0; i < MAX_VERTEX_STREAMS; ++i)
+        {
+            if (graphics_->GetVertexBuffer(i) == this)
+            {
+                graphics_->MarkVertexBuffersDirty_OGL();
+                break;
+            }
+        }
+    }
+
+    return hwData;
 }
 
 void VertexBuffer::UnmapBuffer_OGL()
 {
-    // Never called on OpenGL
+    // Persistently mapped memory is coherent, so there is nothing to flush
 }
 
 }
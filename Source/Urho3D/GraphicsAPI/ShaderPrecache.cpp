@@ -92,6 +92,7 @@ void ShaderPrecache::LoadShaders(Graphics* graphics, Deserializer& source)
     XMLFile xmlFile(graphics->GetContext());
     xmlFile.Load(source);
 
+    Vector<Pair<ShaderVariation*, ShaderVariation*>> combinations;
     XMLElement shader = xmlFile.GetRoot().GetChild("shader");
     while (shader)
     {
@@ -113,12 +114,22 @@ void ShaderPrecache::LoadShaders(Graphics* graphics, Deserializer& source)
 
         ShaderVariation* vs = graphics->GetShader(VS, shader.GetAttribute("vs"), vsDefines);
         ShaderVariation* ps = graphics->GetShader(PS, shader.GetAttribute("ps"), psDefines);
-        // Set the shaders active to actually compile them
-        graphics->SetShaders(vs, ps);
+        combinations.Push(MakePair(vs, ps));
 
         shader = shader.GetNext("shader");
     }
 
+#ifdef URHO3D_OPENGL
+    // Link the programs missing from the program binary cache in a background thread, so that they only need to be
+    // loaded when used
+    if (Graphics::GetGAPI() == GAPI_OPENGL)
+        graphics->BuildProgramBinaries_OGL(combinations);
+#endif
+
+    // Set the shaders active to actually compile them
+    for (const Pair<ShaderVariation*, ShaderVariation*>& combination : combinations)
+        graphics->SetShaders(combination.first_, combination.second_);
+
     URHO3D_LOGDEBUG("End precaching shaders");
 }
 
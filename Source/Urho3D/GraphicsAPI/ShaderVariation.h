@@ -118,6 +118,11 @@ public:
     /// Return defines with the CLIPPLANE define appended. Used internally on Direct3D11 only, will be empty on other APIs.
     const String& GetDefinesClipPlane() { return definesClipPlane_; }
 
+#ifdef URHO3D_OPENGL
+    /// Return the source code with the defines prepended, as passed to the compiler. Used internally on OpenGL only.
+    String GetShaderCode_OGL() const;
+#endif
+
     /// OpenGL vertex semantic names. Used internally.
     static const char* elementSemanticNames_OGL[];
 
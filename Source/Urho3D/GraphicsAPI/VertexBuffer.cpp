@@ -282,12 +282,30 @@ void* VertexBuffer::Lock(i32 start, i32 count, bool discard)
 
 #ifdef URHO3D_OPENGL
     if (gapi == GAPI_OPENGL)
-        return Lock_OGL(start, count, discard);
+        return Lock_OGL(start, count, discard, false);
 #endif
 
 #ifdef URHO3D_D3D11
     if (gapi == GAPI_D3D11)
-        return Lock_D3D11(start, count, discard);
+        return Lock_D3D11(start, count, discard, false);
+#endif
+
+    return {}; // Prevent warning
+}
+
+void* VertexBuffer::LockNoOverwrite(i32 start, i32 count)
+{
+    assert(start >= 0 && count >= 0);
+    GAPI gapi = Graphics::GetGAPI();
+
+#ifdef URHO3D_OPENGL
+    if (gapi == GAPI_OPENGL)
+        return Lock_OGL(start, count, false, true);
+#endif
+
+#ifdef URHO3D_D3D11
+    if (gapi == GAPI_D3D11)
+        return Lock_D3D11(start, count, false, true);
 #endif
 
     return {}; // Prevent warning
@@ -11,6 +11,8 @@
 namespace Urho3D
 {
 
+class PersistentBuffer_OGL;
+
 /// Hardware vertex buffer.
 class URHO3D_API VertexBuffer : public Object, public GPUObject
 {
@@ -42,6 +44,8 @@ public:
     bool SetDataRange(const void* data, i32 start, i32 count, bool discard = false);
     /// Lock the buffer for write-only editing. Return data pointer if successful. Optionally discard data outside the range.
     void* Lock(i32 start, i32 count, bool discard = false);
+    /// Lock a range the GPU has not drawn from since the buffer was last discarded, for appending without synchronizing with earlier draw calls. Return data pointer if successful. Falls back to a non-discarding lock when the memory can not be written directly.
+    void* LockNoOverwrite(i32 start, i32 count);
     /// Unlock the buffer and apply changes to the GPU buffer.
     void Unlock();
 
@@ -114,6 +118,9 @@ public:
     /// Return shared array pointer to the CPU memory shadow data.
     SharedArrayPtr<byte> GetShadowDataShared() const { return shadowData_; }
 
+    /// Return persistently mapped ring of a dynamic buffer, or null if not used. Used only on OpenGL.
+    PersistentBuffer_OGL* GetPersistentBuffer_OGL() const { return persistentBuffer_; }
+
     /// Return buffer hash for building vertex declarations. Used internally.
     hash64 GetBufferHash(i32 streamIndex) { return elementHash_ << (streamIndex * 16); }
 
@@ -145,9 +152,9 @@ private:
     bool Create();
     /// Update the shadow data to the GPU buffer.
     bool UpdateToGPU();
-    /// Map the GPU buffer into CPU memory. Not used on OpenGL.
+    /// Map the GPU buffer into CPU memory. On OpenGL only for persistently mapped dynamic buffers, may return null if the memory is in use.
     void* MapBuffer(i32 start, i32 count, bool discard);
-    /// Unmap the GPU buffer. Not used on OpenGL.
+    /// Unmap the GPU buffer.
     void UnmapBuffer();
 
 #ifdef URHO3D_OPENGL
@@ -156,7 +163,7 @@ private:
     void Release_OGL();
     bool SetData_OGL(const void* data);
     bool SetDataRange_OGL(const void* data, i32 start, i32 count, bool discard = false);
-    void* Lock_OGL(i32 start, i32 count, bool discard);
+    void* Lock_OGL(i32 start, i32 count, bool discard, bool noOverwrite);
     void Unlock_OGL();
     bool Create_OGL();
     bool UpdateToGPU_OGL();
@@ -170,11 +177,12 @@ private:
     void Release_D3D11();
     bool SetData_D3D11(const void* data);
     bool SetDataRange_D3D11(const void* data, i32 start, i32 count, bool discard = false);
-    void* Lock_D3D11(i32 start, i32 count, bool discard);
+    void* Lock_D3D11(i32 start, i32 count, bool discard, bool noOverwrite);
     void Unlock_D3D11();
     bool Create_D3D11();
     bool UpdateToGPU_D3D11();
     void* MapBuffer_D3D11(i32 start, i32 count, bool discard);
+    void* MapBufferNoOverwrite_D3D11(i32 start, i32 count);
     void UnmapBuffer_D3D11();
 #endif // def URHO3D_D3D11
 
@@ -198,12 +206,16 @@ private:
     i32 lockCount_{};
     /// Scratch buffer for fallback locking.
     void* lockScratchData_{};
+    /// Persistently mapped ring of a dynamic buffer. Used by OpenGL only.
+    PersistentBuffer_OGL* persistentBuffer_{};
     /// Dynamic flag.
     bool dynamic_{};
     /// Shadowed flag.
     bool shadowed_{};
     /// Discard lock flag. Used by OpenGL only.
     bool discardLock_{};
+    /// No-overwrite lock flag. Used by OpenGL only.
+    bool noOverwriteLock_{};
 };
 
 }
@@ -4,6 +4,7 @@
 #include "../IK/IK.h"
 #include "../IK/IKConstraint.h"
 #include "../IK/IKEffector.h"
+#include "../IK/IKScheduler.h"
 #include "../IK/IKSolver.h"
 
 namespace Urho3D
@@ -17,6 +18,7 @@ void RegisterIKLibrary(Context* context)
     //IKConstraint::RegisterObject(context);
     IKEffector::RegisterObject(context);
     IKSolver::RegisterObject(context);
+    IKScheduler::RegisterObject(context);
 }
 
 } // namespace Urho3D
@@ -0,0 +1,248 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../IK/IKScheduler.h"
+#include "../IK/IKSolver.h"
+
+#include "../Container/FrameArena.h"
+#include "../Container/Sort.h"
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+
+namespace Urho3D
+{
+
+extern const char* IK_CATEGORY;
+
+// ----------------------------------------------------------------------------
+IKScheduler::IKScheduler(Context* context) :
+    Component(context),
+    maxSolvesPerFrame_(0),
+    maxSolveDistance_(0.0f),
+    parallelSolve_(true),
+    numSolved_(0)
+{
+}
+
+// ----------------------------------------------------------------------------
+IKScheduler::~IKScheduler() = default;
+
+// ----------------------------------------------------------------------------
+void IKScheduler::RegisterObject(Context* context)
+{
+    context->RegisterFactory<IKScheduler>(IK_CATEGORY);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Solves Per Frame", GetMaxSolvesPerFrame, SetMaxSolvesPerFrame, 0, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Solve Distance", GetMaxSolveDistance, SetMaxSolveDistance, 0.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Parallel Solve", GetParallelSolve, SetParallelSolve, true, AM_DEFAULT);
+}
+
+// ----------------------------------------------------------------------------
+void IKScheduler::SetMaxSolvesPerFrame(i32 count)
+{
+    maxSolvesPerFrame_ = Max(count, 0);
+}
+
+// ----------------------------------------------------------------------------
+void IKScheduler::SetMaxSolveDistance(float distance)
+{
+    maxSolveDistance_ = Max(distance, 0.0f);
+}
+
+// ----------------------------------------------------------------------------
+void IKScheduler::SetParallelSolve(bool enable)
+{
+    parallelSolve_ = enable;
+}
+
+// ----------------------------------------------------------------------------
+void IKScheduler::SetLodReference(Node* node)
+{
+    lodReference_ = node;
+}
+
+// ----------------------------------------------------------------------------
+void IKScheduler::AddSolver(IKSolver* solver)
+{
+    for (const SolverEntry& entry : solvers_)
+    {
+        if (entry.solver_ == solver)
+            return;
+    }
+
+    solvers_.Push(SolverEntry{solver, 0});
+}
+
+// ----------------------------------------------------------------------------
+void IKScheduler::RemoveSolver(IKSolver* solver)
+{
+    for (i32 i = 0; i < solvers_.Size(); ++i)
+    {
+        if (solvers_[i].solver_ == solver)
+        {
+            solvers_.Erase(i);
+            return;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+void IKScheduler::Solve()
+{
+    numSolved_ = 0;
+    if (solvers_.Empty())
+        return;
+
+    URHO3D_PROFILE(SolveIK);
+
+    struct Candidate
+    {
+        IKSolver* solver_;
+        i32 entryIndex_;
+        float priority_;
+        i32 depth_;
+    };
+
+    Node* lodReference = lodReference_;
+    const Vector3 referencePosition = lodReference ? lodReference->GetWorldPosition() : Vector3::ZERO;
+
+    // Leave out the solvers that are too far. Closer solvers and the ones that have waited longer get a smaller value
+    FrameVector<Candidate> candidates;
+    candidates.Reserve(solvers_.Size());
+    for (i32 i = 0; i < solvers_.Size(); ++i)
+    {
+        const SolverEntry& entry = solvers_[i];
+        float distance = 0.0f;
+        if (lodReference)
+        {
+            distance = (entry.solver_->GetNode()->GetWorldPosition() - referencePosition).Length();
+            if (maxSolveDistance_ > 0.0f && distance > maxSolveDistance_)
+                continue;
+        }
+
+        candidates.Push(Candidate{entry.solver_, i, (distance + 1.0f) / (float)(entry.framesSkipped_ + 1), 0});
+    }
+
+    // Over the budget, solve the most urgent ones and let the rest wait
+    if (maxSolvesPerFrame_ > 0 && candidates.Size() > maxSolvesPerFrame_)
+    {
+        Sort(RandomAccessIterator<Candidate>(candidates.Begin()), RandomAccessIterator<Candidate>(candidates.End()),
+            [](const Candidate& lhs, const Candidate& rhs) { return lhs.priority_ < rhs.priority_; });
+
+        for (i32 i = maxSolvesPerFrame_; i < candidates.Size(); ++i)
+            ++solvers_[candidates[i].entryIndex_].framesSkipped_;
+        candidates.Resize(maxSolvesPerFrame_);
+    }
+
+    i32 maxDepth = 0;
+    for (Candidate& candidate : candidates)
+    {
+        solvers_[candidate.entryIndex_].framesSkipped_ = 0;
+        candidate.depth_ = GetNestingDepth(candidate.solver_);
+        maxDepth = Max(maxDepth, candidate.depth_);
+    }
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    const bool threaded = parallelSolve_ && queue && queue->GetNumThreads();
+
+    // Nested solvers start from the pose their parent solvers have written to the scene, so solve them in later waves
+    FrameVector<IKSolver*> wave;
+    for (i32 depth = 0; depth <= maxDepth; ++depth)
+    {
+        wave.Clear();
+        for (const Candidate& candidate : candidates)
+        {
+            if (candidate.depth_ == depth && candidate.solver_->BeginSolve())
+                wave.Push(candidate.solver_);
+        }
+
+        const i32 count = wave.Size();
+        if (threaded && count > 1)
+        {
+            const i32 numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
+            const i32 solversPerItem = Max(count / numWorkItems, 1);
+
+            IKSolver** start = wave.Begin();
+            IKSolver** end = wave.End();
+            for (i32 i = 0; i < numWorkItems && start != end; ++i)
+            {
+                IKSolver** itemEnd = end;
+                if (i < numWorkItems - 1 && end - start > solversPerItem)
+                    itemEnd = start + solversPerItem;
+
+                SharedPtr<WorkItem> item = queue->GetFreeItem();
+                item->priority_ = WI_MAX_PRIORITY;
+                item->workFunction_ = SolveWork;
+                item->start_ = start;
+                item->end_ = itemEnd;
+                queue->AddWorkItem(item);
+
+                start = itemEnd;
+            }
+
+            queue->Complete(WI_MAX_PRIORITY);
+        }
+        else
+        {
+            for (IKSolver* solver : wave)
+                solver->SolveActivePose();
+        }
+
+        for (IKSolver* solver : wave)
+            solver->ApplyActivePoseToScene();
+
+        numSolved_ += count;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void IKScheduler::OnSceneSet(Scene* scene)
+{
+    if (scene)
+        SubscribeToEvent(scene, E_SCENEDRAWABLEUPDATEFINISHED, URHO3D_HANDLER(IKScheduler, HandleSceneDrawableUpdateFinished));
+    else
+    {
+        UnsubscribeFromEvent(E_SCENEDRAWABLEUPDATEFINISHED);
+
+        // Removed while solvers remain, so let them register to a new scheduler
+        Vector<SolverEntry> solvers;
+        solvers.Swap(solvers_);
+        for (const SolverEntry& entry : solvers)
+            entry.solver_->OnSchedulerRemoved();
+    }
+}
+
+// ----------------------------------------------------------------------------
+void IKScheduler::HandleSceneDrawableUpdateFinished(StringHash eventType, VariantMap& eventData)
+{
+    if (IsEnabledEffective())
+        Solve();
+}
+
+// ----------------------------------------------------------------------------
+i32 IKScheduler::GetNestingDepth(const IKSolver* solver)
+{
+    i32 depth = 0;
+    for (const Node* node = solver->GetNode()->GetParent(); node != nullptr; node = node->GetParent())
+    {
+        if (node->HasComponent<IKSolver>())
+            ++depth;
+    }
+    return depth;
+}
+
+// ----------------------------------------------------------------------------
+void IKScheduler::SolveWork(const WorkItem* item, i32 /*threadIndex*/)
+{
+    auto** start = reinterpret_cast<IKSolver**>(item->start_);
+    auto** end = reinterpret_cast<IKSolver**>(item->end_);
+
+    for (IKSolver** i = start; i != end; ++i)
+        (*i)->SolveActivePose();
+}
+
+} // namespace Urho3D
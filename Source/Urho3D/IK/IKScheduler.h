@@ -0,0 +1,106 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../Scene/Component.h"
+
+namespace Urho3D
+{
+
+class IKSolver;
+struct WorkItem;
+
+/*!
+ * @brief Solves the automatically solved IK solvers of a scene.
+ *
+ * Created automatically by the first IKSolver with the AUTO_SOLVE feature.
+ * After the scene's drawables have been updated, the solvers are solved in
+ * waves: a solver nested in the subtree of another solver is solved after it.
+ * Within a wave, the solvers copy the scene pose and the effector targets on
+ * the main thread, solve in parallel on the work queue, and write the results
+ * back to the scene on the main thread.
+ *
+ * The number of solvers per frame can be limited, in which case the solvers
+ * closest to the LOD reference node and the ones that have waited the longest
+ * are solved first. Solvers further than the maximum distance from the LOD
+ * reference node are not solved.
+ * @nobind
+ */
+class URHO3D_API IKScheduler : public Component
+{
+    URHO3D_OBJECT(IKScheduler, Component);
+
+public:
+    /// Construct.
+    explicit IKScheduler(Context* context);
+    /// Destruct.
+    ~IKScheduler() override;
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Set maximum number of solvers solved per frame. 0 is unlimited.
+    void SetMaxSolvesPerFrame(i32 count);
+    /// Set maximum distance from the LOD reference node where solvers are solved. 0 is unlimited.
+    void SetMaxSolveDistance(float distance);
+    /// Set whether to solve on the work queue threads.
+    void SetParallelSolve(bool enable);
+    /// Set the node the solver distances are measured from, typically the camera node. Not serialized.
+    void SetLodReference(Node* node);
+
+    /// Return maximum number of solvers solved per frame.
+    i32 GetMaxSolvesPerFrame() const { return maxSolvesPerFrame_; }
+    /// Return maximum distance from the LOD reference node where solvers are solved.
+    float GetMaxSolveDistance() const { return maxSolveDistance_; }
+    /// Return whether solves on the work queue threads.
+    bool GetParallelSolve() const { return parallelSolve_; }
+    /// Return the LOD reference node.
+    Node* GetLodReference() const { return lodReference_; }
+    /// Return number of registered solvers.
+    i32 GetNumSolvers() const { return solvers_.Size(); }
+    /// Return number of solvers solved on the last update.
+    i32 GetNumSolved() const { return numSolved_; }
+
+    /// Solve the registered solvers now. Called automatically after the scene's drawables have been updated.
+    void Solve();
+
+private:
+    friend class IKSolver;
+
+    /// Registered solver.
+    struct SolverEntry
+    {
+        /// Solver.
+        IKSolver* solver_;
+        /// Number of updates the solver has been left out because of the solve budget.
+        i32 framesSkipped_;
+    };
+
+    /// Add a solver. Called by the solver when it enters the scene with the auto solve feature.
+    void AddSolver(IKSolver* solver);
+    /// Remove a solver.
+    void RemoveSolver(IKSolver* solver);
+    /// Subscribe to drawable update finished event here.
+    void OnSceneSet(Scene* scene) override;
+    /// Handle scene drawable update finished event.
+    void HandleSceneDrawableUpdateFinished(StringHash eventType, VariantMap& eventData);
+    /// Return number of IK solvers above the solver in the scene graph.
+    static i32 GetNestingDepth(const IKSolver* solver);
+    /// Work function for solving a range of solvers.
+    static void SolveWork(const WorkItem* item, i32 threadIndex);
+
+    /// Registered solvers.
+    Vector<SolverEntry> solvers_;
+    /// Node the distances are measured from.
+    WeakPtr<Node> lodReference_;
+    /// Maximum number of solvers solved per frame.
+    i32 maxSolvesPerFrame_;
+    /// Maximum distance from the LOD reference node where solvers are solved.
+    float maxSolveDistance_;
+    /// Parallel solve flag.
+    bool parallelSolve_;
+    /// Number of solvers solved on the last update.
+    i32 numSolved_;
+};
+
+} // namespace Urho3D
@@ -6,6 +6,7 @@
 #include "../IK/IKEvents.h"
 #include "../IK/IKEffector.h"
 #include "../IK/IKConverters.h"
+#include "../IK/IKScheduler.h"
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
@@ -13,6 +14,7 @@
 #include "../Graphics/AnimationState.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../IO/Log.h"
+#include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
 
 #include <ik/effector.h>
@@ -20,6 +22,10 @@
 #include <ik/solver.h>
 #include <ik/util.h>
 
+#ifdef URHO3D_SSE
+#include <emmintrin.h>
+#endif
+
 namespace Urho3D
 {
 
@@ -33,7 +39,8 @@ IKSolver::IKSolver(Context* context) :
     features_(AUTO_SOLVE | JOINT_ROTATIONS | UPDATE_ACTIVE_POSE),
     chainTreesNeedUpdating_(false),
     treeNeedsRebuild(true),
-    solverTreeValid_(false)
+    solverTreeValid_(false),
+    poseNodesDirty_(true)
 {
     context_->RequireIK();
 
@@ -48,6 +55,9 @@ IKSolver::IKSolver(Context* context) :
 // ----------------------------------------------------------------------------
 IKSolver::~IKSolver()
 {
+    if (scheduler_)
+        scheduler_->RemoveSolver(this);
+
     // Destroying the solver tree will destroy the effector objects, so remove
     // any references any of the IKEffector objects could be holding
     for (Vector<IKEffector*>::ConstIterator it = effectorList_.Begin(); it != effectorList_.End(); ++it)
@@ -83,6 +93,7 @@ void IKSolver::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Use Original Pose", GetUSE_ORIGINAL_POSE, SetUSE_ORIGINAL_POSE, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Enable Constraints", GetCONSTRAINTS, SetCONSTRAINTS, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Auto Solve", GetAUTO_SOLVE, SetAUTO_SOLVE, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("SIMD FABRIK", GetSIMD_FABRIK, SetSIMD_FABRIK, false, AM_DEFAULT);
 }
 
 // ----------------------------------------------------------------------------
@@ -151,23 +162,15 @@ void IKSolver::SetFeature(Feature feature, bool enable)
                 solver_->flags |= SOLVER_CALCULATE_TARGET_ROTATIONS;
         } break;
 
-        case AUTO_SOLVE:
-        {
-            if (((features_ & AUTO_SOLVE) != 0) == enable)
-                break;
-
-            if (enable)
-                SubscribeToEvent(GetScene(), E_SCENEDRAWABLEUPDATEFINISHED, URHO3D_HANDLER(IKSolver, HandleSceneDrawableUpdateFinished));
-            else
-                UnsubscribeFromEvent(GetScene(), E_SCENEDRAWABLEUPDATEFINISHED);
-        } break;
-
         default: break;
     }
 
     features_ &= ~feature;
     if (enable)
         features_ |= feature;
+
+    if (feature == AUTO_SOLVE)
+        UpdateScheduler();
 }
 
 // ----------------------------------------------------------------------------
@@ -205,6 +208,7 @@ ik_node_t* IKSolver::CreateIKNodeFromUrhoNode(const Node* node)
     ikNode->original_position = Vec3Urho2IK(node->GetWorldPosition());
     ikNode->original_rotation = QuatUrho2IK(node->GetWorldRotation());
     ikNode->user_data = (void*)node;
+    poseNodesDirty_ = true;
 
     /*
      * If Urho's node has an effector, also create and attach one to the
@@ -247,6 +251,7 @@ void IKSolver::DestroyTree()
     ik_solver_destroy_tree(solver_);
     effectorList_.Clear();
     constraintList_.Clear();
+    poseNodesDirty_ = true;
 }
 
 // ----------------------------------------------------------------------------
@@ -381,6 +386,16 @@ void IKSolver::Solve()
 {
     URHO3D_PROFILE(IKSolve);
 
+    if (BeginSolve() == false)
+        return;
+
+    SolveActivePose();
+    ApplyActivePoseToScene();
+}
+
+// ----------------------------------------------------------------------------
+bool IKSolver::BeginSolve()
+{
     if (treeNeedsRebuild)
         RebuildTree();
 
@@ -388,7 +403,7 @@ void IKSolver::Solve()
         RebuildChainTrees();
 
     if (IsSolverTreeValid() == false)
-        return;
+        return false;
 
     if (features_ & UPDATE_ORIGINAL_POSE)
         ApplySceneToOriginalPose();
@@ -404,60 +419,251 @@ void IKSolver::Solve()
         (*it)->UpdateTargetNodePosition();
     }
 
-    ik_solver_solve(solver_);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void IKSolver::SolveActivePose()
+{
+    if ((features_ & SIMD_FABRIK) == 0 || SolveFABRIKChains() == false)
+        ik_solver_solve(solver_);
 
     if (features_ & JOINT_ROTATIONS)
         ik_solver_calculate_joint_rotations(solver_);
+}
 
-    ApplyActivePoseToScene();
+// ----------------------------------------------------------------------------
+static inline ik_node_t* GetChainNode(const chain_t* chain, i32 index)
+{
+    return *(ik_node_t**)ordered_vector_get_element(const_cast<ordered_vector_t*>(&chain->nodes), index);
 }
 
 // ----------------------------------------------------------------------------
-static void ApplyInitialPoseToSceneCallback(ik_node_t* ikNode)
+/*
+ * Blends the effector's target position with the original position of the
+ * effector node by the effector's weight, the same way the IK library does.
+ */
+static Vector3 GetWeightedTargetPosition(const chain_t* chain)
 {
-    auto* node = (Node*)ikNode->user_data;
-    node->SetWorldRotation(QuatIK2Urho(&ikNode->original_rotation));
-    node->SetWorldPosition(Vec3IK2Urho(&ikNode->original_position));
+    const ik_node_t* effectorNode = GetChainNode(chain, 0);
+    const ik_effector_t* effector = effectorNode->effector;
+    const Vector3 originalPosition = Vec3IK2Urho(&effectorNode->original_position);
+    const Vector3 targetPosition = Vec3IK2Urho(&effector->target_position);
+    const float weight = effector->weight;
+    Vector3 result = originalPosition + (targetPosition - originalPosition) * weight;
+
+    // Pin the target to the base node for more natural transitions
+    if ((effector->flags & EFFECTOR_WEIGHT_NLERP) && weight < 1.0f)
+    {
+        const ik_node_t* baseNode = GetChainNode(chain, ordered_vector_count(&chain->nodes) - 1);
+        const Vector3 basePosition = Vec3IK2Urho(&baseNode->original_position);
+        const float distance = (targetPosition - basePosition).Length() * weight +
+            (originalPosition - basePosition).Length() * (1.0f - weight);
+
+        Vector3 direction = result - basePosition;
+        const float length = direction.Length();
+        direction = length != 0.0f ? direction / length : Vector3::RIGHT;
+        result = basePosition + direction * distance;
+    }
+
+    return result;
 }
-void IKSolver::ApplyOriginalPoseToScene()
+
+// ----------------------------------------------------------------------------
+/*
+ * Moves from "from" the given distance towards "to". Coinciding points are
+ * separated along the X axis, like the IK library's normalisation does.
+ */
+static inline void MoveTowards(Vector4& result, const Vector4& from, const Vector4& to, float distance)
 {
-    ik_solver_iterate_tree(solver_, ApplyInitialPoseToSceneCallback);
+#ifdef URHO3D_SSE
+    const __m128 fromVec = _mm_loadu_ps(&from.x_);
+    __m128 delta = _mm_sub_ps(_mm_loadu_ps(&to.x_), fromVec);
+    __m128 lengthSquared = _mm_mul_ps(delta, delta);
+    lengthSquared = _mm_add_ps(lengthSquared, _mm_shuffle_ps(lengthSquared, lengthSquared, _MM_SHUFFLE(2, 3, 0, 1)));
+    lengthSquared = _mm_add_ps(lengthSquared, _mm_shuffle_ps(lengthSquared, lengthSquared, _MM_SHUFFLE(1, 0, 3, 2)));
+    if (_mm_cvtss_f32(lengthSquared) != 0.0f)
+        delta = _mm_mul_ps(delta, _mm_div_ps(_mm_set1_ps(distance), _mm_sqrt_ps(lengthSquared)));
+    else
+        delta = _mm_set_ps(0.0f, 0.0f, 0.0f, -distance);
+    _mm_storeu_ps(&result.x_, _mm_add_ps(fromVec, delta));
+#else
+    Vector3 delta(to.x_ - from.x_, to.y_ - from.y_, to.z_ - from.z_);
+    const float length = delta.Length();
+    delta = length != 0.0f ? delta * (distance / length) : Vector3(-distance, 0.0f, 0.0f);
+    result = Vector4(from.x_ + delta.x_, from.y_ + delta.y_, from.z_ + delta.z_, 0.0f);
+#endif
 }
 
 // ----------------------------------------------------------------------------
-static void ApplySceneToInitialPoseCallback(ik_node_t* ikNode)
+bool IKSolver::SolveFABRIKChains()
 {
-    auto* node = (Node*)ikNode->user_data;
-    ikNode->original_rotation = QuatUrho2IK(node->GetWorldRotation());
-    ikNode->original_position = Vec3Urho2IK(node->GetWorldPosition());
+    if (algorithm_ != FABRIK || (solver_->flags & (SOLVER_ENABLE_CONSTRAINTS | SOLVER_CALCULATE_TARGET_ROTATIONS)))
+        return false;
+
+    // Only unbranched chains are supported, otherwise the library has to average the child chains
+    ORDERED_VECTOR_FOR_EACH(&solver_->chain_tree.islands, chain_island_t, island)
+        if (ordered_vector_count(&island->root_chain.children) != 0)
+            return false;
+    ORDERED_VECTOR_END_EACH
+
+    const float toleranceSquared = solver_->tolerance * solver_->tolerance;
+
+    ORDERED_VECTOR_FOR_EACH(&solver_->chain_tree.islands, chain_island_t, island)
+        const chain_t* chain = &island->root_chain;
+
+        // Copy the chain into contiguous arrays. The first node is the effector, the last one the base
+        const i32 numNodes = ordered_vector_count(&chain->nodes);
+        chainPositions_.Resize(numNodes);
+        chainLengths_.Resize(numNodes);
+        for (i32 i = 0; i < numNodes; ++i)
+        {
+            const ik_node_t* ikNode = GetChainNode(chain, i);
+            chainPositions_[i] = Vector4(Vec3IK2Urho(&ikNode->position), 0.0f);
+            chainLengths_[i] = ikNode->segment_length;
+        }
+
+        Vector4* positions = chainPositions_.Buffer();
+        const float* lengths = chainLengths_.Buffer();
+        const Vector4 targetPosition(GetWeightedTargetPosition(chain), 0.0f);
+        const Vector3 effectorTargetPosition = Vec3IK2Urho(&GetChainNode(chain, 0)->effector->target_position);
+
+        for (i32 iteration = 0; iteration < solver_->max_iterations; ++iteration)
+        {
+            // Move the effector to the target and pull the chain after it
+            Vector4 target = targetPosition;
+            for (i32 i = 0; i < numNodes - 1; ++i)
+            {
+                positions[i] = target;
+                MoveTowards(target, positions[i], positions[i + 1], lengths[i]);
+            }
+
+            // Push the chain back so that the base stays in place
+            target = positions[numNodes - 1];
+            for (i32 i = numNodes - 2; i >= 0; --i)
+            {
+                MoveTowards(target, target, positions[i], lengths[i]);
+                positions[i] = target;
+            }
+
+            if ((Vector3(positions[0]) - effectorTargetPosition).LengthSquared() <= toleranceSquared)
+                break;
+        }
+
+        for (i32 i = 0; i < numNodes - 1; ++i)
+            GetChainNode(chain, i)->position = Vec3Urho2IK(Vector3(positions[i]));
+    ORDERED_VECTOR_END_EACH
+
+    return true;
 }
-void IKSolver::ApplySceneToOriginalPose()
+
+// ----------------------------------------------------------------------------
+void IKSolver::AddPoseNodes(ik_node_t* ikNode, i32 parentIndex)
 {
-    ik_solver_iterate_tree(solver_, ApplySceneToInitialPoseCallback);
+    const i32 index = poseNodes_.Size();
+    poseNodes_.Push(PoseNode{ikNode, (Node*)ikNode->user_data, parentIndex});
+
+    BSTV_FOR_EACH(&ikNode->children, ik_node_t, guid, child)
+        AddPoseNodes(child, index);
+    BSTV_END_EACH
 }
 
 // ----------------------------------------------------------------------------
-static void ApplyActivePoseToSceneCallback(ik_node_t* ikNode)
+void IKSolver::UpdatePoseNodes()
 {
-    auto* node = (Node*)ikNode->user_data;
-    node->SetWorldRotation(QuatIK2Urho(&ikNode->rotation));
-    node->SetWorldPosition(Vec3IK2Urho(&ikNode->position));
+    if (!poseNodesDirty_)
+        return;
+
+    poseNodes_.Clear();
+    if (solver_->tree != nullptr)
+        AddPoseNodes(solver_->tree, NINDEX);
+
+    poseNodesDirty_ = false;
 }
-void IKSolver::ApplyActivePoseToScene()
+
+// ----------------------------------------------------------------------------
+void IKSolver::ApplyPoseToScene(bool original)
 {
-    ik_solver_iterate_tree(solver_, ApplyActivePoseToSceneCallback);
+    UpdatePoseNodes();
+
+    /*
+     * Parents come before their children, so the local transform of each node
+     * can be calculated from the new pose of its parent. This sets every node
+     * once, instead of setting world transforms which would recalculate the
+     * world transforms of the whole subtree for every node. The solver does
+     * not scale, so the world scales are read before anything is changed.
+     */
+    poseScales_.Resize(poseNodes_.Size());
+    for (i32 i = 0; i < poseNodes_.Size(); ++i)
+        poseScales_[i] = poseNodes_[i].node_->GetWorldScale();
+
+    for (const PoseNode& poseNode : poseNodes_)
+    {
+        const ik_node_t* ikNode = poseNode.ikNode_;
+        const Vector3 position = Vec3IK2Urho(original ? &ikNode->original_position : &ikNode->position);
+        const Quaternion rotation = QuatIK2Urho(original ? &ikNode->original_rotation : &ikNode->rotation);
+
+        Vector3 parentPosition;
+        Quaternion parentRotation;
+        Vector3 parentScale = Vector3::ONE;
+        if (poseNode.parentIndex_ != NINDEX)
+        {
+            const ik_node_t* ikParent = poseNodes_[poseNode.parentIndex_].ikNode_;
+            parentPosition = Vec3IK2Urho(original ? &ikParent->original_position : &ikParent->position);
+            parentRotation = QuatIK2Urho(original ? &ikParent->original_rotation : &ikParent->rotation);
+            parentScale = poseScales_[poseNode.parentIndex_];
+        }
+        else
+        {
+            Node* parent = poseNode.node_->GetParent();
+            if (parent != nullptr && parent != poseNode.node_->GetScene())
+            {
+                parentPosition = parent->GetWorldPosition();
+                parentRotation = parent->GetWorldRotation();
+                parentScale = parent->GetWorldScale();
+            }
+        }
+
+        const Quaternion inverseParentRotation = parentRotation.Inverse();
+        poseNode.node_->SetTransform((inverseParentRotation * (position - parentPosition)) / parentScale,
+            inverseParentRotation * rotation);
+    }
 }
 
 // ----------------------------------------------------------------------------
-static void ApplySceneToActivePoseCallback(ik_node_t* ikNode)
+void IKSolver::ApplyOriginalPoseToScene()
 {
-    auto* node = (Node*)ikNode->user_data;
-    ikNode->rotation = QuatUrho2IK(node->GetWorldRotation());
-    ikNode->position = Vec3Urho2IK(node->GetWorldPosition());
+    ApplyPoseToScene(true);
 }
+
+// ----------------------------------------------------------------------------
+void IKSolver::ApplySceneToOriginalPose()
+{
+    UpdatePoseNodes();
+
+    for (const PoseNode& poseNode : poseNodes_)
+    {
+        poseNode.ikNode_->original_rotation = QuatUrho2IK(poseNode.node_->GetWorldRotation());
+        poseNode.ikNode_->original_position = Vec3Urho2IK(poseNode.node_->GetWorldPosition());
+    }
+}
+
+// ----------------------------------------------------------------------------
+void IKSolver::ApplyActivePoseToScene()
+{
+    ApplyPoseToScene(false);
+}
+
+// ----------------------------------------------------------------------------
 void IKSolver::ApplySceneToActivePose()
 {
-    ik_solver_iterate_tree(solver_, ApplySceneToActivePoseCallback);
+    UpdatePoseNodes();
+
+    for (const PoseNode& poseNode : poseNodes_)
+    {
+        poseNode.ikNode_->rotation = QuatUrho2IK(poseNode.node_->GetWorldRotation());
+        poseNode.ikNode_->position = Vec3Urho2IK(poseNode.node_->GetWorldPosition());
+    }
 }
 
 // ----------------------------------------------------------------------------
@@ -499,8 +705,40 @@ bool IKSolver::IsSolverTreeValid() const
 // ----------------------------------------------------------------------------
 void IKSolver::OnSceneSet(Scene* scene)
 {
-    if (features_ & AUTO_SOLVE)
-        SubscribeToEvent(scene, E_SCENEDRAWABLEUPDATEFINISHED, URHO3D_HANDLER(IKSolver, HandleSceneDrawableUpdateFinished));
+    UpdateScheduler();
+}
+
+// ----------------------------------------------------------------------------
+void IKSolver::UpdateScheduler()
+{
+    Scene* scene = GetScene();
+    IKScheduler* scheduler = nullptr;
+    if ((features_ & AUTO_SOLVE) && scene)
+    {
+        scheduler = scene->GetComponent<IKScheduler>();
+        // Create the scheduler on the next scene update instead of now, as the scene may be loading, and the scheduler
+        // would take a component ID that a component later in the scene file uses
+        if (!scheduler)
+            SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(IKSolver, HandleSceneUpdate));
+    }
+    if (scheduler == scheduler_)
+        return;
+
+    if (scheduler_)
+        scheduler_->RemoveSolver(this);
+    scheduler_ = scheduler;
+    if (scheduler_)
+        scheduler_->AddSolver(this);
+}
+
+// ----------------------------------------------------------------------------
+void IKSolver::OnSchedulerRemoved()
+{
+    // The scheduler is still a component of the scene while it is being removed, so wait for the next update
+    scheduler_.Reset();
+    Scene* scene = GetScene();
+    if ((features_ & AUTO_SOLVE) && scene)
+        SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(IKSolver, HandleSceneUpdate));
 }
 
 // ----------------------------------------------------------------------------
@@ -696,14 +934,25 @@ void IKSolver::HandleNodeRemoved(StringHash eventType, VariantMap& eventData)
         else
             ik_node_destroy(ikNode);
 
+        poseNodesDirty_ = true;
         MarkChainsNeedUpdating();
     }
 }
 
 // ----------------------------------------------------------------------------
-void IKSolver::HandleSceneDrawableUpdateFinished(StringHash eventType, VariantMap& eventData)
+void IKSolver::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
 {
-    Solve();
+    UnsubscribeFromEvent(E_SCENEUPDATE);
+
+    Scene* scene = GetScene();
+    if ((features_ & AUTO_SOLVE) && scene && !scene->GetComponent<IKScheduler>())
+    {
+        // The scheduler is created again whenever needed, so it is not saved with the scene
+        auto* scheduler = scene->CreateComponent<IKScheduler>(LOCAL);
+        scheduler->SetTemporary(true);
+    }
+
+    UpdateScheduler();
 }
 
 // ----------------------------------------------------------------------------
@@ -810,6 +1059,7 @@ DEF_FEATURE_GETTER(UPDATE_ACTIVE_POSE)
 DEF_FEATURE_GETTER(USE_ORIGINAL_POSE)
 DEF_FEATURE_GETTER(CONSTRAINTS)
 DEF_FEATURE_GETTER(AUTO_SOLVE)
+DEF_FEATURE_GETTER(SIMD_FABRIK)
 
 DEF_FEATURE_SETTER(JOINT_ROTATIONS)
 DEF_FEATURE_SETTER(TARGET_ROTATIONS)
@@ -818,5 +1068,6 @@ DEF_FEATURE_SETTER(UPDATE_ACTIVE_POSE)
 DEF_FEATURE_SETTER(USE_ORIGINAL_POSE)
 DEF_FEATURE_SETTER(CONSTRAINTS)
 DEF_FEATURE_SETTER(AUTO_SOLVE)
+DEF_FEATURE_SETTER(SIMD_FABRIK)
 
 } // namespace Urho3D
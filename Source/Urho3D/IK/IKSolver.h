@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "../Math/Vector4.h"
 #include "../Scene/Component.h"
 
 struct ik_solver_t;
@@ -13,6 +14,7 @@ namespace Urho3D
 class AnimationState;
 class IKConstraint;
 class IKEffector;
+class IKScheduler;
 
 /*!
  * @brief Marks the root or "beginning" of an IK chain or multiple IK chains.
@@ -143,7 +145,18 @@ public:
          * calculations before being able to set the effector target data, you will
          * want to disable this and call Solve() manually.
          */
-        AUTO_SOLVE = 0x40
+        AUTO_SOLVE = 0x40,
+
+        /*!
+         * When enabled, the FABRIK algorithm solves trees whose chains have
+         * no child chains with a built-in kernel instead of the IK library,
+         * unless constraints or target rotations are enabled. The kernel
+         * copies each chain into a contiguous array, uses SSE for the vector
+         * math when available, and stops iterating as soon as every effector
+         * is within tolerance. Trees with child chains always use the IK
+         * library.
+         */
+        SIMD_FABRIK = 0x80
     };
 
     /// Construct an IK root component.
@@ -255,7 +268,8 @@ public:
      * @note By default this is called automatically for you if the feature
      * flag AUTO_SOLVE is set. For more complex IK problems you can disable
      * that flag and call Solve() in response to E_SCENEDRAWABLEUPDATEFINISHED.
-     * This is right after the animations have been applied.
+     * This is right after the animations have been applied. Automatically
+     * solved solvers are solved together by the scene's IKScheduler.
      */
     void Solve();
 
@@ -300,6 +314,35 @@ public:
 
 private:
     friend class IKEffector;
+    friend class IKScheduler;
+
+    /// Solver tree node and the index of its parent node in the pose transfer array.
+    struct PoseNode
+    {
+        /// Solver tree node.
+        ik_node_t* ikNode_;
+        /// Scene node.
+        Node* node_;
+        /// Index of the parent pose node, or NINDEX for the root node.
+        i32 parentIndex_;
+    };
+
+    /// Prepare solving: rebuild the trees if needed and copy the scene and the effector targets into the solver. Return false if the solver tree is not valid. Must be called from the main thread.
+    bool BeginSolve();
+    /// Solve the active pose. Touches only the solver's own data, so different solvers can do this in parallel.
+    void SolveActivePose();
+    /// Solve with the built-in FABRIK kernel. Return false without solving if the chain trees are not supported by it.
+    bool SolveFABRIKChains();
+    /// Collect the solver tree nodes in parent-first order, if the tree has changed since last time.
+    void UpdatePoseNodes();
+    /// Add a solver tree node and its children to the pose nodes.
+    void AddPoseNodes(ik_node_t* ikNode, i32 parentIndex);
+    /// Copy the original or the active pose into the scene graph.
+    void ApplyPoseToScene(bool original);
+    /// Register to or unregister from the scene's scheduler according to the auto solve feature. If the scene has no scheduler, one is created on the next scene update.
+    void UpdateScheduler();
+    /// Register to a new scheduler on the next scene update. Called when the scheduler is removed from the scene.
+    void OnSchedulerRemoved();
 
     /// Indicates that the internal structures of the IK library need to be updated. See the documentation of ik_solver_rebuild_chain_trees() for more info on when this happens.
     void MarkChainsNeedUpdating();
@@ -308,7 +351,7 @@ private:
     /// Returns false if calling Solve() would cause the IK library to abort. Urho3D's error handling philosophy is to log an error and continue, not crash.
     bool IsSolverTreeValid() const;
 
-    /// Subscribe to drawable update finished event here.
+    /// Register to the scene's scheduler here.
     void OnSceneSet(Scene* scene) override;
     /// Destroys and creates the tree.
     void OnNodeSet(Node* node) override;
@@ -335,8 +378,7 @@ private:
     void HandleComponentRemoved(StringHash eventType, VariantMap& eventData);
     void HandleNodeAdded(StringHash eventType, VariantMap& eventData);
     void HandleNodeRemoved(StringHash eventType, VariantMap& eventData);
-    /// Invokes the IK solver.
-    void HandleSceneDrawableUpdateFinished(StringHash eventType, VariantMap& eventData);
+    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
 
     // Need these wrapper functions flags of GetFeature/SetFeature can be correctly exposed to the editor and to AngelScript and lua
 public:
@@ -354,6 +396,8 @@ public:
     bool GetCONSTRAINTS() const;
     /// @property{get_AUTO_SOLVE}
     bool GetAUTO_SOLVE() const;
+    /// @property{get_SIMD_FABRIK}
+    bool GetSIMD_FABRIK() const;
 
     /// @property{set_JOINT_ROTATIONS}
     void SetJOINT_ROTATIONS(bool enable);
@@ -369,6 +413,8 @@ public:
     void SetCONSTRAINTS(bool enable);
     /// @property{set_AUTO_SOLVE}
     void SetAUTO_SOLVE(bool enable);
+    /// @property{set_SIMD_FABRIK}
+    void SetSIMD_FABRIK(bool enable);
 
 private:
     Vector<IKEffector*> effectorList_;
@@ -379,6 +425,18 @@ private:
     bool chainTreesNeedUpdating_;
     bool treeNeedsRebuild;
     bool solverTreeValid_;
+    /// Solver tree nodes in parent-first order, for transferring poses to and from the scene graph in one pass.
+    Vector<PoseNode> poseNodes_;
+    /// World scales of the pose nodes, captured before a pose is applied to the scene graph.
+    Vector<Vector3> poseScales_;
+    /// Chain node positions of the FABRIK kernel.
+    Vector<Vector4> chainPositions_;
+    /// Chain segment lengths of the FABRIK kernel.
+    Vector<float> chainLengths_;
+    /// Scheduler that solves this solver automatically.
+    WeakPtr<IKScheduler> scheduler_;
+    /// Whether the solver tree has changed since the pose nodes were collected.
+    bool poseNodesDirty_;
 };
 
 } // namespace Urho3D
@@ -35,6 +35,8 @@ public:
     /// Return whether the end of stream has been reached.
     /// @property
     virtual bool IsEof() const { return position_ >= size_; }
+    /// Return the whole stream contents if they are already in memory, otherwise null. Loaders can use this to parse the data in place instead of reading it into a temporary buffer.
+    virtual const byte* GetResidentData() const { return nullptr; }
 
     /// Set position relative to current position. Return actual new position.
     i64 SeekRelative(i64 delta);
@@ -4,6 +4,10 @@
 #include "../Precompiled.h"
 
 #include "../Core/Profiler.h"
+#include "../Core/Thread.h"
+#ifndef MINI_URHO
+#include "../Core/WorkQueue.h"
+#endif
 #include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
@@ -45,6 +49,40 @@ const char* APK = "/apk/";
 static constexpr i32 READ_BUFFER_SIZE = 32768;
 #endif
 static constexpr i32 SKIP_BUFFER_SIZE = 1024;
+static constexpr i32 PARALLEL_DECOMPRESS_SIZE = 262144;
+/// Largest uncompressed size of a compressed block, limited by the 16-bit size in the block header.
+static constexpr i32 MAX_BLOCK_SIZE = 65535;
+
+#ifndef MINI_URHO
+/// Compressed block of a package file entry to be decompressed by a work item.
+struct DecompressBlock
+{
+    /// Offset of the compressed data in the source buffer.
+    i64 srcOffset_;
+    /// Compressed data.
+    const u8* src_;
+    /// Decompression destination.
+    u8* dest_;
+    /// Compressed size.
+    i32 packedSize_;
+    /// Uncompressed size.
+    i32 unpackedSize_;
+    /// Whether decompressed to the uncompressed size successfully.
+    bool success_;
+};
+
+static void DecompressBlocksWork(const WorkItem* item, i32 /*threadIndex*/)
+{
+    auto* start = reinterpret_cast<DecompressBlock*>(item->start_);
+    auto* end = reinterpret_cast<DecompressBlock*>(item->end_);
+
+    for (DecompressBlock* block = start; block != end; ++block)
+    {
+        block->success_ = LZ4_decompress_safe((const char*)block->src_, (char*)block->dest_, block->packedSize_,
+            block->unpackedSize_) == block->unpackedSize_;
+    }
+}
+#endif
 
 static i32 FSeek64(FILE* stream, i64 offset, i32 origin)
 {
@@ -72,6 +110,9 @@ File::File(Context* context) :
     Object(context),
     mode_(FILE_READ),
     handle_(nullptr),
+    mappedData_(nullptr),
+    mappedSize_(0),
+    mappedPosition_(0),
 #ifdef __ANDROID__
     assetHandle_(0),
 #endif
@@ -89,6 +130,9 @@ File::File(Context* context, const String& fileName, FileMode mode) :
     Object(context),
     mode_(FILE_READ),
     handle_(nullptr),
+    mappedData_(nullptr),
+    mappedSize_(0),
+    mappedPosition_(0),
 #ifdef __ANDROID__
     assetHandle_(0),
 #endif
@@ -107,6 +151,9 @@ File::File(Context* context, PackageFile* package, const String& fileName) :
     Object(context),
     mode_(FILE_READ),
     handle_(nullptr),
+    mappedData_(nullptr),
+    mappedSize_(0),
+    mappedPosition_(0),
 #ifdef __ANDROID__
     assetHandle_(0),
 #endif
@@ -140,6 +187,27 @@ bool File::Open(PackageFile* package, const String& fileName)
     if (!entry)
         return false;
 
+    // Read directly from the package mapping without opening a file handle
+    if (package->IsMemoryMapped())
+    {
+        Close();
+
+        mappedPackage_ = package;
+        mappedData_ = package->GetMappedData();
+        mappedSize_ = package->GetTotalSize();
+        mappedPosition_ = entry->offset_;
+        name_ = fileName;
+        mode_ = FILE_READ;
+        offset_ = entry->offset_;
+        checksum_ = entry->checksum_;
+        size_ = entry->size_;
+        position_ = 0;
+        compressed_ = entry->codec_ != PACKAGE_CODEC_NONE;
+        readSyncNeeded_ = false;
+        writeSyncNeeded_ = false;
+        return true;
+    }
+
     bool success = OpenInternal(package->GetName(), FILE_READ, true);
     if (!success)
     {
@@ -151,7 +219,7 @@ bool File::Open(PackageFile* package, const String& fileName)
     offset_ = entry->offset_;
     checksum_ = entry->checksum_;
     size_ = entry->size_;
-    compressed_ = package->IsCompressed();
+    compressed_ = entry->codec_ != PACKAGE_CODEC_NONE;
 
     // Seek to beginning of package entry's file data
     SeekInternal(offset_);
@@ -179,6 +247,13 @@ i32 File::Read(void* dest, i32 size)
     if (!size)
         return 0;
 
+    if (mappedData_ && !compressed_)
+    {
+        memcpy(dest, mappedData_ + offset_ + position_, size);
+        position_ += size;
+        return size;
+    }
+
 #ifdef __ANDROID__
     if (assetHandle_ && !compressed_)
     {
@@ -223,6 +298,22 @@ i32 File::Read(void* dest, i32 size)
         {
             if (!readBuffer_ || readBufferOffset_ >= readBufferSize_)
             {
+                // Decompress large reads directly to the destination using worker threads
+                if (sizeLeft >= PARALLEL_DECOMPRESS_SIZE)
+                {
+                    i32 parallelSize = ReadBlocksParallel(destPtr, sizeLeft);
+                    if (parallelSize < 0)
+                    {
+                        URHO3D_LOGERROR("Error while decompressing file " + GetName());
+                        return 0;
+                    }
+                    destPtr += parallelSize;
+                    sizeLeft -= parallelSize;
+                    position_ += parallelSize;
+                    if (parallelSize || readBufferOffset_ < readBufferSize_)
+                        continue;
+                }
+
                 u8 blockHeaderBytes[4];
                 ReadInternal(blockHeaderBytes, sizeof blockHeaderBytes);
 
@@ -230,18 +321,11 @@ i32 File::Read(void* dest, i32 size)
                 i32 unpackedSize = blockHeader.ReadU16();
                 i32 packedSize = blockHeader.ReadU16();
 
-                if (!readBuffer_)
+                if (!ReadBlock(unpackedSize, packedSize))
                 {
-                    readBuffer_ = new u8[unpackedSize];
-                    inputBuffer_ = new u8[LZ4_compressBound(unpackedSize)];
+                    URHO3D_LOGERROR("Error while decompressing file " + GetName());
+                    return 0;
                 }
-
-                /// \todo Handle errors
-                ReadInternal(inputBuffer_.Get(), packedSize);
-                LZ4_decompress_fast((const char*)inputBuffer_.Get(), (char*)readBuffer_.Get(), unpackedSize);
-
-                readBufferSize_ = unpackedSize;
-                readBufferOffset_ = 0;
             }
 
             i32 copySize = Min((readBufferSize_ - readBufferOffset_), sizeLeft);
@@ -289,6 +373,12 @@ i64 File::Seek(i64 position)
     if (mode_ == FILE_READ && position > size_)
         position = size_;
 
+    if (mappedData_ && !compressed_)
+    {
+        position_ = position;
+        return position_;
+    }
+
     if (compressed_)
     {
         // Start over from the beginning
@@ -403,10 +493,15 @@ void File::Close()
     readBuffer_.Reset();
     inputBuffer_.Reset();
 
-    if (handle_)
+    if (handle_ || mappedData_)
     {
-        fclose((FILE*)handle_);
+        if (handle_)
+            fclose((FILE*)handle_);
         handle_ = nullptr;
+        mappedPackage_.Reset();
+        mappedData_ = nullptr;
+        mappedSize_ = 0;
+        mappedPosition_ = 0;
         position_ = 0;
         size_ = 0;
         offset_ = 0;
@@ -420,12 +515,131 @@ void File::Flush()
         fflush((FILE*)handle_);
 }
 
+i32 File::ReadBlocksParallel(u8* dest, i32 size)
+{
+#ifndef MINI_URHO
+    // Work items can only be queued and completed by the main thread
+    auto* queue = GetSubsystem<WorkQueue>();
+    if (!queue || !queue->GetNumThreads() || queue->IsCompleting() || !Thread::IsMainThread())
+        return 0;
+
+    URHO3D_PROFILE(DecompressFileBlocks);
+
+    Vector<DecompressBlock> blocks;
+    Vector<u8> packedData;
+    i32 unpackedTotal = 0;
+
+    while (unpackedTotal < size)
+    {
+        u8 blockHeaderBytes[4];
+        if (!ReadInternal(blockHeaderBytes, sizeof blockHeaderBytes))
+            break;
+
+        MemoryBuffer blockHeader(&blockHeaderBytes[0], sizeof blockHeaderBytes);
+        i32 unpackedSize = blockHeader.ReadU16();
+        i32 packedSize = blockHeader.ReadU16();
+
+        if (unpackedTotal + unpackedSize > size)
+        {
+            // The block does not fit, so decompress it to the read buffer for the rest of the read
+            if (!ReadBlock(unpackedSize, packedSize))
+                return -1;
+            break;
+        }
+
+        DecompressBlock block{};
+        block.dest_ = dest + unpackedTotal;
+        block.packedSize_ = packedSize;
+        block.unpackedSize_ = unpackedSize;
+
+        // Decompress straight from the mapping if possible, otherwise read the compressed data to a temporary buffer
+        if (mappedData_)
+        {
+            if (mappedPosition_ + packedSize > mappedSize_)
+                break;
+            block.srcOffset_ = mappedPosition_;
+            mappedPosition_ += packedSize;
+        }
+        else
+        {
+            block.srcOffset_ = packedData.Size();
+            packedData.Resize(packedData.Size() + packedSize);
+            if (!ReadInternal(&packedData[(i32)block.srcOffset_], packedSize))
+                break;
+        }
+
+        blocks.Push(block);
+        unpackedTotal += unpackedSize;
+    }
+
+    if (blocks.Empty())
+        return 0;
+
+    const u8* srcData = mappedData_ ? (const u8*)mappedData_ : packedData.Buffer();
+    for (DecompressBlock& block : blocks)
+        block.src_ = srcData + block.srcOffset_;
+
+    i32 numWorkItems = Min(queue->GetNumThreads() + 1, blocks.Size()); // Worker threads + main thread
+    i32 blocksPerItem = (blocks.Size() + numWorkItems - 1) / numWorkItems;
+
+    for (i32 i = 0; i < blocks.Size(); i += blocksPerItem)
+    {
+        SharedPtr<WorkItem> item = queue->GetFreeItem();
+        item->priority_ = WI_MAX_PRIORITY;
+        item->workFunction_ = DecompressBlocksWork;
+        item->start_ = blocks.Buffer() + i;
+        item->end_ = blocks.Buffer() + Min(i + blocksPerItem, blocks.Size());
+        queue->AddWorkItem(item);
+    }
+
+    queue->Complete(WI_MAX_PRIORITY);
+
+    for (const DecompressBlock& block : blocks)
+    {
+        if (!block.success_)
+            return -1;
+    }
+
+    return unpackedTotal;
+#else
+    return 0;
+#endif
+}
+
+bool File::ReadBlock(i32 unpackedSize, i32 packedSize)
+{
+    // The buffers are sized for the largest block, as a short block such as the last one can be read first after
+    // decompressing the blocks before it directly to the destination
+    if (!readBuffer_)
+    {
+        readBuffer_ = new u8[MAX_BLOCK_SIZE];
+        inputBuffer_ = new u8[LZ4_compressBound(MAX_BLOCK_SIZE)];
+    }
+
+    readBufferSize_ = 0;
+    readBufferOffset_ = 0;
+
+    if (!ReadInternal(inputBuffer_.Get(), packedSize))
+        return false;
+    if (LZ4_decompress_safe((const char*)inputBuffer_.Get(), (char*)readBuffer_.Get(), packedSize, unpackedSize) !=
+        unpackedSize)
+        return false;
+
+    readBufferSize_ = unpackedSize;
+    return true;
+}
+
+const byte* File::GetResidentData() const
+{
+    return mappedData_ && !compressed_ ? mappedData_ + offset_ : nullptr;
+}
+
 bool File::IsOpen() const
 {
 #ifdef __ANDROID__
-    return handle_ != 0 || assetHandle_ != 0;
+    return handle_ != 0 || assetHandle_ != 0 || mappedData_ != nullptr;
 #else
-    return handle_ != nullptr;
+    return handle_ != nullptr || mappedData_ != nullptr;
 #endif
 }
 
@@ -535,6 +749,15 @@ bool File::ReadInternal(void* dest, i32 size)
 {
     assert(size >= 0);
 
+    if (mappedData_)
+    {
+        if (mappedPosition_ + size > mappedSize_)
+            return false;
+        memcpy(dest, mappedData_ + mappedPosition_, size);
+        mappedPosition_ += size;
+        return true;
+    }
+
 #ifdef __ANDROID__
     if (assetHandle_)
     {
@@ -549,6 +772,12 @@ void File::SeekInternal(i64 newPosition)
 {
     assert(newPosition >= 0);
 
+    if (mappedData_)
+    {
+        mappedPosition_ = newPosition;
+        return;
+    }
+
 #ifdef __ANDROID__
     if (assetHandle_)
     {
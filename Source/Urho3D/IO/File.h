@@ -81,9 +81,12 @@ public:
     /// @property
     bool IsOpen() const;
 
-    /// Return the file handle.
+    /// Return the file handle. Null for a file opened from a memory mapped package.
     void* GetHandle() const { return handle_; }
 
+    /// Return the file contents if opened uncompressed from a memory mapped package, otherwise null.
+    const byte* GetResidentData() const override;
+
     /// Return whether the file originates from a package.
     /// @property
     bool IsPackaged() const { return offset_ != 0; }
@@ -95,11 +98,25 @@ private:
     bool ReadInternal(void* dest, i32 size);
     /// Seek in file internally using either C standard IO functions or SDL RWops for Android asset files.
     void SeekInternal(i64 newPosition);
+    /// Decompress as many whole compressed blocks as fit in the destination, distributing them to worker threads. A
+    /// block which does not fit is decompressed to the read buffer. Return number of bytes written to the destination,
+    /// or -1 if a block could not be decompressed.
+    i32 ReadBlocksParallel(u8* dest, i32 size);
+    /// Read and decompress the next compressed block to the read buffer. Return true if successful.
+    bool ReadBlock(i32 unpackedSize, i32 packedSize);
 
     /// Open mode.
     FileMode mode_;
     /// File handle.
     void* handle_;
+    /// Memory mapped package, kept alive so that its mapping stays valid while the file is read.
+    SharedPtr<PackageFile> mappedPackage_;
+    /// Memory mapped package contents.
+    const byte* mappedData_;
+    /// Size of the memory mapped package.
+    i64 mappedSize_;
+    /// Read position within the memory mapped package.
+    i64 mappedPosition_;
 #ifdef __ANDROID__
     /// SDL RWops context for Android asset loading.
     SDL_RWops* assetHandle_;
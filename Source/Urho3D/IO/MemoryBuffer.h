@@ -31,6 +31,8 @@ public:
 
     /// Return memory area.
     byte* GetData() { return buffer_; }
+    /// Return memory area.
+    const byte* GetResidentData() const override { return buffer_; }
 
     /// Return whether buffer is read-only.
     bool IsReadOnly() { return readOnly_; }
@@ -3,36 +3,73 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/Sort.h"
 #include "../IO/File.h"
+#include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../IO/PackageFile.h"
 
+#ifdef _WIN32
+#include "../Engine/WinWrapped.h"
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace Urho3D
 {
 
+static bool CompareIndexEntries(const PackageIndexEntry& lhs, const PackageIndexEntry& rhs)
+{
+    return lhs.nameHash_ < rhs.nameHash_;
+}
+
+static bool CompareEntryOffsets(const PackageEntry* lhs, const PackageEntry* rhs)
+{
+    return lhs->offset_ < rhs->offset_;
+}
+
 PackageFile::PackageFile(Context* context) :
     Object(context),
     totalSize_(0),
     totalDataSize_(0),
     checksum_(0),
-    compressed_(false)
+    version_(0),
+    compressed_(false),
+    mappedData_(nullptr),
+    mappedSize_(0)
+#ifdef _WIN32
+    , mappingHandle_(nullptr)
+#endif
 {
 }
 
-PackageFile::PackageFile(Context* context, const String& fileName, unsigned startOffset) :
+PackageFile::PackageFile(Context* context, const String& fileName, unsigned startOffset, bool memoryMapped) :
     Object(context),
     totalSize_(0),
     totalDataSize_(0),
     checksum_(0),
-    compressed_(false)
+    version_(0),
+    compressed_(false),
+    mappedData_(nullptr),
+    mappedSize_(0)
+#ifdef _WIN32
+    , mappingHandle_(nullptr)
+#endif
 {
-    Open(fileName, startOffset);
+    Open(fileName, startOffset, memoryMapped);
 }
 
-PackageFile::~PackageFile() = default;
+PackageFile::~PackageFile()
+{
+    UnmapMemory();
+}
 
-bool PackageFile::Open(const String& fileName, unsigned startOffset)
+bool PackageFile::Open(const String& fileName, unsigned startOffset, bool memoryMapped)
 {
+    UnmapMemory();
+
     SharedPtr<File> file(new File(context_, fileName));
     if (!file->IsOpen())
         return false;
@@ -40,7 +77,7 @@ bool PackageFile::Open(const String& fileName, unsigned startOffset)
     // Check ID, then read the directory
     file->Seek(startOffset);
     String id = file->ReadFileID();
-    if (id != "UPAK" && id != "ULZ4")
+    if (id != "UPAK" && id != "ULZ4" && id != "UPK2")
     {
         // If start offset has not been explicitly specified, also try to read package size from the end of file
         // to know how much we must rewind to find the package start
@@ -57,7 +94,7 @@ bool PackageFile::Open(const String& fileName, unsigned startOffset)
             }
         }
 
-        if (id != "UPAK" && id != "ULZ4")
+        if (id != "UPAK" && id != "ULZ4" && id != "UPK2")
         {
             URHO3D_LOGERROR(fileName + " is not a valid package file");
             return false;
@@ -67,25 +104,91 @@ bool PackageFile::Open(const String& fileName, unsigned startOffset)
     fileName_ = fileName;
     nameHash_ = fileName_;
     totalSize_ = file->GetSize();
+    totalDataSize_ = 0;
+    version_ = id == "UPK2" ? 2 : 1;
     compressed_ = id == "ULZ4";
+    entries_.Clear();
+    index_.Clear();
 
     unsigned numFiles = file->ReadU32();
     checksum_ = file->ReadU32();
+    index_.Reserve(numFiles);
 
     for (unsigned i = 0; i < numFiles; ++i)
     {
+        PackageIndexEntry indexEntry;
+        if (version_ >= 2)
+            indexEntry.nameHash_ = file->ReadStringHash();
+
         String entryName = file->ReadString();
         PackageEntry newEntry{};
         newEntry.offset_ = file->ReadU32() + startOffset;
         totalDataSize_ += (newEntry.size_ = file->ReadU32());
-        newEntry.checksum_ = file->ReadU32();
-        if (!compressed_ && newEntry.offset_ + newEntry.size_ > totalSize_)
+
+        if (version_ >= 2)
+        {
+            newEntry.packedSize_ = file->ReadU32();
+            newEntry.checksum_ = file->ReadU32();
+            unsigned codec = file->ReadU8();
+            if (codec > PACKAGE_CODEC_LZ4HC)
+            {
+                URHO3D_LOGERROR("File entry " + entryName + " has unknown compression codec");
+                return false;
+            }
+            newEntry.codec_ = (PackageCodec)codec;
+            if (newEntry.codec_ != PACKAGE_CODEC_NONE)
+                compressed_ = true;
+        }
+        else
+        {
+            indexEntry.nameHash_ = entryName;
+            newEntry.checksum_ = file->ReadU32();
+            // Version 1 compressed packages always used LZ4 high compression. The packed size is filled in below
+            newEntry.codec_ = compressed_ ? PACKAGE_CODEC_LZ4HC : PACKAGE_CODEC_NONE;
+            newEntry.packedSize_ = compressed_ ? 0 : newEntry.size_;
+        }
+
+        if ((version_ >= 2 || !compressed_) && newEntry.offset_ + newEntry.packedSize_ > totalSize_)
         {
             URHO3D_LOGERROR("File entry " + entryName + " outside package file");
             return false;
         }
-        else
-            entries_[entryName] = newEntry;
+
+        HashMap<String, PackageEntry>::Iterator j = entries_.Insert(MakePair(entryName, newEntry));
+        indexEntry.name_ = &j->first_;
+        indexEntry.entry_ = &j->second_;
+        index_.Push(indexEntry);
+    }
+
+    if (version_ == 1 && compressed_)
+    {
+        // The compressed data of an entry extends to the start of the next entry, or to the package size at the end
+        Vector<PackageEntry*> sortedEntries;
+        for (HashMap<String, PackageEntry>::Iterator i = entries_.Begin(); i != entries_.End(); ++i)
+            sortedEntries.Push(&i->second_);
+        Sort(sortedEntries.Begin(), sortedEntries.End(), CompareEntryOffsets);
+        for (i32 i = 0; i < sortedEntries.Size(); ++i)
+        {
+            unsigned nextOffset = i + 1 < sortedEntries.Size() ? sortedEntries[i + 1]->offset_ : totalSize_ -
+                (unsigned)sizeof(unsigned);
+            sortedEntries[i]->packedSize_ = nextOffset > sortedEntries[i]->offset_ ? nextOffset - sortedEntries[i]->offset_ : 0;
+        }
+    }
+
+    // Version 2 packages store the directory already sorted, so sorting is only needed for version 1 packages
+    bool sorted = true;
+    for (i32 i = 1; i < index_.Size() && sorted; ++i)
+        sorted = !(index_[i].nameHash_ < index_[i - 1].nameHash_);
+    if (!sorted)
+        Sort(index_.Begin(), index_.End(), CompareIndexEntries);
+
+    // Version 1 compressed packages store their blocks without sizes in the directory, so reading them from a mapping
+    // has no benefit over the existing buffered reading
+    if (memoryMapped && (version_ >= 2 || !compressed_))
+    {
+        file->Close();
+        if (!MapMemory())
+            URHO3D_LOGWARNING("Could not memory map package file " + fileName + ", using normal file reading instead");
     }
 
     return true;
@@ -93,45 +196,121 @@ bool PackageFile::Open(const String& fileName, unsigned startOffset)
 
 bool PackageFile::Exists(const String& fileName) const
 {
-    bool found = entries_.Find(fileName) != entries_.End();
+    return GetEntry(fileName) != nullptr;
+}
+
+const PackageEntry* PackageFile::GetEntry(const String& fileName) const
+{
+    // Binary search for the first record with the name hash, then compare names in case of hash collisions
+    StringHash nameHash(fileName);
+    i32 first = 0;
+    i32 last = index_.Size();
+    while (first < last)
+    {
+        i32 middle = (first + last) / 2;
+        if (index_[middle].nameHash_ < nameHash)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    for (i32 i = first; i < index_.Size() && index_[i].nameHash_ == nameHash; ++i)
+    {
+        if (*index_[i].name_ == fileName)
+            return index_[i].entry_;
+    }
 
 #ifdef _WIN32
     // On Windows perform a fallback case-insensitive search
-    if (!found)
+    for (HashMap<String, PackageEntry>::ConstIterator j = entries_.Begin(); j != entries_.End(); ++j)
     {
-        for (HashMap<String, PackageEntry>::ConstIterator i = entries_.Begin(); i != entries_.End(); ++i)
-        {
-            if (!i->first_.Compare(fileName, false))
-            {
-                found = true;
-                break;
-            }
-        }
+        if (!j->first_.Compare(fileName, false))
+            return &j->second_;
     }
 #endif
 
-    return found;
+    return nullptr;
 }
 
-const PackageEntry* PackageFile::GetEntry(const String& fileName) const
+bool PackageFile::MapMemory()
 {
-    HashMap<String, PackageEntry>::ConstIterator i = entries_.Find(fileName);
-    if (i != entries_.End())
-        return &i->second_;
+#if defined(__ANDROID__)
+    // Files inside the APK can not be mapped
+    if (URHO3D_IS_ASSET(fileName_))
+        return false;
+#endif
 
 #ifdef _WIN32
-    // On Windows perform a fallback case-insensitive search
-    else
+    HANDLE fileHandle = CreateFileW(GetWideNativePath(fileName_).CString(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || !fileSize.QuadPart)
     {
-        for (HashMap<String, PackageEntry>::ConstIterator j = entries_.Begin(); j != entries_.End(); ++j)
-        {
-            if (!j->first_.Compare(fileName, false))
-                return &j->second_;
-        }
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    // The mapping object keeps the file open, so the file handle can be closed right away
+    HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(fileHandle);
+    if (!mappingHandle)
+        return false;
+
+    void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        CloseHandle(mappingHandle);
+        return false;
     }
+
+    mappingHandle_ = mappingHandle;
+    mappedData_ = (byte*)data;
+    mappedSize_ = fileSize.QuadPart;
+    return true;
+#elif !defined(__EMSCRIPTEN__)
+    int fd = open(GetNativePath(fileName_).CString(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    off_t fileSize = lseek(fd, 0, SEEK_END);
+    if (fileSize <= 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void* data = mmap(nullptr, (size_t)fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return false;
+
+    mappedData_ = (byte*)data;
+    mappedSize_ = fileSize;
+    return true;
+#else
+    return false;
 #endif
+}
 
-    return nullptr;
+void PackageFile::UnmapMemory()
+{
+    if (!mappedData_)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mappedData_);
+    CloseHandle((HANDLE)mappingHandle_);
+    mappingHandle_ = nullptr;
+#elif !defined(__EMSCRIPTEN__)
+    munmap(mappedData_, (size_t)mappedSize_);
+#endif
+
+    mappedData_ = nullptr;
+    mappedSize_ = 0;
 }
 
 }
@@ -8,6 +8,17 @@
 namespace Urho3D
 {
 
+/// Compression codec of a package file entry.
+enum PackageCodec
+{
+    /// Stored without compression.
+    PACKAGE_CODEC_NONE = 0,
+    /// LZ4 compressed blocks.
+    PACKAGE_CODEC_LZ4,
+    /// LZ4 high compression blocks. Decompressed the same way as LZ4.
+    PACKAGE_CODEC_LZ4HC
+};
+
 /// %File entry within the package file.
 struct PackageEntry
 {
@@ -19,9 +30,28 @@ struct PackageEntry
 
     /// File checksum.
     hash32 checksum_;
+
+    /// Size of the data stored in the package. Less than the file size if compressed.
+    unsigned packedSize_;
+
+    /// Compression codec.
+    PackageCodec codec_;
+};
+
+/// Package file entry lookup record, sorted by the name hash.
+struct PackageIndexEntry
+{
+    /// File name hash.
+    StringHash nameHash_;
+    /// File name.
+    const String* name_;
+    /// File entry.
+    const PackageEntry* entry_;
 };
 
-/// Stores files of a directory tree sequentially for convenient access.
+/// Stores files of a directory tree sequentially for convenient access. Version 1 packages (UPAK or ULZ4) are either
+/// wholly uncompressed or wholly LZ4 compressed. Version 2 packages (UPK2) choose the codec per entry and store the
+/// directory sorted by name hash.
 class URHO3D_API PackageFile : public Object
 {
     URHO3D_OBJECT(PackageFile, Object);
@@ -30,12 +60,15 @@ public:
     /// Construct.
     explicit PackageFile(Context* context);
     /// Construct and open.
-    PackageFile(Context* context, const String& fileName, unsigned startOffset = 0);
+    PackageFile(Context* context, const String& fileName, unsigned startOffset = 0, bool memoryMapped = false);
     /// Destruct.
     ~PackageFile() override;
 
-    /// Open the package file. Return true if successful.
-    bool Open(const String& fileName, unsigned startOffset = 0);
+    /// Open the package file. Return true if successful. If memory mapping is requested, the whole file is mapped to
+    /// memory and files opened from the package read directly from the mapping instead of opening their own file
+    /// handle. Version 1 compressed packages are not mapped. Falls back to normal file reading if mapping is not
+    /// supported or fails.
+    bool Open(const String& fileName, unsigned startOffset = 0, bool memoryMapped = false);
     /// Check if a file exists within the package file. This will be case-insensitive on Windows and case-sensitive on other platforms.
     bool Exists(const String& fileName) const;
     /// Return the file entry corresponding to the name, or null if not found. This will be case-insensitive on Windows and case-sensitive on other platforms.
@@ -67,16 +100,34 @@ public:
     /// @property
     hash32 GetChecksum() const { return checksum_; }
 
-    /// Return whether the files are compressed.
+    /// Return whether the files are compressed. For a version 2 package, whether any file is compressed.
     /// @property
     bool IsCompressed() const { return compressed_; }
 
+    /// Return package format version.
+    /// @property
+    unsigned GetVersion() const { return version_; }
+
+    /// Return whether the package file is memory mapped.
+    /// @property
+    bool IsMemoryMapped() const { return mappedData_ != nullptr; }
+
+    /// Return the memory mapped package file contents, or null if not mapped. Entry offsets index into this.
+    const byte* GetMappedData() const { return mappedData_; }
+
     /// Return list of file names in the package.
     const Vector<String> GetEntryNames() const { return entries_.Keys(); }
 
 private:
+    /// Map the package file to memory. Return true if successful.
+    bool MapMemory();
+    /// Unmap the package file from memory.
+    void UnmapMemory();
+
     /// File entries.
     HashMap<String, PackageEntry> entries_;
+    /// File entries sorted by name hash for lookup.
+    Vector<PackageIndexEntry> index_;
     /// File name.
     String fileName_;
     /// Package file name hash.
@@ -87,8 +138,18 @@ private:
     unsigned totalDataSize_;
     /// Package file checksum.
     hash32 checksum_;
+    /// Package format version.
+    unsigned version_;
     /// Compressed flag.
     bool compressed_;
+    /// Memory mapped package file contents.
+    byte* mappedData_;
+    /// Size of the memory mapping.
+    i64 mappedSize_;
+#ifdef _WIN32
+    /// File mapping object handle.
+    void* mappingHandle_;
+#endif
 };
 
 }
@@ -42,6 +42,9 @@ public:
     /// Return data.
     const byte* GetData() const { return size_ ? &buffer_[0] : nullptr; }
 
+    /// Return data.
+    const byte* GetResidentData() const override { return GetData(); }
+
     /// Return non-const data.
     byte* GetModifiableData() { return size_ ? &buffer_[0] : nullptr; }
 
@@ -16,7 +16,7 @@ class URHO3D_API StringHash
 {
 public:
     /// Construct with zero value.
-    StringHash() noexcept
+    constexpr StringHash() noexcept
         : value_(0)
     {
     }
@@ -47,11 +47,9 @@ public:
     StringHash& operator =(const StringHash& rhs) noexcept = default;
 
     /// Add a hash.
-    StringHash operator +(const StringHash& rhs) const
+    constexpr StringHash operator +(const StringHash& rhs) const
     {
-        StringHash ret;
-        ret.value_ = value_ + rhs.value_;
-        return ret;
+        return StringHash(value_ + rhs.value_);
     }
 
     /// Add-assign a hash.
@@ -62,23 +60,23 @@ public:
     }
 
     /// Test for equality with another hash.
-    bool operator ==(const StringHash& rhs) const { return value_ == rhs.value_; }
+    constexpr bool operator ==(const StringHash& rhs) const { return value_ == rhs.value_; }
 
     /// Test for inequality with another hash.
-    bool operator !=(const StringHash& rhs) const { return value_ != rhs.value_; }
+    constexpr bool operator !=(const StringHash& rhs) const { return value_ != rhs.value_; }
 
     /// Test if less than another hash.
-    bool operator <(const StringHash& rhs) const { return value_ < rhs.value_; }
+    constexpr bool operator <(const StringHash& rhs) const { return value_ < rhs.value_; }
 
     /// Test if greater than another hash.
-    bool operator >(const StringHash& rhs) const { return value_ > rhs.value_; }
+    constexpr bool operator >(const StringHash& rhs) const { return value_ > rhs.value_; }
 
     /// Return true if nonzero hash value.
-    explicit operator bool() const { return value_ != 0; }
+    constexpr explicit operator bool() const { return value_ != 0; }
 
     /// Return hash value.
     /// @property
-    hash32 Value() const { return value_; }
+    constexpr hash32 Value() const { return value_; }
 
     /// Return as string.
     String ToString() const;
@@ -87,7 +85,7 @@ public:
     String Reverse() const;
 
     /// Return hash value for HashSet & HashMap.
-    hash32 ToHash() const { return value_; }
+    constexpr hash32 ToHash() const { return value_; }
 
     /// Calculate hash value from a C string.
     static constexpr hash32 Calculate(const char* str, hash32 hash = 0)
@@ -6,6 +6,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/ProcessUtils.h"
 #include "../Core/Profiler.h"
 #include "../IO/Log.h"
 #include "../Resource/BackgroundLoader.h"
@@ -17,94 +18,90 @@
 namespace Urho3D
 {
 
-BackgroundLoader::BackgroundLoader(ResourceCache* owner) :
+BackgroundLoaderThread::BackgroundLoaderThread(BackgroundLoader* owner) :
     owner_(owner)
 {
 }
 
+void BackgroundLoaderThread::ThreadFunction()
+{
+    URHO3D_PROFILE_THREAD("BackgroundLoader Thread");
+
+    while (shouldRun_)
+    {
+        if (!owner_->LoadNextResource())
+            Time::Sleep(5);
+    }
+}
+
+BackgroundLoader::BackgroundLoader(ResourceCache* owner) :
+    owner_(owner),
+    numThreads_(Clamp((i32)GetNumPhysicalCPUs() - 1, 1, 4)),
+    nextOrder_(0)
+{
+}
+
 BackgroundLoader::~BackgroundLoader()
 {
+    StopThreads();
+
     MutexLock lock(backgroundLoadMutex_);
 
     backgroundLoadQueue_.Clear();
 }
 
-void BackgroundLoader::ThreadFunction()
+void BackgroundLoader::SetNumThreads(i32 num)
 {
-    URHO3D_PROFILE_THREAD("BackgroundLoader Thread");
+    num = Max(num, 1);
 
-    while (shouldRun_)
     {
-        backgroundLoadMutex_.Acquire();
-
-        // Search for a queued resource that has not been loaded yet
-        HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator i = backgroundLoadQueue_.Begin();
-        while (i != backgroundLoadQueue_.End())
-        {
-            if (i->second_.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
-                break;
-            else
-                ++i;
-        }
+        MutexLock lock(backgroundLoadMutex_);
+        if (num == numThreads_)
+            return;
 
-        if (i == backgroundLoadQueue_.End())
-        {
-            // No resources to load found
-            backgroundLoadMutex_.Release();
-            Time::Sleep(5);
-        }
-        else
-        {
-            BackgroundLoadItem& item = i->second_;
-            Resource* resource = item.resource_;
-            // We can be sure that the item is not removed from the queue as long as it is in the
-            // "queued" or "loading" state
-            backgroundLoadMutex_.Release();
-
-            bool success = false;
-            SharedPtr<File> file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
-            if (file)
-            {
-                resource->SetAsyncLoadState(ASYNC_LOADING);
-                success = resource->BeginLoad(*file);
-            }
-
-            // Process dependencies now
-            // Need to lock the queue again when manipulating other entries
-            Pair<StringHash, StringHash> key = MakePair(resource->GetType(), resource->GetNameHash());
-            backgroundLoadMutex_.Acquire();
-            if (item.dependents_.Size())
-            {
-                for (HashSet<Pair<StringHash, StringHash>>::Iterator i = item.dependents_.Begin();
-                     i != item.dependents_.End(); ++i)
-                {
-                    HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator j = backgroundLoadQueue_.Find(*i);
-                    if (j != backgroundLoadQueue_.End())
-                        j->second_.dependencies_.Erase(key);
-                }
+        numThreads_ = num;
+        if (threads_.Empty())
+            return;
+    }
 
-                item.dependents_.Clear();
-            }
+    // Restart with the new count if already running. Resources being loaded are finished before the threads exit
+    StopThreads();
 
-            resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
-            backgroundLoadMutex_.Release();
-        }
-    }
+    MutexLock lock(backgroundLoadMutex_);
+    if (threads_.Empty() && backgroundLoadQueue_.Size())
+        StartThreads();
 }
 
-bool BackgroundLoader::QueueResource(StringHash type, const String& name, bool sendEventOnFailure, Resource* caller)
+bool BackgroundLoader::QueueResource(StringHash type, const String& name, bool sendEventOnFailure, Resource* caller,
+    i32 priority)
 {
     StringHash nameHash(name);
     Pair<StringHash, StringHash> key = MakePair(type, nameHash);
 
     MutexLock lock(backgroundLoadMutex_);
 
-    // Check if already exists in the queue
-    if (backgroundLoadQueue_.Find(key) != backgroundLoadQueue_.End())
+    // Resources requested by a loading resource inherit its priority
+    HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator j = backgroundLoadQueue_.End();
+    if (caller)
+    {
+        j = backgroundLoadQueue_.Find(MakePair(caller->GetType(), caller->GetNameHash()));
+        if (j != backgroundLoadQueue_.End())
+            priority = Max(priority, j->second_.priority_);
+    }
+
+    // Check if already exists in the queue. If requested with a higher priority, raise it
+    HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator i = backgroundLoadQueue_.Find(key);
+    if (i != backgroundLoadQueue_.End())
+    {
+        if (priority > i->second_.priority_)
+            RaisePriority(i->second_, priority);
         return false;
+    }
 
     BackgroundLoadItem& item = backgroundLoadQueue_[key];
     item.sendEventOnFailure_ = sendEventOnFailure;
+    item.priority_ = priority;
+    item.order_ = nextOrder_++;
 
     // Make sure the pointer is non-null and is a Resource subclass
     item.resource_ = DynamicCast<Resource>(owner_->GetContext()->CreateObject(type));
@@ -133,12 +130,10 @@ bool BackgroundLoader::QueueResource(StringHash type, const String& name, bool s
     // If this is a resource calling for the background load of more resources, mark the dependency as necessary
     if (caller)
     {
-        Pair<StringHash, StringHash> callerKey = MakePair(caller->GetType(), caller->GetNameHash());
-        HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator j = backgroundLoadQueue_.Find(callerKey);
         if (j != backgroundLoadQueue_.End())
         {
             BackgroundLoadItem& callerItem = j->second_;
-            item.dependents_.Insert(callerKey);
+            item.dependents_.Insert(j->first_);
             callerItem.dependencies_.Insert(key);
         }
         else
@@ -146,9 +141,9 @@ bool BackgroundLoader::QueueResource(StringHash type, const String& name, bool s
                        " requested for a background loaded resource but was not in the background load queue");
     }
 
-    // Start the background loader thread now
-    if (!IsStarted())
-        Run();
+    // Start the background loader threads now
+    if (threads_.Empty())
+        StartThreads();
 
     return true;
 }
@@ -162,8 +157,17 @@ void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
     HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator i = backgroundLoadQueue_.Find(key);
     if (i != backgroundLoadQueue_.End())
     {
+        // Move the resource and its dependencies to the front of the queue. If no thread has picked the resource up
+        // yet, load it here instead of waiting for one
+        RaisePriority(i->second_, M_MAX_INT);
+        bool loadHere = i->second_.resource_->GetAsyncLoadState() == ASYNC_QUEUED;
+        if (loadHere)
+            i->second_.resource_->SetAsyncLoadState(ASYNC_LOADING);
         backgroundLoadMutex_.Release();
 
+        if (loadHere)
+            LoadResource(i->second_);
+
         {
             Resource* resource = i->second_.resource_;
             HiresTimer waitTimer;
@@ -200,12 +204,12 @@ void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
 
 void BackgroundLoader::FinishResources(int maxMs)
 {
-    if (IsStarted())
+    backgroundLoadMutex_.Acquire();
+
+    if (!threads_.Empty())
     {
         HiresTimer timer;
 
-        backgroundLoadMutex_.Acquire();
-
         for (HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator i = backgroundLoadQueue_.Begin();
              i != backgroundLoadQueue_.End();)
         {
@@ -228,9 +232,43 @@ void BackgroundLoader::FinishResources(int maxMs)
             if (timer.GetUSec(false) >= maxMs * 1000LL)
                 break;
         }
+    }
 
+    backgroundLoadMutex_.Release();
+}
+
+bool BackgroundLoader::LoadNextResource()
+{
+    backgroundLoadMutex_.Acquire();
+
+    // Search for the queued resource with highest priority, and the earliest queued among equal priorities
+    HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator best = backgroundLoadQueue_.End();
+    for (HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator i = backgroundLoadQueue_.Begin();
+         i != backgroundLoadQueue_.End(); ++i)
+    {
+        const BackgroundLoadItem& item = i->second_;
+        if (item.resource_->GetAsyncLoadState() != ASYNC_QUEUED)
+            continue;
+        if (best == backgroundLoadQueue_.End() || item.priority_ > best->second_.priority_ ||
+            (item.priority_ == best->second_.priority_ && item.order_ < best->second_.order_))
+            best = i;
+    }
+
+    if (best == backgroundLoadQueue_.End())
+    {
+        // No resources to load found
         backgroundLoadMutex_.Release();
+        return false;
     }
+
+    // Claim the resource so that other threads skip it. We can be sure that the item is not removed from the queue as
+    // long as it is in the "queued" or "loading" state
+    BackgroundLoadItem& item = best->second_;
+    item.resource_->SetAsyncLoadState(ASYNC_LOADING);
+    backgroundLoadMutex_.Release();
+
+    LoadResource(item);
+    return true;
 }
 
 unsigned BackgroundLoader::GetNumQueuedResources() const
@@ -239,6 +277,69 @@ unsigned BackgroundLoader::GetNumQueuedResources() const
     return backgroundLoadQueue_.Size();
 }
 
+void BackgroundLoader::LoadResource(BackgroundLoadItem& item)
+{
+    Resource* resource = item.resource_;
+
+    bool success = false;
+    SharedPtr<File> file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
+    if (file)
+        success = resource->BeginLoad(*file);
+
+    // Process dependencies now
+    // Need to lock the queue again when manipulating other entries
+    Pair<StringHash, StringHash> key = MakePair(resource->GetType(), resource->GetNameHash());
+    MutexLock lock(backgroundLoadMutex_);
+    if (item.dependents_.Size())
+    {
+        for (HashSet<Pair<StringHash, StringHash>>::Iterator i = item.dependents_.Begin(); i != item.dependents_.End(); ++i)
+        {
+            HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator j = backgroundLoadQueue_.Find(*i);
+            if (j != backgroundLoadQueue_.End())
+                j->second_.dependencies_.Erase(key);
+        }
+
+        item.dependents_.Clear();
+    }
+
+    resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
+}
+
+void BackgroundLoader::RaisePriority(BackgroundLoadItem& item, i32 priority)
+{
+    item.priority_ = priority;
+
+    for (HashSet<Pair<StringHash, StringHash>>::Iterator i = item.dependencies_.Begin(); i != item.dependencies_.End(); ++i)
+    {
+        HashMap<Pair<StringHash, StringHash>, BackgroundLoadItem>::Iterator j = backgroundLoadQueue_.Find(*i);
+        if (j != backgroundLoadQueue_.End() && j->second_.priority_ < priority)
+            RaisePriority(j->second_, priority);
+    }
+}
+
+void BackgroundLoader::StartThreads()
+{
+    for (i32 i = 0; i < numThreads_; ++i)
+    {
+        SharedPtr<BackgroundLoaderThread> thread(new BackgroundLoaderThread(this));
+        thread->Run();
+        threads_.Push(thread);
+    }
+}
+
+void BackgroundLoader::StopThreads()
+{
+    Vector<SharedPtr<BackgroundLoaderThread>> threads;
+    {
+        MutexLock lock(backgroundLoadMutex_);
+        threads.Swap(threads_);
+    }
+
+    // Wait without the mutex, as the threads need it to finish their current resources
+    for (const SharedPtr<BackgroundLoaderThread>& thread : threads)
+        thread->Stop();
+}
+
 void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
 {
     Resource* resource = item.resource_;
@@ -8,6 +8,7 @@
 #include "../Core/Mutex.h"
 #include "../Container/Ptr.h"
 #include "../Container/RefCounted.h"
+#include "../Container/Vector.h"
 #include "../Core/Thread.h"
 #include "../Math/StringHash.h"
 
@@ -28,38 +29,84 @@ struct BackgroundLoadItem
     HashSet<Pair<StringHash, StringHash>> dependents_;
     /// Whether to send failure event.
     bool sendEventOnFailure_;
+    /// Load priority. Higher value = will be loaded first.
+    i32 priority_;
+    /// Queue order for loading resources of equal priority in request order.
+    unsigned order_;
 };
 
-/// Background loader of resources. Owned by the ResourceCache.
+class BackgroundLoader;
+
+/// Loader thread of the background loader.
 /// @nobind
-class BackgroundLoader : public RefCounted, public Thread
+class BackgroundLoaderThread : public RefCounted, public Thread
 {
 public:
     /// Construct.
-    explicit BackgroundLoader(ResourceCache* owner);
-
-    /// Destruct. Forcibly clear the load queue.
-    ~BackgroundLoader() override;
+    explicit BackgroundLoaderThread(BackgroundLoader* owner);
 
     /// Resource background loading loop.
     void ThreadFunction() override;
 
-    /// Queue loading of a resource. The name must be sanitated to ensure consistent format. Return true if queued (not a duplicate and resource was a known type).
-    bool QueueResource(StringHash type, const String& name, bool sendEventOnFailure, Resource* caller);
+private:
+    /// Background loader.
+    BackgroundLoader* owner_;
+};
+
+/// Background loader of resources. Owned by the ResourceCache. Loads resources on a pool of threads in priority order.
+/// Resources requested by a loading resource inherit its priority, and the requesting resource is finished only after
+/// them.
+/// @nobind
+class BackgroundLoader : public RefCounted
+{
+public:
+    /// Construct.
+    explicit BackgroundLoader(ResourceCache* owner);
+
+    /// Destruct. Stop the loader threads and forcibly clear the load queue.
+    ~BackgroundLoader() override;
+
+    /// Set number of loader threads. Running threads are restarted with the new count after finishing the resources they are loading.
+    void SetNumThreads(i32 num);
+    /// Queue loading of a resource. The name must be sanitated to ensure consistent format. Return true if queued (not a duplicate and resource was a known type). If already queued, raise the priority if higher.
+    bool QueueResource(StringHash type, const String& name, bool sendEventOnFailure, Resource* caller, i32 priority);
     /// Wait and finish possible loading of a resource when being requested from the cache.
     void WaitForResource(StringHash type, StringHash nameHash);
     /// Process resources that are ready to finish.
     void FinishResources(int maxMs);
+    /// Load the highest priority queued resource. Called by the loader threads. Return true if a resource was loaded.
+    bool LoadNextResource();
+
+    /// Return number of loader threads.
+    i32 GetNumThreads() const
+    {
+        MutexLock lock(backgroundLoadMutex_);
+        return numThreads_;
+    }
 
     /// Return amount of resources in the load queue.
     unsigned GetNumQueuedResources() const;
 
 private:
+    /// Call BeginLoad() of a resource which has been claimed for loading, then update its dependents.
+    void LoadResource(BackgroundLoadItem& item);
+    /// Raise priority of a queued resource and the resources it depends on. Called with the mutex held.
+    void RaisePriority(BackgroundLoadItem& item, i32 priority);
     /// Finish one background loaded resource.
     void FinishBackgroundLoading(BackgroundLoadItem& item);
+    /// Start the loader threads. Called with the mutex held.
+    void StartThreads();
+    /// Stop the loader threads. Must not be called with the mutex held, as the threads need it to finish.
+    void StopThreads();
 
     /// Resource cache.
     ResourceCache* owner_;
+    /// Loader threads. Guarded by the mutex.
+    Vector<SharedPtr<BackgroundLoaderThread>> threads_;
+    /// Number of loader threads to start. Guarded by the mutex.
+    i32 numThreads_;
+    /// Order counter for queued resources.
+    unsigned nextOrder_;
     /// Mutex for thread-safe access to the background load queue.
     mutable Mutex backgroundLoadMutex_;
     /// Resources that are queued for background loading.
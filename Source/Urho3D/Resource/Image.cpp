@@ -782,17 +782,22 @@ bool Image::BeginLoad(Deserializer& source)
             return false;
         }
 
-        // Read the file to buffer.
+        // Read the file to buffer, unless it is already in memory
         size_t dataSize(source.GetSize());
-        SharedArrayPtr<uint8_t> data(new uint8_t[dataSize]);
-
-        memset(data.Get(), 0, sizeof(uint8_t) * dataSize);
-        source.Seek(0);
-        source.Read(data.Get(), dataSize);
+        SharedArrayPtr<uint8_t> dataBuffer;
+        const uint8_t* data = (const uint8_t*)source.GetResidentData();
+        if (!data)
+        {
+            dataBuffer = new uint8_t[dataSize];
+            memset(dataBuffer.Get(), 0, sizeof(uint8_t) * dataSize);
+            source.Seek(0);
+            source.Read(dataBuffer.Get(), dataSize);
+            data = dataBuffer.Get();
+        }
 
         WebPBitstreamFeatures features;
 
-        if (WebPGetFeatures(data.Get(), dataSize, &features) != VP8_STATUS_OK)
+        if (WebPGetFeatures(data, dataSize, &features) != VP8_STATUS_OK)
         {
             URHO3D_LOGERROR("Error reading WebP image: " + source.GetName());
             return false;
@@ -804,11 +809,11 @@ bool Image::BeginLoad(Deserializer& source)
         bool decodeError(false);
         if (features.has_alpha)
         {
-            decodeError = WebPDecodeRGBAInto(data.Get(), dataSize, pixelData.Get(), imgSize, 4 * features.width) == nullptr;
+            decodeError = WebPDecodeRGBAInto(data, dataSize, pixelData.Get(), imgSize, 4 * features.width) == nullptr;
         }
         else
         {
-            decodeError = WebPDecodeRGBInto(data.Get(), dataSize, pixelData.Get(), imgSize, 3 * features.width) == nullptr;
+            decodeError = WebPDecodeRGBInto(data, dataSize, pixelData.Get(), imgSize, 3 * features.width) == nullptr;
         }
         if (decodeError)
         {
@@ -2336,6 +2341,10 @@ unsigned char* Image::GetImageData(Deserializer& source, int& width, int& height
 {
     unsigned dataSize = source.GetSize();
 
+    // Decode in place if the data is already in memory, for example when loading from a memory mapped package
+    if (const byte* residentData = source.GetResidentData())
+        return stbi_load_from_memory((const unsigned char*)residentData, dataSize, &width, &height, (int*)&components, 0);
+
     SharedArrayPtr<unsigned char> buffer(new unsigned char[dataSize]);
     source.Read(buffer.Get(), dataSize);
     return stbi_load_from_memory(buffer.Get(), dataSize, &width, &height, (int*)&components, 0);
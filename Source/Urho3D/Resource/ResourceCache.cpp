@@ -53,6 +53,7 @@ ResourceCache::ResourceCache(Context* context) :
     autoReloadResources_(false),
     returnFailedResources_(false),
     searchPackagesFirst_(true),
+    memoryMapPackages_(false),
     isRouting_(false),
     finishBackgroundResourcesMs_(5)
 {
@@ -142,7 +143,7 @@ bool ResourceCache::AddPackageFile(const String& fileName, i32 priority)
 {
     assert(priority >= 0 || priority == PRIORITY_LAST);
     SharedPtr<PackageFile> package(new PackageFile(context_));
-    return package->Open(fileName) && AddPackageFile(package, priority);
+    return package->Open(fileName, 0, memoryMapPackages_) && AddPackageFile(package, priority);
 }
 
 bool ResourceCache::AddManualResource(Resource* resource)
@@ -626,7 +627,7 @@ Resource* ResourceCache::GetResource(StringHash type, const String& name, bool s
     return resource;
 }
 
-bool ResourceCache::BackgroundLoadResource(StringHash type, const String& name, bool sendEventOnFailure, Resource* caller)
+bool ResourceCache::BackgroundLoadResource(StringHash type, const String& name, bool sendEventOnFailure, Resource* caller, i32 priority)
 {
 #ifdef URHO3D_THREADING
     // If empty name, fail immediately
@@ -639,7 +640,7 @@ bool ResourceCache::BackgroundLoadResource(StringHash type, const String& name,
     if (FindResource(type, nameHash) != noResource)
         return false;
 
-    return backgroundLoader_->QueueResource(type, sanitatedName, sendEventOnFailure, caller);
+    return backgroundLoader_->QueueResource(type, sanitatedName, sendEventOnFailure, caller, priority);
 #else
     // When threading not supported, fall back to synchronous loading
     return GetResource(type, name, sendEventOnFailure);
@@ -708,6 +709,22 @@ unsigned ResourceCache::GetNumBackgroundLoadResources() const
 #endif
 }
 
+void ResourceCache::SetNumBackgroundLoadThreads(i32 num)
+{
+#ifdef URHO3D_THREADING
+    backgroundLoader_->SetNumThreads(num);
+#endif
+}
+
+i32 ResourceCache::GetNumBackgroundLoadThreads() const
+{
+#ifdef URHO3D_THREADING
+    return backgroundLoader_->GetNumThreads();
+#else
+    return 0;
+#endif
+}
+
 void ResourceCache::GetResources(Vector<Resource*>& result, StringHash type) const
 {
     result.Clear();
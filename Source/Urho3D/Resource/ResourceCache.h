@@ -113,10 +113,18 @@ public:
     /// @property
     void SetSearchPackagesFirst(bool value) { searchPackagesFirst_ = value; }
 
+    /// Set whether package files added by name are memory mapped, so that files are read from them without per-file handles or copies through the C runtime. Only affects uncompressed packages added afterward. Default false.
+    /// @property
+    void SetMemoryMapPackages(bool enable) { memoryMapPackages_ = enable; }
+
     /// Set how many milliseconds maximum per frame to spend on finishing background loaded resources.
     /// @property
     void SetFinishBackgroundResourcesMs(int ms) { finishBackgroundResourcesMs_ = Max(ms, 1); }
 
+    /// Set number of threads used for background loading. Default is one less than the physical CPU count, but at most 4. Running loader threads are restarted with the new count.
+    /// @property
+    void SetNumBackgroundLoadThreads(i32 num);
+
     /// Add a resource router object. By default there is none, so the routing process is skipped.
     void AddResourceRouter(ResourceRouter* router, bool addAsFirst = false);
     /// Remove a resource router object.
@@ -128,11 +136,14 @@ public:
     Resource* GetResource(StringHash type, const String& name, bool sendEventOnFailure = true);
     /// Load a resource without storing it in the resource cache. Return null if not found or if fails. Can be called from outside the main thread if the resource itself is safe to load completely (it does not possess for example GPU data).
     SharedPtr<Resource> GetTempResource(StringHash type, const String& name, bool sendEventOnFailure = true);
-    /// Background load a resource. An event will be sent when complete. Return true if successfully stored to the load queue, false if eg. already exists. Can be called from outside the main thread.
-    bool BackgroundLoadResource(StringHash type, const String& name, bool sendEventOnFailure = true, Resource* caller = nullptr);
+    /// Background load a resource. An event will be sent when complete. Return true if successfully stored to the load queue, false if eg. already exists. Queued resources are loaded in order of descending priority; resources requested by the caller inherit its priority. Requesting an already queued resource with a higher priority raises it. Can be called from outside the main thread.
+    bool BackgroundLoadResource(StringHash type, const String& name, bool sendEventOnFailure = true, Resource* caller = nullptr, i32 priority = 0);
     /// Return number of pending background-loaded resources.
     /// @property
     unsigned GetNumBackgroundLoadResources() const;
+    /// Return number of threads used for background loading.
+    /// @property
+    i32 GetNumBackgroundLoadThreads() const;
     /// Return all loaded resources of a specific type.
     void GetResources(Vector<Resource*>& result, StringHash type) const;
     /// Return an already loaded resource of specific type & name, or null if not found. Will not load if does not exist.
@@ -158,7 +169,7 @@ public:
     /// Template version of releasing a resource by name.
     template <class T> void ReleaseResource(const String& name, bool force = false);
     /// Template version of queueing a resource background load.
-    template <class T> bool BackgroundLoadResource(const String& name, bool sendEventOnFailure = true, Resource* caller = nullptr);
+    template <class T> bool BackgroundLoadResource(const String& name, bool sendEventOnFailure = true, Resource* caller = nullptr, i32 priority = 0);
     /// Template version of returning loaded resources of a specific type.
     template <class T> void GetResources(Vector<T*>& result) const;
     /// Return whether a file exists in the resource directories or package files. Does not check manually added in-memory resources.
@@ -187,6 +198,10 @@ public:
     /// @property
     bool GetSearchPackagesFirst() const { return searchPackagesFirst_; }
 
+    /// Return whether package files added by name are memory mapped.
+    /// @property
+    bool GetMemoryMapPackages() const { return memoryMapPackages_; }
+
     /// Return how many milliseconds maximum to spend on finishing background loaded resources.
     /// @property
     int GetFinishBackgroundResourcesMs() const { return finishBackgroundResourcesMs_; }
@@ -246,6 +261,8 @@ private:
     bool returnFailedResources_;
     /// Search priority flag.
     bool searchPackagesFirst_;
+    /// Memory map packages flag.
+    bool memoryMapPackages_;
     /// Resource routing flag to prevent endless recursion.
     mutable bool isRouting_;
     /// How many milliseconds maximum per frame to spend on finishing background loaded resources.
@@ -276,10 +293,10 @@ template <class T> SharedPtr<T> ResourceCache::GetTempResource(const String& nam
     return StaticCast<T>(GetTempResource(type, name, sendEventOnFailure));
 }
 
-template <class T> bool ResourceCache::BackgroundLoadResource(const String& name, bool sendEventOnFailure, Resource* caller)
+template <class T> bool ResourceCache::BackgroundLoadResource(const String& name, bool sendEventOnFailure, Resource* caller, i32 priority)
 {
     StringHash type = T::GetTypeStatic();
-    return BackgroundLoadResource(type, name, sendEventOnFailure, caller);
+    return BackgroundLoadResource(type, name, sendEventOnFailure, caller, priority);
 }
 
 template <class T> void ResourceCache::GetResources(Vector<T*>& result) const
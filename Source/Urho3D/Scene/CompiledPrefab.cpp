@@ -0,0 +1,250 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../IO/VectorBuffer.h"
+#include "../Scene/CompiledPrefab.h"
+#include "../Scene/Scene.h"
+#include "../Scene/UnknownComponent.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+CompiledPrefab::CompiledPrefab(Context* context) :
+    Resource(context)
+{
+}
+
+CompiledPrefab::~CompiledPrefab() = default;
+
+void CompiledPrefab::RegisterObject(Context* context)
+{
+    context->RegisterFactory<CompiledPrefab>();
+}
+
+bool CompiledPrefab::BeginLoad(Deserializer& source)
+{
+    return Compile(source);
+}
+
+bool CompiledPrefab::Compile(Deserializer& source)
+{
+    Clear();
+
+    if (!CompileNode(source, -1))
+    {
+        URHO3D_LOGERROR("Could not compile prefab " + source.GetName());
+        Clear();
+        return false;
+    }
+
+    i32 memoryUse = sizeof(CompiledPrefab) + nodes_.Size() * sizeof(PrefabNode) + components_.Size() * sizeof(PrefabComponent) +
+        attributeValues_.Size() * sizeof(PrefabAttributeValue);
+    for (const PrefabComponent& component : components_)
+        memoryUse += component.data_.Size();
+    memoryUse += nodeAttributes_.Size() * sizeof(AttributeInfo);
+    SetMemoryUse(memoryUse);
+
+    return true;
+}
+
+bool CompiledPrefab::Compile(Node* node)
+{
+    if (!node)
+    {
+        URHO3D_LOGERROR("Null node for prefab compilation");
+        return false;
+    }
+
+    VectorBuffer buffer;
+    if (!node->Save(buffer))
+        return false;
+
+    buffer.Seek(0);
+    return Compile(buffer);
+}
+
+Node* CompiledPrefab::Instantiate(Node* parent, const Vector3& position, const Quaternion& rotation, CreateMode mode) const
+{
+    if (!parent)
+    {
+        URHO3D_LOGERROR("Null parent node for prefab instantiation");
+        return nullptr;
+    }
+    if (nodes_.Empty())
+    {
+        URHO3D_LOGERROR("Can not instantiate empty prefab " + GetName());
+        return nullptr;
+    }
+
+    URHO3D_PROFILE(InstantiateCompiledPrefab);
+
+    SceneResolver resolver;
+    // Created nodes by command index, so that child nodes find their parent directly
+    Vector<Node*> createdNodes(nodes_.Size());
+
+    for (i32 i = 0; i < nodes_.Size(); ++i)
+    {
+        const PrefabNode& nodeCommand = nodes_[i];
+        Node* parentNode = nodeCommand.parent_ < 0 ? parent : createdNodes[nodeCommand.parent_];
+
+        // Rewrite IDs when instantiating. Like Scene::Instantiate(), the root node is created with the mode as is
+        CreateMode nodeMode = mode;
+        if (nodeCommand.parent_ >= 0 && !Scene::IsReplicatedID(nodeCommand.id_))
+            nodeMode = LOCAL;
+        Node* node = parentNode->CreateChild(0, nodeMode);
+        resolver.AddNode(nodeCommand.id_, node);
+        ApplyAttributeValues(node, nodeCommand.firstAttribute_, nodeCommand.numAttributes_);
+
+        for (i32 j = nodeCommand.firstComponent_; j < nodeCommand.firstComponent_ + nodeCommand.numComponents_; ++j)
+        {
+            const PrefabComponent& compCommand = components_[j];
+            // Do not create replicated components to local nodes, as that may lead to component ID overwrite
+            CreateMode compMode = (mode == REPLICATED && node->IsReplicated() && Scene::IsReplicatedID(compCommand.id_)) ?
+                REPLICATED : LOCAL;
+
+            SharedPtr<Component> newComponent;
+            if (compCommand.factory_)
+                newComponent = StaticCast<Component>(compCommand.factory_->CreateObject());
+            else
+            {
+                SharedPtr<UnknownComponent> unknownComponent(new UnknownComponent(context_));
+                unknownComponent->SetType(compCommand.type_);
+                newComponent = unknownComponent;
+            }
+
+            node->AddComponent(newComponent, 0, compMode);
+            resolver.AddComponent(compCommand.id_, newComponent);
+            // Load the same way as Node::Load() does, so that components which track loading see it
+            MemoryBuffer buffer(compCommand.data_);
+            newComponent->Load(buffer);
+        }
+
+        createdNodes[i] = node;
+    }
+
+    Node* root = createdNodes[0];
+    resolver.Resolve();
+    root->SetTransform(position, rotation);
+    root->ApplyAttributes();
+    return root;
+}
+
+bool CompiledPrefab::CompileNode(Deserializer& source, i32 parentIndex)
+{
+    i32 nodeIndex = nodes_.Size();
+    nodes_.Resize(nodeIndex + 1);
+
+    PrefabNode nodeCommand;
+    nodeCommand.id_ = source.ReadU32();
+    nodeCommand.parent_ = parentIndex;
+    if (!CompileAttributes(source, nodeCommand.firstAttribute_, nodeCommand.numAttributes_))
+        return false;
+
+    const HashMap<StringHash, SharedPtr<ObjectFactory>>& factories = context_->GetObjectFactories();
+    i32 numComponents = source.ReadVLE();
+    nodeCommand.firstComponent_ = components_.Size();
+    nodeCommand.numComponents_ = numComponents;
+    components_.Resize(components_.Size() + numComponents);
+
+    for (i32 i = 0; i < numComponents; ++i)
+    {
+        PrefabComponent& compCommand = components_[nodeCommand.firstComponent_ + i];
+        i32 compSize = source.ReadVLE();
+        if (compSize < (i32)(sizeof(StringHash) + sizeof(ComponentId)) || source.GetPosition() + compSize > source.GetSize())
+        {
+            URHO3D_LOGERROR("Could not compile prefab, component data outside stream");
+            return false;
+        }
+
+        compCommand.type_ = source.ReadStringHash();
+        compCommand.id_ = source.ReadU32();
+        compSize -= (i32)(sizeof(StringHash) + sizeof(ComponentId));
+
+        HashMap<StringHash, SharedPtr<ObjectFactory>>::ConstIterator factory = factories.Find(compCommand.type_);
+        if (factory != factories.End() && factory->second_->GetTypeInfo()->IsTypeOf<Component>())
+            compCommand.factory_ = factory->second_;
+        else
+        {
+            URHO3D_LOGWARNING("Component type " + compCommand.type_.ToString() +
+                " not known, creating UnknownComponent as placeholder");
+        }
+
+        compCommand.data_.Resize(compSize);
+        if (compSize)
+            source.Read(&compCommand.data_[0], compSize);
+    }
+
+    i32 numChildren = source.ReadVLE();
+    // Store the node before recursing, as the vector may be reallocated
+    nodes_[nodeIndex] = nodeCommand;
+
+    for (i32 i = 0; i < numChildren; ++i)
+    {
+        if (!CompileNode(source, nodeIndex))
+            return false;
+    }
+
+    return true;
+}
+
+bool CompiledPrefab::CompileAttributes(Deserializer& source, i32& first, i32& count)
+{
+    first = attributeValues_.Size();
+    count = 0;
+
+    if (nodeAttributes_.Empty())
+    {
+        const Vector<AttributeInfo>* attributes = context_->GetAttributes(Node::GetTypeStatic());
+        if (attributes)
+            nodeAttributes_ = *attributes;
+    }
+
+    // Nodes save their default attributes, so all values are applied like when loading
+    for (i32 i = 0; i < nodeAttributes_.Size(); ++i)
+    {
+        const AttributeInfo& attr = nodeAttributes_[i];
+        if (!(attr.mode_ & AM_FILE))
+            continue;
+
+        if (source.IsEof())
+        {
+            URHO3D_LOGERROR("Could not compile prefab, stream not open or at end");
+            return false;
+        }
+
+        PrefabAttributeValue attrValue;
+        attrValue.index_ = i;
+        attrValue.value_ = source.ReadVariant(attr.type_);
+        attributeValues_.Push(attrValue);
+        ++count;
+    }
+
+    return true;
+}
+
+void CompiledPrefab::ApplyAttributeValues(Node* node, i32 first, i32 count) const
+{
+    for (i32 i = first; i < first + count; ++i)
+    {
+        const PrefabAttributeValue& attrValue = attributeValues_[i];
+        node->OnSetAttribute(nodeAttributes_[attrValue.index_], attrValue.value_);
+    }
+}
+
+void CompiledPrefab::Clear()
+{
+    nodes_.Clear();
+    components_.Clear();
+    attributeValues_.Clear();
+    nodeAttributes_.Clear();
+}
+
+}
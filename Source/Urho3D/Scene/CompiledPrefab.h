@@ -0,0 +1,114 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+/// \file
+
+#pragma once
+
+#include "../Resource/Resource.h"
+#include "../Scene/Node.h"
+
+namespace Urho3D
+{
+
+class ObjectFactory;
+
+/// Node attribute value of a compiled prefab.
+struct PrefabAttributeValue
+{
+    /// Index into the node attribute list.
+    i32 index_;
+    /// Value.
+    Variant value_;
+};
+
+/// Component construction command of a compiled prefab.
+struct PrefabComponent
+{
+    /// Factory resolved at compile time, or null if the component type is unknown.
+    SharedPtr<ObjectFactory> factory_;
+    /// Component type.
+    StringHash type_;
+    /// Original component ID.
+    ComponentId id_;
+    /// Binary attribute data, loaded through Component::Load() so that the load hooks of the component type run.
+    Vector<byte> data_;
+};
+
+/// Node construction command of a compiled prefab.
+struct PrefabNode
+{
+    /// Original node ID.
+    NodeId id_;
+    /// Index of the parent node, or -1 for the prefab root.
+    i32 parent_;
+    /// First attribute value.
+    i32 firstAttribute_;
+    /// Number of attribute values.
+    i32 numAttributes_;
+    /// First component.
+    i32 firstComponent_;
+    /// Number of components.
+    i32 numComponents_;
+};
+
+/// Object prefab resolved once into flat construction commands, pre-parsed node attribute values and per-component
+/// attribute data. Instantiating it skips the node parsing, buffer copies and factory lookups that Scene::Instantiate()
+/// pays on every call, so it should be used for prefabs which are spawned often. Loads from the binary prefab format
+/// written by Node::Save().
+class URHO3D_API CompiledPrefab : public Resource
+{
+    URHO3D_OBJECT(CompiledPrefab, Resource);
+
+public:
+    /// Construct.
+    explicit CompiledPrefab(Context* context);
+    /// Destruct.
+    ~CompiledPrefab() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Load resource from stream. May be called from a worker thread. Return true if successful.
+    bool BeginLoad(Deserializer& source) override;
+
+    /// Compile from binary node data. Return true if successful.
+    bool Compile(Deserializer& source);
+    /// Compile from a node and its children. Return true if successful.
+    bool Compile(Node* node);
+    /// Instantiate as a child of a node. Creates the root node with the mode, and the other nodes and components as replicated only if their original IDs are. Return root node if successful.
+    Node* Instantiate(Node* parent, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED) const;
+
+    /// Return number of nodes.
+    /// @property
+    i32 GetNumNodes() const { return nodes_.Size(); }
+
+    /// Return number of components.
+    /// @property
+    i32 GetNumComponents() const { return components_.Size(); }
+
+    /// Return number of stored node attribute values.
+    /// @property
+    i32 GetNumAttributeValues() const { return attributeValues_.Size(); }
+
+private:
+    /// Compile a node and its children recursively. Return true if successful.
+    bool CompileNode(Deserializer& source, i32 parentIndex);
+    /// Compile the attribute values of one node. Return true if successful.
+    bool CompileAttributes(Deserializer& source, i32& first, i32& count);
+    /// Apply stored attribute values to a node.
+    void ApplyAttributeValues(Node* node, i32 first, i32 count) const;
+    /// Clear all compiled data.
+    void Clear();
+
+    /// Nodes in depth-first order, parents before children.
+    Vector<PrefabNode> nodes_;
+    /// Components in node order.
+    Vector<PrefabComponent> components_;
+    /// Attribute values of all nodes.
+    Vector<PrefabAttributeValue> attributeValues_;
+    /// Node attribute descriptions, copied at compile time so that later attribute registrations do not invalidate them.
+    Vector<AttributeInfo> nodeAttributes_;
+};
+
+}
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "../Container/Allocator.h"
 #include "../Scene/Animatable.h"
 
 namespace Urho3D
@@ -31,6 +32,7 @@ using ComponentId = id32;
 class URHO3D_API Component : public Animatable
 {
     URHO3D_OBJECT(Component, Animatable);
+    URHO3D_POOL_ALLOCATED();
 
     friend class Node;
     friend class Scene;
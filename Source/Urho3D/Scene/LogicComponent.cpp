@@ -4,12 +4,8 @@
 #include "../Precompiled.h"
 
 #include "../IO/Log.h"
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
-#include "../Physics/PhysicsEvents.h"
-#endif
 #include "../Scene/LogicComponent.h"
 #include "../Scene/Scene.h"
-#include "../Scene/SceneEvents.h"
 
 namespace Urho3D
 {
@@ -18,11 +14,20 @@ LogicComponent::LogicComponent(Context* context) :
     Component(context),
     updateEventMask_(LogicComponentEvents::All),
     currentEventMask_(LogicComponentEvents::None),
-    delayedStartCalled_(false)
+    delayedStartCalled_(false),
+    updateParallelSafe_(false)
 {
+    for (i32 i = 0; i < MAX_LOGIC_UPDATE_PHASES; ++i)
+    {
+        updateList_[i] = 0;
+        updateIndex_[i] = NINDEX;
+    }
 }
 
-LogicComponent::~LogicComponent() = default;
+LogicComponent::~LogicComponent()
+{
+    RemoveFromUpdateRegistry();
+}
 
 void LogicComponent::OnSetEnabled()
 {
@@ -54,6 +59,18 @@ void LogicComponent::SetUpdateEventMask(LogicComponentEvents mask)
     }
 }
 
+void LogicComponent::SetUpdateParallelSafe(bool enable)
+{
+    if (enable != updateParallelSafe_)
+    {
+        updateParallelSafe_ = enable;
+
+        // The registry lists parallel-safe components separately, so add again
+        RemoveFromUpdateRegistry();
+        UpdateEventSubscription();
+    }
+}
+
 void LogicComponent::OnNodeSet(Node* node)
 {
     if (node)
@@ -73,15 +90,7 @@ void LogicComponent::OnSceneSet(Scene* scene)
     if (scene)
         UpdateEventSubscription();
     else
-    {
-        UnsubscribeFromEvent(E_SCENEUPDATE);
-        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
-        UnsubscribeFromEvent(E_PHYSICSPRESTEP);
-        UnsubscribeFromEvent(E_PHYSICSPOSTSTEP);
-#endif
-        currentEventMask_ = LogicComponentEvents::None;
-    }
+        RemoveFromUpdateRegistry();
 }
 
 void LogicComponent::UpdateEventSubscription()
@@ -90,119 +99,108 @@ void LogicComponent::UpdateEventSubscription()
     if (!scene)
         return;
 
+    LogicUpdateRegistry* registry = scene->GetLogicUpdateRegistry();
+    if (registry != updateRegistry_.Get())
+    {
+        RemoveFromUpdateRegistry();
+        updateRegistry_ = registry;
+    }
+
     bool enabled = IsEnabledEffective();
 
     bool needUpdate = enabled && (!!(updateEventMask_ & LogicComponentEvents::Update) || !delayedStartCalled_);
-    if (needUpdate && !(currentEventMask_ & LogicComponentEvents::Update))
-    {
-        SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(LogicComponent, HandleSceneUpdate));
-        currentEventMask_ |= LogicComponentEvents::Update;
-    }
-    else if (!needUpdate && !!(currentEventMask_ & LogicComponentEvents::Update))
-    {
-        UnsubscribeFromEvent(scene, E_SCENEUPDATE);
-        currentEventMask_ &= ~LogicComponentEvents::Update;
-    }
+    SetUpdatePhase(LUP_UPDATE, LogicComponentEvents::Update, needUpdate);
 
     bool needPostUpdate = enabled && !!(updateEventMask_ & LogicComponentEvents::PostUpdate);
-    if (needPostUpdate && !(currentEventMask_ & LogicComponentEvents::PostUpdate))
-    {
-        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(LogicComponent, HandleScenePostUpdate));
-        currentEventMask_ |= LogicComponentEvents::PostUpdate;
-    }
-    else if (!needPostUpdate && !!(currentEventMask_ & LogicComponentEvents::PostUpdate))
-    {
-        UnsubscribeFromEvent(scene, E_SCENEPOSTUPDATE);
-        currentEventMask_ &= ~LogicComponentEvents::PostUpdate;
-    }
+    SetUpdatePhase(LUP_POSTUPDATE, LogicComponentEvents::PostUpdate, needPostUpdate);
 
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
     Component* world = GetFixedUpdateSource();
     if (!world)
         return;
 
+    registry->SetFixedUpdateSource(world);
+
     bool needFixedUpdate = enabled && !!(updateEventMask_ & LogicComponentEvents::FixedUpdate);
-    if (needFixedUpdate && !(currentEventMask_ & LogicComponentEvents::FixedUpdate))
-    {
-        SubscribeToEvent(world, E_PHYSICSPRESTEP, URHO3D_HANDLER(LogicComponent, HandlePhysicsPreStep));
-        currentEventMask_ |= LogicComponentEvents::FixedUpdate;
-    }
-    else if (!needFixedUpdate && !!(currentEventMask_ & LogicComponentEvents::FixedUpdate))
+    SetUpdatePhase(LUP_FIXEDUPDATE, LogicComponentEvents::FixedUpdate, needFixedUpdate);
+
+    bool needFixedPostUpdate = enabled && !!(updateEventMask_ & LogicComponentEvents::FixedPostUpdate);
+    SetUpdatePhase(LUP_FIXEDPOSTUPDATE, LogicComponentEvents::FixedPostUpdate, needFixedPostUpdate);
+#endif
+}
+
+void LogicComponent::RemoveFromUpdateRegistry()
+{
+    if (updateRegistry_)
     {
-        UnsubscribeFromEvent(world, E_PHYSICSPRESTEP);
-        currentEventMask_ &= ~LogicComponentEvents::FixedUpdate;
+        for (i32 i = 0; i < MAX_LOGIC_UPDATE_PHASES; ++i)
+            updateRegistry_->Remove(this, (LogicUpdatePhase)i);
     }
 
-    bool needFixedPostUpdate = enabled && !!(updateEventMask_ & LogicComponentEvents::FixedPostUpdate);
-    if (needFixedPostUpdate && !(currentEventMask_ & LogicComponentEvents::FixedPostUpdate))
+    updateRegistry_.Reset();
+    currentEventMask_ = LogicComponentEvents::None;
+}
+
+void LogicComponent::SetUpdatePhase(LogicUpdatePhase phase, LogicComponentEvents flag, bool enable)
+{
+    if (enable && !(currentEventMask_ & flag))
     {
-        SubscribeToEvent(world, E_PHYSICSPOSTSTEP, URHO3D_HANDLER(LogicComponent, HandlePhysicsPostStep));
-        currentEventMask_ |= LogicComponentEvents::FixedPostUpdate;
+        updateRegistry_->Add(this, phase);
+        currentEventMask_ |= flag;
     }
-    else if (!needFixedPostUpdate && !!(currentEventMask_ & LogicComponentEvents::FixedPostUpdate))
+    else if (!enable && !!(currentEventMask_ & flag))
     {
-        UnsubscribeFromEvent(world, E_PHYSICSPOSTSTEP);
-        currentEventMask_ &= ~LogicComponentEvents::FixedPostUpdate;
+        updateRegistry_->Remove(this, phase);
+        currentEventMask_ &= ~flag;
     }
-#endif
 }
 
-void LogicComponent::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+void LogicComponent::CallDelayedStart()
 {
-    using namespace SceneUpdate;
+    DelayedStart();
+    delayedStartCalled_ = true;
 
-    // Execute user-defined delayed start function before first update
-    if (!delayedStartCalled_)
-    {
-        DelayedStart();
-        delayedStartCalled_ = true;
+    // If did not need actual update calls, stop them now
+    if (!(updateEventMask_ & LogicComponentEvents::Update) && updateRegistry_)
+        SetUpdatePhase(LUP_UPDATE, LogicComponentEvents::Update, false);
+}
 
-        // If did not need actual update events, unsubscribe now
-        if (!(updateEventMask_ & LogicComponentEvents::Update))
+void LogicComponent::CallUpdate(LogicUpdatePhase phase, float timeStep)
+{
+    switch (phase)
+    {
+    case LUP_UPDATE:
+        // Execute user-defined delayed start function before first update
+        if (!delayedStartCalled_)
         {
-            UnsubscribeFromEvent(GetScene(), E_SCENEUPDATE);
-            currentEventMask_ &= ~LogicComponentEvents::Update;
-            return;
+            CallDelayedStart();
+            if (!(updateEventMask_ & LogicComponentEvents::Update))
+                return;
         }
-    }
 
-    // Then execute user-defined update function
-    Update(eventData[P_TIMESTEP].GetFloat());
-}
+        // Then execute user-defined update function
+        Update(timeStep);
+        break;
 
-void LogicComponent::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
-{
-    using namespace ScenePostUpdate;
+    case LUP_POSTUPDATE:
+        PostUpdate(timeStep);
+        break;
 
-    // Execute user-defined post-update function
-    PostUpdate(eventData[P_TIMESTEP].GetFloat());
-}
+    case LUP_FIXEDUPDATE:
+        // Execute user-defined delayed start function before first fixed update if not called yet
+        if (!delayedStartCalled_)
+            CallDelayedStart();
 
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
+        FixedUpdate(timeStep);
+        break;
 
-void LogicComponent::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
-{
-    using namespace PhysicsPreStep;
+    case LUP_FIXEDPOSTUPDATE:
+        FixedPostUpdate(timeStep);
+        break;
 
-    // Execute user-defined delayed start function before first fixed update if not called yet
-    if (!delayedStartCalled_)
-    {
-        DelayedStart();
-        delayedStartCalled_ = true;
+    default:
+        break;
     }
-
-    // Execute user-defined fixed update function
-    FixedUpdate(eventData[P_TIMESTEP].GetFloat());
 }
 
-void LogicComponent::HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData)
-{
-    using namespace PhysicsPostStep;
-
-    // Execute user-defined fixed post-update function
-    FixedPostUpdate(eventData[P_TIMESTEP].GetFloat());
-}
-
-#endif
-
 }
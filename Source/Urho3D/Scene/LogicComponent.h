@@ -7,6 +7,7 @@
 
 #include "../Container/FlagSet.h"
 #include "../Scene/Component.h"
+#include "../Scene/LogicUpdateRegistry.h"
 
 namespace Urho3D
 {
@@ -34,10 +35,13 @@ enum class LogicComponentEvents
 URHO3D_FLAGS(LogicComponentEvents);
 
 /// Helper base class for user-defined game logic components that hooks up to update events and forwards them to virtual functions similar to ScriptInstance class.
+/// The update functions are called by the logic update registry of the scene, grouped by component type, instead of through per-component event subscriptions.
 class URHO3D_API LogicComponent : public Component
 {
     URHO3D_OBJECT(LogicComponent, Component);
 
+    friend class LogicUpdateRegistry;
+
 public:
     /// Construct.
     explicit LogicComponent(Context* context);
@@ -71,6 +75,12 @@ public:
     /// Return what update events are subscribed to.
     LogicComponentEvents GetUpdateEventMask() const { return updateEventMask_; }
 
+    /// Set whether the update functions of this component may run in worker threads, in parallel with other components of the same type. Default false. Use only for update functions that modify nothing but the component's own state and node transforms, and do not create or remove nodes or components, send events or access resources. DelayedStart() is always called in the main thread. Like the update event mask, should be called eg. in the subclass constructor.
+    void SetUpdateParallelSafe(bool enable);
+
+    /// Return whether the update functions may run in worker threads.
+    bool IsUpdateParallelSafe() const { return updateParallelSafe_; }
+
     /// Return whether the DelayedStart() function has been called.
     bool IsDelayedStartCalled() const { return delayedStartCalled_; }
 
@@ -81,24 +91,31 @@ protected:
     void OnSceneSet(Scene* scene) override;
 
 private:
-    /// Subscribe/unsubscribe to update events based on current enabled state and update event mask.
+    /// Add to/remove from the update phases of the scene's logic update registry based on current enabled state and update event mask.
     void UpdateEventSubscription();
-    /// Handle scene update event.
-    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
-    /// Handle scene post-update event.
-    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
-#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
-    /// Handle physics pre-step event.
-    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
-    /// Handle physics post-step event.
-    void HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData);
-#endif
+    /// Remove from all update phases.
+    void RemoveFromUpdateRegistry();
+    /// Add to or remove from an update phase.
+    void SetUpdatePhase(LogicUpdatePhase phase, LogicComponentEvents flag, bool enable);
+    /// Call DelayedStart(). Stop the update calls if they were wanted only for it.
+    void CallDelayedStart();
+    /// Call the update function of a phase. Called by the logic update registry.
+    void CallUpdate(LogicUpdatePhase phase, float timeStep);
+
     /// Requested event subscription mask.
     LogicComponentEvents updateEventMask_;
     /// Current event subscription mask.
     LogicComponentEvents currentEventMask_;
     /// Flag for delayed start.
     bool delayedStartCalled_;
+    /// Parallel-safe update flag.
+    bool updateParallelSafe_;
+    /// Logic update registry the component has been added to.
+    WeakPtr<LogicUpdateRegistry> updateRegistry_;
+    /// List index in the logic update registry per update phase.
+    i32 updateList_[MAX_LOGIC_UPDATE_PHASES];
+    /// Position in the list per update phase, or NINDEX if not added.
+    i32 updateIndex_[MAX_LOGIC_UPDATE_PHASES];
 };
 
 }
@@ -0,0 +1,280 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../Precompiled.h"
+
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
+#include "../Physics/PhysicsEvents.h"
+#endif
+#include "../Scene/LogicComponent.h"
+#include "../Scene/LogicUpdateRegistry.h"
+#include "../Scene/Scene.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+template <LogicUpdatePhase Phase> static void LogicUpdateWork(const WorkItem* item, i32 /*threadIndex*/)
+{
+    auto** start = reinterpret_cast<LogicComponent**>(item->start_);
+    auto** end = reinterpret_cast<LogicComponent**>(item->end_);
+    const float timeStep = *reinterpret_cast<float*>(item->aux_);
+
+    for (LogicComponent** i = start; i != end; ++i)
+    {
+        LogicComponent* component = *i;
+        if (!component || component->GetBlockEvents())
+            continue;
+
+        if constexpr (Phase == LUP_UPDATE)
+            component->Update(timeStep);
+        else if constexpr (Phase == LUP_POSTUPDATE)
+            component->PostUpdate(timeStep);
+        else if constexpr (Phase == LUP_FIXEDUPDATE)
+            component->FixedUpdate(timeStep);
+        else
+            component->FixedPostUpdate(timeStep);
+    }
+}
+
+static void (* const logicUpdateWorkFunctions[])(const WorkItem*, i32) =
+{
+    LogicUpdateWork<LUP_UPDATE>,
+    LogicUpdateWork<LUP_POSTUPDATE>,
+    LogicUpdateWork<LUP_FIXEDUPDATE>,
+    LogicUpdateWork<LUP_FIXEDPOSTUPDATE>
+};
+
+LogicUpdateRegistry::LogicUpdateRegistry(Scene* scene) :
+    Object(scene->GetContext()),
+    scene_(scene)
+{
+}
+
+LogicUpdateRegistry::~LogicUpdateRegistry()
+{
+    // Components that still exist may be added to another scene later
+    for (i32 phase = 0; phase < MAX_LOGIC_UPDATE_PHASES; ++phase)
+    {
+        for (LogicUpdateList& list : lists_[phase])
+        {
+            for (LogicComponent* component : list.components_)
+            {
+                if (component)
+                    component->updateIndex_[phase] = NINDEX;
+            }
+        }
+    }
+}
+
+void LogicUpdateRegistry::Add(LogicComponent* component, LogicUpdatePhase phase)
+{
+    assert(component->updateIndex_[phase] == NINDEX);
+
+    const StringHash type = component->GetType();
+    const bool parallel = component->IsUpdateParallelSafe();
+    Vector<LogicUpdateList>& lists = lists_[phase];
+
+    i32 listIndex = NINDEX;
+    for (i32 i = 0; i < lists.Size(); ++i)
+    {
+        if (lists[i].type_ == type && lists[i].parallel_ == parallel)
+        {
+            listIndex = i;
+            break;
+        }
+    }
+
+    if (listIndex == NINDEX)
+    {
+        listIndex = lists.Size();
+        lists.Resize(listIndex + 1);
+        lists[listIndex].type_ = type;
+        lists[listIndex].parallel_ = parallel;
+    }
+
+    LogicUpdateList& list = lists[listIndex];
+    component->updateList_[phase] = listIndex;
+    component->updateIndex_[phase] = list.components_.Size();
+    list.components_.Push(component);
+}
+
+void LogicUpdateRegistry::Remove(LogicComponent* component, LogicUpdatePhase phase)
+{
+    const i32 index = component->updateIndex_[phase];
+    if (index == NINDEX)
+        return;
+
+    LogicUpdateList& list = lists_[phase][component->updateList_[phase]];
+    if (inUpdate_[phase])
+    {
+        list.components_[index] = nullptr;
+        list.dirty_ = true;
+    }
+    else
+    {
+        // Order within a type does not matter, so move the last component to the hole
+        LogicComponent* last = list.components_.Back();
+        list.components_[index] = last;
+        last->updateIndex_[phase] = index;
+        list.components_.Pop();
+    }
+
+    component->updateIndex_[phase] = NINDEX;
+}
+
+void LogicUpdateRegistry::Update(LogicUpdatePhase phase, float timeStep)
+{
+    if (lists_[phase].Empty())
+        return;
+
+    URHO3D_PROFILE(UpdateLogicComponents);
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    const bool threaded = queue && queue->GetNumThreads() && !scene_->IsThreadedUpdate();
+
+    ++inUpdate_[phase];
+
+    // Lists and components added during the update are updated on the next time
+    const i32 numLists = lists_[phase].Size();
+    for (i32 i = 0; i < numLists; ++i)
+    {
+        const i32 count = lists_[phase][i].components_.Size();
+        if (threaded && lists_[phase][i].parallel_ && count > 1)
+        {
+            // DelayedStart() is called in the main thread, as it may create nodes and components
+            for (i32 j = 0; j < count; ++j)
+            {
+                LogicComponent* component = lists_[phase][i].components_[j];
+                if (component && !component->IsDelayedStartCalled() && !component->GetBlockEvents() &&
+                    (phase == LUP_UPDATE || phase == LUP_FIXEDUPDATE))
+                    component->CallDelayedStart();
+            }
+
+            UpdateListThreaded(lists_[phase][i], count, phase, timeStep);
+        }
+        else
+            UpdateList(i, count, phase, timeStep);
+    }
+
+    if (--inUpdate_[phase] == 0)
+    {
+        for (LogicUpdateList& list : lists_[phase])
+        {
+            if (!list.dirty_)
+                continue;
+
+            i32 dest = 0;
+            for (i32 j = 0; j < list.components_.Size(); ++j)
+            {
+                LogicComponent* component = list.components_[j];
+                if (component)
+                {
+                    list.components_[dest] = component;
+                    component->updateIndex_[phase] = dest;
+                    ++dest;
+                }
+            }
+
+            list.components_.Resize(dest);
+            list.dirty_ = false;
+        }
+    }
+}
+
+void LogicUpdateRegistry::SetFixedUpdateSource(Component* source)
+{
+    if (source == fixedUpdateSource_.Get())
+        return;
+
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
+    if (fixedUpdateSource_)
+        UnsubscribeFromEvents(fixedUpdateSource_);
+
+    if (source)
+    {
+        SubscribeToEvent(source, E_PHYSICSPRESTEP, URHO3D_HANDLER(LogicUpdateRegistry, HandlePhysicsPreStep));
+        SubscribeToEvent(source, E_PHYSICSPOSTSTEP, URHO3D_HANDLER(LogicUpdateRegistry, HandlePhysicsPostStep));
+    }
+#endif
+
+    fixedUpdateSource_ = source;
+}
+
+i32 LogicUpdateRegistry::GetNumComponents(LogicUpdatePhase phase) const
+{
+    i32 ret = 0;
+    for (const LogicUpdateList& list : lists_[phase])
+        ret += list.components_.Size();
+    return ret;
+}
+
+void LogicUpdateRegistry::UpdateList(i32 listIndex, i32 count, LogicUpdatePhase phase, float timeStep)
+{
+    for (i32 i = 0; i < count; ++i)
+    {
+        // The list may be reallocated by the update of a component, so index it each time. Components that block events
+        // are skipped, as they did not receive the update events either
+        LogicComponent* component = lists_[phase][listIndex].components_[i];
+        if (component && !component->GetBlockEvents())
+            component->CallUpdate(phase, timeStep);
+    }
+}
+
+void LogicUpdateRegistry::UpdateListThreaded(LogicUpdateList& list, i32 count, LogicUpdatePhase phase, float timeStep)
+{
+    URHO3D_PROFILE(UpdateLogicComponentsThreaded);
+
+    auto* queue = GetSubsystem<WorkQueue>();
+    const i32 numWorkItems = queue->GetNumThreads() + 1; // Worker threads + main thread
+    const i32 componentsPerItem = Max(count / numWorkItems, 1);
+    threadedTimeStep_ = timeStep;
+
+    // Notify the scene that a threaded update is going on, so that components marked dirty defer non-threadsafe work
+    scene_->BeginThreadedUpdate();
+
+    LogicComponent** start = list.components_.Buffer();
+    LogicComponent** end = start + count;
+    for (i32 i = 0; i < numWorkItems && start != end; ++i)
+    {
+        LogicComponent** itemEnd = end;
+        if (i < numWorkItems - 1 && end - start > componentsPerItem)
+            itemEnd = start + componentsPerItem;
+
+        SharedPtr<WorkItem> item = queue->GetFreeItem();
+        item->priority_ = WI_MAX_PRIORITY;
+        item->workFunction_ = logicUpdateWorkFunctions[phase];
+        item->start_ = start;
+        item->end_ = itemEnd;
+        item->aux_ = &threadedTimeStep_;
+        queue->AddWorkItem(item);
+
+        start = itemEnd;
+    }
+
+    queue->Complete(WI_MAX_PRIORITY);
+    scene_->EndThreadedUpdate();
+}
+
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
+
+void LogicUpdateRegistry::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
+{
+    using namespace PhysicsPreStep;
+
+    Update(LUP_FIXEDUPDATE, eventData[P_TIMESTEP].GetFloat());
+}
+
+void LogicUpdateRegistry::HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData)
+{
+    using namespace PhysicsPostStep;
+
+    Update(LUP_FIXEDPOSTUPDATE, eventData[P_TIMESTEP].GetFloat());
+}
+
+#endif
+
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+/// \file
+
+#pragma once
+
+#include "../Core/Object.h"
+
+namespace Urho3D
+{
+
+class Component;
+class LogicComponent;
+class Scene;
+struct WorkItem;
+
+/// Update phase of logic components.
+enum LogicUpdatePhase
+{
+    /// Scene update, variable timestep.
+    LUP_UPDATE = 0,
+    /// Scene post-update, variable timestep.
+    LUP_POSTUPDATE,
+    /// Physics pre-step, fixed timestep.
+    LUP_FIXEDUPDATE,
+    /// Physics post-step, fixed timestep.
+    LUP_FIXEDPOSTUPDATE,
+    /// Number of phases.
+    MAX_LOGIC_UPDATE_PHASES
+};
+
+/// Logic components of one type that are updated in one phase.
+struct LogicUpdateList
+{
+    /// Component type.
+    StringHash type_;
+    /// Whether the updates may run in worker threads.
+    bool parallel_{};
+    /// Components. May contain holes during update.
+    Vector<LogicComponent*> components_;
+    /// Holes exist flag.
+    bool dirty_{};
+};
+
+/// Scene-owned registry that calls the update functions of logic components directly instead of through per-component
+/// event subscriptions. Components are stored in contiguous lists per type, and the lists of types that are marked
+/// parallel-safe are split across the work queue threads. Components that block events are skipped.
+/// @nobind
+class URHO3D_API LogicUpdateRegistry : public Object
+{
+    URHO3D_OBJECT(LogicUpdateRegistry, Object);
+
+public:
+    /// Construct.
+    explicit LogicUpdateRegistry(Scene* scene);
+    /// Destruct.
+    ~LogicUpdateRegistry() override;
+
+    /// Add a component to a phase. Must not be added twice to the same phase.
+    void Add(LogicComponent* component, LogicUpdatePhase phase);
+    /// Remove a component from a phase. Leave a hole if the phase is being updated.
+    void Remove(LogicComponent* component, LogicUpdatePhase phase);
+    /// Call the update functions of a phase. Called by the scene for the variable timestep phases and by the fixed update source for the fixed timestep phases.
+    void Update(LogicUpdatePhase phase, float timeStep);
+    /// Set the component that sends the fixed timestep events, usually a physics world. Subscribe to its events if it changed.
+    void SetFixedUpdateSource(Component* source);
+
+    /// Return number of components in a phase.
+    i32 GetNumComponents(LogicUpdatePhase phase) const;
+
+private:
+    /// Call the update functions of the first components of a list in the main thread.
+    void UpdateList(i32 listIndex, i32 count, LogicUpdatePhase phase, float timeStep);
+    /// Call the update functions of the first components of a list in the worker threads. The components must have been started already.
+    void UpdateListThreaded(LogicUpdateList& list, i32 count, LogicUpdatePhase phase, float timeStep);
+#if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
+    /// Handle the fixed timestep update of the fixed update source.
+    void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
+    /// Handle the fixed timestep post-update of the fixed update source.
+    void HandlePhysicsPostStep(StringHash eventType, VariantMap& eventData);
+#endif
+
+    /// Scene.
+    Scene* scene_;
+    /// Fixed update source.
+    WeakPtr<Component> fixedUpdateSource_;
+    /// Lists per phase.
+    Vector<LogicUpdateList> lists_[MAX_LOGIC_UPDATE_PHASES];
+    /// Update recursion counters per phase.
+    i32 inUpdate_[MAX_LOGIC_UPDATE_PHASES]{};
+    /// Timestep of the threaded update in progress.
+    float threadedTimeStep_{};
+};
+
+}
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "../Container/Allocator.h"
 #include "../IO/VectorBuffer.h"
 #include "../Math/Matrix3x4.h"
 #include "../Scene/Animatable.h"
@@ -61,6 +62,7 @@ struct URHO3D_API NodeImpl
 class URHO3D_API Node : public Animatable
 {
     URHO3D_OBJECT(Node, Animatable);
+    URHO3D_POOL_ALLOCATED();
 
     friend class Connection;
 
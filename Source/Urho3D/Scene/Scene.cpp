@@ -5,6 +5,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
+#include "../Core/TypedEvent.h"
 #include "../Core/Profiler.h"
 #include "../Core/WorkQueue.h"
 #include "../IO/File.h"
@@ -14,11 +15,14 @@
 #include "../Resource/ResourceEvents.h"
 #include "../Resource/XMLFile.h"
 #include "../Resource/JSONFile.h"
+#include "../Scene/CompiledPrefab.h"
 #include "../Scene/Component.h"
+#include "../Scene/LogicUpdateRegistry.h"
 #include "../Scene/ObjectAnimation.h"
 #include "../Scene/ReplicationState.h"
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
+#include "../Scene/SceneStreamer.h"
 #include "../Scene/SmoothedTransform.h"
 #include "../Scene/SplinePath.h"
 #include "../Scene/UnknownComponent.h"
@@ -68,9 +72,9 @@ Scene::~Scene()
     RemoveAllChildren();
 
     // Remove scene reference and owner from all nodes that still exist
-    for (HashMap<NodeId, Node*>::Iterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
+    for (FlatHashMap<NodeId, Node*>::Iterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
         i->second_->ResetScene();
-    for (HashMap<NodeId, Node*>::Iterator i = localNodes_.Begin(); i != localNodes_.End(); ++i)
+    for (FlatHashMap<NodeId, Node*>::Iterator i = localNodes_.Begin(); i != localNodes_.End(); ++i)
         i->second_->ResetScene();
 }
 
@@ -191,7 +195,7 @@ void Scene::AddReplicationState(NodeReplicationState* state)
     Node::AddReplicationState(state);
 
     // This is the first update for a new connection. Mark all replicated nodes dirty
-    for (HashMap<NodeId, Node*>::ConstIterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
+    for (FlatHashMap<NodeId, Node*>::ConstIterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
         state->sceneState_->dirtyNodes_.Insert(i->first_);
 }
 
@@ -529,6 +533,17 @@ Node* Scene::Instantiate(Deserializer& source, const Vector3& position, const Qu
     }
 }
 
+Node* Scene::Instantiate(CompiledPrefab* prefab, const Vector3& position, const Quaternion& rotation, CreateMode mode)
+{
+    if (!prefab)
+    {
+        URHO3D_LOGERROR("Null compiled prefab for instantiation");
+        return nullptr;
+    }
+
+    return prefab->Instantiate(this, position, rotation, mode);
+}
+
 Node* Scene::InstantiateXML(const XMLElement& source, const Vector3& position, const Quaternion& rotation, CreateMode mode)
 {
     URHO3D_PROFILE(InstantiateXML);
@@ -688,12 +703,12 @@ Node* Scene::GetNode(NodeId id) const
 {
     if (IsReplicatedID(id))
     {
-        HashMap<NodeId, Node*>::ConstIterator i = replicatedNodes_.Find(id);
+        FlatHashMap<NodeId, Node*>::ConstIterator i = replicatedNodes_.Find(id);
         return i != replicatedNodes_.End() ? i->second_ : nullptr;
     }
     else
     {
-        HashMap<NodeId, Node*>::ConstIterator i = localNodes_.Find(id);
+        FlatHashMap<NodeId, Node*>::ConstIterator i = localNodes_.Find(id);
         return i != localNodes_.End() ? i->second_ : nullptr;
     }
 }
@@ -715,12 +730,12 @@ Component* Scene::GetComponent(ComponentId id) const
 {
     if (IsReplicatedID(id))
     {
-        HashMap<ComponentId, Component*>::ConstIterator i = replicatedComponents_.Find(id);
+        FlatHashMap<ComponentId, Component*>::ConstIterator i = replicatedComponents_.Find(id);
         return i != replicatedComponents_.End() ? i->second_ : nullptr;
     }
     else
     {
-        HashMap<ComponentId, Component*>::ConstIterator i = localComponents_.Find(id);
+        FlatHashMap<ComponentId, Component*>::ConstIterator i = localComponents_.Find(id);
         return i != localComponents_.End() ? i->second_ : nullptr;
     }
 }
@@ -754,13 +769,18 @@ void Scene::Update(float timeStep)
 
     using namespace SceneUpdate;
 
+    // Update variable timestep logic
+    SceneUpdateEvent sceneUpdate{this, timeStep};
+    SendTypedEvent(sceneUpdate);
+
+    // Update logic components
+    if (logicUpdateRegistry_)
+        logicUpdateRegistry_->Update(LUP_UPDATE, timeStep);
+
     VariantMap& eventData = GetEventDataMap();
     eventData[P_SCENE] = this;
     eventData[P_TIMESTEP] = timeStep;
 
-    // Update variable timestep logic
-    SendEvent(E_SCENEUPDATE, eventData);
-
     // Update scene attribute animation.
     SendEvent(E_ATTRIBUTEANIMATIONUPDATE, eventData);
 
@@ -782,7 +802,11 @@ void Scene::Update(float timeStep)
     }
 
     // Post-update variable timestep logic
-    SendEvent(E_SCENEPOSTUPDATE, eventData);
+    ScenePostUpdateEvent scenePostUpdate{this, timeStep};
+    SendTypedEvent(scenePostUpdate);
+
+    if (logicUpdateRegistry_)
+        logicUpdateRegistry_->Update(LUP_POSTUPDATE, timeStep);
 
     // Note: using a float for elapsed time accumulation is inherently inaccurate. The purpose of this value is
     // primarily to update material animation effects, as it is available to shaders. It can be reset by calling
@@ -790,6 +814,14 @@ void Scene::Update(float timeStep)
     elapsedTime_ += timeStep;
 }
 
+LogicUpdateRegistry* Scene::GetLogicUpdateRegistry()
+{
+    if (!logicUpdateRegistry_)
+        logicUpdateRegistry_ = new LogicUpdateRegistry(this);
+
+    return logicUpdateRegistry_;
+}
+
 void Scene::BeginThreadedUpdate()
 {
     // Check the work queue subsystem whether it actually has created worker threads. If not, do not enter threaded mode.
@@ -907,7 +939,7 @@ void Scene::NodeAdded(Node* node)
     // If node with same ID exists, remove the scene reference from it and overwrite with the new node
     if (IsReplicatedID(id))
     {
-        HashMap<NodeId, Node*>::Iterator i = replicatedNodes_.Find(id);
+        FlatHashMap<NodeId, Node*>::Iterator i = replicatedNodes_.Find(id);
         if (i != replicatedNodes_.End() && i->second_ != node)
         {
             URHO3D_LOGWARNING("Overwriting node with ID " + String(id));
@@ -921,7 +953,7 @@ void Scene::NodeAdded(Node* node)
     }
     else
     {
-        HashMap<NodeId, Node*>::Iterator i = localNodes_.Find(id);
+        FlatHashMap<NodeId, Node*>::Iterator i = localNodes_.Find(id);
         if (i != localNodes_.End() && i->second_ != node)
         {
             URHO3D_LOGWARNING("Overwriting node with ID " + String(id));
@@ -1006,7 +1038,7 @@ void Scene::ComponentAdded(Component* component)
 
     if (IsReplicatedID(id))
     {
-        HashMap<ComponentId, Component*>::Iterator i = replicatedComponents_.Find(id);
+        FlatHashMap<ComponentId, Component*>::Iterator i = replicatedComponents_.Find(id);
         if (i != replicatedComponents_.End() && i->second_ != component)
         {
             URHO3D_LOGWARNING("Overwriting component with ID " + String(id));
@@ -1017,7 +1049,7 @@ void Scene::ComponentAdded(Component* component)
     }
     else
     {
-        HashMap<ComponentId, Component*>::Iterator i = localComponents_.Find(id);
+        FlatHashMap<ComponentId, Component*>::Iterator i = localComponents_.Find(id);
         if (i != localComponents_.End() && i->second_ != component)
         {
             URHO3D_LOGWARNING("Overwriting component with ID " + String(id));
@@ -1093,10 +1125,10 @@ void Scene::CleanupConnection(Connection* connection)
 {
     Node::CleanupConnection(connection);
 
-    for (HashMap<NodeId, Node*>::Iterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
+    for (FlatHashMap<NodeId, Node*>::Iterator i = replicatedNodes_.Begin(); i != replicatedNodes_.End(); ++i)
         i->second_->CleanupConnection(connection);
 
-    for (HashMap<ComponentId, Component*>::Iterator i = replicatedComponents_.Begin(); i != replicatedComponents_.End(); ++i)
+    for (FlatHashMap<ComponentId, Component*>::Iterator i = replicatedComponents_.Begin(); i != replicatedComponents_.End(); ++i)
         i->second_->CleanupConnection(connection);
 }
 
@@ -1508,6 +1540,18 @@ void Scene::PreloadResourcesJSON(const JSONValue& value)
 #endif
 }
 
+void SceneUpdateEvent::ToEventData(VariantMap& eventData) const
+{
+    eventData[SceneUpdate::P_SCENE] = scene_;
+    eventData[SceneUpdate::P_TIMESTEP] = timeStep_;
+}
+
+void ScenePostUpdateEvent::ToEventData(VariantMap& eventData) const
+{
+    eventData[ScenePostUpdate::P_SCENE] = scene_;
+    eventData[ScenePostUpdate::P_TIMESTEP] = timeStep_;
+}
+
 void RegisterSceneLibrary(Context* context)
 {
     ValueAnimation::RegisterObject(context);
@@ -1517,6 +1561,9 @@ void RegisterSceneLibrary(Context* context)
     SmoothedTransform::RegisterObject(context);
     UnknownComponent::RegisterObject(context);
     SplinePath::RegisterObject(context);
+    SceneCell::RegisterObject(context);
+    CompiledPrefab::RegisterObject(context);
+    SceneStreamer::RegisterObject(context);
 }
 
 }
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "../Container/FlatHashMap.h"
 #include "../Container/HashSet.h"
 #include "../Core/Mutex.h"
 #include "../Resource/XMLElement.h"
@@ -15,7 +16,9 @@
 namespace Urho3D
 {
 
+class CompiledPrefab;
 class File;
+class LogicUpdateRegistry;
 class PackageFile;
 
 inline constexpr id32 FIRST_REPLICATED_ID = 0x1;
@@ -116,6 +119,8 @@ public:
     void StopAsyncLoading();
     /// Instantiate scene content from binary data. Return root node if successful.
     Node* Instantiate(Deserializer& source, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED);
+    /// Instantiate a compiled prefab. Faster than instantiating from binary data when spawning the same prefab repeatedly. Return root node if successful.
+    Node* Instantiate(CompiledPrefab* prefab, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED);
     /// Instantiate scene content from XML data. Return root node if successful.
     Node* InstantiateXML
         (const XMLElement& source, const Vector3& position, const Quaternion& rotation, CreateMode mode = REPLICATED);
@@ -228,6 +233,10 @@ public:
     /// Return threaded update flag.
     bool IsThreadedUpdate() const { return threadedUpdate_; }
 
+    /// Return the registry that calls the update functions of the logic components. Create if not created yet.
+    /// @nobind
+    LogicUpdateRegistry* GetLogicUpdateRegistry();
+
     /// Get free node ID, either non-local or local.
     NodeId GetFreeNodeID(CreateMode mode);
     /// Get free component ID, either non-local or local.
@@ -285,13 +294,13 @@ private:
     void PreloadResourcesJSON(const JSONValue& value);
 
     /// Replicated scene nodes by ID.
-    HashMap<NodeId, Node*> replicatedNodes_;
+    FlatHashMap<NodeId, Node*> replicatedNodes_;
     /// Local scene nodes by ID.
-    HashMap<NodeId, Node*> localNodes_;
+    FlatHashMap<NodeId, Node*> localNodes_;
     /// Replicated components by ID.
-    HashMap<ComponentId, Component*> replicatedComponents_;
+    FlatHashMap<ComponentId, Component*> replicatedComponents_;
     /// Local components by ID.
-    HashMap<ComponentId, Component*> localComponents_;
+    FlatHashMap<ComponentId, Component*> localComponents_;
     /// Cached tagged nodes by tag.
     HashMap<StringHash, Vector<Node*>> taggedNodes_;
     /// Asynchronous loading progress.
@@ -308,6 +317,8 @@ private:
     HashSet<NodeId> networkUpdateNodes_;
     /// Components to check for attribute changes on the next network update.
     HashSet<ComponentId> networkUpdateComponents_;
+    /// Logic component update registry.
+    SharedPtr<LogicUpdateRegistry> logicUpdateRegistry_;
     /// Delayed dirty notification queue for components.
     Vector<Component*> delayedDirtyComponents_;
     /// Mutex for the delayed dirty notification queue.
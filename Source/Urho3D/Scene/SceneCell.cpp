@@ -0,0 +1,141 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../IO/VectorBuffer.h"
+#include "../Resource/ResourceCache.h"
+#include "../Scene/Node.h"
+#include "../Scene/SceneCell.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+SceneCell::SceneCell(Context* context) :
+    Resource(context)
+{
+}
+
+SceneCell::~SceneCell() = default;
+
+void SceneCell::RegisterObject(Context* context)
+{
+    context->RegisterFactory<SceneCell>();
+}
+
+bool SceneCell::BeginLoad(Deserializer& source)
+{
+    i32 dataSize = (i32)(source.GetSize() - source.GetPosition());
+    if (!dataSize)
+    {
+        URHO3D_LOGERROR("Zero sized scene cell data in " + source.GetName());
+        return false;
+    }
+
+    data_.Resize(dataSize);
+    if (source.Read(&data_[0], dataSize) != dataSize)
+        return false;
+
+    // If async loading, scan the node data for resource references and request them to be loaded as dependencies,
+    // so that instantiating the cell later does not need to load anything synchronously
+    if (GetAsyncLoadState() == ASYNC_LOADING)
+    {
+        MemoryBuffer buffer(data_);
+        PreloadResources(buffer);
+    }
+
+    SetMemoryUse(dataSize);
+    return true;
+}
+
+bool SceneCell::Save(Serializer& dest) const
+{
+    if (data_.Empty())
+    {
+        URHO3D_LOGERROR("Can not save empty scene cell");
+        return false;
+    }
+
+    return dest.Write(&data_[0], data_.Size()) == data_.Size();
+}
+
+bool SceneCell::SetNode(Node* node)
+{
+    if (!node)
+    {
+        URHO3D_LOGERROR("Null node for scene cell");
+        return false;
+    }
+
+    VectorBuffer buffer;
+    if (!node->Save(buffer))
+        return false;
+
+    data_ = buffer.GetBuffer();
+    SetMemoryUse(data_.Size());
+    return true;
+}
+
+void SceneCell::PreloadResources(Deserializer& source)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+
+    // Read node ID (not needed)
+    /*NodeId nodeID = */source.ReadU32();
+
+    // Read node attributes; these do not include any resources
+    const Vector<AttributeInfo>* attributes = context_->GetAttributes(Node::GetTypeStatic());
+    assert(attributes);
+
+    for (const AttributeInfo& attr : *attributes)
+    {
+        if (!(attr.mode_ & AM_FILE) || (attr.mode_ & AM_FILEREADONLY) == AM_FILEREADONLY)
+            continue;
+        /*Variant varValue = */source.ReadVariant(attr.type_);
+    }
+
+    // Read component attributes
+    unsigned numComponents = source.ReadVLE();
+    for (unsigned i = 0; i < numComponents; ++i)
+    {
+        VectorBuffer compBuffer(source, source.ReadVLE());
+        StringHash compType = compBuffer.ReadStringHash();
+        // Read component ID (not needed)
+        /*ComponentId compID = */compBuffer.ReadU32();
+
+        attributes = context_->GetAttributes(compType);
+        if (!attributes)
+            continue;
+
+        for (const AttributeInfo& attr : *attributes)
+        {
+            if (!(attr.mode_ & AM_FILE) || (attr.mode_ & AM_FILEREADONLY) == AM_FILEREADONLY)
+                continue;
+
+            Variant varValue = compBuffer.ReadVariant(attr.type_);
+            if (attr.type_ == VAR_RESOURCEREF)
+            {
+                const ResourceRef& ref = varValue.GetResourceRef();
+                cache->BackgroundLoadResource(ref.type_, ref.name_, true, this);
+            }
+            else if (attr.type_ == VAR_RESOURCEREFLIST)
+            {
+                const ResourceRefList& refList = varValue.GetResourceRefList();
+                for (const String& name : refList.names_)
+                    cache->BackgroundLoadResource(refList.type_, name, true, this);
+            }
+        }
+    }
+
+    // Read child nodes
+    unsigned numChildren = source.ReadVLE();
+    for (unsigned i = 0; i < numChildren; ++i)
+        PreloadResources(source);
+}
+
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+/// \file
+
+#pragma once
+
+#include "../Resource/Resource.h"
+
+namespace Urho3D
+{
+
+class Node;
+
+/// World partition cell resource. Holds a node hierarchy in the binary prefab format written by Node::Save().
+/// When background loaded, the resources referred to by the node attributes are queued as dependencies, so the cell
+/// finishes loading only after everything needed to instantiate it is in the resource cache.
+class URHO3D_API SceneCell : public Resource
+{
+    URHO3D_OBJECT(SceneCell, Resource);
+
+public:
+    /// Construct.
+    explicit SceneCell(Context* context);
+    /// Destruct.
+    ~SceneCell() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Load resource from stream. May be called from a worker thread. Return true if successful.
+    bool BeginLoad(Deserializer& source) override;
+    /// Save resource. Return true if successful.
+    bool Save(Serializer& dest) const override;
+
+    /// Set cell content from a node and its children. Return true if successful.
+    bool SetNode(Node* node);
+
+    /// Return the binary node data.
+    const Vector<byte>& GetData() const { return data_; }
+
+private:
+    /// Queue background loading of the resources referred to by a node, its components and child nodes.
+    void PreloadResources(Deserializer& source);
+
+    /// Binary node data.
+    Vector<byte> data_;
+};
+
+}
@@ -8,6 +8,8 @@
 namespace Urho3D
 {
 
+class Scene;
+
 /// Variable timestep scene update.
 URHO3D_EVENT(E_SCENEUPDATE, SceneUpdate)
 {
@@ -74,6 +76,36 @@ URHO3D_EVENT(E_SCENEPOSTUPDATE, ScenePostUpdate)
     URHO3D_PARAM(P_TIMESTEP, TimeStep);            // float
 }
 
+/// Typed version of E_SCENEUPDATE, sent without a VariantMap to SubscribeToTypedEvent() subscribers.
+/// @nobind
+struct URHO3D_API SceneUpdateEvent
+{
+    URHO3D_TYPED_EVENT_BRIDGE(SceneUpdateEvent, E_SCENEUPDATE)
+
+    /// Fill the parameters of E_SCENEUPDATE.
+    void ToEventData(VariantMap& eventData) const;
+
+    /// Scene.
+    Scene* scene_;
+    /// Timestep.
+    float timeStep_;
+};
+
+/// Typed version of E_SCENEPOSTUPDATE.
+/// @nobind
+struct URHO3D_API ScenePostUpdateEvent
+{
+    URHO3D_TYPED_EVENT_BRIDGE(ScenePostUpdateEvent, E_SCENEPOSTUPDATE)
+
+    /// Fill the parameters of E_SCENEPOSTUPDATE.
+    void ToEventData(VariantMap& eventData) const;
+
+    /// Scene.
+    Scene* scene_;
+    /// Timestep.
+    float timeStep_;
+};
+
 /// Asynchronous scene loading progress.
 URHO3D_EVENT(E_ASYNCLOADPROGRESS, AsyncLoadProgress)
 {
@@ -183,6 +215,22 @@ URHO3D_EVENT(E_COMPONENTCLONED, ComponentCloned)
     URHO3D_PARAM(P_CLONECOMPONENT, CloneComponent); // Component pointer
 }
 
+/// A world partition cell has been instantiated by SceneStreamer.
+URHO3D_EVENT(E_SCENECELLLOADED, SceneCellLoaded)
+{
+    URHO3D_PARAM(P_SCENE, Scene);                  // Scene pointer
+    URHO3D_PARAM(P_NODE, Node);                    // Node pointer (cell root)
+    URHO3D_PARAM(P_CELL, Cell);                    // IntVector2
+}
+
+/// A world partition cell is about to be removed by SceneStreamer.
+URHO3D_EVENT(E_SCENECELLUNLOADED, SceneCellUnloaded)
+{
+    URHO3D_PARAM(P_SCENE, Scene);                  // Scene pointer
+    URHO3D_PARAM(P_NODE, Node);                    // Node pointer (cell root)
+    URHO3D_PARAM(P_CELL, Cell);                    // IntVector2
+}
+
 /// A network attribute update from the server has been intercepted.
 URHO3D_EVENT(E_INTERCEPTNETWORKUPDATE, InterceptNetworkUpdate)
 {
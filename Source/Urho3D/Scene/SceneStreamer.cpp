@@ -0,0 +1,409 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../Resource/ResourceCache.h"
+#include "../Resource/ResourceEvents.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+#include "../Scene/SceneStreamer.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+extern const char* SUBSYSTEM_CATEGORY;
+
+static const float DEFAULT_CELL_SIZE = 64.0f;
+static const float DEFAULT_LOAD_RADIUS = 128.0f;
+static const float DEFAULT_UNLOAD_RADIUS = 160.0f;
+static const int DEFAULT_INSTANTIATE_BUDGET_MS = 2;
+static const char* DEFAULT_CELL_PREFIX = "Cells/";
+
+static const char* createModeNames[] =
+{
+    "Replicated",
+    "Local",
+    nullptr
+};
+
+SceneStreamer::SceneStreamer(Context* context) :
+    Component(context),
+    cellPrefix_(DEFAULT_CELL_PREFIX),
+    cellSize_(DEFAULT_CELL_SIZE),
+    loadRadius_(DEFAULT_LOAD_RADIUS),
+    unloadRadius_(DEFAULT_UNLOAD_RADIUS),
+    instantiateBudgetMs_(DEFAULT_INSTANTIATE_BUDGET_MS),
+    createMode_(LOCAL)
+{
+    SubscribeToEvent(E_RESOURCEBACKGROUNDLOADED, URHO3D_HANDLER(SceneStreamer, HandleResourceBackgroundLoaded));
+}
+
+SceneStreamer::~SceneStreamer() = default;
+
+void SceneStreamer::RegisterObject(Context* context)
+{
+    context->RegisterFactory<SceneStreamer>(SUBSYSTEM_CATEGORY);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cell Prefix", GetCellPrefix, SetCellPrefix, String(DEFAULT_CELL_PREFIX), AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Cell Size", GetCellSize, SetCellSize, DEFAULT_CELL_SIZE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Load Radius", GetLoadRadius, SetLoadRadius, DEFAULT_LOAD_RADIUS, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Unload Radius", GetUnloadRadius, SetUnloadRadius, DEFAULT_UNLOAD_RADIUS, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Instantiate Budget Ms", GetInstantiateBudgetMs, SetInstantiateBudgetMs,
+        DEFAULT_INSTANTIATE_BUDGET_MS, AM_DEFAULT);
+    URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Create Mode", GetCreateMode, SetCreateMode, createModeNames, LOCAL, AM_DEFAULT);
+}
+
+void SceneStreamer::OnSetEnabled()
+{
+    Scene* scene = GetScene();
+    if (scene)
+    {
+        if (IsEnabledEffective())
+            SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(SceneStreamer, HandleSceneUpdate));
+        else
+            UnsubscribeFromEvent(scene, E_SCENEUPDATE);
+    }
+}
+
+void SceneStreamer::SetFocusNode(Node* node)
+{
+    focusNode_ = node;
+}
+
+void SceneStreamer::SetCellSize(float size)
+{
+    size = Max(size, M_EPSILON);
+    if (size != cellSize_)
+    {
+        // Cell layout changes, so everything streamed so far is invalid
+        UnloadAllCells();
+        missingCells_.Clear();
+        cellSize_ = size;
+    }
+}
+
+void SceneStreamer::SetLoadRadius(float radius)
+{
+    loadRadius_ = Max(radius, 0.0f);
+    unloadRadius_ = Max(unloadRadius_, loadRadius_);
+}
+
+void SceneStreamer::SetUnloadRadius(float radius)
+{
+    unloadRadius_ = Max(radius, loadRadius_);
+}
+
+void SceneStreamer::SetCellPrefix(const String& prefix)
+{
+    if (prefix != cellPrefix_)
+    {
+        UnloadAllCells();
+        missingCells_.Clear();
+        cellPrefix_ = prefix;
+    }
+}
+
+void SceneStreamer::SetInstantiateBudgetMs(int ms)
+{
+    instantiateBudgetMs_ = Max(ms, 1);
+}
+
+void SceneStreamer::SetCreateMode(CreateMode mode)
+{
+    createMode_ = mode;
+}
+
+void SceneStreamer::Update()
+{
+    if (!focusNode_ || !GetScene())
+        return;
+
+    URHO3D_PROFILE(UpdateSceneStreaming);
+
+    Vector3 position = focusNode_->GetWorldPosition();
+    UnloadDistantCells(position);
+    RequestCells(position);
+    InstantiateCells(position);
+}
+
+void SceneStreamer::UnloadAllCells()
+{
+    for (HashMap<IntVector2, StreamedCell>::Iterator i = cells_.Begin(); i != cells_.End(); ++i)
+        UnloadCell(i->first_, i->second_);
+
+    cells_.Clear();
+}
+
+IntVector2 SceneStreamer::GetCellCoords(const Vector3& position) const
+{
+    return IntVector2(FloorToInt(position.x_ / cellSize_), FloorToInt(position.z_ / cellSize_));
+}
+
+String SceneStreamer::GetCellFileName(const IntVector2& cell) const
+{
+    return cellPrefix_ + String(cell.x_) + "_" + String(cell.y_) + ".bin";
+}
+
+Node* SceneStreamer::GetCellNode(const IntVector2& cell) const
+{
+    HashMap<IntVector2, StreamedCell>::ConstIterator i = cells_.Find(cell);
+    return i != cells_.End() ? i->second_.node_.Get() : nullptr;
+}
+
+i32 SceneStreamer::GetNumInstantiatedCells() const
+{
+    i32 ret = 0;
+    for (HashMap<IntVector2, StreamedCell>::ConstIterator i = cells_.Begin(); i != cells_.End(); ++i)
+    {
+        if (i->second_.state_ == CELL_INSTANTIATED)
+            ++ret;
+    }
+
+    return ret;
+}
+
+i32 SceneStreamer::GetNumPendingCells() const
+{
+    return cells_.Size() - GetNumInstantiatedCells();
+}
+
+void SceneStreamer::OnSceneSet(Scene* scene)
+{
+    if (scene && IsEnabledEffective())
+        SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(SceneStreamer, HandleSceneUpdate));
+    else if (!scene)
+    {
+        UnsubscribeFromEvent(E_SCENEUPDATE);
+        // The cell nodes are owned by the scene; just forget about them. The loaded cells are not needed anymore
+        for (HashMap<IntVector2, StreamedCell>::Iterator i = cells_.Begin(); i != cells_.End(); ++i)
+            ReleaseCellResource(i->second_);
+        cells_.Clear();
+        missingCells_.Clear();
+    }
+}
+
+void SceneStreamer::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+{
+    Update();
+}
+
+void SceneStreamer::HandleResourceBackgroundLoaded(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ResourceBackgroundLoaded;
+
+    auto* resource = static_cast<Resource*>(eventData[P_RESOURCE].GetPtr());
+    if (!resource || resource->GetType() != SceneCell::GetTypeStatic())
+        return;
+
+    for (HashMap<IntVector2, StreamedCell>::Iterator i = cells_.Begin(); i != cells_.End(); ++i)
+    {
+        StreamedCell& cell = i->second_;
+        if (cell.state_ != CELL_LOADING || cell.fileName_ != resource->GetName())
+            continue;
+
+        if (eventData[P_SUCCESS].GetBool())
+        {
+            cell.resource_ = static_cast<SceneCell*>(resource);
+            cell.state_ = CELL_READY;
+        }
+        else
+        {
+            // Do not retry a broken cell file
+            missingCells_.Insert(i->first_);
+            cells_.Erase(i);
+        }
+        return;
+    }
+
+    // The cell went out of range while loading, free the memory
+    if (resource->GetName().StartsWith(cellPrefix_))
+        ReleaseCellFile(resource->GetName());
+}
+
+float SceneStreamer::GetCellDistance(const IntVector2& cell, const Vector3& position) const
+{
+    float minX = cell.x_ * cellSize_;
+    float minZ = cell.y_ * cellSize_;
+    float dx = Max(Max(minX - position.x_, position.x_ - (minX + cellSize_)), 0.0f);
+    float dz = Max(Max(minZ - position.z_, position.z_ - (minZ + cellSize_)), 0.0f);
+    return sqrtf(dx * dx + dz * dz);
+}
+
+void SceneStreamer::RequestCells(const Vector3& position)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+
+    IntVector2 minCell = GetCellCoords(position - Vector3(loadRadius_, 0.0f, loadRadius_));
+    IntVector2 maxCell = GetCellCoords(position + Vector3(loadRadius_, 0.0f, loadRadius_));
+
+    for (int z = minCell.y_; z <= maxCell.y_; ++z)
+    {
+        for (int x = minCell.x_; x <= maxCell.x_; ++x)
+        {
+            IntVector2 coords(x, z);
+            if (cells_.Contains(coords) || missingCells_.Contains(coords))
+                continue;
+            float distance = GetCellDistance(coords, position);
+            if (distance > loadRadius_)
+                continue;
+
+            String fileName = GetCellFileName(coords);
+            if (!cache->Exists(fileName))
+            {
+                missingCells_.Insert(coords);
+                continue;
+            }
+
+            StreamedCell& cell = cells_[coords];
+            cell.fileName_ = fileName;
+            // Nearer cells are loaded first
+            cache->BackgroundLoadResource<SceneCell>(fileName, true, nullptr, -(i32)(distance / cellSize_));
+            // Without threading support, or if the cell was already in the cache, the resource is available immediately
+            cell.resource_ = cache->GetExistingResource<SceneCell>(fileName);
+            cell.state_ = cell.resource_ ? CELL_READY : CELL_LOADING;
+        }
+    }
+}
+
+void SceneStreamer::UnloadDistantCells(const Vector3& position)
+{
+    for (HashMap<IntVector2, StreamedCell>::Iterator i = cells_.Begin(); i != cells_.End();)
+    {
+        StreamedCell& cell = i->second_;
+        // The cell content may also have been removed by other means, in which case it can be requested again
+        bool removed = cell.state_ == CELL_INSTANTIATED && !cell.node_;
+        if (removed || GetCellDistance(i->first_, position) > unloadRadius_)
+        {
+            UnloadCell(i->first_, cell);
+            i = cells_.Erase(i);
+        }
+        else
+            ++i;
+    }
+}
+
+void SceneStreamer::InstantiateCells(const Vector3& position)
+{
+    HiresTimer budgetTimer;
+
+    for (;;)
+    {
+        // Instantiate the nearest cell first
+        HashMap<IntVector2, StreamedCell>::Iterator nearest = cells_.End();
+        float nearestDistance = M_INFINITY;
+        for (HashMap<IntVector2, StreamedCell>::Iterator i = cells_.Begin(); i != cells_.End(); ++i)
+        {
+            if (i->second_.state_ != CELL_READY)
+                continue;
+
+            float distance = GetCellDistance(i->first_, position);
+            if (distance < nearestDistance)
+            {
+                nearest = i;
+                nearestDistance = distance;
+            }
+        }
+
+        if (nearest == cells_.End())
+            break;
+
+        if (!InstantiateCell(nearest->first_, nearest->second_))
+        {
+            missingCells_.Insert(nearest->first_);
+            cells_.Erase(nearest);
+        }
+
+        // Break if time limit exceeded, so that we keep sufficient FPS
+        if (budgetTimer.GetUSec(false) >= instantiateBudgetMs_ * 1000LL)
+            break;
+    }
+}
+
+bool SceneStreamer::InstantiateCell(const IntVector2& coords, StreamedCell& cell)
+{
+    URHO3D_PROFILE(InstantiateSceneCell);
+
+    Scene* scene = GetScene();
+    MemoryBuffer source(cell.resource_->GetData());
+
+    SceneResolver resolver;
+    NodeId nodeID = source.ReadU32();
+    // Rewrite IDs when instantiating, the same cell may be streamed in many times
+    Node* node = scene->CreateChild(String::EMPTY, createMode_);
+    resolver.AddNode(nodeID, node);
+    bool success = node->Load(source, resolver, true, true, createMode_);
+
+    // The cell data is not needed after instantiation
+    cell.resource_.Reset();
+    ReleaseCellFile(cell.fileName_);
+
+    if (!success)
+    {
+        URHO3D_LOGERROR("Failed to instantiate scene cell " + cell.fileName_);
+        node->Remove();
+        return false;
+    }
+
+    resolver.Resolve();
+    node->ApplyAttributes();
+    // Streamed content is stored in the cell files, so it is not saved with the scene
+    node->SetTemporary(true);
+
+    cell.node_ = node;
+    cell.state_ = CELL_INSTANTIATED;
+
+    using namespace SceneCellLoaded;
+
+    VariantMap& eventData = GetEventDataMap();
+    eventData[P_SCENE] = scene;
+    eventData[P_NODE] = node;
+    eventData[P_CELL] = coords;
+    SendEvent(E_SCENECELLLOADED, eventData);
+
+    return true;
+}
+
+void SceneStreamer::UnloadCell(const IntVector2& coords, StreamedCell& cell)
+{
+    if (cell.node_)
+    {
+        using namespace SceneCellUnloaded;
+
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_SCENE] = GetScene();
+        eventData[P_NODE] = cell.node_.Get();
+        eventData[P_CELL] = coords;
+        SendEvent(E_SCENECELLUNLOADED, eventData);
+
+        if (cell.node_)
+            cell.node_->Remove();
+    }
+
+    ReleaseCellResource(cell);
+}
+
+void SceneStreamer::ReleaseCellResource(StreamedCell& cell)
+{
+    // A cell still loading is released when its background load finishes
+    if (cell.state_ == CELL_READY)
+    {
+        cell.resource_.Reset();
+        ReleaseCellFile(cell.fileName_);
+    }
+}
+
+void SceneStreamer::ReleaseCellFile(const String& fileName)
+{
+    // Force, as the event data of the finished background load still refers to the cell weakly, which would keep it
+    GetSubsystem<ResourceCache>()->ReleaseResource<SceneCell>(fileName, true);
+}
+
+}
@@ -0,0 +1,170 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+/// \file
+
+#pragma once
+
+#include "../Container/HashSet.h"
+#include "../Scene/Component.h"
+#include "../Scene/SceneCell.h"
+
+namespace Urho3D
+{
+
+/// Streaming state of a world partition cell.
+enum CellStreamState
+{
+    /// Cell resource is being background loaded.
+    CELL_LOADING = 0,
+    /// Cell resource and its dependencies are loaded, waiting for instantiation.
+    CELL_READY,
+    /// Cell content has been instantiated into the scene.
+    CELL_INSTANTIATED
+};
+
+/// Book-keeping for one streamed world partition cell.
+struct StreamedCell
+{
+    /// Cell resource name.
+    String fileName_;
+    /// Cell resource, held until instantiated.
+    SharedPtr<SceneCell> resource_;
+    /// Instantiated root node of the cell.
+    WeakPtr<Node> node_;
+    /// Streaming state.
+    CellStreamState state_;
+};
+
+/// World partition component. Divides the XZ plane into square cells and streams cell files in and out of the scene
+/// around a focus node. Should be added only to the root scene node.
+class URHO3D_API SceneStreamer : public Component
+{
+    URHO3D_OBJECT(SceneStreamer, Component);
+
+public:
+    /// Construct.
+    explicit SceneStreamer(Context* context);
+    /// Destruct.
+    ~SceneStreamer() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Handle enabled/disabled state change.
+    void OnSetEnabled() override;
+
+    /// Set the node around which cells are streamed, usually the player or the camera.
+    /// @property
+    void SetFocusNode(Node* node);
+    /// Set cell edge length in world units.
+    /// @property
+    void SetCellSize(float size);
+    /// Set distance from the focus node within which cells are loaded.
+    /// @property
+    void SetLoadRadius(float radius);
+    /// Set distance from the focus node beyond which cells are unloaded. Clamped to be at least the load radius.
+    /// @property
+    void SetUnloadRadius(float radius);
+    /// Set resource name prefix of the cell files. Cell (x, z) is loaded from prefix + "x_z.bin".
+    /// @property
+    void SetCellPrefix(const String& prefix);
+    /// Set maximum milliseconds per frame to spend on instantiating cells. At least one cell is instantiated per frame.
+    /// @property
+    void SetInstantiateBudgetMs(int ms);
+    /// Set whether cell content is created as replicated or local nodes and components.
+    /// @property
+    void SetCreateMode(CreateMode mode);
+    /// Update streaming: request, instantiate and unload cells as necessary. Called on scene update.
+    void Update();
+    /// Remove all instantiated cells from the scene and cancel pending loads.
+    void UnloadAllCells();
+
+    /// Return focus node.
+    /// @property
+    Node* GetFocusNode() const { return focusNode_; }
+
+    /// Return cell edge length.
+    /// @property
+    float GetCellSize() const { return cellSize_; }
+
+    /// Return load radius.
+    /// @property
+    float GetLoadRadius() const { return loadRadius_; }
+
+    /// Return unload radius.
+    /// @property
+    float GetUnloadRadius() const { return unloadRadius_; }
+
+    /// Return cell file resource name prefix.
+    /// @property
+    const String& GetCellPrefix() const { return cellPrefix_; }
+
+    /// Return maximum milliseconds per frame to spend on instantiating cells.
+    /// @property
+    int GetInstantiateBudgetMs() const { return instantiateBudgetMs_; }
+
+    /// Return create mode of cell content.
+    /// @property
+    CreateMode GetCreateMode() const { return createMode_; }
+
+    /// Return cell coordinates containing a world position.
+    IntVector2 GetCellCoords(const Vector3& position) const;
+    /// Return resource name of a cell file.
+    String GetCellFileName(const IntVector2& cell) const;
+    /// Return instantiated root node of a cell, or null if not instantiated.
+    Node* GetCellNode(const IntVector2& cell) const;
+    /// Return number of cells currently instantiated.
+    /// @property
+    i32 GetNumInstantiatedCells() const;
+    /// Return number of cells loading or waiting for instantiation.
+    /// @property
+    i32 GetNumPendingCells() const;
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    /// Handle scene update event.
+    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle a background loaded resource completing.
+    void HandleResourceBackgroundLoaded(StringHash eventType, VariantMap& eventData);
+    /// Return distance on the XZ plane from a world position to the nearest point of a cell.
+    float GetCellDistance(const IntVector2& cell, const Vector3& position) const;
+    /// Queue loading of the cells within load radius which are not yet tracked.
+    void RequestCells(const Vector3& position);
+    /// Unload the cells beyond unload radius.
+    void UnloadDistantCells(const Vector3& position);
+    /// Instantiate loaded cells, nearest first, within the per-frame budget.
+    void InstantiateCells(const Vector3& position);
+    /// Instantiate one loaded cell. Return true if successful.
+    bool InstantiateCell(const IntVector2& coords, StreamedCell& cell);
+    /// Remove a cell's content and release its resource.
+    void UnloadCell(const IntVector2& coords, StreamedCell& cell);
+    /// Release the resource of a cell which is loaded but not instantiated.
+    void ReleaseCellResource(StreamedCell& cell);
+    /// Remove a cell file from the resource cache.
+    void ReleaseCellFile(const String& fileName);
+
+    /// Focus node.
+    WeakPtr<Node> focusNode_;
+    /// Tracked cells by coordinates.
+    HashMap<IntVector2, StreamedCell> cells_;
+    /// Cells known to have no cell file, so that they are not looked up again.
+    HashSet<IntVector2> missingCells_;
+    /// Cell file resource name prefix.
+    String cellPrefix_;
+    /// Cell edge length.
+    float cellSize_;
+    /// Load radius.
+    float loadRadius_;
+    /// Unload radius.
+    float unloadRadius_;
+    /// Maximum milliseconds per frame to spend on instantiating cells.
+    int instantiateBudgetMs_;
+    /// Create mode of cell content.
+    CreateMode createMode_;
+};
+
+}
@@ -20,6 +20,49 @@ using namespace std;
 namespace Urho3D
 {
 
+/// Read an attribute value with the read function and set it through the typed accessor. Return false without reading if the attribute has no accessor of the type.
+template <class T, class TReadFunction> static bool ReadTypedAttributeValue(Serializable* serializable, const AttributeInfo& attr,
+    Deserializer& source, TReadFunction readFunction)
+{
+    TypedAttributeAccessor<T>* accessor = attr.GetTypedAccessor<T>();
+    if (!accessor)
+        return false;
+
+    accessor->SetValue(serializable, readFunction(source));
+    return true;
+}
+
+/// Return the name table of the attributes registered to the context for an object type, or null if the attributes are not the registered ones, like the per-instance attributes of script objects.
+static const AttributeNameTable* GetAttributeNameTable(Context* context, StringHash type, const Vector<AttributeInfo>* attributes)
+{
+    return attributes == context->GetAttributes(type) ? context->GetAttributeNameTable(type) : nullptr;
+}
+
+/// Return index of an attribute by name, or NINDEX if not found. Use the name table if given, otherwise search linearly from the start index. When file attributes are required, only attributes with the file mode can be found.
+static i32 FindAttribute(const Vector<AttributeInfo>& attributes, const AttributeNameTable* nameTable, const String& name,
+    bool fileOnly = false, i32 startIndex = 0)
+{
+    if (nameTable)
+    {
+        // Names are unique when the name table exists, so the name needs to be compared only once
+        i32 index = nameTable->Find(StringHash(name));
+        if (index == NINDEX || (fileOnly && !(attributes[index].mode_ & AM_FILE)) || attributes[index].name_.Compare(name, true))
+            return NINDEX;
+        return index;
+    }
+
+    i32 i = startIndex;
+    for (i32 attempts = attributes.Size(); attempts; --attempts)
+    {
+        const AttributeInfo& attr = attributes[i];
+        if ((!fileOnly || (attr.mode_ & AM_FILE)) && !attr.name_.Compare(name, true))
+            return i;
+        i = (i + 1) % attributes.Size();
+    }
+
+    return NINDEX;
+}
+
 static unsigned RemapAttributeIndex(const Vector<AttributeInfo>* attributes, const AttributeInfo& netAttr, unsigned netAttrIndex)
 {
     if (!attributes)
@@ -291,8 +334,7 @@ bool Serializable::Load(Deserializer& source)
             return false;
         }
 
-        Variant varValue = source.ReadVariant(attr.type_);
-        OnSetAttribute(attr, varValue);
+        ReadAttributeValue(attr, source);
     }
 
     return true;
@@ -336,61 +378,51 @@ bool Serializable::LoadXML(const XMLElement& source)
     if (!attributes)
         return true;
 
+    const AttributeNameTable* nameTable = GetAttributeNameTable(context_, GetType(), attributes);
     XMLElement attrElem = source.GetChild("attribute");
-    unsigned startIndex = 0;
+    i32 startIndex = 0;
 
     while (attrElem)
     {
         String name = attrElem.GetAttribute("name");
-        unsigned i = startIndex;
-        unsigned attempts = attributes->Size();
+        i32 i = FindAttribute(*attributes, nameTable, name, true, startIndex);
 
-        while (attempts)
+        if (i != NINDEX)
         {
             const AttributeInfo& attr = attributes->At(i);
-            if ((attr.mode_ & AM_FILE) && !attr.name_.Compare(name, true))
-            {
-                Variant varValue;
+            Variant varValue;
 
-                // If enums specified, do enum lookup and int assignment. Otherwise assign the variant directly
-                if (attr.enumNames_)
+            // If enums specified, do enum lookup and int assignment. Otherwise assign the variant directly
+            if (attr.enumNames_)
+            {
+                String value = attrElem.GetAttribute("value");
+                bool enumFound = false;
+                int enumValue = 0;
+                const char** enumPtr = attr.enumNames_;
+                while (*enumPtr)
                 {
-                    String value = attrElem.GetAttribute("value");
-                    bool enumFound = false;
-                    int enumValue = 0;
-                    const char** enumPtr = attr.enumNames_;
-                    while (*enumPtr)
+                    if (!value.Compare(*enumPtr, false))
                     {
-                        if (!value.Compare(*enumPtr, false))
-                        {
-                            enumFound = true;
-                            break;
-                        }
-                        ++enumPtr;
-                        ++enumValue;
+                        enumFound = true;
+                        break;
                     }
-                    if (enumFound)
-                        varValue = enumValue;
-                    else
-                        URHO3D_LOGWARNING("Unknown enum value " + value + " in attribute " + attr.name_);
+                    ++enumPtr;
+                    ++enumValue;
                 }
+                if (enumFound)
+                    varValue = enumValue;
                 else
-                    varValue = attrElem.GetVariantValue(attr.type_);
-
-                if (!varValue.IsEmpty())
-                    OnSetAttribute(attr, varValue);
-
-                startIndex = (i + 1) % attributes->Size();
-                break;
+                    URHO3D_LOGWARNING("Unknown enum value " + value + " in attribute " + attr.name_);
             }
             else
-            {
-                i = (i + 1) % attributes->Size();
-                --attempts;
-            }
-        }
+                varValue = attrElem.GetVariantValue(attr.type_);
 
-        if (!attempts)
+            if (!varValue.IsEmpty())
+                OnSetAttribute(attr, varValue);
+
+            startIndex = (i + 1) % attributes->Size();
+        }
+        else
             URHO3D_LOGWARNING("Unknown attribute " + name + " in XML data");
 
         attrElem = attrElem.GetNext("attribute");
@@ -424,61 +456,51 @@ bool Serializable::LoadJSON(const JSONValue& source)
 
     const JSONObject& attributesObject = attributesValue.GetObject();
 
-    unsigned startIndex = 0;
+    const AttributeNameTable* nameTable = GetAttributeNameTable(context_, GetType(), attributes);
+    i32 startIndex = 0;
 
     for (JSONObject::ConstIterator it = attributesObject.Begin(); it != attributesObject.End();)
     {
-        String name = it->first_;
+        const String& name = it->first_;
         const JSONValue& value = it->second_;
-        unsigned i = startIndex;
-        unsigned attempts = attributes->Size();
+        i32 i = FindAttribute(*attributes, nameTable, name, true, startIndex);
 
-        while (attempts)
+        if (i != NINDEX)
         {
             const AttributeInfo& attr = attributes->At(i);
-            if ((attr.mode_ & AM_FILE) && !attr.name_.Compare(name, true))
-            {
-                Variant varValue;
+            Variant varValue;
 
-                // If enums specified, do enum lookup ad int assignment. Otherwise assign variant directly
-                if (attr.enumNames_)
+            // If enums specified, do enum lookup ad int assignment. Otherwise assign variant directly
+            if (attr.enumNames_)
+            {
+                const String& valueStr = value.GetString();
+                bool enumFound = false;
+                int enumValue = 0;
+                const char** enumPtr = attr.enumNames_;
+                while (*enumPtr)
                 {
-                    const String& valueStr = value.GetString();
-                    bool enumFound = false;
-                    int enumValue = 0;
-                    const char** enumPtr = attr.enumNames_;
-                    while (*enumPtr)
+                    if (!valueStr.Compare(*enumPtr, false))
                     {
-                        if (!valueStr.Compare(*enumPtr, false))
-                        {
-                            enumFound = true;
-                            break;
-                        }
-                        ++enumPtr;
-                        ++enumValue;
+                        enumFound = true;
+                        break;
                     }
-                    if (enumFound)
-                        varValue = enumValue;
-                    else
-                        URHO3D_LOGWARNING("Unknown enum value " + valueStr + " in attribute " + attr.name_);
+                    ++enumPtr;
+                    ++enumValue;
                 }
+                if (enumFound)
+                    varValue = enumValue;
                 else
-                    varValue = value.GetVariantValue(attr.type_);
-
-                if (!varValue.IsEmpty())
-                    OnSetAttribute(attr, varValue);
-
-                startIndex = (i + 1) % attributes->Size();
-                break;
+                    URHO3D_LOGWARNING("Unknown enum value " + valueStr + " in attribute " + attr.name_);
             }
             else
-            {
-                i = (i + 1) % attributes->Size();
-                --attempts;
-            }
-        }
+                varValue = value.GetVariantValue(attr.type_);
+
+            if (!varValue.IsEmpty())
+                OnSetAttribute(attr, varValue);
 
-        if (!attempts)
+            startIndex = (i + 1) % attributes->Size();
+        }
+        else
             URHO3D_LOGWARNING("Unknown attribute " + name + " in JSON data");
 
         it++;
@@ -607,27 +629,26 @@ bool Serializable::SetAttribute(const String& name, const Variant& value)
         return false;
     }
 
-    for (Vector<AttributeInfo>::ConstIterator i = attributes->Begin(); i != attributes->End(); ++i)
+    i32 index = FindAttribute(*attributes, GetAttributeNameTable(context_, GetType(), attributes), name);
+    if (index == NINDEX)
     {
-        if (!i->name_.Compare(name, true))
-        {
-            // Check that the new value's type matches the attribute type
-            if (value.GetType() == i->type_)
-            {
-                OnSetAttribute(*i, value);
-                return true;
-            }
-            else
-            {
-                URHO3D_LOGERROR("Could not set attribute " + i->name_ + ": expected type " + Variant::GetTypeName(i->type_)
-                         + " but got " + value.GetTypeName());
-                return false;
-            }
-        }
+        URHO3D_LOGERROR("Could not find attribute " + name + " in " + GetTypeName());
+        return false;
     }
 
-    URHO3D_LOGERROR("Could not find attribute " + name + " in " + GetTypeName());
-    return false;
+    // Check that the new value's type matches the attribute type
+    const AttributeInfo& attr = attributes->At(index);
+    if (value.GetType() == attr.type_)
+    {
+        OnSetAttribute(attr, value);
+        return true;
+    }
+    else
+    {
+        URHO3D_LOGERROR("Could not set attribute " + attr.name_ + ": expected type " + Variant::GetTypeName(attr.type_)
+                 + " but got " + value.GetTypeName());
+        return false;
+    }
 }
 
 void Serializable::ResetToDefault()
@@ -821,7 +842,7 @@ bool Serializable::ReadDeltaUpdate(Deserializer& source)
             const AttributeInfo& attr = attributes->At(i);
             if (!(interceptMask & (1ULL << i)))
             {
-                OnSetAttribute(attr, source.ReadVariant(attr.type_));
+                ReadAttributeValue(attr, source);
                 changed = true;
             }
             else
@@ -861,7 +882,7 @@ bool Serializable::ReadLatestDataUpdate(Deserializer& source)
         {
             if (!(interceptMask & (1ULL << i)))
             {
-                OnSetAttribute(attr, source.ReadVariant(attr.type_));
+                ReadAttributeValue(attr, source);
                 changed = true;
             }
             else
@@ -913,16 +934,14 @@ Variant Serializable::GetAttribute(const String& name) const
         return ret;
     }
 
-    for (Vector<AttributeInfo>::ConstIterator i = attributes->Begin(); i != attributes->End(); ++i)
+    i32 index = FindAttribute(*attributes, GetAttributeNameTable(context_, GetType(), attributes), name);
+    if (index == NINDEX)
     {
-        if (!i->name_.Compare(name, true))
-        {
-            OnGetAttribute(*i, ret);
-            return ret;
-        }
+        URHO3D_LOGERROR("Could not find attribute " + name + " in " + GetTypeName());
+        return ret;
     }
 
-    URHO3D_LOGERROR("Could not find attribute " + name + " in " + GetTypeName());
+    OnGetAttribute(attributes->At(index), ret);
     return ret;
 }
 
@@ -958,14 +977,14 @@ Variant Serializable::GetAttributeDefault(const String& name) const
         return Variant::EMPTY;
     }
 
-    for (Vector<AttributeInfo>::ConstIterator i = attributes->Begin(); i != attributes->End(); ++i)
+    i32 index = FindAttribute(*attributes, GetAttributeNameTable(context_, GetType(), attributes), name);
+    if (index == NINDEX)
     {
-        if (!i->name_.Compare(name, true))
-            return i->defaultValue_;
+        URHO3D_LOGERROR("Could not find attribute " + name + " in " + GetTypeName());
+        return Variant::EMPTY;
     }
 
-    URHO3D_LOGERROR("Could not find attribute " + name + " in " + GetTypeName());
-    return Variant::EMPTY;
+    return attributes->At(index).defaultValue_;
 }
 
 unsigned Serializable::GetNumAttributes() const
@@ -999,6 +1018,60 @@ bool Serializable::GetInterceptNetworkUpdate(const String& attributeName) const
     return false;
 }
 
+void Serializable::ReadAttributeValue(const AttributeInfo& attr, Deserializer& source)
+{
+    if (!setInstanceDefault_ && IsTypedAttributeAccessSupported())
+    {
+        switch (attr.type_)
+        {
+        case VAR_INT:
+            if (ReadTypedAttributeValue<i32>(this, attr, source, [](Deserializer& source) { return source.ReadI32(); }))
+                return;
+            break;
+
+        case VAR_BOOL:
+            if (ReadTypedAttributeValue<bool>(this, attr, source, [](Deserializer& source) { return source.ReadBool(); }))
+                return;
+            break;
+
+        case VAR_FLOAT:
+            if (ReadTypedAttributeValue<float>(this, attr, source, [](Deserializer& source) { return source.ReadFloat(); }))
+                return;
+            break;
+
+        case VAR_VECTOR2:
+            if (ReadTypedAttributeValue<Vector2>(this, attr, source, [](Deserializer& source) { return source.ReadVector2(); }))
+                return;
+            break;
+
+        case VAR_VECTOR3:
+            if (ReadTypedAttributeValue<Vector3>(this, attr, source, [](Deserializer& source) { return source.ReadVector3(); }))
+                return;
+            break;
+
+        case VAR_QUATERNION:
+            if (ReadTypedAttributeValue<Quaternion>(this, attr, source, [](Deserializer& source) { return source.ReadQuaternion(); }))
+                return;
+            break;
+
+        case VAR_COLOR:
+            if (ReadTypedAttributeValue<Color>(this, attr, source, [](Deserializer& source) { return source.ReadColor(); }))
+                return;
+            break;
+
+        case VAR_STRING:
+            if (ReadTypedAttributeValue<String>(this, attr, source, [](Deserializer& source) { return source.ReadString(); }))
+                return;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    OnSetAttribute(attr, source.ReadVariant(attr.type_));
+}
+
 void Serializable::SetInstanceDefault(const String& name, const Variant& defaultValue)
 {
     // Allocate the instance level default value
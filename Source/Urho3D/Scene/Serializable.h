@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace Urho3D
 {
@@ -93,6 +94,32 @@ public:
     /// Read and apply a network latest data update. Return true if attributes were changed.
     bool ReadLatestDataUpdate(Deserializer& source);
 
+    /// Read attribute value by index, without a Variant if the attribute has an accessor of the same type and a Variant stores that type. Return false if the index is illegal.
+    template <class T> bool GetAttributeValue(unsigned index, T& dest) const
+    {
+        if (const TypedAttributeAccessor<T>* accessor = GetTypedAttributeAccessor<T>(index))
+        {
+            accessor->GetValue(this, dest);
+            return true;
+        }
+        Variant value = GetAttribute(index);
+        if (value.IsEmpty())
+            return false;
+        dest = value.Get<T>();
+        return true;
+    }
+    /// Set attribute value by index, without a Variant if the attribute has an accessor of the same type and a Variant stores that type, moving the value if it is an rvalue. Return true if successfully set.
+    template <class T> bool SetAttributeValue(unsigned index, T&& value)
+    {
+        using ValueType = std::remove_cv_t<std::remove_reference_t<T>>;
+        if (TypedAttributeAccessor<ValueType>* accessor = GetTypedAttributeAccessor<ValueType>(index))
+        {
+            accessor->SetValue(this, ValueType(std::forward<T>(value)));
+            return true;
+        }
+        return SetAttribute(index, Variant(value));
+    }
+
     /// Return attribute value by index. Return empty if illegal index.
     /// @property{get_attributes}
     Variant GetAttribute(unsigned index) const;
@@ -120,10 +147,24 @@ public:
     NetworkState* GetNetworkState() const { return networkState_.get(); }
 
 protected:
+    /// Return whether GetAttributeValue() and SetAttributeValue() may invoke the typed accessors directly. Override to return false when OnSetAttribute() or OnGetAttribute() does more than invoke the accessor.
+    virtual bool IsTypedAttributeAccessSupported() const { return true; }
+
     /// Network attribute state.
     std::unique_ptr<NetworkState> networkState_;
 
 private:
+    /// Return the typed accessor of an attribute if it may be invoked directly, otherwise null.
+    template <class T> TypedAttributeAccessor<T>* GetTypedAttributeAccessor(unsigned index) const
+    {
+        const Vector<AttributeInfo>* attributes = GetAttributes();
+        if (!attributes || index >= attributes->Size() || setInstanceDefault_ || !IsTypedAttributeAccessSupported())
+            return nullptr;
+        return attributes->At(index).GetTypedAccessor<T>();
+    }
+
+    /// Read an attribute value from a stream and set it. Common types go through the typed accessor without a Variant when possible.
+    void ReadAttributeValue(const AttributeInfo& attr, Deserializer& source);
     /// Set instance-level default value. Allocate the internal data structure as necessary.
     void SetInstanceDefault(const String& name, const Variant& defaultValue);
     /// Get instance-level default value.
@@ -180,20 +221,74 @@ SharedPtr<AttributeAccessor> MakeVariantAttributeAccessor(TGetFunction getFuncti
     return SharedPtr<AttributeAccessor>(new VariantAttributeAccessorImpl<TClassType, TGetFunction, TSetFunction>(getFunction, setFunction));
 }
 
+/// Template implementation of the typed attribute accessor.
+template <class TClassType, class T, class TGetFunction, class TSetFunction>
+class TypedAttributeAccessorImpl : public TypedAttributeAccessor<T>
+{
+public:
+    /// Construct.
+    TypedAttributeAccessorImpl(TGetFunction getFunction, TSetFunction setFunction) : getFunction_(getFunction), setFunction_(setFunction) { }
+
+    /// Invoke getter function.
+    void Get(const Serializable* ptr, Variant& value) const override
+    {
+        assert(ptr);
+        value = getFunction_(*static_cast<const TClassType*>(ptr));
+    }
+
+    /// Invoke setter function.
+    void Set(Serializable* ptr, const Variant& value) override
+    {
+        assert(ptr);
+        setFunction_(*static_cast<TClassType*>(ptr), value.Get<T>());
+    }
+
+    /// Invoke getter function without a Variant.
+    void GetValue(const Serializable* ptr, T& value) const override
+    {
+        assert(ptr);
+        value = getFunction_(*static_cast<const TClassType*>(ptr));
+    }
+
+    /// Invoke setter function without a Variant.
+    void SetValue(Serializable* ptr, T&& value) override
+    {
+        assert(ptr);
+        setFunction_(*static_cast<TClassType*>(ptr), std::move(value));
+    }
+
+private:
+    /// Get functor.
+    TGetFunction getFunction_;
+    /// Set functor.
+    TSetFunction setFunction_;
+};
+
+/// Make typed attribute accessor implementation.
+/// \tparam TClassType Serializable class type.
+/// \tparam T Attribute value type.
+/// \tparam TGetFunction Functional object with call signature `T getFunction(const TClassType& self)`, may also return a reference
+/// \tparam TSetFunction Functional object with call signature `void setFunction(TClassType& self, T value)`, called with both lvalues and rvalues
+template <class TClassType, class T, class TGetFunction, class TSetFunction>
+SharedPtr<AttributeAccessor> MakeTypedAttributeAccessor(TGetFunction getFunction, TSetFunction setFunction)
+{
+    return SharedPtr<AttributeAccessor>(new TypedAttributeAccessorImpl<TClassType, T, TGetFunction, TSetFunction>(getFunction, setFunction));
+}
+
 /// Make member attribute accessor.
-#define URHO3D_MAKE_MEMBER_ATTRIBUTE_ACCESSOR(typeName, variable) Urho3D::MakeVariantAttributeAccessor<ClassName>( \
-    [](const ClassName& self, Urho3D::Variant& value) { value = self.variable; }, \
-    [](ClassName& self, const Urho3D::Variant& value) { self.variable = value.Get<typeName>(); })
+#define URHO3D_MAKE_MEMBER_ATTRIBUTE_ACCESSOR(typeName, variable) Urho3D::MakeTypedAttributeAccessor<ClassName, typeName>( \
+    [](const ClassName& self) -> decltype(auto) { return (self.variable); }, \
+    [](ClassName& self, auto&& value) { self.variable = std::forward<decltype(value)>(value); })
 
 /// Make member attribute accessor with custom post-set callback.
-#define URHO3D_MAKE_MEMBER_ATTRIBUTE_ACCESSOR_EX(typeName, variable, postSetCallback) Urho3D::MakeVariantAttributeAccessor<ClassName>( \
-    [](const ClassName& self, Urho3D::Variant& value) { value = self.variable; }, \
-    [](ClassName& self, const Urho3D::Variant& value) { self.variable = value.Get<typeName>(); self.postSetCallback(); })
+#define URHO3D_MAKE_MEMBER_ATTRIBUTE_ACCESSOR_EX(typeName, variable, postSetCallback) Urho3D::MakeTypedAttributeAccessor<ClassName, typeName>( \
+    [](const ClassName& self) -> decltype(auto) { return (self.variable); }, \
+    [](ClassName& self, auto&& value) { self.variable = std::forward<decltype(value)>(value); self.postSetCallback(); })
 
 /// Make get/set attribute accessor.
-#define URHO3D_MAKE_GET_SET_ATTRIBUTE_ACCESSOR(getFunction, setFunction, typeName) Urho3D::MakeVariantAttributeAccessor<ClassName>( \
-    [](const ClassName& self, Urho3D::Variant& value) { value = self.getFunction(); }, \
-    [](ClassName& self, const Urho3D::Variant& value) { self.setFunction(value.Get<typeName>()); })
+#define URHO3D_MAKE_GET_SET_ATTRIBUTE_ACCESSOR(getFunction, setFunction, typeName) Urho3D::MakeTypedAttributeAccessor<ClassName, typeName>( \
+    [](const ClassName& self) -> decltype(auto) { return self.getFunction(); }, \
+    [](ClassName& self, auto&& value) { self.setFunction(std::forward<decltype(value)>(value)); })
 
 /// Make member enum attribute accessor.
 #define URHO3D_MAKE_MEMBER_ENUM_ATTRIBUTE_ACCESSOR(variable) Urho3D::MakeVariantAttributeAccessor<ClassName>( \
@@ -138,11 +138,13 @@ void Button::OnKey(Key key, MouseButtonFlags buttons, QualifierFlags qualifiers)
 void Button::SetPressedOffset(const IntVector2& offset)
 {
     pressedOffset_ = offset;
+    MarkBatchesDirty();
 }
 
 void Button::SetPressedOffset(int x, int y)
 {
     pressedOffset_ = IntVector2(x, y);
+    MarkBatchesDirty();
 }
 
 void Button::SetPressedChildOffset(const IntVector2& offset)
@@ -175,6 +177,7 @@ void Button::SetPressed(bool enable)
 {
     pressed_ = enable;
     SetChildOffset(pressed_ ? pressedChildOffset_ : IntVector2::ZERO);
+    MarkBatchesDirty();
 }
 
 }
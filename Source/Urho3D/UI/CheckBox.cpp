@@ -74,6 +74,7 @@ void CheckBox::SetChecked(bool enable)
     if (enable != checked_)
     {
         checked_ = enable;
+        MarkBatchesDirty();
 
         using namespace Toggled;
 
@@ -87,11 +88,13 @@ void CheckBox::SetChecked(bool enable)
 void CheckBox::SetCheckedOffset(const IntVector2& offset)
 {
     checkedOffset_ = offset;
+    MarkBatchesDirty();
 }
 
 void CheckBox::SetCheckedOffset(int x, int y)
 {
     checkedOffset_ = IntVector2(x, y);
+    MarkBatchesDirty();
 }
 
 }
@@ -0,0 +1,313 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../Precompiled.h"
+
+#include "../Core/Profiler.h"
+#include "../GraphicsAPI/Texture2D.h"
+#include "../IO/Log.h"
+#include "../Resource/Image.h"
+#include "../UI/Font.h"
+#include "../UI/FontAtlas.h"
+#include "../UI/FontFaceFreeType.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+FontAtlas::FontAtlas(Context* context, i32 textureSize) :
+    context_(context),
+    textureSize_(textureSize),
+    frameNumber_(1),
+    fullWarningShown_(false),
+    library_(nullptr)
+{
+    FT_Library library;
+    if (FT_Init_FreeType(&library))
+        URHO3D_LOGERROR("Could not initialize FreeType library for the font atlas");
+    else
+        library_ = library;
+
+    i32 numBands = Max(textureSize_ / FONT_ATLAS_BAND_SIZE, 1);
+    i32 bandHeight = textureSize_ / numBands;
+    bands_.Resize(numBands);
+    for (FontAtlasBand& band : bands_)
+        band.allocator_.Reset(textureSize_, bandHeight);
+
+    texture_ = new Texture2D(context_);
+    texture_->SetMipsToSkip(QUALITY_LOW, 0); // No quality reduction
+    texture_->SetNumLevels(1); // No mipmaps
+    texture_->SetAddressMode(COORD_U, ADDRESS_BORDER);
+    texture_->SetAddressMode(COORD_V, ADDRESS_BORDER);
+    texture_->SetBorderColor(Color(0.0f, 0.0f, 0.0f, 0.0f));
+    ClearTexture();
+}
+
+FontAtlas::~FontAtlas()
+{
+    // Wake up the thread so that it sees the running flag cleared
+    shouldRun_ = false;
+    glyphsQueued_.Set();
+    Stop();
+
+    // The faces remove themselves before they are destroyed, so only the library should remain
+    for (HashMap<FontFaceFreeType*, void*>::Iterator i = workerFaces_.Begin(); i != workerFaces_.End(); ++i)
+        FT_Done_Face((FT_Face)i->second_);
+    workerFaces_.Clear();
+
+    if (library_)
+        FT_Done_FreeType((FT_Library)library_);
+}
+
+void FontAtlas::ThreadFunction()
+{
+    URHO3D_PROFILE_THREAD("FontAtlas Thread");
+
+    while (shouldRun_)
+    {
+        if (!RasterizeNext())
+            glyphsQueued_.Wait();
+    }
+}
+
+bool FontAtlas::AddFace(FontFaceFreeType* face, const unsigned char* fontData, unsigned fontDataSize)
+{
+    if (!library_)
+        return false;
+
+    MutexLock lock(rasterMutex_);
+
+    FT_Face workerFace;
+    if (FT_New_Memory_Face((FT_Library)library_, fontData, fontDataSize, 0, &workerFace))
+    {
+        URHO3D_LOGERROR("Could not create font face for the font atlas");
+        return false;
+    }
+    if (FT_Set_Char_Size(workerFace, 0, face->GetPointSize() * 64, face->GetOversampling() * FONT_DPI, FONT_DPI))
+    {
+        FT_Done_Face(workerFace);
+        URHO3D_LOGERROR("Could not set font point size " + String(face->GetPointSize()) + " for the font atlas");
+        return false;
+    }
+
+    workerFaces_[face] = workerFace;
+
+    if (!IsStarted())
+        Run();
+
+    return true;
+}
+
+void FontAtlas::RemoveFace(FontFaceFreeType* face)
+{
+    // Wait for the glyph being rasterized, as it may be of this face
+    MutexLock rasterLock(rasterMutex_);
+
+    {
+        MutexLock queueLock(queueMutex_);
+
+        for (Vector<FontAtlasJob>::Iterator i = queue_.Begin(); i != queue_.End();)
+        {
+            if (i->face_ == face)
+                i = queue_.Erase(i);
+            else
+                ++i;
+        }
+
+        for (Vector<FontAtlasJob>::Iterator i = finished_.Begin(); i != finished_.End();)
+        {
+            if (i->face_ == face)
+                i = finished_.Erase(i);
+            else
+                ++i;
+        }
+    }
+
+    HashMap<FontFaceFreeType*, void*>::Iterator i = workerFaces_.Find(face);
+    if (i != workerFaces_.End())
+    {
+        FT_Done_Face((FT_Face)i->second_);
+        workerFaces_.Erase(i);
+    }
+}
+
+bool FontAtlas::AllocateGlyph(FontFaceFreeType* face, c32 charCode, FontGlyph& glyph)
+{
+    // Leave a padding column and row so that filtering does not pick up the neighbouring glyphs
+    i32 width = glyph.texWidth_ + 1;
+    i32 height = glyph.texHeight_ + 1;
+    i32 x = 0, y = 0;
+    i32 index = NINDEX;
+
+    for (i32 i = 0; i < bands_.Size(); ++i)
+    {
+        if (bands_[i].allocator_.Allocate(width, height, x, y))
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if (index == NINDEX)
+    {
+        if (height > bands_[0].allocator_.GetHeight() || width > textureSize_)
+        {
+            URHO3D_LOGWARNINGF("Glyph of char code %u is too large for the font atlas", charCode);
+            return false;
+        }
+
+        // Evict the least recently used band
+        index = 0;
+        for (i32 i = 1; i < bands_.Size(); ++i)
+        {
+            if (bands_[i].lastUse_ < bands_[index].lastUse_)
+                index = i;
+        }
+
+        if (bands_[index].lastUse_ == frameNumber_ && !fullWarningShown_)
+        {
+            URHO3D_LOGWARNING("Font atlas is too small for the glyphs used on one frame, consider increasing the maximum font texture size");
+            fullWarningShown_ = true;
+        }
+
+        EvictBand(index);
+        if (!bands_[index].allocator_.Allocate(width, height, x, y))
+            return false;
+    }
+
+    FontAtlasBand& band = bands_[index];
+    band.glyphs_.Push(MakePair(WeakPtr<FontFaceFreeType>(face), charCode));
+    band.lastUse_ = frameNumber_;
+
+    i32 bandTop = index * bands_[0].allocator_.GetHeight();
+    glyph.x_ = (short)x;
+    glyph.y_ = (short)(bandTop + y);
+    glyph.page_ = NINDEX;
+
+    FontAtlasJob job;
+    job.face_ = face;
+    job.charCode_ = charCode;
+    job.x_ = x;
+    job.y_ = bandTop + y;
+    job.width_ = width;
+    job.height_ = height;
+    job.band_ = index;
+    job.generation_ = band.generation_;
+
+    {
+        MutexLock lock(queueMutex_);
+        queue_.Push(job);
+    }
+
+    glyphsQueued_.Set();
+    return true;
+}
+
+void FontAtlas::TouchGlyph(const FontGlyph& glyph)
+{
+    bands_[glyph.y_ / bands_[0].allocator_.GetHeight()].lastUse_ = frameNumber_;
+}
+
+void FontAtlas::Update()
+{
+    ++frameNumber_;
+
+    if (texture_->IsDataLost())
+    {
+        ClearTexture();
+        texture_->ClearDataLost();
+        for (i32 i = 0; i < bands_.Size(); ++i)
+            EvictBand(i);
+    }
+
+    // Without the thread, rasterize now
+    if (!IsStarted())
+    {
+        while (RasterizeNext())
+        {
+        }
+    }
+
+    Vector<FontAtlasJob> finished;
+    {
+        MutexLock lock(queueMutex_);
+        finished.Swap(finished_);
+    }
+
+    for (const FontAtlasJob& job : finished)
+    {
+        // The band may have been evicted after the glyph was queued
+        if (job.generation_ != bands_[job.band_].generation_)
+            continue;
+
+        texture_->SetData(0, job.x_, job.y_, job.width_, job.height_, job.data_.Buffer());
+        job.face_->OnGlyphRasterized(job.charCode_);
+    }
+}
+
+bool FontAtlas::RasterizeNext()
+{
+    MutexLock rasterLock(rasterMutex_);
+
+    FontAtlasJob job;
+    {
+        MutexLock queueLock(queueMutex_);
+        if (queue_.Empty())
+            return false;
+        job = queue_.Front();
+        queue_.Erase(0);
+    }
+
+    HashMap<FontFaceFreeType*, void*>::ConstIterator i = workerFaces_.Find(job.face_);
+    if (i == workerFaces_.End())
+        return true;
+
+    // The padding column and row stay transparent
+    job.data_.Resize(job.width_ * job.height_);
+    memset(job.data_.Buffer(), 0, job.data_.Size());
+    job.face_->RasterizeGlyph(i->second_, job.charCode_, job.data_.Buffer(), job.width_, job.width_ - 1, job.height_ - 1);
+
+    MutexLock queueLock(queueMutex_);
+    finished_.Push(job);
+    return true;
+}
+
+void FontAtlas::EvictBand(i32 index)
+{
+    FontAtlasBand& band = bands_[index];
+
+    for (const Pair<WeakPtr<FontFaceFreeType>, c32>& glyph : band.glyphs_)
+    {
+        if (glyph.first_)
+            glyph.first_->OnGlyphEvicted(glyph.second_);
+    }
+
+    band.glyphs_.Clear();
+    band.allocator_.Reset(band.allocator_.GetWidth(), band.allocator_.GetHeight());
+    ++band.generation_;
+
+    // Queued glyphs of the band would be discarded after rasterizing, so drop them now
+    MutexLock lock(queueMutex_);
+    for (Vector<FontAtlasJob>::Iterator i = queue_.Begin(); i != queue_.End();)
+    {
+        if (i->band_ == index)
+            i = queue_.Erase(i);
+        else
+            ++i;
+    }
+}
+
+void FontAtlas::ClearTexture()
+{
+    SharedPtr<Image> image(new Image(context_));
+    image->SetSize(textureSize_, textureSize_, 1);
+    memset(image->GetData(), 0, (size_t)textureSize_ * textureSize_);
+    if (!texture_->SetData(image, true))
+        URHO3D_LOGERROR("Could not create font atlas texture");
+}
+
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../Container/HashMap.h"
+#include "../Container/Ptr.h"
+#include "../Container/RefCounted.h"
+#include "../Container/Vector.h"
+#include "../Core/Condition.h"
+#include "../Core/Mutex.h"
+#include "../Core/Thread.h"
+#include "../Math/AreaAllocator.h"
+
+namespace Urho3D
+{
+
+class Context;
+class FontFaceFreeType;
+class Texture2D;
+struct FontGlyph;
+
+/// Height of a band of the shared font atlas. Glyphs are evicted from the atlas a band at a time.
+inline constexpr i32 FONT_ATLAS_BAND_SIZE = 256;
+
+/// Glyph to rasterize into the shared font atlas.
+struct FontAtlasJob
+{
+    /// Font face.
+    FontFaceFreeType* face_{};
+    /// Character code.
+    c32 charCode_{};
+    /// X position in the atlas.
+    i32 x_{};
+    /// Y position in the atlas.
+    i32 y_{};
+    /// Width of the area, including a padding column.
+    i32 width_{};
+    /// Height of the area, including a padding row.
+    i32 height_{};
+    /// Band.
+    i32 band_{};
+    /// Generation of the band when the area was allocated. A result for an older generation is discarded.
+    unsigned generation_{};
+    /// Rasterized pixels of the area, filled by the worker thread.
+    Vector<unsigned char> data_;
+};
+
+/// Band of the shared font atlas.
+struct FontAtlasBand
+{
+    /// Area allocator.
+    AreaAllocator allocator_;
+    /// Glyphs allocated in the band.
+    Vector<Pair<WeakPtr<FontFaceFreeType>, c32>> glyphs_;
+    /// Frame number of the last use of a glyph in the band.
+    unsigned lastUse_{};
+    /// Generation, incremented on eviction.
+    unsigned generation_{};
+};
+
+/// Texture shared by the FreeType font faces of all fonts when mutable glyphs are in use. Glyph metrics are loaded on
+/// the main thread when a glyph is first requested, while the worker thread renders the glyph with its own FreeType
+/// faces. The rendered glyphs are uploaded at the start of the next UI render update. When the texture is full, the
+/// least recently used band of it is evicted and its glyphs are rendered again on their next use.
+/// @nobind
+class URHO3D_API FontAtlas : public RefCounted, public Thread
+{
+public:
+    /// Construct with texture size. Does not start the thread yet.
+    FontAtlas(Context* context, i32 textureSize);
+    /// Destruct. Stop the thread.
+    ~FontAtlas() override;
+
+    /// Rasterization loop.
+    void ThreadFunction() override;
+
+    /// Register a font face that rasterizes into the atlas. Open a FreeType face of the font data for the worker thread. The font data must stay valid until the face is removed. Return true if successful.
+    bool AddFace(FontFaceFreeType* face, const unsigned char* fontData, unsigned fontDataSize);
+    /// Unregister a font face. Discard its queued glyphs and close its worker FreeType face.
+    void RemoveFace(FontFaceFreeType* face);
+    /// Allocate an area for a glyph with known metrics and queue it for rasterization. Evict the least recently used band if full. Return false if the glyph does not fit at all.
+    bool AllocateGlyph(FontFaceFreeType* face, c32 charCode, FontGlyph& glyph);
+    /// Mark the band of a resident glyph used on this frame.
+    void TouchGlyph(const FontGlyph& glyph);
+    /// Upload the rasterized glyphs into the texture and advance the frame number. Rasterize synchronously if the thread could not be started. Called from the main thread.
+    void Update();
+
+    /// Return texture.
+    Texture2D* GetTexture() const { return texture_; }
+
+    /// Return texture size.
+    i32 GetTextureSize() const { return textureSize_; }
+
+private:
+    /// Rasterize the next queued glyph. Return true if there was one.
+    bool RasterizeNext();
+    /// Evict the glyphs of a band and reset it. Called from the main thread.
+    void EvictBand(i32 index);
+    /// Fill the texture with transparent pixels.
+    void ClearTexture();
+
+    /// Context.
+    Context* context_;
+    /// Texture.
+    SharedPtr<Texture2D> texture_;
+    /// Texture size.
+    i32 textureSize_;
+    /// Bands. Used only from the main thread.
+    Vector<FontAtlasBand> bands_;
+    /// Frame number.
+    unsigned frameNumber_;
+    /// Full atlas warning shown flag.
+    bool fullWarningShown_;
+    /// FreeType library of the worker thread.
+    void* library_;
+    /// FreeType faces of the worker thread.
+    HashMap<FontFaceFreeType*, void*> workerFaces_;
+    /// Mutex held while rasterizing. Protects the worker thread's FreeType library and faces.
+    Mutex rasterMutex_;
+    /// Mutex for the queues.
+    Mutex queueMutex_;
+    /// Glyphs waiting to be rasterized.
+    Vector<FontAtlasJob> queue_;
+    /// Condition set when glyphs are queued or the thread should stop.
+    Condition glyphsQueued_;
+    /// Rasterized glyphs waiting to be uploaded.
+    Vector<FontAtlasJob> finished_;
+};
+
+}
@@ -34,15 +34,10 @@ FontFace::~FontFace()
 
 const FontGlyph* FontFace::GetGlyph(c32 c)
 {
-    HashMap<c32, FontGlyph>::Iterator i = glyphMapping_.Find(c);
-    if (i != glyphMapping_.End())
-    {
-        FontGlyph& glyph = i->second_;
-        glyph.used_ = true;
-        return &glyph;
-    }
-    else
-        return nullptr;
+    FontGlyph* glyph = FindGlyph(c);
+    if (glyph)
+        glyph->used_ = true;
+    return glyph;
 }
 
 float FontFace::GetKerning(c32 c, c32 d) const
@@ -76,6 +71,21 @@ bool FontFace::IsDataLost() const
 }
 
 
+FontGlyph* FontFace::FindGlyph(c32 c)
+{
+    if (c < FONT_LATIN_GLYPHS && latinGlyphs_[c])
+        return latinGlyphs_[c];
+
+    HashMap<c32, FontGlyph>::Iterator i = glyphMapping_.Find(c);
+    if (i == glyphMapping_.End())
+        return nullptr;
+
+    // Hash map nodes do not move when other glyphs are added, so the pointer stays valid
+    if (c < FONT_LATIN_GLYPHS)
+        latinGlyphs_[c] = &i->second_;
+    return &i->second_;
+}
+
 SharedPtr<Texture2D> FontFace::CreateFaceTexture()
 {
     SharedPtr<Texture2D> texture(new Texture2D(font_->GetContext()));
@@ -13,6 +13,9 @@ class Font;
 class Image;
 class Texture2D;
 
+/// Number of characters from the start of Unicode (ASCII and Latin-1) whose glyphs are looked up from a flat array.
+inline constexpr c32 FONT_LATIN_GLYPHS = 256;
+
 /// %Font glyph description.
 struct URHO3D_API FontGlyph
 {
@@ -73,17 +76,24 @@ public:
     /// Return textures.
     const Vector<SharedPtr<Texture2D>>& GetTextures() const { return textures_; }
 
+    /// Return a counter that changes when glyphs move in or out of the textures. Glyph locations cached for rendering are valid until it changes.
+    unsigned GetGlyphVersion() const { return glyphVersion_; }
+
 protected:
     friend class FontFaceBitmap;
     /// Create a texture for font rendering.
     SharedPtr<Texture2D> CreateFaceTexture();
     /// Load font face texture from image resource.
     SharedPtr<Texture2D> LoadFaceTexture(const SharedPtr<Image>& image);
+    /// Return the glyph corresponding to a character without marking it used, or null if not loaded.
+    FontGlyph* FindGlyph(c32 c);
 
     /// Parent font.
     Font* font_{};
     /// Glyph mapping.
     HashMap<c32, FontGlyph> glyphMapping_;
+    /// Glyphs of the first characters, pointing into the glyph mapping. Filled on first lookup, so glyphs must not be erased from the mapping once looked up.
+    FontGlyph* latinGlyphs_[FONT_LATIN_GLYPHS]{};
     /// Kerning mapping.
     HashMap<u32, float> kerningMapping_;
     /// Glyph texture pages.
@@ -92,6 +102,8 @@ protected:
     float pointSize_{};
     /// Row height.
     float rowHeight_{};
+    /// Glyph version.
+    unsigned glyphVersion_{};
 };
 
 }
@@ -10,6 +10,7 @@
 #include "../IO/Log.h"
 #include "../IO/MemoryBuffer.h"
 #include "../UI/Font.h"
+#include "../UI/FontAtlas.h"
 #include "../UI/FontFaceFreeType.h"
 #include "../UI/UI.h"
 
@@ -17,6 +18,7 @@
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include FT_OUTLINE_H
 #include FT_TRUETYPE_TABLES_H
 
 #include "../DebugNew.h"
@@ -65,6 +67,13 @@ FontFaceFreeType::FontFaceFreeType(Font* font) :
 
 FontFaceFreeType::~FontFaceFreeType()
 {
+    if (atlas_)
+    {
+        atlas_->RemoveFace(this);
+        // The texture belongs to the atlas and is not counted in the memory use of the font
+        textures_.Clear();
+    }
+
     if (face_)
     {
         FT_Done_Face((FT_Face)face_);
@@ -157,40 +166,63 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
         rowHeight_ = Max(rowHeight_, ascender_ + descender);
     }
 
-    int textureWidth = maxTextureSize;
-    int textureHeight = maxTextureSize;
-    hasMutableGlyph_ = false;
-
-    SharedPtr<Image> image(new Image(font_->GetContext()));
-    image->SetSize(textureWidth, textureHeight, 1);
-    unsigned char* imageData = image->GetData();
-    memset(imageData, 0, (size_t)image->GetWidth() * image->GetHeight());
-    allocator_.Reset(FONT_TEXTURE_MIN_SIZE, FONT_TEXTURE_MIN_SIZE, textureWidth, textureHeight);
-
     HashMap<FT_UInt, FT_ULong> charCodes;
     FT_UInt glyphIndex;
-    FT_ULong charCode = FT_Get_First_Char(face, &glyphIndex);
+    FT_ULong charCode;
 
-    while (glyphIndex != 0)
+    if (ui->GetUseMutableGlyphs())
     {
-        if (!LoadCharGlyph(charCode, image))
+        // Render the glyphs into the shared font atlas on first use, so only the char codes are needed for kerning now
+        SharedPtr<FontAtlas> atlas(ui->GetFontAtlas());
+        if (!atlas->AddFace(this, fontData, fontDataSize))
+            return false;
+
+        atlas_ = atlas;
+        hasMutableGlyph_ = true;
+        textures_.Push(SharedPtr<Texture2D>(atlas_->GetTexture()));
+
+        charCode = FT_Get_First_Char(face, &glyphIndex);
+        while (glyphIndex != 0)
         {
-            hasMutableGlyph_ = true;
-            break;
+            charCodes[glyphIndex] = charCode;
+            charCode = FT_Get_Next_Char(face, charCode, &glyphIndex);
         }
+    }
+    else
+    {
+        int textureWidth = maxTextureSize;
+        int textureHeight = maxTextureSize;
+        hasMutableGlyph_ = false;
 
-        // TODO: FT_Get_Next_Char can return same glyphIndex for different charCode
-        charCodes[glyphIndex] = charCode;
+        SharedPtr<Image> image(new Image(font_->GetContext()));
+        image->SetSize(textureWidth, textureHeight, 1);
+        unsigned char* imageData = image->GetData();
+        memset(imageData, 0, (size_t)image->GetWidth() * image->GetHeight());
+        allocator_.Reset(FONT_TEXTURE_MIN_SIZE, FONT_TEXTURE_MIN_SIZE, textureWidth, textureHeight);
 
-        charCode = FT_Get_Next_Char(face, charCode, &glyphIndex);
-    }
+        charCode = FT_Get_First_Char(face, &glyphIndex);
 
-    SharedPtr<Texture2D> texture = LoadFaceTexture(image);
-    if (!texture)
-        return false;
+        while (glyphIndex != 0)
+        {
+            if (!LoadCharGlyph(charCode, image))
+            {
+                hasMutableGlyph_ = true;
+                break;
+            }
 
-    textures_.Push(texture);
-    font_->SetMemoryUse(font_->GetMemoryUse() + textureWidth * textureHeight);
+            // TODO: FT_Get_Next_Char can return same glyphIndex for different charCode
+            charCodes[glyphIndex] = charCode;
+
+            charCode = FT_Get_Next_Char(face, charCode, &glyphIndex);
+        }
+
+        SharedPtr<Texture2D> texture = LoadFaceTexture(image);
+        if (!texture)
+            return false;
+
+        textures_.Push(texture);
+        font_->SetMemoryUse(font_->GetMemoryUse() + textureWidth * textureHeight);
+    }
 
     // Store kerning if face has kerning information
     if (FT_HAS_KERNING(face))
@@ -273,26 +305,58 @@ bool FontFaceFreeType::Load(const unsigned char* fontData, unsigned fontDataSize
 
 const FontGlyph* FontFaceFreeType::GetGlyph(c32 c)
 {
-    HashMap<c32, FontGlyph>::Iterator i = glyphMapping_.Find(c);
-    if (i != glyphMapping_.End())
+    FontGlyph* glyph = FindGlyph(c);
+    if (!glyph)
     {
-        FontGlyph& glyph = i->second_;
-        glyph.used_ = true;
-        return &glyph;
+        if (!LoadCharGlyph(c))
+            return nullptr;
+        glyph = FindGlyph(c);
+        if (!glyph)
+            return nullptr;
     }
 
-    if (LoadCharGlyph(c))
+    glyph->used_ = true;
+
+    if (atlas_ && glyph->texWidth_ > 0 && glyph->texHeight_ > 0)
     {
-        HashMap<c32, FontGlyph>::Iterator i = glyphMapping_.Find(c);
-        if (i != glyphMapping_.End())
+        if (glyph->page_ != NINDEX)
+            atlas_->TouchGlyph(*glyph);
+        else if (!requestedGlyphs_.Contains(c))
         {
-            FontGlyph& glyph = i->second_;
-            glyph.used_ = true;
-            return &glyph;
+            // A glyph that does not fit into the atlas at all stays requested, so it is not retried on every use
+            atlas_->AllocateGlyph(this, c, *glyph);
+            requestedGlyphs_.Insert(c);
         }
     }
 
-    return nullptr;
+    return glyph;
+}
+
+void FontFaceFreeType::RasterizeGlyph(void* face, c32 charCode, unsigned char* dest, unsigned pitch, i32 width, i32 height) const
+{
+    auto ftFace = (FT_Face)face;
+    if (FT_Load_Char(ftFace, charCode, loadMode_ | FT_LOAD_RENDER))
+        return;
+
+    CopyBitmap(&ftFace->glyph->bitmap, dest, pitch, width, height);
+}
+
+void FontFaceFreeType::OnGlyphEvicted(c32 charCode)
+{
+    FontGlyph* glyph = FindGlyph(charCode);
+    if (glyph)
+        glyph->page_ = NINDEX;
+    requestedGlyphs_.Erase(charCode);
+    ++glyphVersion_;
+}
+
+void FontFaceFreeType::OnGlyphRasterized(c32 charCode)
+{
+    FontGlyph* glyph = FindGlyph(charCode);
+    if (glyph)
+        glyph->page_ = 0;
+    requestedGlyphs_.Erase(charCode);
+    ++glyphVersion_;
 }
 
 bool FontFaceFreeType::SetupNextTexture(int textureWidth, int textureHeight)
@@ -314,7 +378,51 @@ bool FontFaceFreeType::SetupNextTexture(int textureWidth, int textureHeight)
     return true;
 }
 
-void FontFaceFreeType::BoxFilter(unsigned char* dest, size_t destSize, const unsigned char* src, size_t srcSize)
+void FontFaceFreeType::CopyBitmap(const void* bitmap, unsigned char* dest, unsigned pitch, i32 width, i32 height) const
+{
+    auto* src = (const FT_Bitmap*)bitmap;
+    const i32 rows = Min((i32)src->rows, height);
+
+    if (src->pixel_mode == FT_PIXEL_MODE_MONO)
+    {
+        const i32 offset = (oversampling_ - 1) / 2;
+        const i32 columns = Min((i32)src->width, width - offset);
+
+        for (i32 y = 0; y < rows; ++y)
+        {
+            const unsigned char* srcRow = src->buffer + src->pitch * y;
+            unsigned char* rowDest = dest + offset + y * pitch;
+
+            // Don't do any oversampling, just unpack the bits directly.
+            for (i32 x = 0; x < columns; ++x)
+                rowDest[x] = (unsigned char)((srcRow[x >> 3u] & (0x80u >> (x & 7u))) ? 255 : 0);
+        }
+    }
+    else
+    {
+        // Filter through a scratch row if the destination is narrower than the filtered bitmap
+        const i32 rowWidth = (i32)src->width + oversampling_ - 1;
+        Vector<unsigned char> scratch;
+        if (rowWidth > width)
+            scratch.Resize(rowWidth);
+
+        for (i32 y = 0; y < rows; ++y)
+        {
+            const unsigned char* srcRow = src->buffer + src->pitch * y;
+            unsigned char* rowDest = dest + y * pitch;
+
+            if (scratch.Empty())
+                BoxFilter(rowDest, rowWidth, srcRow, src->width);
+            else
+            {
+                BoxFilter(scratch.Buffer(), rowWidth, srcRow, src->width);
+                memcpy(rowDest, scratch.Buffer(), width);
+            }
+        }
+    }
+}
+
+void FontFaceFreeType::BoxFilter(unsigned char* dest, size_t destSize, const unsigned char* src, size_t srcSize) const
 {
     const int filterSize = oversampling_;
 
@@ -381,8 +489,9 @@ bool FontFaceFreeType::LoadCharGlyph(c32 charCode, Image* image)
     auto face = (FT_Face)face_;
     FT_GlyphSlot slot = face->glyph;
 
+    // With the font atlas the glyph is rendered on first use by its worker thread, so only the metrics are loaded here
     FontGlyph fontGlyph;
-    FT_Error error = FT_Load_Char(face, charCode, loadMode_ | FT_LOAD_RENDER);
+    FT_Error error = FT_Load_Char(face, charCode, atlas_ ? loadMode_ : loadMode_ | FT_LOAD_RENDER);
     if (error)
     {
         const char* family = face->family_name ? face->family_name : "NULL";
@@ -398,13 +507,34 @@ bool FontFaceFreeType::LoadCharGlyph(c32 charCode, Image* image)
     }
     else
     {
+        int bitmapLeft = slot->bitmap_left;
+        int bitmapTop = slot->bitmap_top;
+        int bitmapWidth = (int)slot->bitmap.width;
+        int bitmapRows = (int)slot->bitmap.rows;
+
+        if (slot->format == FT_GLYPH_FORMAT_OUTLINE)
+        {
+            // Not rendered yet: compute the bitmap extents the same way as the FreeType rasterizer
+            FT_BBox box;
+            FT_Outline_Get_CBox(&slot->outline, &box);
+            box.xMin &= ~63;
+            box.yMin &= ~63;
+            box.xMax = (box.xMax + 63) & ~63;
+            box.yMax = (box.yMax + 63) & ~63;
+
+            bitmapLeft = (int)(box.xMin >> 6);
+            bitmapTop = (int)(box.yMax >> 6);
+            bitmapWidth = (int)((box.xMax - box.xMin) >> 6);
+            bitmapRows = (int)((box.yMax - box.yMin) >> 6);
+        }
+
         // Note: position within texture will be filled later
-        fontGlyph.texWidth_ = slot->bitmap.width + oversampling_ - 1;
-        fontGlyph.texHeight_ = slot->bitmap.rows;
-        fontGlyph.width_ = slot->bitmap.width + oversampling_ - 1;
-        fontGlyph.height_ = slot->bitmap.rows;
-        fontGlyph.offsetX_ = slot->bitmap_left - (oversampling_ - 1) / 2.0f;
-        fontGlyph.offsetY_ = floorf(ascender_ + 0.5f) - slot->bitmap_top;
+        fontGlyph.texWidth_ = bitmapWidth + oversampling_ - 1;
+        fontGlyph.texHeight_ = bitmapRows;
+        fontGlyph.width_ = bitmapWidth + oversampling_ - 1;
+        fontGlyph.height_ = bitmapRows;
+        fontGlyph.offsetX_ = bitmapLeft - (oversampling_ - 1) / 2.0f;
+        fontGlyph.offsetY_ = floorf(ascender_ + 0.5f) - bitmapTop;
 
         if (subpixel_ && slot->linearHoriAdvance)
         {
@@ -423,7 +553,14 @@ bool FontFaceFreeType::LoadCharGlyph(c32 charCode, Image* image)
     }
 
     int x = 0, y = 0;
-    if (fontGlyph.texWidth_ > 0 && fontGlyph.texHeight_ > 0)
+    if (fontGlyph.texWidth_ > 0 && fontGlyph.texHeight_ > 0 && atlas_)
+    {
+        // Allocated in the atlas on first use
+        fontGlyph.x_ = 0;
+        fontGlyph.y_ = 0;
+        fontGlyph.page_ = NINDEX;
+    }
+    else if (fontGlyph.texWidth_ > 0 && fontGlyph.texHeight_ > 0)
     {
         if (!allocator_.Allocate(fontGlyph.texWidth_ + 1, fontGlyph.texHeight_ + 1, x, y))
         {
@@ -466,27 +603,7 @@ bool FontFaceFreeType::LoadCharGlyph(c32 charCode, Image* image)
             pitch = (unsigned)fontGlyph.texWidth_;
         }
 
-        if (slot->bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
-        {
-            for (unsigned y = 0; y < (unsigned)slot->bitmap.rows; ++y)
-            {
-                unsigned char* src = slot->bitmap.buffer + slot->bitmap.pitch * y;
-                unsigned char* rowDest = dest + (oversampling_ - 1)/2 + y * pitch;
-
-                // Don't do any oversampling, just unpack the bits directly.
-                for (unsigned x = 0; x < (unsigned)slot->bitmap.width; ++x)
-                    rowDest[x] = (unsigned char)((src[x >> 3u] & (0x80u >> (x & 7u))) ? 255 : 0);
-            }
-        }
-        else
-        {
-            for (unsigned y = 0; y < (unsigned)slot->bitmap.rows; ++y)
-            {
-                unsigned char* src = slot->bitmap.buffer + slot->bitmap.pitch * y;
-                unsigned char* rowDest = dest + y * pitch;
-                BoxFilter(rowDest, fontGlyph.texWidth_, src, slot->bitmap.width);
-            }
-        }
+        CopyBitmap(&slot->bitmap, dest, pitch, fontGlyph.texWidth_, fontGlyph.texHeight_);
 
         if (!image)
         {
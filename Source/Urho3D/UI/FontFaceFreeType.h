@@ -3,11 +3,13 @@
 
 #pragma once
 
+#include "../Container/HashSet.h"
 #include "../UI/FontFace.h"
 
 namespace Urho3D
 {
 
+class FontAtlas;
 class FreeTypeLibrary;
 class Texture2D;
 
@@ -28,13 +30,26 @@ public:
     /// Return if font face uses mutable glyphs.
     bool HasMutableGlyphs() const override { return hasMutableGlyph_; }
 
+    /// Return oversampling level.
+    int GetOversampling() const { return oversampling_; }
+    /// Render a glyph with a FreeType face opened from the same font data and size. Write at most width x height pixels. Called from the font atlas worker thread.
+    void RasterizeGlyph(void* face, c32 charCode, unsigned char* dest, unsigned pitch, i32 width, i32 height) const;
+
 private:
+    friend class FontAtlas;
+
+    /// Handle a glyph being evicted from the font atlas.
+    void OnGlyphEvicted(c32 charCode);
+    /// Handle a glyph having been uploaded into the font atlas.
+    void OnGlyphRasterized(c32 charCode);
+    /// Copy a rendered glyph bitmap. Write at most width x height pixels.
+    void CopyBitmap(const void* bitmap, unsigned char* dest, unsigned pitch, i32 width, i32 height) const;
     /// Setup next texture.
     bool SetupNextTexture(int textureWidth, int textureHeight);
     /// Load char glyph.
     bool LoadCharGlyph(c32 charCode, Image* image = nullptr);
     /// Smooth one row of a horizontally oversampled glyph image.
-    void BoxFilter(unsigned char* dest, size_t destSize, const unsigned char* src, size_t srcSize);
+    void BoxFilter(unsigned char* dest, size_t destSize, const unsigned char* src, size_t srcSize) const;
 
     /// FreeType library.
     SharedPtr<FreeTypeLibrary> freeType_;
@@ -52,6 +67,10 @@ private:
     bool hasMutableGlyph_{};
     /// Glyph area allocator.
     AreaAllocator allocator_;
+    /// Shared font atlas. Non-null when glyphs are rendered into it instead of own textures.
+    SharedPtr<FontAtlas> atlas_;
+    /// Glyphs allocated in the font atlas but not yet uploaded.
+    HashSet<c32> requestedGlyphs_;
 };
 
 }
@@ -77,7 +77,7 @@ void Slider::OnHover(const IntVector2& position, const IntVector2& screenPositio
 void Slider::OnClickBegin(const IntVector2& position, const IntVector2& screenPosition, MouseButton button, MouseButtonFlags buttons, QualifierFlags qualifiers,
     Cursor* cursor)
 {
-    selected_ = true;
+    SetSelected(true);
     hovering_ = knob_->IsInside(screenPosition, true);
     if (!hovering_ && button == MOUSEB_LEFT)
         Page(position, true);
@@ -135,7 +135,7 @@ void Slider::OnDragEnd(const IntVector2& position, const IntVector2& screenPosit
     if (dragButtons == MOUSEB_LEFT)
     {
         dragSlider_ = false;
-        selected_ = false;
+        SetSelected(false);
     }
 }
 
@@ -115,8 +115,16 @@ void Text::GetBatches(Vector<UIBatch>& batches, Vector<float>& vertexData, const
     {
         for (i32 i = 0; i < printText_.Size(); ++i)
             face->GetGlyph(printText_[i]);
+
+        // Glyphs may have moved in or out of the texture since the locations were stored
+        if (face->GetGlyphVersion() != glyphVersion_)
+            UpdateCharLocations();
     }
 
+    // Glyphs of a mutable face may move in the texture, so retained batches containing them must be rebuilt each frame
+    if (face->HasMutableGlyphs())
+        MarkBatchesDirty();
+
     // Hovering and/or whole selection batch
     UISelectable::GetBatches(batches, vertexData, currentScissor);
 
@@ -229,6 +237,7 @@ void Text::OnResize(const IntVector2& newSize, const IntVector2& delta)
 void Text::OnIndentSet()
 {
     charLocationsDirty_ = true;
+    MarkBatchesDirty();
 }
 
 bool Text::SetFont(const String& fontName, float size)
@@ -355,42 +364,50 @@ void Text::SetSelection(i32 start, i32 length)
     selectionStart_ = start;
     selectionLength_ = length;
     ValidateSelection();
+    MarkBatchesDirty();
 }
 
 void Text::ClearSelection()
 {
     selectionStart_ = 0;
     selectionLength_ = 0;
+    MarkBatchesDirty();
 }
 
 void Text::SetTextEffect(TextEffect textEffect)
 {
     textEffect_ = textEffect;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectShadowOffset(const IntVector2& offset)
 {
     shadowOffset_ = offset;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectStrokeThickness(int thickness)
 {
     strokeThickness_ = Abs(thickness);
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectRoundStroke(bool roundStroke)
 {
     roundStroke_ = roundStroke;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectColor(const Color& effectColor)
 {
     effectColor_ = effectColor;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectDepthBias(float bias)
 {
     effectDepthBias_ = bias;
+    MarkBatchesDirty();
 }
 
 float Text::GetRowWidth(i32 index) const
@@ -659,6 +676,8 @@ void Text::UpdateText(bool onResize)
         if (parent && parent->GetLayoutMode() != LM_FREE)
             parent->UpdateLayout();
     }
+
+    MarkBatchesDirty();
 }
 
 void Text::UpdateCharLocations()
@@ -724,6 +743,7 @@ void Text::UpdateCharLocations()
     charLocations_[numChars].position_ = Vector2(x, y);
     charLocations_[numChars].size_ = Vector2::ZERO;
 
+    glyphVersion_ = face->GetGlyphVersion();
     charLocationsDirty_ = false;
 }
 
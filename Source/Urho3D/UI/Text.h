@@ -248,6 +248,8 @@ protected:
     bool wordWrap_;
     /// Char positions dirty flag.
     bool charLocationsDirty_;
+    /// Glyph version of the font face when the char positions were updated.
+    unsigned glyphVersion_{};
     /// Selection start.
     i32 selectionStart_;
     /// Selection length.
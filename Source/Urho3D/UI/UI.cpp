@@ -21,6 +21,7 @@
 #include "../Input/InputEvents.h"
 #include "../IO/Log.h"
 #include "../Math/Matrix3x4.h"
+#include "../Resource/ResourceEvents.h"
 #include "../Resource/ResourceCache.h"
 #include "../Scene/Scene.h"
 #include "../UI/CheckBox.h"
@@ -28,6 +29,7 @@
 #include "../UI/DropDownList.h"
 #include "../UI/FileSelector.h"
 #include "../UI/Font.h"
+#include "../UI/FontAtlas.h"
 #include "../UI/LineEdit.h"
 #include "../UI/ListView.h"
 #include "../UI/MessageBox.h"
@@ -125,6 +127,7 @@ UI::UI(Context* context) :
     SubscribeToEvent(E_KEYDOWN, URHO3D_HANDLER(UI, HandleKeyDown));
     SubscribeToEvent(E_TEXTINPUT, URHO3D_HANDLER(UI, HandleTextInput));
     SubscribeToEvent(E_DROPFILE, URHO3D_HANDLER(UI, HandleDropFile));
+    SubscribeToEvent(E_RELOADFINISHED, URHO3D_HANDLER(UI, HandleReloadFinished));
 
     // Try to initialize right now, but skip if screen mode is not yet set
     Initialize();
@@ -190,6 +193,7 @@ void UI::SetFocusElement(UIElement* element, bool byKey)
     {
         UIElement* oldFocusElement = focusElement_;
         focusElement_.Reset();
+        oldFocusElement->MarkBatchesDirty();
 
         VariantMap& focusEventData = GetEventDataMap();
         focusEventData[Defocused::P_ELEMENT] = oldFocusElement;
@@ -200,6 +204,7 @@ void UI::SetFocusElement(UIElement* element, bool byKey)
     if (element && element->GetFocusMode() >= FM_FOCUSABLE)
     {
         focusElement_ = element;
+        element->MarkBatchesDirty();
 
         VariantMap& focusEventData = GetEventDataMap();
         focusEventData[Focused::P_ELEMENT] = element;
@@ -377,6 +382,11 @@ void UI::Update(float timeStep)
             {
                 using namespace HoverEnd;
 
+                // Elements reset their hover state when their batches are rebuilt, which retained batches skip. Rebuild
+                // regardless of the state, as a rebuild may have reset it already
+                element->MarkBatchesDirty();
+                element->SetHovering(false);
+
                 VariantMap& eventData = GetEventDataMap();
                 eventData[P_ELEMENT] = element;
                 element->SendEvent(E_HOVEREND, eventData);
@@ -397,6 +407,10 @@ void UI::RenderUpdate()
 
     URHO3D_PROFILE(GetUIBatches);
 
+    // Upload the glyphs rendered since the last frame before the text batches refer to them
+    if (fontAtlas_)
+        fontAtlas_->Update();
+
     uiRendered_ = false;
 
     // If the OS cursor is visible, do not render the UI's own cursor
@@ -405,6 +419,7 @@ void UI::RenderUpdate()
     // Get rendering batches from the non-modal UI elements
     batches_.Clear();
     vertexData_.Clear();
+    unchangedVertexDataSize_ = 0;
     const IntVector2& rootSize = rootElement_->GetSize();
     const IntVector2& rootPos = rootElement_->GetPosition();
     // Note: the scissors operate on unscaled coordinates. Scissor scaling is only performed during render
@@ -426,6 +441,8 @@ void UI::RenderUpdate()
         GetBatches(batches_, vertexData_, cursor_, currentScissor);
     }
 
+    vertexDataUploaded_ = false;
+
     // Get batches for UI elements rendered into textures. Each element rendered into texture is treated as root element.
     for (auto it = renderToTexture_.Begin(); it != renderToTexture_.End();)
     {
@@ -475,7 +492,8 @@ void UI::Render(bool renderUICommand)
     // Perform the default backbuffer render only if not rendered yet, or additional renders through RenderUI command
     if (renderUICommand || !uiRendered_)
     {
-        SetVertexData(vertexBuffer_, vertexData_);
+        SetVertexData(vertexBuffer_, vertexData_, unchangedVertexDataSize_);
+        vertexDataUploaded_ = true;
         SetVertexData(debugVertexBuffer_, debugVertexData_);
 
         if (!renderUICommand)
@@ -677,6 +695,15 @@ void UI::SetUseMutableGlyphs(bool enable)
     }
 }
 
+FontAtlas* UI::GetFontAtlas()
+{
+    // Faces of the previous size keep the old atlas alive until they are released
+    if (!fontAtlas_ || fontAtlas_->GetTextureSize() != maxFontTextureSize_)
+        fontAtlas_ = new FontAtlas(context_, maxFontTextureSize_);
+
+    return fontAtlas_;
+}
+
 void UI::SetForceAutoHint(bool enable)
 {
     if (enable != forceAutoHint_)
@@ -956,7 +983,7 @@ void UI::Update(float timeStep, UIElement* element)
         Update(timeStep, children[i]);
 }
 
-void UI::SetVertexData(VertexBuffer* dest, const Vector<float>& vertexData)
+void UI::SetVertexData(VertexBuffer* dest, const Vector<float>& vertexData, unsigned unchangedSize)
 {
     if (vertexData.Empty())
         return;
@@ -964,10 +991,27 @@ void UI::SetVertexData(VertexBuffer* dest, const Vector<float>& vertexData)
     // Update quad geometry into the vertex buffer
     // Resize the vertex buffer first if too small or much too large
     i32 numVertices = vertexData.Size() / UI_VERTEX_SIZE;
+    bool resized = false;
     if (dest->GetVertexCount() < numVertices || dest->GetVertexCount() > numVertices * 2)
+    {
         dest->SetSize(numVertices, VertexElements::Position | VertexElements::Color | VertexElements::TexCoord1, true);
+        resized = true;
+    }
 
-    dest->SetData(&vertexData[0]);
+    // Upload only from the first changed vertex onward. Retained batches keep the start of the data stable when only
+    // later elements change. Only OpenGL preserves the rest of a dynamic buffer on a partial update
+    i32 firstVertex = 0;
+    if (unchangedSize && !resized && !dest->IsDataLost() && Graphics::GetGAPI() == GAPI_OPENGL)
+    {
+        firstVertex = Min(unchangedSize, vertexData.Size()) / UI_VERTEX_SIZE;
+        if (firstVertex == numVertices)
+            return;
+    }
+
+    if (firstVertex)
+        dest->SetDataRange(&vertexData[firstVertex * UI_VERTEX_SIZE], firstVertex, numVertices - firstVertex);
+    else
+        dest->SetData(&vertexData[0]);
 }
 
 void UI::Render(VertexBuffer* buffer, const Vector<UIBatch>& batches, unsigned batchStart, unsigned batchEnd)
@@ -1140,7 +1184,55 @@ void UI::Render(VertexBuffer* buffer, const Vector<UIBatch>& batches, unsigned b
     }
 }
 
-void UI::GetBatches(Vector<UIBatch>& batches, Vector<float>& vertexData, UIElement* element, IntRect currentScissor)
+void UI::GetBatches(Vector<UIBatch>& batches, Vector<float>& vertexData, UIElement* element, const IntRect& currentScissor)
+{
+    UIRetainedBatches* retained = element->GetRetainedBatches();
+    if (!retained)
+    {
+        GetChildBatches(batches, vertexData, element, currentScissor);
+        return;
+    }
+
+    // Rebuild the retained batches only if something within has changed. Clear the flag first so that changes made while
+    // rebuilding are not lost
+    bool rebuilt = false;
+    if (retained->dirty_ || retained->scissor_ != currentScissor)
+    {
+        rebuilt = true;
+        retained->dirty_ = false;
+        retained->scissor_ = currentScissor;
+        retained->batches_.Clear();
+        retained->vertexData_.Clear();
+        GetChildBatches(retained->batches_, retained->vertexData_, element, currentScissor);
+    }
+
+    // The vertex data is unchanged since the previous upload if it lands in the same place after unchanged data only
+    unsigned vertexOffset = vertexData.Size();
+    if (&vertexData == &vertexData_)
+    {
+        if (!rebuilt && vertexDataUploaded_ && retained->vertexOffset_ == vertexOffset && unchangedVertexDataSize_ == vertexOffset)
+            unchangedVertexDataSize_ += retained->vertexData_.Size();
+        retained->vertexOffset_ = vertexOffset;
+    }
+    else
+        retained->vertexOffset_ = M_MAX_UNSIGNED;
+
+    if (retained->batches_.Empty())
+        return;
+
+    // Append the retained vertex data and rebase the batches onto it. The first batch may still merge with the previous one
+    vertexData.Push(retained->vertexData_);
+    for (const UIBatch& retainedBatch : retained->batches_)
+    {
+        UIBatch batch(retainedBatch);
+        batch.vertexData_ = &vertexData;
+        batch.vertexStart_ += vertexOffset;
+        batch.vertexEnd_ += vertexOffset;
+        UIBatch::AddOrMerge(batch, batches);
+    }
+}
+
+void UI::GetChildBatches(Vector<UIBatch>& batches, Vector<float>& vertexData, UIElement* element, IntRect currentScissor)
 {
     // Set clipping scissor for child elements. No need to draw if zero size
     element->AdjustScissor(currentScissor);
@@ -1355,6 +1447,7 @@ void UI::ProcessHover(const IntVector2& windowCursorPos, MouseButtonFlags button
                 // Begin hover event
                 if (!hoveredElements_.Contains(element))
                 {
+                    element->MarkBatchesDirty();
                     SendDragOrHoverEvent(E_HOVERBEGIN, element, cursorPos, IntVector2::ZERO, nullptr);
                     // Exit if element is destroyed by the event handling
                     if (!element)
@@ -1400,6 +1493,7 @@ void UI::ProcessHover(const IntVector2& windowCursorPos, MouseButtonFlags button
             // Begin hover event
             if (!hoveredElements_.Contains(element))
             {
+                element->MarkBatchesDirty();
                 SendDragOrHoverEvent(E_HOVERBEGIN, element, cursorPos, IntVector2::ZERO, nullptr);
                 // Exit if element is destroyed by the event handling
                 if (!element)
@@ -2061,6 +2155,30 @@ void UI::HandleDropFile(StringHash eventType, VariantMap& eventData)
     }
 }
 
+void UI::HandleReloadFinished(StringHash eventType, VariantMap& eventData)
+{
+    // A reloaded font releases its faces, whose textures retained batches may refer to. Rebuild all of them
+    auto markRetainedBatchesDirty = [this](UIElement* root)
+    {
+        root->GetChildren(tempElements_, true);
+        tempElements_.Push(root);
+        for (UIElement* element : tempElements_)
+        {
+            if (element->GetRetainBatches())
+                element->MarkBatchesDirty();
+        }
+    };
+
+    markRetainedBatchesDirty(rootElement_);
+    markRetainedBatchesDirty(rootModalElement_);
+    for (auto& item : renderToTexture_)
+    {
+        if (item.second_.rootElement_)
+            markRetainedBatchesDirty(item.second_.rootElement_);
+    }
+    tempElements_.Clear();
+}
+
 HashMap<WeakPtr<UIElement>, UI::DragData*>::Iterator UI::DragElementErase(HashMap<WeakPtr<UIElement>, UI::DragData*>::Iterator i)
 {
     // If running the engine frame in response to an event (re-entering UI frame logic) the dragElements_ may already be empty
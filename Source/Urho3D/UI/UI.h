@@ -27,6 +27,7 @@ enum FontHintLevel
 };
 
 class Cursor;
+class FontAtlas;
 class Graphics;
 class ResourceCache;
 class Timer;
@@ -102,7 +103,7 @@ public:
     /// Set whether to show the on-screen keyboard (if supported) when a %LineEdit is focused. Default true on mobile devices.
     /// @property
     void SetUseScreenKeyboard(bool enable);
-    /// Set whether to use mutable (eraseable) glyphs to ensure a font face never expands to more than one texture. Default false.
+    /// Set whether to use mutable (eraseable) glyphs to ensure a font face never expands to more than one texture. Default false. FreeType font faces then share one atlas texture of the maximum font texture size: glyphs are rendered on their first use by a worker thread, and the least recently used glyphs are evicted when the atlas is full.
     /// @property
     void SetUseMutableGlyphs(bool enable);
     /// Set whether to force font autohinting instead of using FreeType's TTF bytecode interpreter.
@@ -216,6 +217,10 @@ public:
     /// @property
     bool GetUseMutableGlyphs() const { return useMutableGlyphs_; }
 
+    /// Return the font atlas shared by the font faces when using mutable glyphs. Create it if necessary.
+    /// @nobind
+    FontAtlas* GetFontAtlas();
+
     /// Return whether is using forced autohinting.
     /// @property
     bool GetForceAutoHint() const { return forceAutoHint_; }
@@ -292,12 +297,14 @@ private:
     void Initialize();
     /// Update UI element logic recursively.
     void Update(float timeStep, UIElement* element);
-    /// Upload UI geometry into a vertex buffer.
-    void SetVertexData(VertexBuffer* dest, const Vector<float>& vertexData);
+    /// Upload UI geometry into a vertex buffer. Skip a number of floats at the start which are unchanged since the previous upload into the buffer.
+    void SetVertexData(VertexBuffer* dest, const Vector<float>& vertexData, unsigned unchangedSize = 0);
     /// Render UI batches to the current rendertarget. Geometry must have been uploaded first.
     void Render(VertexBuffer* buffer, const Vector<UIBatch>& batches, unsigned batchStart, unsigned batchEnd);
-    /// Generate batches from an UI element recursively. Skip the cursor element.
-    void GetBatches(Vector<UIBatch>& batches, Vector<float>& vertexData, UIElement* element, IntRect currentScissor);
+    /// Generate batches from an UI element recursively. Skip the cursor element. Use the retained batches of the element if it has them.
+    void GetBatches(Vector<UIBatch>& batches, Vector<float>& vertexData, UIElement* element, const IntRect& currentScissor);
+    /// Generate batches from the child elements of an UI element.
+    void GetChildBatches(Vector<UIBatch>& batches, Vector<float>& vertexData, UIElement* element, IntRect currentScissor);
     /// Return UI element at global screen coordinates. Return position converted to element's screen coordinates.
     UIElement* GetElementAt(const IntVector2& position, bool enabledOnly, IntVector2* elementScreenPosition);
     /// Return UI element at screen position recursively.
@@ -359,6 +366,8 @@ private:
     void HandleRenderUpdate(StringHash eventType, VariantMap& eventData);
     /// Handle a file being drag-dropped into the application window.
     void HandleDropFile(StringHash eventType, VariantMap& eventData);
+    /// Handle a resource being reloaded.
+    void HandleReloadFinished(StringHash eventType, VariantMap& eventData);
     /// Remove drag data and return next iterator.
     HashMap<WeakPtr<UIElement>, DragData*>::Iterator DragElementErase(HashMap<WeakPtr<UIElement>, DragData*>::Iterator i);
     /// Handle clean up on a drag cancel.
@@ -384,6 +393,10 @@ private:
     Vector<UIBatch> batches_;
     /// UI rendering vertex data.
     Vector<float> vertexData_;
+    /// Number of floats at the start of the UI rendering vertex data which are unchanged since the previous frame, as they come from retained batches.
+    unsigned unchangedVertexDataSize_{};
+    /// UI rendering vertex data of the previous frame has been uploaded flag.
+    bool vertexDataUploaded_{};
     /// UI rendering batches for debug draw.
     Vector<UIBatch> debugDrawBatches_;
     /// UI rendering vertex data for debug draw.
@@ -424,6 +437,8 @@ private:
     bool useScreenKeyboard_;
     /// Flag for using mutable (erasable) font glyphs.
     bool useMutableGlyphs_;
+    /// Font atlas for mutable glyphs.
+    SharedPtr<FontAtlas> fontAtlas_;
     /// Flag for forcing FreeType auto hinting.
     bool forceAutoHint_;
     /// FreeType hinting level (default is FONT_HINT_LEVEL_NORMAL).
@@ -94,4 +94,19 @@ public:
     Material* customMaterial_{};
 };
 
+/// %UI batches of an element's child elements, retained between frames.
+struct UIRetainedBatches
+{
+    /// Batches. Their vertex data ranges refer to the retained vertex data.
+    Vector<UIBatch> batches_;
+    /// Vertex data.
+    Vector<float> vertexData_;
+    /// Scissor the batches were built with.
+    IntRect scissor_;
+    /// Offset of the vertex data in the UI vertex data of the previous frame, or M_MAX_UNSIGNED if not used there.
+    unsigned vertexOffset_{M_MAX_UNSIGNED};
+    /// Rebuild needed flag.
+    bool dirty_{true};
+};
+
 }
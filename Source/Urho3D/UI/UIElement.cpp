@@ -125,6 +125,7 @@ void UIElement::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Bring To Back", GetBringToBack, SetBringToBack, true, AM_FILE);
     URHO3D_ACCESSOR_ATTRIBUTE("Clip Children", GetClipChildren, SetClipChildren, false, AM_FILE);
     URHO3D_ACCESSOR_ATTRIBUTE("Use Derived Opacity", GetUseDerivedOpacity, SetUseDerivedOpacity, true, AM_FILE);
+    URHO3D_ACCESSOR_ATTRIBUTE("Retain Batches", GetRetainBatches, SetRetainBatches, false, AM_FILE);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Focus Mode", GetFocusMode, SetFocusMode, focusModes, FM_NOTFOCUSABLE, AM_FILE);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Drag And Drop Mode", GetDragDropMode, SetDragDropMode, dragDropModes, DD_DISABLED, AM_FILE);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Layout Mode", GetLayoutMode, SetLayoutMode, layoutModes, LM_FREE, AM_FILE);
@@ -137,6 +138,12 @@ void UIElement::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Tags", tags_, Variant::emptyStringVector, AM_FILE);
 }
 
+void UIElement::OnSetAttribute(const AttributeInfo& attr, const Variant& src)
+{
+    Animatable::OnSetAttribute(attr, src);
+    MarkBatchesDirty();
+}
+
 void UIElement::ApplyAttributes()
 {
     colorGradient_ = false;
@@ -799,6 +806,7 @@ void UIElement::SetClipBorder(const IntRect& rect)
     clipBorder_.top_ = Max(rect.top_, 0);
     clipBorder_.right_ = Max(rect.right_, 0);
     clipBorder_.bottom_ = Max(rect.bottom_, 0);
+    MarkBatchesDirty();
 }
 
 void UIElement::SetColor(const Color& color)
@@ -807,6 +815,7 @@ void UIElement::SetColor(const Color& color)
         cornerColor = color;
     colorGradient_ = false;
     derivedColorDirty_ = true;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetColor(Corner corner, const Color& color)
@@ -814,6 +823,7 @@ void UIElement::SetColor(Corner corner, const Color& color)
     colors_[corner] = color;
     colorGradient_ = false;
     derivedColorDirty_ = true;
+    MarkBatchesDirty();
 
     for (i32 i = 0; i < MAX_UIELEMENT_CORNERS; ++i)
     {
@@ -830,6 +840,7 @@ void UIElement::SetPriority(int priority)
     priority_ = priority;
     if (parent_)
         parent_->sortOrderDirty_ = true;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetOpacity(float opacity)
@@ -851,6 +862,7 @@ void UIElement::SetBringToBack(bool enable)
 void UIElement::SetClipChildren(bool enable)
 {
     clipChildren_ = enable;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetSortChildren(bool enable)
@@ -859,22 +871,26 @@ void UIElement::SetSortChildren(bool enable)
         sortOrderDirty_ = true;
 
     sortChildren_ = enable;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetUseDerivedOpacity(bool enable)
 {
     useDerivedOpacity_ = enable;
+    MarkDirty();
 }
 
 void UIElement::SetEnabled(bool enable)
 {
     enabled_ = enable;
     enabledPrev_ = enable;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetDeepEnabled(bool enable)
 {
     enabled_ = enable;
+    MarkBatchesDirty();
 
     for (Vector<SharedPtr<UIElement>>::ConstIterator i = children_.Begin(); i != children_.End(); ++i)
         (*i)->SetDeepEnabled(enable);
@@ -883,6 +899,7 @@ void UIElement::SetDeepEnabled(bool enable)
 void UIElement::ResetDeepEnabled()
 {
     enabled_ = enabledPrev_;
+    MarkBatchesDirty();
 
     for (Vector<SharedPtr<UIElement>>::ConstIterator i = children_.Begin(); i != children_.End(); ++i)
         (*i)->ResetDeepEnabled();
@@ -892,6 +909,7 @@ void UIElement::SetEnabledRecursive(bool enable)
 {
     enabled_ = enable;
     enabledPrev_ = enable;
+    MarkBatchesDirty();
 
     for (Vector<SharedPtr<UIElement>>::ConstIterator i = children_.Begin(); i != children_.End(); ++i)
         (*i)->SetEnabledRecursive(enable);
@@ -933,7 +951,11 @@ void UIElement::SetFocus(bool enable)
 
 void UIElement::SetSelected(bool enable)
 {
-    selected_ = enable;
+    if (enable != selected_)
+    {
+        selected_ = enable;
+        MarkBatchesDirty();
+    }
 }
 
 void UIElement::SetVisible(bool enable)
@@ -946,6 +968,7 @@ void UIElement::SetVisible(bool enable)
     if (enable != visible_)
     {
         visible_ = enable;
+        MarkBatchesDirty();
 
         // Parent's layout may change as a result of visibility change
         if (parent_)
@@ -1361,6 +1384,7 @@ void UIElement::RemoveChild(UIElement* element, i32 index/* = 0*/)
             element->Detach();
             children_.Erase(i);
             UpdateLayout();
+            MarkBatchesDirty();
             return;
         }
     }
@@ -1390,6 +1414,7 @@ void UIElement::RemoveChildAtIndex(i32 index)
     children_[index]->Detach();
     children_.Erase(index);
     UpdateLayout();
+    MarkBatchesDirty();
 }
 
 void UIElement::RemoveAllChildren()
@@ -1416,6 +1441,7 @@ void UIElement::RemoveAllChildren()
     }
     children_.Clear();
     UpdateLayout();
+    MarkBatchesDirty();
 }
 
 void UIElement::Remove()
@@ -1449,6 +1475,7 @@ void UIElement::SetInternal(bool enable)
 void UIElement::SetTraversalMode(TraversalMode traversalMode)
 {
     traversalMode_ = traversalMode;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetElementEventSender(bool flag)
@@ -1456,6 +1483,28 @@ void UIElement::SetElementEventSender(bool flag)
     elementEventSender_ = flag;
 }
 
+void UIElement::SetRetainBatches(bool enable)
+{
+    if (enable == GetRetainBatches())
+        return;
+
+    if (enable)
+        retainedBatches_ = std::make_unique<UIRetainedBatches>();
+    else
+        retainedBatches_.reset();
+
+    MarkBatchesDirty();
+}
+
+void UIElement::MarkBatchesDirty()
+{
+    for (UIElement* element = this; element; element = element->parent_)
+    {
+        if (element->retainedBatches_)
+            element->retainedBatches_->dirty_ = true;
+    }
+}
+
 void UIElement::SetTags(const StringVector& tags)
 {
     RemoveAllTags();
@@ -1936,13 +1985,21 @@ Animatable* UIElement::FindAttributeAnimationTarget(const String& name, String&
 }
 
 void UIElement::MarkDirty()
+{
+    MarkBatchesDirty();
+    MarkSubtreeDirty();
+}
+
+void UIElement::MarkSubtreeDirty()
 {
     positionDirty_ = true;
     opacityDirty_ = true;
     derivedColorDirty_ = true;
+    if (retainedBatches_)
+        retainedBatches_->dirty_ = true;
 
     for (Vector<SharedPtr<UIElement>>::ConstIterator i = children_.Begin(); i != children_.End(); ++i)
-        (*i)->MarkDirty();
+        (*i)->MarkSubtreeDirty();
 }
 
 bool UIElement::RemoveChildXML(XMLElement& parent, const String& name) const
@@ -11,6 +11,8 @@
 #include "../Scene/Animatable.h"
 #include "../UI/UIBatch.h"
 
+#include <memory>
+
 namespace Urho3D
 {
 
@@ -113,6 +115,8 @@ public:
     /// @nobind
     static void RegisterObject(Context* context);
 
+    /// Handle attribute write access.
+    void OnSetAttribute(const AttributeInfo& attr, const Variant& src) override;
     /// Apply attribute changes that can not be applied immediately.
     void ApplyAttributes() override;
     /// Load from XML data. Return true if successful.
@@ -412,6 +416,11 @@ public:
     /// Set element event sender flag. When child element is added or deleted, the event would be sent using UIElement found in the parental chain having this flag set. If not set, the event is sent using UI's root as per normal.
     /// @property
     void SetElementEventSender(bool flag);
+    /// Set whether to retain the rendering batches of child elements between frames. They are then rebuilt only when an element within changes, which saves work on large element hierarchies that rarely change. Default false.
+    /// @property
+    void SetRetainBatches(bool enable);
+    /// Mark the retained rendering batches of this element and its parents as needing a rebuild. Called automatically by the setters; a subclass that changes its rendering in other ways must call it.
+    void MarkBatchesDirty();
 
     /// Set tags. Old tags are overwritten.
     void SetTags(const StringVector& tags);
@@ -751,6 +760,14 @@ public:
     /// @property
     TraversalMode GetTraversalMode() const { return traversalMode_; }
 
+    /// Return whether the rendering batches of child elements are retained between frames.
+    /// @property
+    bool GetRetainBatches() const { return retainedBatches_ != nullptr; }
+
+    /// Return retained rendering batches of child elements, or null if not retained. Used by UI.
+    /// @nobind
+    UIRetainedBatches* GetRetainedBatches() const { return retainedBatches_.get(); }
+
     /// Return whether element should send child added / removed events by itself. If false, defers to parent element.
     /// @property
     bool IsElementEventSender() const { return elementEventSender_; }
@@ -765,6 +782,8 @@ public:
     void SetRenderTexture(Texture2D* texture);
 
 protected:
+    /// Return false, as OnSetAttribute() also marks the batches dirty.
+    bool IsTypedAttributeAccessSupported() const override { return false; }
     /// Handle attribute animation added.
     void OnAttributeAnimationAdded() override;
     /// Handle attribute animation removed.
@@ -773,6 +792,8 @@ protected:
     Animatable* FindAttributeAnimationTarget(const String& name, String& outName) override;
     /// Mark screen position as needing an update.
     void MarkDirty();
+    /// Mark position, opacity and color of this element and its children dirty, without marking the parents' retained batches.
+    void MarkSubtreeDirty();
     /// Remove child XML element by matching attribute name.
     bool RemoveChildXML(XMLElement& parent, const String& name) const;
     /// Remove child XML element by matching attribute name and value.
@@ -925,6 +946,8 @@ private:
     TraversalMode traversalMode_{TM_BREADTH_FIRST};
     /// Flag whether node should send child added / removed events by itself.
     bool elementEventSender_{};
+    /// Retained rendering batches of child elements.
+    std::unique_ptr<UIRetainedBatches> retainedBatches_;
     /// XPath query for selecting UI-style.
     static XPathQuery styleXPathQuery_;
     /// Tag list.
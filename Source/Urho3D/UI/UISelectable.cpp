@@ -40,11 +40,13 @@ void UISelectable::GetBatches(Vector<UIBatch>& batches, Vector<float>& vertexDat
 void UISelectable::SetSelectionColor(const Color& color)
 {
     selectionColor_ = color;
+    MarkBatchesDirty();
 }
 
 void UISelectable::SetHoverColor(const Color& color)
 {
     hoverColor_ = color;
+    MarkBatchesDirty();
 }
 
 }
@@ -281,16 +281,19 @@ void Window::SetModal(bool modal)
 void Window::SetModalShadeColor(const Color& color)
 {
     modalShadeColor_ = color;
+    MarkBatchesDirty();
 }
 
 void Window::SetModalFrameColor(const Color& color)
 {
     modalFrameColor_ = color;
+    MarkBatchesDirty();
 }
 
 void Window::SetModalFrameSize(const IntVector2& size)
 {
     modalFrameSize_ = size;
+    MarkBatchesDirty();
 }
 
 void Window::SetModalAutoDismiss(bool enable)
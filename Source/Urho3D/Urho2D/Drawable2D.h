@@ -76,7 +76,7 @@ public:
     /// @property
     int GetOrderInLayer() const { return orderInLayer_; }
 
-    /// Return all source batches (called by Renderer2D).
+    /// Return all source batches, updating them first if necessary. Called by Renderer2D, also from worker threads for visible drawables.
     const Vector<SourceBatch2D>& GetSourceBatches();
 
 protected:
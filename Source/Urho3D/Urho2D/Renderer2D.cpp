@@ -3,6 +3,8 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/FrameArena.h"
+#include "../Container/Sort.h"
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
 #include "../Core/WorkQueue.h"
@@ -31,6 +33,18 @@ extern const char* blendModeNames[];
 
 static const VertexElements MASK_VERTEX2D = VertexElements::Position | VertexElements::Color | VertexElements::TexCoord1;
 
+/// Minimum number of vertices copied by one work item when the vertex buffer is filled in parallel.
+static const unsigned MIN_VERTICES_PER_COPY_WORK_ITEM = 8192;
+
+/// Packed sort key of a 2D source batch for radix sorting.
+struct SourceBatch2DSortKey
+{
+    /// Sort key.
+    u64 key_;
+    /// Source batch.
+    const SourceBatch2D* batch_;
+};
+
 ViewBatchInfo2D::ViewBatchInfo2D() :
     vertexBufferUpdateFrameNumber_(0),
     indexCount_(0),
@@ -107,6 +121,23 @@ void Renderer2D::UpdateBatches(const FrameInfo& frame)
     }
 }
 
+static void CopyVertices(const SourceBatch2D** start, const SourceBatch2D** end, Vertex2D* dest)
+{
+    while (start != end)
+    {
+        const Vector<Vertex2D>& vertices = (*start++)->vertices_;
+        memcpy(static_cast<void*>(dest), vertices.Buffer(), vertices.Size() * sizeof(Vertex2D));
+        dest += vertices.Size();
+    }
+}
+
+static void CopyVerticesWork(const WorkItem* item, i32 /*threadIndex*/)
+{
+    auto** start = reinterpret_cast<const SourceBatch2D**>(item->start_);
+    auto** end = reinterpret_cast<const SourceBatch2D**>(item->end_);
+    CopyVertices(start, end, reinterpret_cast<Vertex2D*>(item->aux_));
+}
+
 void Renderer2D::UpdateGeometry(const FrameInfo& frame)
 {
     unsigned indexCount = 0;
@@ -116,9 +147,14 @@ void Renderer2D::UpdateGeometry(const FrameInfo& frame)
             indexCount = Max(indexCount, i->second_.indexCount_);
     }
 
-    // Fill index buffer
+    // Fill index buffer. Leave room to grow, as all indices are written again on resize
     if (indexBuffer_->GetIndexCount() < indexCount || indexBuffer_->IsDataLost())
     {
+        if (indexBuffer_->GetIndexCount() < indexCount)
+            indexCount = NextPowerOfTwo(indexCount / 6) * 6;
+        else
+            indexCount = indexBuffer_->GetIndexCount();
+
         bool largeIndices = (indexCount * 4 / 6) > 0xffff;
         indexBuffer_->SetSize(indexCount, largeIndices);
 
@@ -173,22 +209,47 @@ void Renderer2D::UpdateGeometry(const FrameInfo& frame)
     {
         unsigned vertexCount = viewBatchInfo.vertexCount_;
         VertexBuffer* vertexBuffer = viewBatchInfo.vertexBuffer_;
+        // Leave room to grow, as resizing recreates the buffer
         if (vertexBuffer->GetVertexCount() < vertexCount)
-            vertexBuffer->SetSize(vertexCount, MASK_VERTEX2D, true);
+            vertexBuffer->SetSize(NextPowerOfTwo(vertexCount), MASK_VERTEX2D, true);
 
         if (vertexCount)
         {
             auto* dest = reinterpret_cast<Vertex2D*>(vertexBuffer->Lock(0, vertexCount, true));
             if (dest)
             {
-                const Vector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
-                for (unsigned b = 0; b < sourceBatches.Size(); ++b)
+                Vector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
+                const SourceBatch2D** start = sourceBatches.Buffer();
+                const SourceBatch2D** end = start + sourceBatches.Size();
+
+                auto* queue = GetSubsystem<WorkQueue>();
+                int numWorkItems = Min(queue->GetNumThreads() + 1, (int)(vertexCount / MIN_VERTICES_PER_COPY_WORK_ITEM));
+                if (numWorkItems > 1)
                 {
-                    const Vector<Vertex2D>& vertices = sourceBatches[b]->vertices_;
-                    for (unsigned i = 0; i < vertices.Size(); ++i)
-                        dest[i] = vertices[i];
-                    dest += vertices.Size();
+                    // Split the source batches into ranges of about the same number of vertices
+                    unsigned verticesPerItem = vertexCount / numWorkItems;
+                    for (int i = 0; i < numWorkItems && start != end; ++i)
+                    {
+                        SharedPtr<WorkItem> item = queue->GetFreeItem();
+                        item->priority_ = WI_MAX_PRIORITY;
+                        item->workFunction_ = CopyVerticesWork;
+                        item->aux_ = dest;
+                        item->start_ = start;
+
+                        unsigned itemVertexCount = 0;
+                        while (start != end && (i == numWorkItems - 1 || itemVertexCount < verticesPerItem))
+                            itemVertexCount += (*start++)->vertices_.Size();
+
+                        item->end_ = start;
+                        queue->AddWorkItem(item);
+
+                        dest += itemVertexCount;
+                    }
+
+                    queue->Complete(WI_MAX_PRIORITY);
                 }
+                else
+                    CopyVertices(start, end, dest);
 
                 vertexBuffer->Unlock();
             }
@@ -294,7 +355,11 @@ void CheckDrawableVisibilityWork(const WorkItem* item, i32 threadIndex)
     {
         Drawable2D* drawable = *start++;
         if (renderer->CheckVisibility(drawable))
+        {
             drawable->MarkInView(renderer->frame_);
+            // Generate the vertices of visible drawables here instead of later in the main thread
+            drawable->GetSourceBatches();
+        }
     }
 }
 
@@ -383,18 +448,45 @@ void Renderer2D::GetDrawables(Vector<Drawable2D*>& drawables, Node* node)
         GetDrawables(drawables, i->Get());
 }
 
-static inline bool CompareSourceBatch2Ds(const SourceBatch2D* lhs, const SourceBatch2D* rhs)
+static inline u64 GetDrawOrderKey(int drawOrder)
 {
-    if (lhs->drawOrder_ != rhs->drawOrder_)
-        return lhs->drawOrder_ < rhs->drawOrder_;
+    // Flip the sign bit so that negative values come first
+    return (u32)drawOrder ^ 0x80000000u;
+}
 
-    if (lhs->distance_ != rhs->distance_)
-        return lhs->distance_ > rhs->distance_;
+static inline u64 GetBackToFrontKey(float distance)
+{
+    u32 bits;
+    memcpy(&bits, &distance, sizeof(bits));
+    // Flip the bits of a key which sorts in the same order as the distance, so that the furthest comes first
+    return (bits & 0x80000000u) ? bits : (~bits & 0x7fffffffu);
+}
 
-    if (lhs->material_ != rhs->material_)
-        return lhs->material_->GetNameHash() < rhs->material_->GetNameHash();
+void Renderer2D::SortSourceBatches(Vector<const SourceBatch2D*>& sourceBatches)
+{
+    const i32 count = sourceBatches.Size();
+    FrameVector<SourceBatch2DSortKey> keys;
+    FrameVector<SourceBatch2DSortKey> temp;
+    keys.Resize(count);
+    temp.Resize(count);
+
+    // Sort by material first. The radix sort is stable, so the batches at the same distance stay grouped by material
+    for (i32 i = 0; i < count; ++i)
+        keys[i] = SourceBatch2DSortKey{sourceBatches[i]->material_->GetNameHash().Value(), sourceBatches[i]};
+    RadixSort(RandomAccessIterator<SourceBatch2DSortKey>(keys.Begin()), RandomAccessIterator<SourceBatch2DSortKey>(keys.End()),
+        RandomAccessIterator<SourceBatch2DSortKey>(temp.Begin()));
+
+    // Then by draw order and back to front
+    for (i32 i = 0; i < count; ++i)
+    {
+        const SourceBatch2D* batch = keys[i].batch_;
+        keys[i].key_ = (GetDrawOrderKey(batch->drawOrder_) << 32u) | GetBackToFrontKey(batch->distance_);
+    }
+    RadixSort(RandomAccessIterator<SourceBatch2DSortKey>(keys.Begin()), RandomAccessIterator<SourceBatch2DSortKey>(keys.End()),
+        RandomAccessIterator<SourceBatch2DSortKey>(temp.Begin()));
 
-    return lhs < rhs;
+    for (i32 i = 0; i < count; ++i)
+        sourceBatches[i] = keys[i].batch_;
 }
 
 void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* camera)
@@ -425,7 +517,7 @@ void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* cam
         sourceBatch->distance_ = camera->GetDistance(worldPos);
     }
 
-    Sort(sourceBatches.Begin(), sourceBatches.End(), CompareSourceBatch2Ds);
+    SortSourceBatches(sourceBatches);
 
     viewBatchInfo.batchCount_ = 0;
     Material* currMaterial = nullptr;
@@ -82,6 +82,9 @@ public:
     /// Check visibility.
     bool CheckVisibility(Drawable2D* drawable) const;
 
+    /// Sort source batches by draw order, back to front and by material. Batches equal in all three keep their order.
+    static void SortSourceBatches(Vector<const SourceBatch2D*>& sourceBatches);
+
 private:
     /// Recalculate the world-space bounding box.
     void OnWorldBoundingBoxUpdate() override;
@@ -0,0 +1,262 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Material.h"
+#include "../GraphicsAPI/Texture2D.h"
+#include "../Scene/Node.h"
+#include "../Urho2D/Renderer2D.h"
+#include "../Urho2D/Sprite2D.h"
+#include "../Urho2D/TileMap2D.h"
+#include "../Urho2D/TileMapChunk2D.h"
+#include "../Urho2D/TileMapLayer2D.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+TileMapChunk2D::TileMapChunk2D(Context* context) :
+    Drawable2D(context),
+    numTiles_(0)
+{
+}
+
+TileMapChunk2D::~TileMapChunk2D() = default;
+
+void TileMapChunk2D::RegisterObject(Context* context)
+{
+    context->RegisterFactory<TileMapChunk2D>();
+
+    URHO3D_COPY_BASE_ATTRIBUTES(Drawable2D);
+}
+
+void TileMapChunk2D::Initialize(TileMapLayer2D* layer, const IntRect& tileRect)
+{
+    layer_ = layer;
+    tileRect_ = tileRect;
+
+    BakeTiles();
+}
+
+// Write the vertices of a tile at a position the same way as StaticSprite2D does. Return false if the tile can not be drawn
+static bool GetTileVertices(const Tile2D* tile, const Vector2& position, Vertex2D* vertices)
+{
+    Sprite2D* sprite = tile->GetSprite();
+    Rect drawRect;
+    Rect textureRect;
+    if (!sprite || !sprite->GetTexture() || !sprite->GetDrawRectangle(drawRect) ||
+        !sprite->GetTextureRectangle(textureRect, tile->GetFlipX(), tile->GetFlipY()))
+        return false;
+
+    /*
+    V1---------V2
+    |         / |
+    |       /   |
+    |     /     |
+    |   /       |
+    | /         |
+    V0---------V3
+    */
+    const Vector3 origin(position);
+    vertices[0].position_ = origin + Vector3(drawRect.min_.x_, drawRect.min_.y_, 0.0f);
+    vertices[1].position_ = origin + Vector3(drawRect.min_.x_, drawRect.max_.y_, 0.0f);
+    vertices[2].position_ = origin + Vector3(drawRect.max_.x_, drawRect.max_.y_, 0.0f);
+    vertices[3].position_ = origin + Vector3(drawRect.max_.x_, drawRect.min_.y_, 0.0f);
+
+    const bool swapXY = tile->GetSwapXY();
+    vertices[0].uv_ = textureRect.min_;
+    vertices[swapXY ? 3 : 1].uv_ = Vector2(textureRect.min_.x_, textureRect.max_.y_);
+    vertices[2].uv_ = textureRect.max_;
+    vertices[swapXY ? 1 : 3].uv_ = Vector2(textureRect.max_.x_, textureRect.min_.y_);
+
+    vertices[0].color_ = vertices[1].color_ = vertices[2].color_ = vertices[3].color_ = Color::WHITE.ToU32();
+    return true;
+}
+
+void TileMapChunk2D::UpdateTile(int x, int y)
+{
+    if (x < tileRect_.left_ || x >= tileRect_.right_ || y < tileRect_.top_ || y >= tileRect_.bottom_)
+        return;
+
+    TileMapLayer2D* layer = layer_;
+    TileMap2D* tileMap = layer ? layer->GetTileMap() : nullptr;
+    if (!tileMap)
+        return;
+
+    TileVertices& location = tileVertices_[(y - tileRect_.top_) * tileRect_.Width() + x - tileRect_.left_];
+    const Tile2D* tile = layer->GetTile(x, y);
+    Vertex2D vertices[4];
+    bool drawn = tile && !layer->GetTileNode(x, y) && GetTileVertices(tile, tileMap->GetInfo().TileIndexToPosition(x, y), vertices);
+
+    if (!drawn)
+    {
+        if (location.batch_ == NINDEX)
+            return;
+
+        // Collapse the quad in place, so that the other tiles keep their vertices
+        const Vector3 position = localVertices_[location.batch_][location.start_].position_;
+        for (Vertex2D& vertex : vertices)
+            vertex.position_ = position;
+        WriteTileVertices(location, vertices);
+
+        location.batch_ = NINDEX;
+        --numTiles_;
+    }
+    else if (location.batch_ != NINDEX && textures_[location.batch_] == tile->GetSprite()->GetTexture())
+    {
+        WriteTileVertices(location, vertices);
+
+        for (const Vertex2D& vertex : vertices)
+            boundingBox_.Merge(vertex.position_);
+        worldBoundingBoxDirty_ = true;
+    }
+    else
+    {
+        // The tile needs vertices in a different source batch
+        BakeTiles();
+    }
+}
+
+void TileMapChunk2D::OnSceneSet(Scene* scene)
+{
+    Drawable2D::OnSceneSet(scene);
+
+    UpdateMaterials();
+}
+
+void TileMapChunk2D::OnWorldBoundingBoxUpdate()
+{
+    if (boundingBox_.Defined())
+        worldBoundingBox_ = boundingBox_.Transformed(node_->GetWorldTransform());
+    else
+        worldBoundingBox_.Clear();
+}
+
+void TileMapChunk2D::OnDrawOrderChanged()
+{
+    UpdateDrawOrders();
+}
+
+void TileMapChunk2D::UpdateSourceBatches()
+{
+    if (!sourceBatchesDirty_)
+        return;
+
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    for (i32 i = 0; i < localVertices_.Size(); ++i)
+    {
+        const Vector<Vertex2D>& localVertices = localVertices_[i];
+        Vector<Vertex2D>& vertices = sourceBatches_[i].vertices_;
+        vertices.Resize(localVertices.Size());
+
+        for (i32 j = 0; j < localVertices.Size(); ++j)
+        {
+            vertices[j] = localVertices[j];
+            vertices[j].position_ = worldTransform * localVertices[j].position_;
+        }
+    }
+
+    sourceBatchesDirty_ = false;
+}
+
+void TileMapChunk2D::BakeTiles()
+{
+    localVertices_.Clear();
+    textures_.Clear();
+    batchOrders_.Clear();
+    tileVertices_.Resize(tileRect_.Width() * tileRect_.Height());
+    numTiles_ = 0;
+    boundingBox_.Clear();
+
+    TileMapLayer2D* layer = layer_;
+    TileMap2D* tileMap = layer ? layer->GetTileMap() : nullptr;
+    if (tileMap)
+    {
+        const TileMapInfo2D& info = tileMap->GetInfo();
+        const int layerWidth = layer->GetWidth();
+        Vertex2D vertices[4];
+
+        // Row by row, starting a new source batch whenever the texture changes, so that overlapping tiles are drawn in
+        // the same order as by tile nodes
+        i32 index = 0;
+        for (int y = tileRect_.top_; y < tileRect_.bottom_; ++y)
+        {
+            for (int x = tileRect_.left_; x < tileRect_.right_; ++x)
+            {
+                TileVertices& location = tileVertices_[index++];
+                location.batch_ = NINDEX;
+
+                // Tiles with nodes are drawn by their nodes
+                const Tile2D* tile = layer->GetTile(x, y);
+                if (!tile || layer->GetTileNode(x, y) || !GetTileVertices(tile, info.TileIndexToPosition(x, y), vertices))
+                    continue;
+
+                Texture2D* texture = tile->GetSprite()->GetTexture();
+                i32 batch = textures_.Size() - 1;
+                if (textures_.Empty() || textures_.Back() != texture)
+                {
+                    ++batch;
+                    textures_.Push(SharedPtr<Texture2D>(texture));
+                    batchOrders_.Push((y - tileRect_.top_) * layerWidth + x - tileRect_.left_);
+                    localVertices_.Resize(batch + 1);
+                }
+
+                Vector<Vertex2D>& batchVertices = localVertices_[batch];
+                location.batch_ = batch;
+                location.start_ = batchVertices.Size();
+                for (const Vertex2D& vertex : vertices)
+                {
+                    batchVertices.Push(vertex);
+                    boundingBox_.Merge(vertex.position_);
+                }
+
+                ++numTiles_;
+            }
+        }
+    }
+
+    sourceBatches_.Resize(localVertices_.Size());
+    for (SourceBatch2D& sourceBatch : sourceBatches_)
+        sourceBatch.owner_ = this;
+    UpdateDrawOrders();
+    UpdateMaterials();
+
+    sourceBatchesDirty_ = true;
+    worldBoundingBoxDirty_ = true;
+}
+
+void TileMapChunk2D::UpdateDrawOrders()
+{
+    for (i32 i = 0; i < sourceBatches_.Size(); ++i)
+        sourceBatches_[i].drawOrder_ = GetDrawOrder() + batchOrders_[i];
+}
+
+void TileMapChunk2D::UpdateMaterials()
+{
+    for (i32 i = 0; i < sourceBatches_.Size(); ++i)
+        sourceBatches_[i].material_ = renderer_ ? renderer_->GetMaterial(textures_[i], BLEND_ALPHA) : nullptr;
+}
+
+void TileMapChunk2D::WriteTileVertices(const TileVertices& location, const Vertex2D* vertices)
+{
+    Vertex2D* localDest = &localVertices_[location.batch_][location.start_];
+    for (i32 i = 0; i < 4; ++i)
+        localDest[i] = vertices[i];
+
+    // Transform only the changed vertices, unless all of them are transformed again anyway
+    if (!sourceBatchesDirty_ && node_)
+    {
+        const Matrix3x4& worldTransform = node_->GetWorldTransform();
+        Vertex2D* dest = &sourceBatches_[location.batch_].vertices_[location.start_];
+        for (i32 i = 0; i < 4; ++i)
+        {
+            dest[i] = vertices[i];
+            dest[i].position_ = worldTransform * vertices[i].position_;
+        }
+    }
+}
+
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2008-2023 the Urho3D project
+// License: MIT
+
+#pragma once
+
+#include "../Urho2D/Drawable2D.h"
+
+namespace Urho3D
+{
+
+class Tile2D;
+class TileMapLayer2D;
+
+/// Width and height of the tile chunks of an orthogonal tile layer, in tiles. The chunks of the other orientations span the whole width of the layer.
+static const int TILE_CHUNK_SIZE = 32;
+
+/// Draws a rectangle of the tiles of a tile layer. The vertices are baked in the space of the node when the tiles are set,
+/// so that only the node transform is applied when the source batches are updated. The chunk is culled as a whole.
+/// Each run of consecutive tiles with the same texture is a source batch, whose draw order is that of its first tile, so
+/// the tiles draw in the same order as tile nodes would.
+/// @nobind
+class URHO3D_API TileMapChunk2D : public Drawable2D
+{
+    URHO3D_OBJECT(TileMapChunk2D, Drawable2D);
+
+public:
+    /// Construct.
+    explicit TileMapChunk2D(Context* context);
+    /// Destruct.
+    ~TileMapChunk2D() override;
+    /// Register object factory. Drawable2D must be registered first.
+    static void RegisterObject(Context* context);
+
+    /// Set the layer and the rectangle of tile indices to draw, and bake all tiles.
+    void Initialize(TileMapLayer2D* layer, const IntRect& tileRect);
+    /// Update one tile after it has changed in the layer. Patches the vertices of the tile in place if possible, otherwise bakes the chunk again.
+    void UpdateTile(int x, int y);
+
+    /// Return the rectangle of tile indices. The right and bottom edges are exclusive.
+    const IntRect& GetTileRect() const { return tileRect_; }
+    /// Return number of tiles drawn.
+    i32 GetNumTiles() const { return numTiles_; }
+
+private:
+    /// Location of the vertices of a tile.
+    struct TileVertices
+    {
+        /// Source batch index, or NINDEX if the tile is not drawn.
+        i32 batch_;
+        /// Index of the first vertex in the source batch.
+        i32 start_;
+    };
+
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+    /// Recalculate the world-space bounding box.
+    void OnWorldBoundingBoxUpdate() override;
+    /// Handle draw order changed.
+    void OnDrawOrderChanged() override;
+    /// Update source batches. Transforms the baked vertices, so may be called from a worker thread.
+    void UpdateSourceBatches() override;
+    /// Bake the vertices of all tiles into runs of the same texture.
+    void BakeTiles();
+    /// Update the draw orders of the source batches.
+    void UpdateDrawOrders();
+    /// Update the materials of the source batches. Must be called from the main thread.
+    void UpdateMaterials();
+    /// Overwrite the four baked vertices of a tile, and the transformed ones if they are up to date.
+    void WriteTileVertices(const TileVertices& location, const Vertex2D* vertices);
+
+    /// Layer.
+    WeakPtr<TileMapLayer2D> layer_;
+    /// Rectangle of tile indices.
+    IntRect tileRect_;
+    /// Baked vertices per source batch.
+    Vector<Vector<Vertex2D>> localVertices_;
+    /// Texture per source batch.
+    Vector<SharedPtr<Texture2D>> textures_;
+    /// Draw order per source batch, relative to the first tile of the chunk.
+    Vector<int> batchOrders_;
+    /// Vertex locations of the tiles in the rectangle, row by row.
+    Vector<TileVertices> tileVertices_;
+    /// Number of tiles drawn.
+    i32 numTiles_;
+};
+
+}
@@ -145,6 +145,11 @@ Tile2D::Tile2D() :
 {
 }
 
+void Tile2D::SetSprite(Sprite2D* sprite)
+{
+    sprite_ = sprite;
+}
+
 Sprite2D* Tile2D::GetSprite() const
 {
     return sprite_;
@@ -131,9 +131,14 @@ public:
     /// @property
     bool GetSwapXY() const { return gid_ & FLIP_DIAGONAL; }
 
+    /// Set sprite, for example to create a tile for TileMapLayer2D::SetTile().
+    /// @property
+    void SetSprite(Sprite2D* sprite);
     /// Return sprite.
     /// @property
     Sprite2D* GetSprite() const;
+    /// Return whether has any properties.
+    bool HasProperties() const { return propertySet_.NotNull(); }
     /// Return has property.
     bool HasProperty(const String& name) const;
     /// Return property.
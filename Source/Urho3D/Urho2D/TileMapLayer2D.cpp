@@ -9,6 +9,7 @@
 #include "../Scene/Node.h"
 #include "../Urho2D/StaticSprite2D.h"
 #include "../Urho2D/TileMap2D.h"
+#include "../Urho2D/TileMapChunk2D.h"
 #include "../Urho2D/TileMapLayer2D.h"
 #include "../Urho2D/TmxFile2D.h"
 
@@ -162,6 +163,15 @@ void TileMapLayer2D::Initialize(TileMap2D* tileMap, const TmxLayer2D* tmxLayer)
         }
 
         nodes_.Clear();
+
+        for (unsigned i = 0; i < chunks_.Size(); ++i)
+        {
+            if (chunks_[i]->GetNode())
+                chunks_[i]->GetNode()->Remove();
+        }
+
+        chunks_.Clear();
+        tiles_.Clear();
     }
 
     tileLayer_ = nullptr;
@@ -211,6 +221,9 @@ void TileMapLayer2D::SetDrawOrder(int drawOrder)
         if (staticSprite)
             staticSprite->SetLayer(drawOrder_);
     }
+
+    for (unsigned i = 0; i < chunks_.Size(); ++i)
+        chunks_[i]->SetLayer(drawOrder_);
 }
 
 void TileMapLayer2D::SetVisible(bool visible)
@@ -225,6 +238,12 @@ void TileMapLayer2D::SetVisible(bool visible)
         if (nodes_[i])
             nodes_[i]->SetEnabled(visible_);
     }
+
+    for (unsigned i = 0; i < chunks_.Size(); ++i)
+    {
+        if (chunks_[i]->GetNode())
+            chunks_[i]->GetNode()->SetEnabled(visible_);
+    }
 }
 
 TileMap2D* TileMapLayer2D::GetTileMap() const
@@ -267,7 +286,39 @@ Tile2D* TileMapLayer2D::GetTile(int x, int y) const
     if (!tileLayer_)
         return nullptr;
 
-    return tileLayer_->GetTile(x, y);
+    if (x < 0 || x >= tileLayer_->GetWidth() || y < 0 || y >= tileLayer_->GetHeight())
+        return nullptr;
+
+    return tiles_[y * tileLayer_->GetWidth() + x];
+}
+
+void TileMapLayer2D::SetTile(int x, int y, Tile2D* tile)
+{
+    if (!tileLayer_)
+        return;
+
+    int width = tileLayer_->GetWidth();
+    if (x < 0 || x >= width || y < 0 || y >= tileLayer_->GetHeight())
+        return;
+
+    int index = y * width + x;
+    if (tile == tiles_[index])
+        return;
+
+    tiles_[index] = tile;
+
+    if (nodes_[index])
+    {
+        nodes_[index]->Remove();
+        nodes_[index].Reset();
+    }
+
+    if (tile && tile->HasProperties())
+        CreateTileNode(x, y);
+
+    int chunkWidth = GetChunkWidth();
+    int numChunksX = (width + chunkWidth - 1) / chunkWidth;
+    chunks_[(y / TILE_CHUNK_SIZE) * numChunksX + x / chunkWidth]->UpdateTile(x, y);
 }
 
 Node* TileMapLayer2D::GetTileNode(int x, int y) const
@@ -323,30 +374,64 @@ void TileMapLayer2D::SetTileLayer(const TmxTileLayer2D* tileLayer)
     int width = tileLayer->GetWidth();
     int height = tileLayer->GetHeight();
     nodes_.Resize((unsigned)(width * height));
+    tiles_.Resize((unsigned)(width * height));
 
-    const TileMapInfo2D& info = tileMap_->GetInfo();
+    // Only tiles with properties get a node, so that they can be found and extended like objects
     for (int y = 0; y < height; ++y)
     {
         for (int x = 0; x < width; ++x)
         {
-            const Tile2D* tile = tileLayer->GetTile(x, y);
-            if (!tile)
-                continue;
+            Tile2D* tile = tileLayer->GetTile(x, y);
+            tiles_[y * width + x] = tile;
 
-            SharedPtr<Node> tileNode(GetNode()->CreateTemporaryChild("Tile"));
-            tileNode->SetPosition(Vector3(info.TileIndexToPosition(x, y)));
+            if (tile && tile->HasProperties())
+                CreateTileNode(x, y);
+        }
+    }
 
-            auto* staticSprite = tileNode->CreateComponent<StaticSprite2D>();
-            staticSprite->SetSprite(tile->GetSprite());
-            staticSprite->SetFlip(tile->GetFlipX(), tile->GetFlipY(), tile->GetSwapXY());
-            staticSprite->SetLayer(drawOrder_);
-            staticSprite->SetOrderInLayer(y * width + x);
+    // The other tiles are baked into chunks, which are drawn in the same order as nodes of their first tiles would be
+    int chunkWidth = GetChunkWidth();
+    for (int y = 0; y < height; y += TILE_CHUNK_SIZE)
+    {
+        for (int x = 0; x < width; x += chunkWidth)
+        {
+            SharedPtr<Node> chunkNode(GetNode()->CreateTemporaryChild("TileChunk"));
+
+            SharedPtr<TileMapChunk2D> chunk(chunkNode->CreateComponent<TileMapChunk2D>());
+            chunk->SetLayer(drawOrder_);
+            chunk->SetOrderInLayer(y * width + x);
+            chunk->Initialize(this, IntRect(x, y, Min(x + chunkWidth, width), Min(y + TILE_CHUNK_SIZE, height)));
 
-            nodes_[y * width + x] = tileNode;
+            chunks_.Push(chunk);
         }
     }
 }
 
+int TileMapLayer2D::GetChunkWidth() const
+{
+    // Tiles of the other orientations overlap their neighbours, so their chunks are strips of whole rows, which keep the
+    // draw order of the tiles across chunks
+    return tileMap_->GetInfo().orientation_ == O_ORTHOGONAL ? TILE_CHUNK_SIZE : tileLayer_->GetWidth();
+}
+
+void TileMapLayer2D::CreateTileNode(int x, int y)
+{
+    const Tile2D* tile = tiles_[y * tileLayer_->GetWidth() + x];
+    const TileMapInfo2D& info = tileMap_->GetInfo();
+
+    SharedPtr<Node> tileNode(GetNode()->CreateTemporaryChild("Tile"));
+    tileNode->SetPosition(Vector3(info.TileIndexToPosition(x, y)));
+    tileNode->SetEnabled(visible_);
+
+    auto* staticSprite = tileNode->CreateComponent<StaticSprite2D>();
+    staticSprite->SetSprite(tile->GetSprite());
+    staticSprite->SetFlip(tile->GetFlipX(), tile->GetFlipY(), tile->GetSwapXY());
+    staticSprite->SetLayer(drawOrder_);
+    staticSprite->SetOrderInLayer(y * tileLayer_->GetWidth() + x);
+
+    nodes_[y * tileLayer_->GetWidth() + x] = tileNode;
+}
+
 void TileMapLayer2D::SetObjectGroup(const TmxObjectGroup2D* objectGroup)
 {
     objectGroup_ = objectGroup;
@@ -16,6 +16,7 @@ namespace Urho3D
 class DebugRenderer;
 class Node;
 class TileMap2D;
+class TileMapChunk2D;
 class TmxImageLayer2D;
 class TmxLayer2D;
 class TmxObjectGroup2D;
@@ -75,10 +76,12 @@ public:
     /// Return height (for tile layer only).
     /// @property
     int GetHeight() const;
-    /// Return tile node (for tile layer only).
+    /// Return tile node (for tile layer only). Only tiles with properties have nodes, the other tiles are drawn in chunks.
     Node* GetTileNode(int x, int y) const;
     /// Return tile (for tile layer only).
     Tile2D* GetTile(int x, int y) const;
+    /// Set tile (for tile layer only). Null removes the tile. Changes only this layer, not the tmx file.
+    void SetTile(int x, int y, Tile2D* tile);
 
     /// Return number of tile map objects (for object group only).
     /// @property
@@ -99,6 +102,10 @@ private:
     void SetObjectGroup(const TmxObjectGroup2D* objectGroup);
     /// Set image layer.
     void SetImageLayer(const TmxImageLayer2D* imageLayer);
+    /// Return width of the tile chunks in tiles.
+    int GetChunkWidth() const;
+    /// Create the node of a tile with properties.
+    void CreateTileNode(int x, int y);
 
     /// Tile map.
     WeakPtr<TileMap2D> tileMap_;
@@ -116,6 +123,10 @@ private:
     bool visible_{true};
     /// Tile node or image nodes.
     Vector<SharedPtr<Node>> nodes_;
+    /// Tiles (for tile layer only).
+    Vector<SharedPtr<Tile2D>> tiles_;
+    /// Tile chunks (for tile layer only).
+    Vector<SharedPtr<TileMapChunk2D>> chunks_;
 };
 
 }
@@ -13,6 +13,7 @@
 #include "../Urho2D/Sprite2D.h"
 #include "../Urho2D/SpriteSheet2D.h"
 #include "../Urho2D/TileMap2D.h"
+#include "../Urho2D/TileMapChunk2D.h"
 #include "../Urho2D/TileMapLayer2D.h"
 #include "../Urho2D/TmxFile2D.h"
 #include "../Urho2D/Urho2D.h"
@@ -46,6 +47,7 @@ void RegisterUrho2DLibrary(Context* context)
     TmxFile2D::RegisterObject(context);
     TileMap2D::RegisterObject(context);
     TileMapLayer2D::RegisterObject(context);
+    TileMapChunk2D::RegisterObject(context);
 }
 
 }
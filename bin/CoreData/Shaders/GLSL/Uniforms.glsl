@@ -1,5 +1,4 @@
-// Use of constant buffers on OpenGL 3 commented out for now as it seems to be slower in practice
-//#define USE_CBUFFERS
+// On OpenGL 3 the engine defines USE_CBUFFERS, as it packs the constant buffer data of each frame into one uniform buffer
 
 #if !defined(GL3) || !defined(USE_CBUFFERS)
 
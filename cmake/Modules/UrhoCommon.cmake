@@ -254,6 +254,10 @@ if (NOT WEB)
     set (THREADING_DEFAULT TRUE)
 endif ()
 option (URHO3D_THREADING "Enable thread support, on Web platform default to 0, on other platforms default to 1" ${THREADING_DEFAULT})
+# Atomic reference counting is disabled by default, as it makes copying and releasing shared pointers slower
+cmake_dependent_option (URHO3D_THREAD_SAFE_REFCOUNT "Enable atomic reference counting, so that shared and weak pointers to the same object can be copied and released in several threads" FALSE "URHO3D_THREADING" FALSE)
+# Allocate scene nodes and components from the size-class pool by default. If disabled, they are allocated from the heap, for example to find their leaks with a memory checker
+option (URHO3D_POOL_ALLOCATION "Enable allocating scene nodes and components from the size-class pool" TRUE)
 if (URHO3D_TESTING)
     if (WEB)
         set (DEFAULT_TIMEOUT 10)